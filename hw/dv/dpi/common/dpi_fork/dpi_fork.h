@@ -0,0 +1,83 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_DPI_COMMON_DPI_FORK_DPI_FORK_H_
+#define OPENTITAN_HW_DV_DPI_COMMON_DPI_FORK_DPI_FORK_H_
+
+/**
+ * Fork hooks for DPI models
+ *
+ * Simulators that fork copies of a running simulation, like the test server
+ * mode of VerilatorSimCtrl, provide dpi_fork_register(). fork() only keeps the
+ * calling thread, and the copies must not share the host endpoints of the
+ * parent, so DPI models with threads or endpoints register two hooks when they
+ * are created:
+ *
+ * - `prepare` is called once in the parent before the first fork. It stops the
+ *   threads of the model and closes its host endpoints. The parent does not
+ *   simulate any further, so the model only has to be closed afterwards.
+ * - `child` is called in each copy, in the directory of the copy. It reopens
+ *   the host endpoints there, or on a new port, and restarts the threads.
+ *
+ * Either hook may be NULL. Buffered output of stdio streams is flushed before
+ * each fork, so files that the copies write to may stay open in the parent.
+ *
+ * In simulators that do not fork, dpi_fork_add_hooks() is a no-op.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A fork hook, called with the context the model registered it with
+ */
+typedef void (*dpi_fork_hook_t)(void *ctx);
+
+/**
+ * Register the fork hooks of a DPI model
+ *
+ * This is a weak symbol: it is NULL unless the simulator provides it. Use
+ * dpi_fork_add_hooks() instead.
+ *
+ * @param ctx context of the model, passed to the hooks
+ * @param prepare hook called in the parent before the first fork
+ * @param child hook called in each copy
+ */
+void dpi_fork_register(void *ctx, dpi_fork_hook_t prepare,
+                       dpi_fork_hook_t child) __attribute__((weak));
+
+/**
+ * Unregister the fork hooks of a DPI model
+ *
+ * This is a weak symbol: it is NULL unless the simulator provides it. Use
+ * dpi_fork_remove_hooks() instead.
+ *
+ * @param ctx context the hooks were registered with
+ */
+void dpi_fork_unregister(void *ctx) __attribute__((weak));
+
+/**
+ * Register the fork hooks of a DPI model, if the simulator forks
+ */
+static inline void dpi_fork_add_hooks(void *ctx, dpi_fork_hook_t prepare,
+                                      dpi_fork_hook_t child) {
+  if (dpi_fork_register) {
+    dpi_fork_register(ctx, prepare, child);
+  }
+}
+
+/**
+ * Unregister the fork hooks of a DPI model before it is freed
+ */
+static inline void dpi_fork_remove_hooks(void *ctx) {
+  if (dpi_fork_unregister) {
+    dpi_fork_unregister(ctx);
+  }
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_DV_DPI_COMMON_DPI_FORK_DPI_FORK_H_
@@ -0,0 +1,766 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "dpi_hub.h"
+
+// Strictly speaking, versions of C older than C23 might not declare
+// strdup in string.h. With e.g. glibc, this macro tells it to declare
+// what we need.
+#define __STDC_WANT_LIB_EXT2__ 1
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dpi_fork.h"
+
+#define DPI_HUB_MAX_CHANNELS 32
+#define DPI_HUB_HEADER_BYTES 8
+
+// Bytes buffered per channel from the host, which is also the credit a client
+// gets on connection
+#define DPI_HUB_RX_BYTES 4096
+
+// Bytes buffered per channel for the host
+#define DPI_HUB_TX_BYTES 65536
+
+// Milliseconds a write waits for a connected client to make room in a full
+// buffer before it drops the data
+#define DPI_HUB_TX_TIMEOUT_MS 100
+
+// Bytes of frames received from the client but not processed yet
+#define DPI_HUB_IN_BYTES (4 * (DPI_HUB_HEADER_BYTES + DPI_HUB_RX_BYTES))
+
+// Bytes of frames to send to the client per pass
+#define DPI_HUB_OUT_BYTES (4 * DPI_HUB_TX_BYTES)
+
+/**
+ * A channel of the hub
+ *
+ * All fields but `rx_len` are protected by the lock of the hub.
+ */
+struct dpi_hub_channel {
+  struct dpi_hub *hub;
+  uint16_t id;
+  char *name;
+  bool open;
+  // The CHANNEL and CREDIT frames, or the CLOSE frame, are due to be sent
+  bool announce;
+  bool close;
+
+  // Ring buffer of data from the host. `rx_len` is also read without the lock
+  // to make polling an idle channel cheap.
+  uint8_t rx_buf[DPI_HUB_RX_BYTES];
+  size_t rx_rptr;
+  size_t rx_len;
+  // Credit the client has left, and credit to be returned to it. Together
+  // with `rx_len`, they add up to DPI_HUB_RX_BYTES while a client is connected.
+  uint32_t credit;
+  uint32_t credit_due;
+
+  // Data for the host. Once data was dropped, writes do not wait for room
+  // until the buffer has drained.
+  uint8_t *tx_buf;
+  size_t tx_len;
+  bool tx_dropped;
+};
+
+/**
+ * The hub and its server thread
+ */
+struct dpi_hub {
+  pthread_mutex_t lock;
+  // Signalled when the server thread took data from the channels or the
+  // client disconnected
+  pthread_cond_t tx_cond;
+  char *path;
+  volatile bool run;
+  int sfd;  // socket fd
+  int cfd;  // client fd
+  pthread_t thread;
+  bool thread_running;
+  // Whether a client is connected, protected by the lock
+  bool connected;
+
+  struct dpi_hub_channel *channels[DPI_HUB_MAX_CHANNELS];
+  unsigned num_channels;
+  unsigned num_open;
+
+  // Owned by the server thread
+  uint8_t in_buf[DPI_HUB_IN_BYTES];
+  size_t in_len;
+  uint8_t out_buf[DPI_HUB_OUT_BYTES];
+  size_t out_len;
+  size_t out_pos;
+};
+
+static pthread_mutex_t hub_init_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct dpi_hub *hub_instance;
+
+static uint32_t get_le32(const uint8_t *buf) {
+  return (uint32_t)buf[0] | (uint32_t)buf[1] << 8 | (uint32_t)buf[2] << 16 |
+         (uint32_t)buf[3] << 24;
+}
+
+static void put_le32(uint8_t *buf, uint32_t val) {
+  buf[0] = val;
+  buf[1] = val >> 8;
+  buf[2] = val >> 16;
+  buf[3] = val >> 24;
+}
+
+/**
+ * Append a frame to the output buffer
+ *
+ * @return false if the frame does not fit
+ */
+static bool out_frame(struct dpi_hub *hub, uint16_t channel, uint8_t type,
+                      const void *payload, size_t len) {
+  if (DPI_HUB_OUT_BYTES - hub->out_len < DPI_HUB_HEADER_BYTES + len) {
+    return false;
+  }
+  uint8_t *frame = &hub->out_buf[hub->out_len];
+  frame[0] = channel;
+  frame[1] = channel >> 8;
+  frame[2] = type;
+  frame[3] = 0;
+  put_le32(&frame[4], len);
+  memcpy(&frame[DPI_HUB_HEADER_BYTES], payload, len);
+  hub->out_len += DPI_HUB_HEADER_BYTES + len;
+  return true;
+}
+
+/**
+ * Queue the frames due on a channel, with the lock held
+ */
+static void out_channel(struct dpi_hub *hub, struct dpi_hub_channel *ch) {
+  uint8_t credit[4];
+
+  if (ch->announce) {
+    put_le32(credit, ch->credit);
+    if (DPI_HUB_OUT_BYTES - hub->out_len <
+        2 * DPI_HUB_HEADER_BYTES + strlen(ch->name) + sizeof(credit)) {
+      return;
+    }
+    out_frame(hub, ch->id, DPI_HUB_FRAME_CHANNEL, ch->name, strlen(ch->name));
+    out_frame(hub, ch->id, DPI_HUB_FRAME_CREDIT, credit, sizeof(credit));
+    ch->announce = false;
+  }
+
+  if (ch->tx_len && DPI_HUB_OUT_BYTES - hub->out_len > DPI_HUB_HEADER_BYTES) {
+    size_t len = DPI_HUB_OUT_BYTES - hub->out_len - DPI_HUB_HEADER_BYTES;
+    if (len > ch->tx_len) {
+      len = ch->tx_len;
+    }
+    out_frame(hub, ch->id, DPI_HUB_FRAME_DATA, ch->tx_buf, len);
+    ch->tx_len -= len;
+    memmove(ch->tx_buf, &ch->tx_buf[len], ch->tx_len);
+    if (!ch->tx_len) {
+      ch->tx_dropped = false;
+    }
+  }
+
+  // Return credit in batches, unless the model has caught up with the host.
+  size_t rx_len = __atomic_load_n(&ch->rx_len, __ATOMIC_ACQUIRE);
+  if (ch->credit_due >= DPI_HUB_RX_BYTES / 4 ||
+      (ch->credit_due && rx_len == 0)) {
+    put_le32(credit, ch->credit_due);
+    if (out_frame(hub, ch->id, DPI_HUB_FRAME_CREDIT, credit, sizeof(credit))) {
+      ch->credit += ch->credit_due;
+      ch->credit_due = 0;
+    }
+  }
+
+  if (ch->close && out_frame(hub, ch->id, DPI_HUB_FRAME_CLOSE, NULL, 0)) {
+    ch->close = false;
+  }
+}
+
+/**
+ * Close the connection to the client
+ */
+static void client_close(struct dpi_hub *hub) {
+  if (!hub->cfd) {
+    return;
+  }
+  pthread_mutex_lock(&hub->lock);
+  hub->connected = false;
+  pthread_cond_broadcast(&hub->tx_cond);
+  pthread_mutex_unlock(&hub->lock);
+  close(hub->cfd);
+  hub->cfd = 0;
+  hub->in_len = 0;
+  hub->out_len = 0;
+  hub->out_pos = 0;
+}
+
+/**
+ * Start the server on the UNIX socket
+ *
+ * @return 0 on success, -1 in case of an error
+ */
+static int start(struct dpi_hub *hub) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (strlen(hub->path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "DPI hub: Socket path %s is too long\n", hub->path);
+    return -1;
+  }
+  strcpy(addr.sun_path, hub->path);
+
+  int sfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (sfd == -1) {
+    fprintf(stderr, "DPI hub: Unable to create socket: %s (%d)\n",
+            strerror(errno), errno);
+    return -1;
+  }
+
+  if (fcntl(sfd, F_SETFL, O_NONBLOCK) != 0) {
+    fprintf(stderr, "DPI hub: Unable to make socket non-blocking: %s (%d)\n",
+            strerror(errno), errno);
+    close(sfd);
+    return -1;
+  }
+
+  // Replace the socket of an earlier simulation
+  unlink(hub->path);
+  if (bind(sfd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    fprintf(stderr, "DPI hub: Failed to bind socket %s: %s (%d)\n", hub->path,
+            strerror(errno), errno);
+    close(sfd);
+    return -1;
+  }
+
+  if (listen(sfd, 1) != 0) {
+    fprintf(stderr, "DPI hub: Failed to listen on socket: %s (%d)\n",
+            strerror(errno), errno);
+    close(sfd);
+    unlink(hub->path);
+    return -1;
+  }
+
+  hub->sfd = sfd;
+  printf("DPI hub: Listening on %s\n", hub->path);
+  return 0;
+}
+
+/**
+ * Accept an incoming connection from a client (nonblocking)
+ *
+ * Each channel is announced to the new client, with the free space of its
+ * buffer as initial credit.
+ */
+static void client_tryaccept(struct dpi_hub *hub) {
+  int cfd = accept(hub->sfd, NULL, NULL);
+  if (cfd == -1) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      fprintf(stderr,
+              "DPI hub: Unable to accept incoming connection: %s (%d)\n",
+              strerror(errno), errno);
+    }
+    return;
+  }
+
+  if (hub->cfd > 0) {
+    // Enforce a single concurrent connection.
+    fprintf(stderr, "DPI hub: Rejecting additional connection\n");
+    close(cfd);
+    return;
+  }
+
+  if (fcntl(cfd, F_SETFL, O_NONBLOCK) != 0) {
+    fprintf(stderr,
+            "DPI hub: Unable to make client socket non-blocking: %s (%d)\n",
+            strerror(errno), errno);
+    close(cfd);
+    return;
+  }
+  hub->cfd = cfd;
+
+  pthread_mutex_lock(&hub->lock);
+  hub->connected = true;
+  for (unsigned i = 0; i < hub->num_channels; ++i) {
+    struct dpi_hub_channel *ch = hub->channels[i];
+    if (ch->open) {
+      ch->announce = true;
+      ch->credit = DPI_HUB_RX_BYTES - ch->rx_len;
+      ch->credit_due = 0;
+    }
+  }
+  pthread_mutex_unlock(&hub->lock);
+
+  printf("DPI hub: Accepted client connection\n");
+}
+
+/**
+ * Process the complete frames received from the client, with the lock held
+ *
+ * @return false if the client violated the protocol
+ */
+static bool process_frames(struct dpi_hub *hub) {
+  size_t pos = 0;
+  bool ok = true;
+  while (ok && hub->in_len - pos >= DPI_HUB_HEADER_BYTES) {
+    const uint8_t *frame = &hub->in_buf[pos];
+    uint16_t id = frame[0] | frame[1] << 8;
+    uint8_t type = frame[2];
+    uint32_t len = get_le32(&frame[4]);
+    if (len > DPI_HUB_RX_BYTES) {
+      ok = false;
+      break;
+    }
+    if (hub->in_len - pos < DPI_HUB_HEADER_BYTES + len) {
+      break;
+    }
+    pos += DPI_HUB_HEADER_BYTES + len;
+
+    // Data for channels closed in the meantime and other frame types are
+    // ignored.
+    if (type != DPI_HUB_FRAME_DATA || id >= hub->num_channels ||
+        !hub->channels[id]->open) {
+      continue;
+    }
+    struct dpi_hub_channel *ch = hub->channels[id];
+    if (len > ch->credit) {
+      fprintf(stderr, "DPI hub: Client exceeded its credit on %s\n", ch->name);
+      ok = false;
+      break;
+    }
+    ch->credit -= len;
+
+    size_t wptr = (ch->rx_rptr + ch->rx_len) % DPI_HUB_RX_BYTES;
+    for (uint32_t i = 0; i < len; ++i) {
+      ch->rx_buf[(wptr + i) % DPI_HUB_RX_BYTES] =
+          frame[DPI_HUB_HEADER_BYTES + i];
+    }
+    __atomic_store_n(&ch->rx_len, ch->rx_len + len, __ATOMIC_RELEASE);
+  }
+
+  hub->in_len -= pos;
+  memmove(hub->in_buf, &hub->in_buf[pos], hub->in_len);
+  return ok;
+}
+
+/**
+ * Receive frames from the client
+ */
+static void client_read(struct dpi_hub *hub) {
+  ssize_t num_read = read(hub->cfd, &hub->in_buf[hub->in_len],
+                          DPI_HUB_IN_BYTES - hub->in_len);
+  if (num_read == 0) {
+    printf("DPI hub: Client disconnected\n");
+    client_close(hub);
+    return;
+  }
+  if (num_read < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+      fprintf(stderr, "DPI hub: Error while reading from client: %s (%d)\n",
+              strerror(errno), errno);
+      client_close(hub);
+    }
+    return;
+  }
+  hub->in_len += num_read;
+
+  pthread_mutex_lock(&hub->lock);
+  bool ok = process_frames(hub);
+  pthread_mutex_unlock(&hub->lock);
+  if (!ok) {
+    fprintf(stderr, "DPI hub: Protocol error, dropping client\n");
+    client_close(hub);
+  }
+}
+
+/**
+ * Send the frames due on all channels to the client
+ *
+ * The frames of all channels go out in as few writes as the socket allows.
+ */
+static void client_write(struct dpi_hub *hub) {
+  if (hub->out_pos == hub->out_len) {
+    hub->out_pos = 0;
+    hub->out_len = 0;
+    pthread_mutex_lock(&hub->lock);
+    for (unsigned i = 0; i < hub->num_channels; ++i) {
+      out_channel(hub, hub->channels[i]);
+    }
+    pthread_cond_broadcast(&hub->tx_cond);
+    pthread_mutex_unlock(&hub->lock);
+  }
+
+  while (hub->out_pos < hub->out_len) {
+    ssize_t num_written = send(hub->cfd, &hub->out_buf[hub->out_pos],
+                               hub->out_len - hub->out_pos, MSG_NOSIGNAL);
+    if (num_written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        printf("DPI hub: Client disconnected\n");
+        client_close(hub);
+      }
+      return;
+    }
+    hub->out_pos += num_written;
+  }
+}
+
+/**
+ * Thread function of the hub
+ *
+ * @param hub_void hub object
+ * @return Always returns NULL
+ */
+static void *server_run(void *hub_void) {
+  struct dpi_hub *hub = (struct dpi_hub *)hub_void;
+  struct timeval timeout;
+
+  while (hub->run) {
+    fd_set read_fds;
+    fd_set write_fds;
+    FD_ZERO(&read_fds);
+    FD_ZERO(&write_fds);
+    FD_SET(hub->sfd, &read_fds);
+    if (hub->cfd) {
+      FD_SET(hub->cfd, &read_fds);
+      if (hub->out_pos < hub->out_len) {
+        FD_SET(hub->cfd, &write_fds);
+      }
+    }
+    int mfd = (hub->cfd > hub->sfd) ? hub->cfd : hub->sfd;
+
+    // Same period as the TCP server, set every time since select can trash
+    // it.
+    timeout.tv_sec = 0;
+    timeout.tv_usec = 50;
+
+    int rv = select(mfd + 1, &read_fds, &write_fds, NULL, &timeout);
+    if (rv < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "DPI hub: select failed: %s (%d)\n", strerror(errno),
+              errno);
+      client_close(hub);
+      continue;
+    }
+
+    if (FD_ISSET(hub->sfd, &read_fds)) {
+      client_tryaccept(hub);
+    }
+    if (hub->cfd && FD_ISSET(hub->cfd, &read_fds)) {
+      client_read(hub);
+    }
+    if (hub->cfd) {
+      client_write(hub);
+    }
+  }
+
+  // Give the client the last output and the CLOSE frames.
+  for (int i = 0; i < 1000 && hub->cfd; ++i) {
+    client_write(hub);
+    if (hub->out_pos == hub->out_len) {
+      break;
+    }
+    usleep(100);
+  }
+
+  client_close(hub);
+  close(hub->sfd);
+  hub->sfd = 0;
+  unlink(hub->path);
+  return NULL;
+}
+
+/**
+ * Determine the socket path, or NULL if the hub is not enabled
+ *
+ * @param forked whether the path is for a forked copy of the simulation, which
+ *               puts a socket given by its path in the current directory
+ */
+static char *socket_path(bool forked) {
+  const char *env = getenv("DPI_HUB_SOCKET");
+  if (!env || !*env) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (stat(env, &st) != 0 || !S_ISDIR(st.st_mode)) {
+    if (!forked) {
+      return strdup(env);
+    }
+    char cwd[PATH_MAX];
+    char *cwd_rv = getcwd(cwd, sizeof(cwd));
+    assert(cwd_rv != NULL);
+    // basename() may modify its argument.
+    char *env_copy = strdup(env);
+    assert(env_copy);
+    size_t len = strlen(cwd) + strlen(env) + 2;
+    char *path = (char *)malloc(len);
+    assert(path);
+    snprintf(path, len, "%s/%s", cwd, basename(env_copy));
+    free(env_copy);
+    return path;
+  }
+
+  size_t len = strlen(env) + 32;
+  char *path = (char *)malloc(len);
+  assert(path);
+  snprintf(path, len, "%s/%ld.sock", env, (long)getpid());
+  return path;
+}
+
+/**
+ * Start the server thread of the hub
+ *
+ * @return 0 on success, -1 in case of an error
+ */
+static int thread_start(struct dpi_hub *hub) {
+  hub->run = true;
+  if (start(hub) != 0 ||
+      pthread_create(&hub->thread, NULL, server_run, (void *)hub) != 0) {
+    fprintf(stderr, "DPI hub: Unable to start on %s\n", hub->path);
+    if (hub->sfd) {
+      close(hub->sfd);
+      hub->sfd = 0;
+      unlink(hub->path);
+    }
+    return -1;
+  }
+  hub->thread_running = true;
+  return 0;
+}
+
+/**
+ * Stop the server thread of the hub, which closes the socket
+ */
+static void thread_stop(struct dpi_hub *hub) {
+  if (!hub->thread_running) {
+    return;
+  }
+  hub->run = false;
+  pthread_join(hub->thread, NULL);
+  hub->thread_running = false;
+}
+
+/**
+ * Fork hook: stop the hub before the simulation is forked
+ */
+static void fork_prepare(void *hub_void) {
+  thread_stop((struct dpi_hub *)hub_void);
+}
+
+/**
+ * Fork hook: restart the hub in a forked copy of the simulation
+ *
+ * The channels keep their buffered data, and are announced again to the
+ * client of the new socket.
+ */
+static void fork_child(void *hub_void) {
+  struct dpi_hub *hub = (struct dpi_hub *)hub_void;
+  free(hub->path);
+  hub->path = socket_path(true);
+  thread_start(hub);
+}
+
+/**
+ * Get the hub, starting it on first use
+ */
+static struct dpi_hub *hub_get(void) {
+  pthread_mutex_lock(&hub_init_lock);
+  if (hub_instance) {
+    pthread_mutex_unlock(&hub_init_lock);
+    return hub_instance;
+  }
+
+  char *path = socket_path(false);
+  if (!path) {
+    pthread_mutex_unlock(&hub_init_lock);
+    return NULL;
+  }
+
+  struct dpi_hub *hub = (struct dpi_hub *)calloc(1, sizeof(struct dpi_hub));
+  assert(hub);
+  pthread_mutex_init(&hub->lock, NULL);
+  pthread_cond_init(&hub->tx_cond, NULL);
+  hub->path = path;
+
+  if (thread_start(hub) != 0) {
+    pthread_cond_destroy(&hub->tx_cond);
+    pthread_mutex_destroy(&hub->lock);
+    free(path);
+    free(hub);
+    pthread_mutex_unlock(&hub_init_lock);
+    return NULL;
+  }
+
+  dpi_fork_add_hooks(hub, fork_prepare, fork_child);
+  hub_instance = hub;
+  pthread_mutex_unlock(&hub_init_lock);
+  return hub;
+}
+
+/**
+ * Stop the hub and free it with all its channels
+ */
+static void hub_free(struct dpi_hub *hub) {
+  dpi_fork_remove_hooks(hub);
+  thread_stop(hub);
+  for (unsigned i = 0; i < hub->num_channels; ++i) {
+    free(hub->channels[i]->name);
+    free(hub->channels[i]->tx_buf);
+    free(hub->channels[i]);
+  }
+  pthread_cond_destroy(&hub->tx_cond);
+  pthread_mutex_destroy(&hub->lock);
+  free(hub->path);
+  free(hub);
+}
+
+struct dpi_hub_channel *dpi_hub_channel_open(const char *name) {
+  struct dpi_hub *hub = hub_get();
+  if (!hub) {
+    return NULL;
+  }
+
+  pthread_mutex_lock(&hub->lock);
+  for (unsigned i = 0; i < hub->num_channels; ++i) {
+    if (hub->channels[i]->open && !strcmp(hub->channels[i]->name, name)) {
+      fprintf(stderr, "DPI hub: Channel %s is already open\n", name);
+      pthread_mutex_unlock(&hub->lock);
+      return NULL;
+    }
+  }
+  if (hub->num_channels == DPI_HUB_MAX_CHANNELS) {
+    fprintf(stderr, "DPI hub: Too many channels to open %s\n", name);
+    pthread_mutex_unlock(&hub->lock);
+    return NULL;
+  }
+
+  struct dpi_hub_channel *ch =
+      (struct dpi_hub_channel *)calloc(1, sizeof(struct dpi_hub_channel));
+  assert(ch);
+  ch->tx_buf = (uint8_t *)malloc(DPI_HUB_TX_BYTES);
+  ch->name = strdup(name);
+  assert(ch->tx_buf && ch->name);
+  ch->hub = hub;
+  ch->id = hub->num_channels;
+  ch->open = true;
+  // Announce the channel to a client which is already connected.
+  ch->announce = true;
+  ch->credit = DPI_HUB_RX_BYTES;
+
+  hub->channels[hub->num_channels++] = ch;
+  ++hub->num_open;
+  pthread_mutex_unlock(&hub->lock);
+
+  printf("DPI hub: Opened channel %u for %s\n", ch->id, name);
+  return ch;
+}
+
+size_t dpi_hub_channel_read(struct dpi_hub_channel *channel, void *buf,
+                            size_t len) {
+  assert(channel);
+  if (!len || !__atomic_load_n(&channel->rx_len, __ATOMIC_ACQUIRE)) {
+    return 0;
+  }
+
+  pthread_mutex_lock(&channel->hub->lock);
+  if (len > channel->rx_len) {
+    len = channel->rx_len;
+  }
+  uint8_t *bytes = (uint8_t *)buf;
+  for (size_t i = 0; i < len; ++i) {
+    bytes[i] = channel->rx_buf[channel->rx_rptr];
+    channel->rx_rptr = (channel->rx_rptr + 1) % DPI_HUB_RX_BYTES;
+  }
+  __atomic_store_n(&channel->rx_len, channel->rx_len - len, __ATOMIC_RELEASE);
+  channel->credit_due += len;
+  pthread_mutex_unlock(&channel->hub->lock);
+  return len;
+}
+
+void dpi_hub_channel_write(struct dpi_hub_channel *channel, const void *buf,
+                           size_t len) {
+  assert(channel);
+  struct dpi_hub *hub = channel->hub;
+  const uint8_t *bytes = (const uint8_t *)buf;
+  struct timespec deadline;
+  bool waited = false;
+
+  pthread_mutex_lock(&hub->lock);
+  while (true) {
+    size_t space = DPI_HUB_TX_BYTES - channel->tx_len;
+    size_t num = len < space ? len : space;
+    memcpy(&channel->tx_buf[channel->tx_len], bytes, num);
+    channel->tx_len += num;
+    bytes += num;
+    len -= num;
+    if (!len) {
+      break;
+    }
+
+    // Give a connected client some time to catch up, but do not stall the
+    // simulation on a client that stopped reading.
+    if (hub->connected && !channel->tx_dropped) {
+      if (!waited) {
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += DPI_HUB_TX_TIMEOUT_MS * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        waited = true;
+      }
+      if (pthread_cond_timedwait(&hub->tx_cond, &hub->lock, &deadline) !=
+          ETIMEDOUT) {
+        continue;
+      }
+    }
+
+    if (!channel->tx_dropped) {
+      fprintf(stderr, "DPI hub: Buffer of %s is full %s, dropping data\n",
+              channel->name,
+              hub->connected ? "and the client is not reading"
+                             : "without a client");
+      channel->tx_dropped = true;
+    }
+    break;
+  }
+  pthread_mutex_unlock(&hub->lock);
+}
+
+void dpi_hub_channel_close(struct dpi_hub_channel *channel) {
+  if (!channel) {
+    return;
+  }
+  struct dpi_hub *hub = channel->hub;
+
+  pthread_mutex_lock(&hub->lock);
+  channel->open = false;
+  channel->announce = false;
+  channel->close = true;
+  bool last = --hub->num_open == 0;
+  pthread_mutex_unlock(&hub->lock);
+
+  if (last) {
+    pthread_mutex_lock(&hub_init_lock);
+    hub_instance = NULL;
+    pthread_mutex_unlock(&hub_init_lock);
+    hub_free(hub);
+  }
+}
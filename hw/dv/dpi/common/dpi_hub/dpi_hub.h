@@ -0,0 +1,108 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_DPI_COMMON_DPI_HUB_DPI_HUB_H_
+#define OPENTITAN_HW_DV_DPI_COMMON_DPI_HUB_DPI_HUB_H_
+
+/**
+ * A single host endpoint for all DPI models of a simulation
+ *
+ * If the environment variable DPI_HUB_SOCKET is set, DPI models open a named
+ * channel on the hub instead of their own TCP port, pseudo-terminal or FIFO.
+ * The hub serves all channels on one UNIX socket at the path given in
+ * DPI_HUB_SOCKET, or at `<pid>.sock` in it if it is a directory, which makes
+ * the simulations on a machine easy to discover. The socket is removed when
+ * the last channel is closed.
+ *
+ * One client at a time can connect. The connection carries frames of an
+ * 8-byte header (all fields little-endian) followed by `length` bytes of
+ * payload:
+ *
+ *   uint16_t channel; uint8_t type; uint8_t reserved; uint32_t length;
+ *
+ * with the types
+ *
+ *   DPI_HUB_FRAME_DATA     bytes of the channel's stream, in either direction
+ *   DPI_HUB_FRAME_CREDIT   hub to host: a uint32_t number of bytes the host may
+ *                          send on the channel in addition to before
+ *   DPI_HUB_FRAME_CHANNEL  hub to host: the channel exists and has the name in
+ *                          the payload
+ *   DPI_HUB_FRAME_CLOSE    hub to host: the channel was closed
+ *
+ * On connection, the hub announces each open channel with a CHANNEL frame
+ * followed by a CREDIT frame. The host must not send more data on a channel
+ * than it has been granted credit for; the hub drops a client that does. Data
+ * to the host is buffered while no client is connected or the client does not
+ * keep up, and dropped when the buffer of the channel is full, see
+ * `dpi_hub_channel_write()`. Any number of frames can be batched into one
+ * write, and the hub sends everything the models wrote since its last pass in
+ * one write. util/dpi_hub_client.py is a reference client.
+ *
+ * The hub serves the socket from a thread of its own, which fork() does not
+ * copy. Simulations that fork, like the test server mode of VerilatorSimCtrl,
+ * stop the thread through the hooks of dpi_fork.h, and each copy starts a hub
+ * of its own: on `<pid>.sock` if `DPI_HUB_SOCKET` is a directory, and in the
+ * directory of the copy otherwise.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DPI_HUB_FRAME_DATA 0
+#define DPI_HUB_FRAME_CREDIT 1
+#define DPI_HUB_FRAME_CHANNEL 2
+#define DPI_HUB_FRAME_CLOSE 3
+
+struct dpi_hub_channel;
+
+/**
+ * Open a channel on the hub, starting the hub if necessary
+ *
+ * @param name unique name of the channel, e.g. the display name of the model
+ * @return the channel, or NULL if the hub is not enabled or failed to start
+ */
+struct dpi_hub_channel *dpi_hub_channel_open(const char *name);
+
+/**
+ * Non-blocking read from the channel
+ *
+ * @param channel channel to read from
+ * @param buf buffer for the data read
+ * @param len maximum number of bytes to read
+ * @return number of bytes read
+ */
+size_t dpi_hub_channel_read(struct dpi_hub_channel *channel, void *buf,
+                            size_t len);
+
+/**
+ * Write to the channel
+ *
+ * The data is buffered. While the buffer is full and a client is connected,
+ * the call waits up to 100 ms for the client to make room. Data beyond the
+ * buffer is then discarded, as it is without a client, and later writes do not
+ * wait until the client has drained the buffer.
+ *
+ * @param channel channel to write to
+ * @param buf data to write
+ * @param len number of bytes to write
+ */
+void dpi_hub_channel_write(struct dpi_hub_channel *channel, const void *buf,
+                           size_t len);
+
+/**
+ * Close the channel, and shut down the hub after its last channel
+ *
+ * @param channel channel to close
+ */
+void dpi_hub_channel_close(struct dpi_hub_channel *channel);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_DV_DPI_COMMON_DPI_HUB_DPI_HUB_H_
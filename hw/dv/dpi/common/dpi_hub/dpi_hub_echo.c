@@ -0,0 +1,69 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Stand-in for a simulation in the tests of the DPI hub, see
+// util/dpi_hub_client_test.py. It opens three channels:
+//
+//   echo  sends back everything it receives
+//   sink  never reads, so the credit of the client runs out
+//   ctrl  takes single-byte commands:
+//           'f' writes 4 MiB to sink, then 'F' to ctrl
+//           'q' closes all channels and exits
+//
+// The socket is given in DPI_HUB_SOCKET, as for a simulation.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "dpi_hub.h"
+
+#define FLOOD_BYTES (4 * 1024 * 1024)
+#define MAX_RUNTIME_US (60 * 1000 * 1000)
+#define POLL_US 100
+
+int main(void) {
+  struct dpi_hub_channel *echo = dpi_hub_channel_open("echo");
+  struct dpi_hub_channel *sink = dpi_hub_channel_open("sink");
+  struct dpi_hub_channel *ctrl = dpi_hub_channel_open("ctrl");
+  if (!echo || !sink || !ctrl) {
+    fprintf(stderr, "Unable to open the channels of the DPI hub\n");
+    return 1;
+  }
+
+  static char buf[4096];
+  bool run = true;
+  for (long t = 0; run && t < MAX_RUNTIME_US; t += POLL_US) {
+    size_t len = dpi_hub_channel_read(echo, buf, sizeof(buf));
+    if (len) {
+      dpi_hub_channel_write(echo, buf, len);
+    }
+
+    char cmd;
+    if (dpi_hub_channel_read(ctrl, &cmd, 1)) {
+      switch (cmd) {
+        case 'f':
+          for (size_t i = 0; i < sizeof(buf); ++i) {
+            buf[i] = (char)i;
+          }
+          for (size_t i = 0; i < FLOOD_BYTES; i += sizeof(buf)) {
+            dpi_hub_channel_write(sink, buf, sizeof(buf));
+          }
+          dpi_hub_channel_write(ctrl, "F", 1);
+          break;
+        case 'q':
+          run = false;
+          break;
+        default:
+          fprintf(stderr, "Unknown command %c\n", cmd);
+      }
+    }
+    usleep(POLL_US);
+  }
+
+  dpi_hub_channel_close(echo);
+  dpi_hub_channel_close(sink);
+  dpi_hub_channel_close(ctrl);
+  return run ? 1 : 0;
+}
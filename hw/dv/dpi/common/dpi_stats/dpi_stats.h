@@ -0,0 +1,56 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_DPI_COMMON_DPI_STATS_DPI_STATS_H_
+#define OPENTITAN_HW_DV_DPI_COMMON_DPI_STATS_DPI_STATS_H_
+
+/**
+ * Call counters for DPI models
+ *
+ * Simulators that collect statistics, like VerilatorSimCtrl, provide
+ * dpi_stats_counter(). DPI models get their counter once when they are created
+ * and count their calls with dpi_stats_count(), which is a no-op in
+ * simulators that do not collect statistics.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Get the call counter of a DPI model
+ *
+ * This is a weak symbol: it is NULL unless the simulator provides it. Use
+ * dpi_stats_get_counter() instead.
+ *
+ * @param model name of the DPI model
+ * @return a counter that stays valid for the rest of the simulation
+ */
+uint64_t *dpi_stats_counter(const char *model) __attribute__((weak));
+
+/**
+ * Get the call counter of a DPI model, or NULL if there is none
+ */
+static inline uint64_t *dpi_stats_get_counter(const char *model) {
+  return dpi_stats_counter ? dpi_stats_counter(model) : NULL;
+}
+
+/**
+ * Count a call into a DPI model
+ *
+ * @param counter counter from dpi_stats_get_counter(), may be NULL
+ */
+static inline void dpi_stats_count(uint64_t *counter) {
+  if (counter) {
+    ++*counter;
+  }
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_DV_DPI_COMMON_DPI_STATS_DPI_STATS_H_
@@ -23,6 +23,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "dpi_fork.h"
+#include "dpi_hub.h"
+#include "dpi_stats.h"
+
 /**
  * Simple buffer for passing data between TCP sockets and DPI modules
  */
@@ -48,6 +52,14 @@ struct tcp_server_ctx {
   int sfd;  // socket fd
   int cfd;  // client fd
   pthread_t sock_thread;
+  bool thread_running;
+  // Whether the server was restarted in a forked copy of the simulation,
+  // which falls back to any free port if its port is taken
+  bool forked;
+  // Channel on the DPI hub which replaces the socket, or NULL
+  struct dpi_hub_channel *hub_channel;
+  // Read and write call counter, or NULL
+  uint64_t *stats_calls;
 };
 
 static bool tcp_buffer_is_full(struct tcp_buf *buf) {
@@ -151,6 +163,10 @@ static int start(struct tcp_server_ctx *ctx) {
   addr.sin_port = htons(ctx->listen_port);
 
   rv = bind(sfd, (struct sockaddr *)&addr, sizeof(addr));
+  if (rv != 0 && errno == EADDRINUSE && ctx->forked) {
+    addr.sin_port = 0;
+    rv = bind(sfd, (struct sockaddr *)&addr, sizeof(addr));
+  }
   if (rv != 0) {
     fprintf(stderr, "%s: Failed to bind socket: %s (%d)\n", ctx->display_name,
             strerror(errno), errno);
@@ -165,6 +181,14 @@ static int start(struct tcp_server_ctx *ctx) {
     return -1;
   }
 
+  if (ctx->forked) {
+    socklen_t addr_len = sizeof(addr);
+    rv = getsockname(sfd, (struct sockaddr *)&addr, &addr_len);
+    assert(rv == 0);
+    ctx->listen_port = ntohs(addr.sin_port);
+    printf("%s: Listening on port %d\n", ctx->display_name, ctx->listen_port);
+  }
+
   ctx->sfd = sfd;
   assert(ctx->sfd > 0);
 
@@ -393,12 +417,72 @@ err_cleanup_return:
   return NULL;
 }
 
+/**
+ * Start the server thread
+ *
+ * @param ctx context object
+ * @return 0 on success, -1 in case of an error
+ */
+static int thread_start(struct tcp_server_ctx *ctx) {
+  ctx->socket_run = true;
+  if (pthread_create(&ctx->sock_thread, NULL, server_create, (void *)ctx) !=
+      0) {
+    fprintf(stderr, "%s: Unable to create TCP socket thread\n",
+            ctx->display_name);
+    return -1;
+  }
+  ctx->thread_running = true;
+  return 0;
+}
+
+/**
+ * Stop the server thread, which closes the sockets
+ *
+ * @param ctx context object
+ */
+static void thread_stop(struct tcp_server_ctx *ctx) {
+  if (!ctx->thread_running) {
+    return;
+  }
+  ctx->socket_run = false;
+  pthread_join(ctx->sock_thread, NULL);
+  ctx->thread_running = false;
+}
+
+/**
+ * Fork hook: stop the server before the simulation is forked
+ */
+static void fork_prepare(void *ctx_void) {
+  thread_stop((struct tcp_server_ctx *)ctx_void);
+}
+
+/**
+ * Fork hook: restart the server in a forked copy of the simulation
+ *
+ * Data buffered in either direction is kept, but the client has to connect
+ * again, possibly to another port if several copies run at the same time.
+ */
+static void fork_child(void *ctx_void) {
+  struct tcp_server_ctx *ctx = (struct tcp_server_ctx *)ctx_void;
+  ctx->forked = true;
+  thread_start(ctx);
+}
+
 // Abstract interface functions
 struct tcp_server_ctx *tcp_server_create(const char *display_name,
                                          int listen_port) {
   struct tcp_server_ctx *ctx =
       (struct tcp_server_ctx *)calloc(1, sizeof(struct tcp_server_ctx));
   assert(ctx);
+  ctx->stats_calls = dpi_stats_get_counter("tcp_server");
+
+  // Serve the client through the DPI hub if it is enabled.
+  ctx->hub_channel = dpi_hub_channel_open(display_name);
+  if (ctx->hub_channel) {
+    ctx->display_name = strdup(display_name);
+    assert(ctx->display_name);
+    return ctx;
+  }
 
   // Create the buffers
   struct tcp_buf *buf_in = tcp_buffer_new();
@@ -411,40 +495,56 @@ struct tcp_server_ctx *tcp_server_create(const char *display_name,
   ctx->buf_out = buf_out;
 
   // Set up socket details
-  ctx->socket_run = true;
   ctx->listen_port = listen_port;
   ctx->display_name = strdup(display_name);
   assert(ctx->display_name);
 
-  if (pthread_create(&ctx->sock_thread, NULL, server_create, (void *)ctx) !=
-      0) {
-    fprintf(stderr, "%s: Unable to create TCP socket thread\n",
-            ctx->display_name);
+  if (thread_start(ctx) != 0) {
     ctx_free(ctx);
-    free(ctx);
     return NULL;
   }
+  dpi_fork_add_hooks(ctx, fork_prepare, fork_child);
   return ctx;
 }
 
 bool tcp_server_read(struct tcp_server_ctx *ctx, char *dat) {
+  dpi_stats_count(ctx->stats_calls);
+  if (ctx->hub_channel) {
+    return dpi_hub_channel_read(ctx->hub_channel, dat, 1) == 1;
+  }
   return tcp_buffer_get_byte(ctx->buf_in, dat);
 }
 
 void tcp_server_write(struct tcp_server_ctx *ctx, char dat) {
+  dpi_stats_count(ctx->stats_calls);
+  if (ctx->hub_channel) {
+    dpi_hub_channel_write(ctx->hub_channel, &dat, 1);
+    return;
+  }
   tcp_buffer_put_byte(ctx->buf_out, dat);
 }
 
 void tcp_server_close(struct tcp_server_ctx *ctx) {
+  if (ctx->hub_channel) {
+    dpi_hub_channel_close(ctx->hub_channel);
+    ctx_free(ctx);
+    return;
+  }
+
   // Shut down the socket thread
-  ctx->socket_run = false;
-  pthread_join(ctx->sock_thread, NULL);
+  dpi_fork_remove_hooks(ctx);
+  thread_stop(ctx);
   ctx_free(ctx);
 }
 
 void tcp_server_client_close(struct tcp_server_ctx *ctx) {
   assert(ctx);
 
+  // The client of the DPI hub is shared with other channels, keep it.
+  if (ctx->hub_channel) {
+    return;
+  }
+
   if (!ctx->cfd) {
     return;
   }
@@ -10,6 +10,9 @@
  *
  * This is intended to be used by simulation add-on DPI modules to provide
  * basic TCP socket communication between a host and simulated peripherals.
+ *
+ * If the DPI hub is enabled (see dpi_hub.h), the server is a channel on the
+ * hub named after its display name, instead of listening on its own port.
  */
 
 #ifdef __cplusplus
@@ -4,6 +4,9 @@
 
 #include "gpiodpi.h"
 
+#include "dpi_fork.h"
+#include "dpi_hub.h"
+
 #ifdef __linux__
 #include <linux/limits.h>
 #include <pty.h>
@@ -26,6 +29,9 @@
 // The number of ticks of host_to_device_tick between making syscalls.
 #define TICKS_PER_SYSCALL 2048
 
+// The number of binary events buffered in each direction.
+#define EVENT_BUF_LEN 64
+
 // This module currently is capable of implementing 32 GPIOs.
 #define NUM_GPIO 32
 
@@ -36,6 +42,7 @@
 #define CLR_BIT(word, bit_idx) ((word) &= ~(1 << (bit_idx)))
 
 struct gpiodpi_ctx {
+  char *name;
   // The number of pins we're driving.
   int n_bits;
 
@@ -44,15 +51,52 @@ struct gpiodpi_ctx {
   // Whether or not the pin is being driven weakly or strongly.
   uint32_t weak_pins;
   // A counter of calls into the host_to_device_tick function; used to
-  // avoid excessive `read` syscalls to the pipe fd.
-  uint32_t counter;
+  // avoid excessive `read` syscalls to the pipe fd, and the cycle of the
+  // binary event protocol.
+  uint64_t counter;
 
   // File descriptors and paths for the device-to-host and host-to-device
-  // FIFOs.
+  // FIFOs, -1 while they are closed.
   int dev_to_host_fifo;
   char dev_to_host_path[PATH_MAX];
   int host_to_dev_fifo;
   char host_to_dev_path[PATH_MAX];
+
+  // Channel on the DPI hub which replaces the FIFOs, or NULL. Polling it does
+  // not need a syscall, so it is read on every tick.
+  struct dpi_hub_channel *hub_channel;
+
+  // Whether the host switched to the binary event protocol.
+  bool binary;
+  // The last output state of the device, and the one reported to the host.
+  uint32_t output_values;
+  uint32_t output_enables;
+  uint32_t reported_values;
+  uint32_t reported_enables;
+  // Partial events received from the host.
+  uint8_t in_buf[EVENT_BUF_LEN * GPIODPI_EVENT_BYTES];
+  size_t in_len;
+  // Events for the host, sent in batches.
+  uint8_t out_buf[EVENT_BUF_LEN * GPIODPI_EVENT_BYTES];
+  size_t out_len;
+  // Events scheduled by the host, ordered by cycle, starting at `sched_head`.
+  struct gpiodpi_event *sched;
+  size_t sched_head;
+  size_t sched_len;
+  size_t sched_cap;
+  // The number of events which were received after their cycle.
+  uint64_t late_events;
+};
+
+/**
+ * A decoded binary event, see gpiodpi.h.
+ */
+struct gpiodpi_event {
+  uint8_t type;
+  uint32_t mask;
+  uint32_t value;
+  uint32_t weak;
+  uint64_t cycle;
 };
 
 /**
@@ -107,54 +151,216 @@ static void print_usage(char *rfifo, char *wfifo, int n_bits) {
          wfifo);
 }
 
-void *gpiodpi_create(const char *name, int n_bits) {
-  struct gpiodpi_ctx *ctx =
-      (struct gpiodpi_ctx *)malloc(sizeof(struct gpiodpi_ctx));
-  assert(ctx);
-
-  // n_bits > 32 requires more sophisticated handling of svBitVecVal which we
-  // currently don't do.
-  assert(n_bits <= 32 && "n_bits must be <= 32");
-  ctx->n_bits = n_bits;
-
-  ctx->driven_pin_values = 0;
-  ctx->weak_pins = 0;
-  ctx->counter = 0;
-
+/**
+ * Creates the FIFOs in the current directory and opens them.
+ *
+ * @return false if any of them could not be opened.
+ */
+static bool fifos_open(struct gpiodpi_ctx *ctx) {
   char cwd_buf[PATH_MAX];
   char *cwd = getcwd(cwd_buf, sizeof(cwd_buf));
   assert(cwd != NULL);
 
   int path_len;
-  path_len = snprintf(ctx->dev_to_host_path, PATH_MAX, "%s/%s-read", cwd, name);
+  path_len = snprintf(ctx->dev_to_host_path, PATH_MAX, "%s/%s-read", cwd,
+                      ctx->name);
   assert(path_len > 0 && path_len <= PATH_MAX);
-  path_len =
-      snprintf(ctx->host_to_dev_path, PATH_MAX, "%s/%s-write", cwd, name);
+  path_len = snprintf(ctx->host_to_dev_path, PATH_MAX, "%s/%s-write", cwd,
+                      ctx->name);
   assert(path_len > 0 && path_len <= PATH_MAX);
 
   ctx->dev_to_host_fifo = open_fifo(ctx->dev_to_host_path, O_RDWR);
   if (ctx->dev_to_host_fifo < 0) {
-    return NULL;
+    return false;
   }
 
   ctx->host_to_dev_fifo = open_fifo(ctx->host_to_dev_path, O_RDWR);
   if (ctx->host_to_dev_fifo < 0) {
-    return NULL;
+    return false;
   }
 
   int flags = fcntl(ctx->host_to_dev_fifo, F_GETFL, 0);
   fcntl(ctx->host_to_dev_fifo, F_SETFL, flags | O_NONBLOCK);
 
   print_usage(ctx->dev_to_host_path, ctx->host_to_dev_path, ctx->n_bits);
+  return true;
+}
+
+/**
+ * Closes the FIFOs, if they are open, and deletes them.
+ */
+static void fifos_close(struct gpiodpi_ctx *ctx) {
+  if (ctx->dev_to_host_fifo < 0) {
+    return;
+  }
+
+  if (close(ctx->dev_to_host_fifo) != 0) {
+    printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->dev_to_host_path,
+           strerror(errno));
+  }
+  if (close(ctx->host_to_dev_fifo) != 0) {
+    printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->host_to_dev_path,
+           strerror(errno));
+  }
+  ctx->dev_to_host_fifo = -1;
+  ctx->host_to_dev_fifo = -1;
 
+  if (unlink(ctx->dev_to_host_path) != 0) {
+    printf("GPIO: Failed to unlink FIFO file at %s: %s\n",
+           ctx->dev_to_host_path, strerror(errno));
+  }
+  if (unlink(ctx->host_to_dev_path) != 0) {
+    printf("GPIO: Failed to unlink FIFO file at %s: %s\n",
+           ctx->host_to_dev_path, strerror(errno));
+  }
+}
+
+/**
+ * Fork hook: closes the FIFOs before the simulation is forked.
+ */
+static void fork_prepare(void *ctx_void) {
+  struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
+  if (!ctx->hub_channel) {
+    fifos_close(ctx);
+  }
+}
+
+/**
+ * Fork hook: opens new FIFOs in the directory of the test in a forked copy of
+ * the simulation.
+ *
+ * The host of the copy starts with the text protocol, like any new host. The
+ * pins keep their values and the events scheduled so far.
+ */
+static void fork_child(void *ctx_void) {
+  struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
+  // Events still buffered were meant for the host of the parent.
+  ctx->binary = false;
+  ctx->in_len = 0;
+  ctx->out_len = 0;
+  if (!ctx->hub_channel && !fifos_open(ctx)) {
+    fprintf(stderr, "GPIO: %s is not connected to the host in this test\n",
+            ctx->name);
+  }
+}
+
+void *gpiodpi_create(const char *name, int n_bits) {
+  struct gpiodpi_ctx *ctx =
+      (struct gpiodpi_ctx *)calloc(1, sizeof(struct gpiodpi_ctx));
+  assert(ctx);
+  ctx->name = strdup(name);
+  assert(ctx->name);
+
+  // n_bits > 32 requires more sophisticated handling of svBitVecVal which we
+  // currently don't do.
+  assert(n_bits <= 32 && "n_bits must be <= 32");
+  ctx->n_bits = n_bits;
+
+  ctx->driven_pin_values = 0;
+  ctx->weak_pins = 0;
+  ctx->counter = 0;
+  ctx->dev_to_host_fifo = -1;
+  ctx->host_to_dev_fifo = -1;
+
+  ctx->hub_channel = dpi_hub_channel_open(name);
+  if (ctx->hub_channel) {
+    printf("\nGPIO: Serving %s on the DPI hub, with the FIFO protocol.\n",
+           name);
+  } else if (!fifos_open(ctx)) {
+    return NULL;
+  }
+
+  dpi_fork_add_hooks(ctx, fork_prepare, fork_child);
   return (void *)ctx;
 }
 
+/**
+ * Reads from the host-to-device FIFO or hub channel without blocking.
+ *
+ * @return the number of bytes read, or -1 if there was nothing to read.
+ */
+static ssize_t host_read(struct gpiodpi_ctx *ctx, void *buf, size_t len) {
+  if (ctx->hub_channel) {
+    return dpi_hub_channel_read(ctx->hub_channel, buf, len);
+  }
+  return read(ctx->host_to_dev_fifo, buf, len);
+}
+
+static uint32_t get_le32(const uint8_t *buf) {
+  return (uint32_t)buf[0] | (uint32_t)buf[1] << 8 | (uint32_t)buf[2] << 16 |
+         (uint32_t)buf[3] << 24;
+}
+
+static void put_le32(uint8_t *buf, uint32_t val) {
+  for (int i = 0; i < 4; ++i) {
+    buf[i] = val >> (8 * i);
+  }
+}
+
+/**
+ * Sends the buffered events to the host.
+ */
+static void flush_events(struct gpiodpi_ctx *ctx) {
+  if (ctx->out_len == 0) {
+    return;
+  }
+  if (ctx->hub_channel) {
+    dpi_hub_channel_write(ctx->hub_channel, ctx->out_buf, ctx->out_len);
+  } else {
+    ssize_t written = write(ctx->dev_to_host_fifo, ctx->out_buf, ctx->out_len);
+    assert(written == (ssize_t)ctx->out_len);
+  }
+  ctx->out_len = 0;
+}
+
+/**
+ * Buffers an event for the host, stamped with the current cycle.
+ */
+static void send_event(struct gpiodpi_ctx *ctx, uint8_t type, uint32_t mask,
+                       uint32_t value, uint32_t weak) {
+  if (ctx->out_len == sizeof(ctx->out_buf)) {
+    flush_events(ctx);
+  }
+  uint8_t *buf = &ctx->out_buf[ctx->out_len];
+  memset(buf, 0, GPIODPI_EVENT_BYTES);
+  buf[0] = type;
+  put_le32(&buf[4], mask);
+  put_le32(&buf[8], value);
+  put_le32(&buf[12], weak);
+  put_le32(&buf[16], ctx->counter);
+  put_le32(&buf[20], ctx->counter >> 32);
+  ctx->out_len += GPIODPI_EVENT_BYTES;
+}
+
+/**
+ * Reports a transition of the outputs of the device, if there is one.
+ */
+static void report_output(struct gpiodpi_ctx *ctx) {
+  uint32_t changed = (ctx->output_values ^ ctx->reported_values) |
+                     (ctx->output_enables ^ ctx->reported_enables);
+  if (changed == 0) {
+    return;
+  }
+  send_event(ctx, GPIODPI_EVENT_OUTPUT, ctx->output_enables,
+             ctx->output_values, changed);
+  ctx->reported_values = ctx->output_values;
+  ctx->reported_enables = ctx->output_enables;
+}
+
 void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
                             svBitVecVal *gpio_oe) {
   struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
   assert(ctx);
 
+  uint32_t pin_mask =
+      ctx->n_bits == 32 ? UINT32_MAX : ((uint32_t)1 << ctx->n_bits) - 1;
+  ctx->output_values = gpio_data[0] & pin_mask;
+  ctx->output_enables = gpio_oe[0] & pin_mask;
+  if (ctx->binary) {
+    report_output(ctx);
+    return;
+  }
+
   // Write 0, 1, or X (when oe is not set) for each GPIO pin, in big endian
   // order (i.e., pin 0 is the last character written). Finish it with a
   // newline.
@@ -171,6 +377,10 @@ void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
   }
   *pin_char = '\n';
 
+  if (ctx->hub_channel) {
+    dpi_hub_channel_write(ctx->hub_channel, gpio_str, ctx->n_bits + 1);
+    return;
+  }
   ssize_t written = write(ctx->dev_to_host_fifo, gpio_str, ctx->n_bits + 1);
   assert(written == ctx->n_bits + 1);
 }
@@ -211,18 +421,136 @@ static void set_bit_val(uint32_t *word, uint32_t idx, bool val) {
   }
 }
 
+/**
+ * Schedules an event from the host, after the events for the same or an
+ * earlier cycle.
+ */
+static void schedule_event(struct gpiodpi_ctx *ctx,
+                           const struct gpiodpi_event *event) {
+  if (ctx->sched_head > 0) {
+    ctx->sched_len -= ctx->sched_head;
+    memmove(ctx->sched, &ctx->sched[ctx->sched_head],
+            ctx->sched_len * sizeof(*ctx->sched));
+    ctx->sched_head = 0;
+  }
+  if (ctx->sched_len == ctx->sched_cap) {
+    ctx->sched_cap = ctx->sched_cap ? 2 * ctx->sched_cap : EVENT_BUF_LEN;
+    ctx->sched = (struct gpiodpi_event *)realloc(
+        ctx->sched, ctx->sched_cap * sizeof(*ctx->sched));
+    assert(ctx->sched);
+  }
+
+  // Hosts usually send their events in order, so search from the end.
+  size_t pos = ctx->sched_len;
+  while (pos > 0 && ctx->sched[pos - 1].cycle > event->cycle) {
+    --pos;
+  }
+  memmove(&ctx->sched[pos + 1], &ctx->sched[pos],
+          (ctx->sched_len - pos) * sizeof(*ctx->sched));
+  ctx->sched[pos] = *event;
+  ++ctx->sched_len;
+}
+
+/**
+ * Decodes and schedules the complete events received from the host.
+ */
+static void parse_events(struct gpiodpi_ctx *ctx) {
+  size_t pos = 0;
+  for (; ctx->in_len - pos >= GPIODPI_EVENT_BYTES; pos += GPIODPI_EVENT_BYTES) {
+    const uint8_t *buf = &ctx->in_buf[pos];
+    struct gpiodpi_event event;
+    event.type = buf[0];
+    event.mask = get_le32(&buf[4]);
+    event.value = get_le32(&buf[8]);
+    event.weak = get_le32(&buf[12]);
+    event.cycle = get_le32(&buf[16]) | (uint64_t)get_le32(&buf[20]) << 32;
+    if (event.type != GPIODPI_EVENT_SET && event.type != GPIODPI_EVENT_SYNC) {
+      fprintf(stderr, "GPIO: Ignoring event of unknown type 0x%02x\n",
+              event.type);
+      continue;
+    }
+    if (event.cycle != 0 && event.cycle < ctx->counter) {
+      ++ctx->late_events;
+    }
+    schedule_event(ctx, &event);
+  }
+  ctx->in_len -= pos;
+  memmove(ctx->in_buf, &ctx->in_buf[pos], ctx->in_len);
+}
+
+/**
+ * Switches to the binary event protocol, starting with the bytes in |buf|.
+ */
+static void start_binary(struct gpiodpi_ctx *ctx, const char *buf,
+                         size_t len) {
+  printf("GPIO: Host switched to the binary event protocol\n");
+  ctx->binary = true;
+  // Report the outputs from now on, the host learns the current state from
+  // the reply to a sync event.
+  ctx->reported_values = ctx->output_values;
+  ctx->reported_enables = ctx->output_enables;
+  memcpy(ctx->in_buf, buf, len);
+  ctx->in_len = len;
+  parse_events(ctx);
+}
+
+/**
+ * Applies the events scheduled up to the current cycle.
+ */
+static void apply_events(struct gpiodpi_ctx *ctx) {
+  while (ctx->sched_head < ctx->sched_len &&
+         ctx->sched[ctx->sched_head].cycle <= ctx->counter) {
+    const struct gpiodpi_event *event = &ctx->sched[ctx->sched_head++];
+    if (event->type == GPIODPI_EVENT_SET) {
+      ctx->driven_pin_values &= ~event->mask;
+      ctx->driven_pin_values |= event->value & event->mask;
+      ctx->weak_pins &= ~event->mask;
+      ctx->weak_pins |= event->weak & event->mask;
+    } else {
+      // Outputs reported before the reply belong to earlier cycles.
+      report_output(ctx);
+      send_event(ctx, GPIODPI_EVENT_SYNC, ctx->output_enables,
+                 ctx->output_values, 0);
+      flush_events(ctx);
+    }
+  }
+  if (ctx->sched_head == ctx->sched_len) {
+    ctx->sched_head = 0;
+    ctx->sched_len = 0;
+  }
+}
+
 uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
                                      svBitVecVal *gpio_pull_en,
                                      svBitVecVal *gpio_pull_sel) {
   struct gpiodpi_ctx *ctx = (struct gpiodpi_ctx *)ctx_void;
   assert(ctx);
 
-  if (ctx->counter % TICKS_PER_SYSCALL == 0) {
-    char gpio_str[256];
-    ssize_t read_len =
-        read(ctx->host_to_dev_fifo, gpio_str, sizeof(gpio_str) - 1);
+  bool poll = ctx->hub_channel || ctx->counter % TICKS_PER_SYSCALL == 0;
+  if (ctx->binary && poll) {
+    ssize_t read_len = host_read(ctx, &ctx->in_buf[ctx->in_len],
+                                 sizeof(ctx->in_buf) - ctx->in_len);
     if (read_len > 0) {
-      gpio_str[read_len] = '\0';
+      ctx->in_len += read_len;
+      parse_events(ctx);
+    }
+    flush_events(ctx);
+  } else if (poll) {
+    char gpio_str[256];
+    ssize_t read_len = host_read(ctx, gpio_str, sizeof(gpio_str) - 1);
+    // Text commands never contain the bytes of the event types, so the first
+    // such byte starts the binary events. These are only scheduled here and
+    // take effect in apply_events(), after the text commands before them.
+    ssize_t text_len = 0;
+    while (text_len < read_len &&
+           (uint8_t)gpio_str[text_len] < GPIODPI_EVENT_SYNC) {
+      ++text_len;
+    }
+    if (text_len < read_len) {
+      start_binary(ctx, &gpio_str[text_len], read_len - text_len);
+    }
+    if (text_len > 0) {
+      gpio_str[text_len] = '\0';
 
       bool weak = false;
       char *gpio_text = gpio_str;
@@ -283,6 +611,9 @@ uint32_t gpiodpi_host_to_device_tick(void *ctx_void, svBitVecVal *gpio_oe,
   }
 
 parse_loop_end:
+  if (ctx->binary) {
+    apply_events(ctx);
+  }
   ctx->counter += 1;
   // The verilated module simulates logic, but the weak/strong inputs result
   // from the properties of the IO pads and the selection of external pull
@@ -305,23 +636,24 @@ void gpiodpi_close(void *ctx_void) {
     return;
   }
 
-  if (close(ctx->dev_to_host_fifo) != 0) {
-    printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->dev_to_host_path,
-           strerror(errno));
+  if (ctx->binary) {
+    flush_events(ctx);
   }
-  if (close(ctx->host_to_dev_fifo) != 0) {
-    printf("GPIO: Failed to close FIFO file at %s: %s\n", ctx->host_to_dev_path,
-           strerror(errno));
+  if (ctx->late_events) {
+    fprintf(stderr,
+            "GPIO: %llu events arrived after the cycle they were scheduled "
+            "for\n",
+            (unsigned long long)ctx->late_events);
   }
+  free(ctx->sched);
+  dpi_fork_remove_hooks(ctx);
 
-  if (unlink(ctx->dev_to_host_path) != 0) {
-    printf("GPIO: Failed to unlink FIFO file at %s: %s\n",
-           ctx->dev_to_host_path, strerror(errno));
-  }
-  if (unlink(ctx->host_to_dev_path) != 0) {
-    printf("GPIO: Failed to unlink FIFO file at %s: %s\n",
-           ctx->host_to_dev_path, strerror(errno));
+  if (ctx->hub_channel) {
+    dpi_hub_channel_close(ctx->hub_channel);
+  } else {
+    fifos_close(ctx);
   }
 
+  free(ctx->name);
   free(ctx);
 }
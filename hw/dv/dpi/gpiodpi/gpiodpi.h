@@ -11,6 +11,48 @@
 extern "C" {
 #endif
 
+/**
+ * Binary event protocol
+ *
+ * Instead of text commands, the host can send binary events, and switches to
+ * them for the rest of the simulation with the first one. From then on, the
+ * device reports its outputs as binary events as well. Events are 24 bytes,
+ * with all fields little-endian:
+ *
+ *   offset 0:  uint8_t type, followed by 3 reserved bytes
+ *   offset 4:  uint32_t mask
+ *   offset 8:  uint32_t value
+ *   offset 12: uint32_t weak
+ *   offset 16: uint64_t cycle
+ *
+ * Cycles count the ticks of the model, i.e. its clock cycles outside of
+ * reset.
+ *
+ * GPIODPI_EVENT_SET (host to device): at `cycle`, drive the pins in `mask` to
+ * `value`, weakly for the pins in `weak`. The pins take the value at the clock
+ * edge ending the cycle.
+ *
+ * GPIODPI_EVENT_SYNC (host to device): at `cycle`, send a SYNC event back.
+ * (device to host): `cycle` is the current cycle, `value` the outputs of the
+ * device and `mask` their output enables. All OUTPUT events of earlier
+ * cycles precede it.
+ *
+ * GPIODPI_EVENT_OUTPUT (device to host): at `cycle`, the outputs of the device
+ * changed to `value`, with the output enables `mask`. `weak` holds the pins
+ * which changed.
+ *
+ * Events for cycles that have passed, e.g. with `cycle` 0, apply at the next
+ * cycle. Any number of events can be sent ahead of time; they are applied in
+ * the order of their cycles, and in the order they were sent within a cycle.
+ * The output events are sent in batches, at the latest with the reply to a
+ * SYNC event. The first event starts with the first byte >= 0x80, and text
+ * written before it, even in the same write, precedes it.
+ */
+#define GPIODPI_EVENT_SYNC 0x80
+#define GPIODPI_EVENT_SET 0x81
+#define GPIODPI_EVENT_OUTPUT 0x82
+#define GPIODPI_EVENT_BYTES 24
+
 /**
  * Allocate a new GPIO DPI interface, returned as an opaque pointer.
  *
@@ -23,7 +65,8 @@ void *gpiodpi_create(const char *name, int n_bits);
 /**
  * Attempt to post the current GPIO state to the outside world.
  *
- * Intended to be called from SystemVerilog.
+ * Intended to be called from SystemVerilog, whenever the outputs or their
+ * enables change.
  */
 void gpiodpi_device_to_host(void *ctx_void, svBitVecVal *gpio_data,
                             svBitVecVal *gpio_oe);
@@ -56,10 +56,14 @@ module gpiodpi
    logic eff_clk;
    assign eff_clk = clk_i && active;
 
+   // Report changes of the outputs and of their enables, since a pin that is
+   // no longer driven changes its state for the host as well.
    logic [N_GPIO-1:0] gpio_d2p_r;
+   logic [N_GPIO-1:0] gpio_en_d2p_r;
    always_ff @(posedge eff_clk) begin
      gpio_d2p_r <= gpio_d2p;
-     if (gpio_d2p_r != gpio_d2p) begin
+     gpio_en_d2p_r <= gpio_en_d2p;
+     if (gpio_d2p_r != gpio_d2p || gpio_en_d2p_r != gpio_en_d2p) begin
        gpiodpi_device_to_host(ctx, gpio_d2p, gpio_en_d2p);
      end
    end
@@ -0,0 +1,56 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Stand-in for a simulation in the tests of gpiodpi, see
+// util/gpiodpi_test.py. It ticks a 32-bit gpio0 model with all pins enabled
+// and prints the pin values whenever they change, as "PINS <cycle> <value>"
+// in hex.
+//
+// The device loops the pins back to its outputs: the pins 15..0 driven by the
+// host are output on the pins 15..0 in the next cycle, with the pins 31..16 as
+// their output enables. Like gpiodpi.sv, it reports the outputs to the model
+// whenever they or their enables change.
+//
+// The model is reached through the DPI hub given in DPI_HUB_SOCKET.
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "gpiodpi.h"
+
+#define MAX_TICKS (600 * 1000)
+#define TICK_US 100
+
+int main(void) {
+  void *ctx = gpiodpi_create("gpio0", 32);
+  if (!ctx) {
+    return 1;
+  }
+
+  svBitVecVal oe = 0xffffffff;
+  svBitVecVal pull_en = 0;
+  svBitVecVal pull_sel = 0;
+  svBitVecVal out_data = 0;
+  svBitVecVal out_oe = 0;
+  uint32_t last = 0;
+  for (unsigned long tick = 0; tick < MAX_TICKS; ++tick) {
+    if ((last & 0xffff) != out_data || last >> 16 != out_oe) {
+      out_data = last & 0xffff;
+      out_oe = last >> 16;
+      gpiodpi_device_to_host(ctx, &out_data, &out_oe);
+    }
+
+    uint32_t value =
+        gpiodpi_host_to_device_tick(ctx, &oe, &pull_en, &pull_sel);
+    if (value != last) {
+      printf("PINS %lx %x\n", tick, value);
+      fflush(stdout);
+      last = value;
+    }
+    usleep(TICK_US);
+  }
+
+  gpiodpi_close(ctx);
+  return 0;
+}
@@ -13,6 +13,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -21,6 +23,9 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "dpi_fork.h"
+#include "dpi_hub.h"
+#include "dpi_stats.h"
 #include "spidpi.h"
 #ifdef VERILATOR
 #include "verilator_sim_ctrl.h"
@@ -29,10 +34,14 @@
 // This holds the necessary SPI state.
 #define MAX_TRANSACTION 4
 struct spidpi_ctx {
+  char *name;
   int loglevel;
   char ptyname[64];
   int host;
   int device;
+  // Channel on the DPI hub which replaces the pty, or NULL
+  struct dpi_hub_channel *hub_channel;
+  // Monitor output, NULL while it is closed
   FILE *mon_file;
   char mon_pathname[PATH_MAX];
   void *mon;
@@ -49,6 +58,7 @@ struct spidpi_ctx {
   char driving;
   int state;
   char buf[MAX_TRANSACTION];
+  uint64_t *stats_calls;
 };
 
 // SPI Host States
@@ -63,39 +73,14 @@ struct spidpi_ctx {
 // and resume at the first SPI packet
 // #define CONTROL_TRACE
 
-void *spidpi_create(const char *name, int mode, int loglevel) {
-  int i;
-  struct spidpi_ctx *ctx =
-      (struct spidpi_ctx *)calloc(1, sizeof(struct spidpi_ctx));
-  assert(ctx);
-
-  ctx->loglevel = loglevel;
-  ctx->mon = monitor_spi_init(mode);
-  ctx->tick = 0;
-  ctx->msbfirst = 1;
-  ctx->nmax = MAX_TRANSACTION;
-  ctx->nin = 0;
-  ctx->nout = 0;
-  ctx->bout = 0;
-  ctx->state = SP_IDLE;
-  /* mode is CPOL << 1 | CPHA
-   * cpol = 0 --> external clock matches internal
-   * cpha = 0 --> drive on internal falling edge, capture on rising
-   */
-  ctx->cpol = ((mode == 0) || (mode == 2)) ? 0 : 1;
-  ctx->cpha = ((mode == 1) || (mode == 3)) ? 1 : 0;
-  /* CPOL = 1 for clock idle high */
-  ctx->driving = P2D_CSB | ((ctx->cpol) ? P2D_SCK : 0);
-  char cwd[PATH_MAX];
-  char *cwd_rv;
-  cwd_rv = getcwd(cwd, sizeof(cwd));
-  assert(cwd_rv != NULL);
-
-  int rv;
+/**
+ * Open the pseudo-terminal the host drives the SPI bus through
+ */
+static void pty_open(struct spidpi_ctx *ctx) {
   struct termios tty;
   cfmakeraw(&tty);
 
-  rv = openpty(&ctx->host, &ctx->device, 0, &tty, 0);
+  int rv = openpty(&ctx->host, &ctx->device, 0, &tty, 0);
   assert(rv != -1);
 
   rv = ttyname_r(ctx->device, ctx->ptyname, 64);
@@ -108,18 +93,43 @@ void *spidpi_create(const char *name, int mode, int loglevel) {
 
   printf(
       "\n"
-      "SPI: Created %s for %s. Connect to it with any terminal program, e.g.\n"
+      "SPI: Created %s for %s. Connect to it with any terminal program, "
+      "e.g.\n"
       "$ screen %s\n"
       "NOTE: a SPI transaction is run for every 4 characters entered.\n",
-      ctx->ptyname, name, ctx->ptyname);
+      ctx->ptyname, ctx->name, ctx->ptyname);
+}
+
+/**
+ * Close the pseudo-terminal, if it is open
+ */
+static void pty_close(struct spidpi_ctx *ctx) {
+  if (ctx->host != -1) {
+    close(ctx->host);
+    close(ctx->device);
+    ctx->host = -1;
+    ctx->device = -1;
+  }
+}
 
-  rv = snprintf(ctx->mon_pathname, PATH_MAX, "%s/%s.log", cwd, name);
+/**
+ * Create the monitor output file in the current directory
+ *
+ * @return false if it could not be created
+ */
+static bool mon_open(struct spidpi_ctx *ctx) {
+  char cwd[PATH_MAX];
+  char *cwd_rv;
+  cwd_rv = getcwd(cwd, sizeof(cwd));
+  assert(cwd_rv != NULL);
+
+  int rv = snprintf(ctx->mon_pathname, PATH_MAX, "%s/%s.log", cwd, ctx->name);
   assert(rv <= PATH_MAX && rv > 0);
   ctx->mon_file = fopen(ctx->mon_pathname, "w");
   if (ctx->mon_file == NULL) {
     fprintf(stderr, "SPI: Unable to open file at %s: %s\n", ctx->mon_pathname,
             strerror(errno));
-    return NULL;
+    return false;
   }
   // more useful for tail -f
   setlinebuf(ctx->mon_file);
@@ -127,13 +137,92 @@ void *spidpi_create(const char *name, int mode, int loglevel) {
       "SPI: Monitor output file created at %s. Works well with tail:\n"
       "$ tail -f %s\n",
       ctx->mon_pathname, ctx->mon_pathname);
+  return true;
+}
+
+/**
+ * Close the monitor output file, if it is open
+ */
+static void mon_close(struct spidpi_ctx *ctx) {
+  if (ctx->mon_file) {
+    fclose(ctx->mon_file);
+    ctx->mon_file = NULL;
+  }
+}
 
+/**
+ * Fork hook: close the pty and the monitor output before the simulation is
+ * forked
+ */
+static void fork_prepare(void *ctx_void) {
+  struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
+  pty_close(ctx);
+  mon_close(ctx);
+}
+
+/**
+ * Fork hook: open a pty, and the monitor output in the directory of the test,
+ * in a forked copy of the simulation
+ */
+static void fork_child(void *ctx_void) {
+  struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
+  if (!ctx->hub_channel) {
+    pty_open(ctx);
+  }
+  mon_open(ctx);
+}
+
+void *spidpi_create(const char *name, int mode, int loglevel) {
+  struct spidpi_ctx *ctx =
+      (struct spidpi_ctx *)calloc(1, sizeof(struct spidpi_ctx));
+  assert(ctx);
+  ctx->name = strdup(name);
+  assert(ctx->name);
+
+  ctx->loglevel = loglevel;
+  ctx->mon = monitor_spi_init(mode);
+  ctx->tick = 0;
+  ctx->msbfirst = 1;
+  ctx->nmax = MAX_TRANSACTION;
+  ctx->nin = 0;
+  ctx->nout = 0;
+  ctx->bout = 0;
+  ctx->state = SP_IDLE;
+  /* mode is CPOL << 1 | CPHA
+   * cpol = 0 --> external clock matches internal
+   * cpha = 0 --> drive on internal falling edge, capture on rising
+   */
+  ctx->cpol = ((mode == 0) || (mode == 2)) ? 0 : 1;
+  ctx->cpha = ((mode == 1) || (mode == 3)) ? 1 : 0;
+  /* CPOL = 1 for clock idle high */
+  ctx->driving = P2D_CSB | ((ctx->cpol) ? P2D_SCK : 0);
+
+  ctx->host = -1;
+  ctx->device = -1;
+  ctx->hub_channel = dpi_hub_channel_open(name);
+  if (ctx->hub_channel) {
+    printf(
+        "\n"
+        "SPI: Serving %s on the DPI hub.\n"
+        "NOTE: a SPI transaction is run for every 4 characters sent.\n",
+        name);
+  } else {
+    pty_open(ctx);
+  }
+
+  if (!mon_open(ctx)) {
+    return NULL;
+  }
+
+  ctx->stats_calls = dpi_stats_get_counter("spidpi");
+  dpi_fork_add_hooks(ctx, fork_prepare, fork_child);
   return (void *)ctx;
 }
 
 char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
   struct spidpi_ctx *ctx = (struct spidpi_ctx *)ctx_void;
   assert(ctx);
+  dpi_stats_count(ctx->stats_calls);
   int d2p = d2p_data->aval;
 
   // Will tick at the host clock
@@ -147,11 +236,19 @@ char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
 #endif
 #endif
 
-  monitor_spi(ctx->mon, ctx->mon_file, ctx->loglevel, ctx->tick, ctx->driving,
-              d2p);
+  if (ctx->mon_file) {
+    monitor_spi(ctx->mon, ctx->mon_file, ctx->loglevel, ctx->tick,
+                ctx->driving, d2p);
+  }
 
   if (ctx->state == SP_IDLE) {
-    int n = read(ctx->host, &(ctx->buf[ctx->nin]), ctx->nmax - ctx->nin);
+    int n;
+    if (ctx->hub_channel) {
+      n = dpi_hub_channel_read(ctx->hub_channel, &(ctx->buf[ctx->nin]),
+                               ctx->nmax - ctx->nin);
+    } else {
+      n = read(ctx->host, &(ctx->buf[ctx->nin]), ctx->nmax - ctx->nin);
+    }
     if (n == -1) {
       if (errno != EAGAIN) {
         fprintf(stderr, "Read on SPI FIFO gave %s\n", strerror(errno));
@@ -218,8 +315,12 @@ char spidpi_tick(void *ctx_void, const svLogicVecVal *d2p_data) {
         ctx->din = ctx->din | ((d2p & D2P_SDO) ? ctx->bin : 0);
         ctx->bin = (ctx->msbfirst) ? ctx->bin >> 1 : ctx->bin << 1;
         if (ctx->bin == 0) {
-          int rv = write(ctx->host, &(ctx->din), 1);
-          assert(rv == 1 && "write() failed.");
+          if (ctx->hub_channel) {
+            dpi_hub_channel_write(ctx->hub_channel, &(ctx->din), 1);
+          } else {
+            int rv = write(ctx->host, &(ctx->din), 1);
+            assert(rv == 1 && "write() failed.");
+          }
           ctx->bin = (ctx->msbfirst) ? 0x80 : 0x01;
           ctx->din = 0;
         }
@@ -254,6 +355,10 @@ void spidpi_close(void *ctx_void) {
   if (!ctx) {
     return;
   }
-  fclose(ctx->mon_file);
+  dpi_fork_remove_hooks(ctx);
+  dpi_hub_channel_close(ctx->hub_channel);
+  pty_close(ctx);
+  mon_close(ctx);
+  free(ctx->name);
   free(ctx);
 }
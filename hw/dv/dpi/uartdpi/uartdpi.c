@@ -9,6 +9,10 @@
 
 #include "uartdpi.h"
 
+#include "dpi_fork.h"
+#include "dpi_hub.h"
+#include "dpi_stats.h"
+
 #ifdef __linux__
 #include <pty.h>
 #elif __APPLE__
@@ -21,6 +25,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -28,29 +33,30 @@
 
 // This keeps the necessary uart state.
 struct uartdpi_ctx {
+  char *name;
   char ptyname[64];
   char exitstring[EXIT_STRING_MAX_LENGTH];
   int exittracker;
   int host;
   int device;
+  // Channel on the DPI hub which replaces the pty, or NULL
+  struct dpi_hub_channel *hub_channel;
   char tmp_read;
+  char *log_file_path;
   FILE *log_file;
+  uint64_t *stats_calls;
 };
 
-void *uartdpi_create(const char *name, const char *log_file_path,
-                     const char *exit_string) {
-  struct uartdpi_ctx *ctx =
-      (struct uartdpi_ctx *)malloc(sizeof(struct uartdpi_ctx));
-  assert(ctx);
-
-  int rv;
-
+/**
+ * Open the pseudo-terminal of the UART
+ */
+static void pty_open(struct uartdpi_ctx *ctx) {
   // Initialize UART pseudo-terminal
-  rv = openpty(&ctx->host, &ctx->device, 0, 0, 0);
+  int rv = openpty(&ctx->host, &ctx->device, 0, 0, 0);
   assert(rv == 0 && "failed to open pty for uart");
 
-  // Customise the slave side of the uart pseudo-terminal to be in "raw mode",
-  // using the BSD cfmakeraw function.
+  // Customise the slave side of the uart pseudo-terminal to be in "raw
+  // mode", using the BSD cfmakeraw function.
   struct termios tty;
   rv = tcgetattr(ctx->device, &tty);
   assert(rv == 0 && "failed to get device terminal attrs");
@@ -68,37 +74,113 @@ void *uartdpi_create(const char *name, const char *log_file_path,
 
   printf(
       "\n"
-      "UART: Created %s for %s. Connect to it with any terminal program, e.g.\n"
+      "UART: Created %s for %s. Connect to it with any terminal program, "
+      "e.g.\n"
       "$ screen %s\n",
-      ctx->ptyname, name, ctx->ptyname);
+      ctx->ptyname, ctx->name, ctx->ptyname);
+}
+
+/**
+ * Close the pseudo-terminal of the UART, if it is open
+ */
+static void pty_close(struct uartdpi_ctx *ctx) {
+  if (ctx->host != -1) {
+    close(ctx->host);
+    close(ctx->device);
+    ctx->host = -1;
+    ctx->device = -1;
+  }
+}
 
-  // Open log file (if requested)
+/**
+ * Open the log file (if requested)
+ */
+static void log_open(struct uartdpi_ctx *ctx) {
   ctx->log_file = NULL;
-  bool write_log_file = strlen(log_file_path) != 0;
-  if (write_log_file) {
-    if (strcmp(log_file_path, "-") == 0) {
-      ctx->log_file = stdout;
-      printf("UART: Additionally writing all UART output to STDOUT.\n");
+  if (strlen(ctx->log_file_path) == 0) {
+    return;
+  }
+  if (strcmp(ctx->log_file_path, "-") == 0) {
+    ctx->log_file = stdout;
+    printf("UART: Additionally writing all UART output to STDOUT.\n");
+    return;
+  }
 
-    } else {
-      FILE *log_file;
-      log_file = fopen(log_file_path, "w");
-      if (!log_file) {
-        fprintf(stderr, "UART: Unable to open log file at %s: %s\n",
-                log_file_path, strerror(errno));
-      } else {
-        // Switch log file output to line buffering to ensure lines written to
-        // the UART device show up in the log file as soon as a newline
-        // character is written.
-        rv = setvbuf(log_file, NULL, _IOLBF, 0);
-        assert(rv == 0);
-
-        ctx->log_file = log_file;
-        printf("UART: Additionally writing all UART output to '%s'.\n",
-               log_file_path);
-      }
+  FILE *log_file;
+  log_file = fopen(ctx->log_file_path, "w");
+  if (!log_file) {
+    fprintf(stderr, "UART: Unable to open log file at %s: %s\n",
+            ctx->log_file_path, strerror(errno));
+    return;
+  }
+  // Switch log file output to line buffering to ensure lines written to
+  // the UART device show up in the log file as soon as a newline
+  // character is written.
+  int rv = setvbuf(log_file, NULL, _IOLBF, 0);
+  assert(rv == 0);
+
+  ctx->log_file = log_file;
+  printf("UART: Additionally writing all UART output to '%s'.\n",
+         ctx->log_file_path);
+}
+
+/**
+ * Close the log file, if it is open
+ */
+static void log_close(struct uartdpi_ctx *ctx) {
+  if (ctx->log_file) {
+    // Always ensure the log file is flushed (most important when writing
+    // to STDOUT)
+    fflush(ctx->log_file);
+    if (ctx->log_file != stdout) {
+      fclose(ctx->log_file);
     }
+    ctx->log_file = NULL;
   }
+}
+
+/**
+ * Fork hook: close the pty and the log file before the simulation is forked
+ */
+static void fork_prepare(void *ctx_void) {
+  struct uartdpi_ctx *ctx = (struct uartdpi_ctx *)ctx_void;
+  if (!ctx->hub_channel) {
+    pty_close(ctx);
+  }
+  log_close(ctx);
+}
+
+/**
+ * Fork hook: open a pty and, relative to the directory of the test, the log
+ * file in a forked copy of the simulation
+ */
+static void fork_child(void *ctx_void) {
+  struct uartdpi_ctx *ctx = (struct uartdpi_ctx *)ctx_void;
+  if (!ctx->hub_channel) {
+    pty_open(ctx);
+  }
+  log_open(ctx);
+}
+
+void *uartdpi_create(const char *name, const char *log_file_path,
+                     const char *exit_string) {
+  struct uartdpi_ctx *ctx =
+      (struct uartdpi_ctx *)malloc(sizeof(struct uartdpi_ctx));
+  assert(ctx);
+  ctx->name = strdup(name);
+  ctx->log_file_path = strdup(log_file_path);
+  assert(ctx->name && ctx->log_file_path);
+
+  ctx->hub_channel = dpi_hub_channel_open(name);
+  if (ctx->hub_channel) {
+    ctx->host = -1;
+    ctx->device = -1;
+    printf("\nUART: Serving %s on the DPI hub.\n", name);
+  } else {
+    pty_open(ctx);
+  }
+
+  log_open(ctx);
 
   ctx->exittracker = 0;
   if (strnlen(exit_string, EXIT_STRING_MAX_LENGTH) < EXIT_STRING_MAX_LENGTH) {
@@ -114,6 +196,9 @@ void *uartdpi_create(const char *name, const char *log_file_path,
   // Guarantee that at least one character in the exit string is null.
   ctx->exitstring[EXIT_STRING_MAX_LENGTH - 1] = '\0';
 
+  ctx->stats_calls = dpi_stats_get_counter("uartdpi");
+
+  dpi_fork_add_hooks(ctx, fork_prepare, fork_child);
   return (void *)ctx;
 }
 
@@ -122,19 +207,18 @@ void uartdpi_close(void *ctx_void) {
   if (!ctx) {
     return;
   }
+  dpi_fork_remove_hooks(ctx);
 
-  close(ctx->host);
-  close(ctx->device);
-
-  if (ctx->log_file) {
-    // Always ensure the log file is flushed (most important when writing
-    // to STDOUT)
-    fflush(ctx->log_file);
-    if (ctx->log_file != stdout) {
-      fclose(ctx->log_file);
-    }
+  if (ctx->hub_channel) {
+    dpi_hub_channel_close(ctx->hub_channel);
+  } else {
+    pty_close(ctx);
   }
 
+  log_close(ctx);
+
+  free(ctx->log_file_path);
+  free(ctx->name);
   free(ctx);
 }
 
@@ -143,6 +227,10 @@ int uartdpi_can_read(void *ctx_void) {
   if (ctx == NULL) {
     return 0;
   }
+  dpi_stats_count(ctx->stats_calls);
+  if (ctx->hub_channel) {
+    return dpi_hub_channel_read(ctx->hub_channel, &ctx->tmp_read, 1) == 1;
+  }
   int rv = read(ctx->host, &ctx->tmp_read, 1);
   return (rv == 1);
 }
@@ -159,9 +247,14 @@ int uartdpi_write(void *ctx_void, char c) {
   if (ctx == NULL) {
     return 0;
   }
+  dpi_stats_count(ctx->stats_calls);
 
-  rv = write(ctx->host, &c, 1);
-  assert(rv == 1 && "Write to pseudo-terminal failed.");
+  if (ctx->hub_channel) {
+    dpi_hub_channel_write(ctx->hub_channel, &c, 1);
+  } else {
+    rv = write(ctx->host, &c, 1);
+    assert(rv == 1 && "Write to pseudo-terminal failed.");
+  }
 
   if (ctx->log_file) {
     rv = fwrite(&c, sizeof(char), 1, ctx->log_file);
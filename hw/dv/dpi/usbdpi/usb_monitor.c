@@ -112,6 +112,27 @@ usb_monitor_ctx_t *usb_monitor_init(const char *filename,
   return mon;
 }
 
+/**
+ * Continue the log of a USB monitor in another file
+ */
+bool usb_monitor_reopen(usb_monitor_ctx_t *mon, const char *filename) {
+  FILE *file = fopen(filename, "w");
+  if (!file) {
+    fprintf(stderr, "USBDPI: Unable to open monitor file at %s: %s\n", filename,
+            strerror(errno));
+    return false;
+  }
+  fclose(mon->file);
+  mon->file = file;
+
+  setvbuf(mon->file, NULL, _IOLBF, 0);
+  printf(
+      "\nUSBDPI: Monitor output file created at %s. Works well with tail:\n"
+      "$ tail -f %s\n",
+      filename, filename);
+  return true;
+}
+
 /**
  * Finalize a USB monitor
  */
@@ -38,6 +38,19 @@ usb_monitor_ctx_t *usb_monitor_init(const char *filename,
                                     usb_monitor_data_callback_t data_cb,
                                     void *data_ctx);
 
+/**
+ * Continue the log of a USB monitor in another file
+ *
+ * Used by a forked copy of the simulation, which must not share the log of
+ * its parent.
+ *
+ * @param  mon       USB monitor context
+ * @param  filename  Filename to be used for log file
+ * @return           false if the file could not be opened, in which case the
+ *                   old log file is kept
+ */
+bool usb_monitor_reopen(usb_monitor_ctx_t *mon, const char *filename);
+
 /**
  * Finalize a USB monitor
  *
@@ -16,6 +16,8 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include "dpi_fork.h"
+#include "dpi_stats.h"
 #include "usb_utils.h"
 #include "usbdpi_test.h"
 
@@ -102,6 +104,35 @@ static void bus_reset(usbdpi_ctx_t *ctx) {
 static void usbdpi_data_callback(void *ctx_v, usbmon_data_type_t type,
                                  uint8_t d);
 
+/**
+ * Fork hook: continue the monitor log in the directory of the test in a forked
+ * copy of the simulation
+ *
+ * The model has no host endpoints, and the parent keeps its log, so there is
+ * nothing to close before the fork.
+ */
+static void fork_child(void *ctx_v) {
+  usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_v;
+  if (!ctx->mon) {
+    return;
+  }
+
+  char cwd[FILENAME_MAX];
+  char *cwd_rv;
+  cwd_rv = getcwd(cwd, sizeof(cwd));
+  assert(cwd_rv != NULL);
+
+  // Keep the file name of the log of the parent.
+  const char *filename = strrchr(ctx->mon_pathname, '/') + 1;
+  char pathname[FILENAME_MAX];
+  int rv = snprintf(pathname, FILENAME_MAX, "%s/%s", cwd, filename);
+  assert(rv <= FILENAME_MAX && rv > 0);
+
+  if (usb_monitor_reopen(ctx->mon, pathname)) {
+    strcpy(ctx->mon_pathname, pathname);
+  }
+}
+
 /**
  * Create a USB DPI instance, returning a 'chandle' for later use
  */
@@ -137,12 +168,15 @@ void *usbdpi_create(const char *name, int loglevel) {
   // Prepare the transfer descriptors for use
   usb_transfer_setup(ctx);
 
+  ctx->stats_calls = dpi_stats_get_counter("usbdpi");
+  dpi_fork_add_hooks(ctx, NULL, fork_child);
   return (void *)ctx;
 }
 
 void usbdpi_device_to_host(void *ctx_void, const svBitVecVal *usb_d2p) {
   usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
   assert(ctx);
+  dpi_stats_count(ctx->stats_calls);
 
   // Ascertain the state of the D+/D- signals from the device
   // TODO - migrate to a simple function
@@ -1115,6 +1149,7 @@ uint32_t inv_driving(usbdpi_ctx_t *ctx, uint32_t d2p) {
 uint8_t usbdpi_host_to_device(void *ctx_void, const svBitVecVal *usb_d2p) {
   usbdpi_ctx_t *ctx = (usbdpi_ctx_t *)ctx_void;
   assert(ctx);
+  dpi_stats_count(ctx->stats_calls);
   int d2p = usb_d2p[0];
   uint32_t last_driving = ctx->driving;
   int force_stat = 0;
@@ -1473,6 +1508,7 @@ void usbdpi_close(void *ctx_void) {
   if (!ctx) {
     return;
   }
+  dpi_fork_remove_hooks(ctx);
   usb_monitor_fin(ctx->mon);
   free(ctx);
 }
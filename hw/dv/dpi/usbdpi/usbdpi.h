@@ -393,6 +393,11 @@ struct usbdpi_ctx {
    * Small pool of transfer descriptors
    */
   usbdpi_transfer_t transfer_pool[USBDPI_MAX_TRANSFERS];
+
+  /**
+   * DPI call counter of the simulation statistics, or NULL
+   */
+  uint64_t *stats_calls;
 };
 
 /**
@@ -11,6 +11,12 @@
 
 #include "sv_scoped.h"
 
+// Other simulators only get the DPI path.
+#ifdef VERILATOR
+#include <verilated.h>
+#include <verilated_syms.h>
+#endif
+
 // DPI exports, defined in prim_util_memload.svh
 extern "C" {
 void simutil_memload(const char *file);
@@ -20,7 +26,10 @@ int simutil_get_mem(int index, svBitVecVal *val);
 
 MemArea::MemArea(const std::string &scope, uint32_t num_words,
                  uint32_t width_byte)
-    : scope_(scope), num_words_(num_words), width_byte_(width_byte) {
+    : scope_(scope),
+      num_words_(num_words),
+      width_byte_(width_byte),
+      direct_mem_{} {
   assert(0 < num_words);
   assert(width_byte <= SV_MEM_WIDTH_BYTES);
 }
@@ -101,7 +110,42 @@ void MemArea::ReadBuffer(std::vector<uint8_t> &data,
               std::back_inserter(data));
 }
 
+const MemArea::DirectMem &MemArea::ResolveDirectMem() const {
+  if (direct_mem_.resolved) {
+    return direct_mem_;
+  }
+  direct_mem_.resolved = true;
+#ifdef VERILATOR
+  // The array is only registered with its scope if it is public, which is
+  // what memutil_public.vlt asks for. Verilator stores each word in the
+  // smallest of CData, SData, IData, QData or an array of 32-bit words that
+  // fits, with the least significant bits first.
+  SVScoped scoped(scope_);
+  auto *scope = static_cast<const VerilatedScope *>(svGetScope());
+  VerilatedVar *var = scope ? scope->varFind("mem") : nullptr;
+  if (!var || !var->isPublicRW() || var->udims() != 1) {
+    return direct_mem_;
+  }
+  size_t stride = var->entSize();
+  if (stride == 0 || stride > SV_MEM_WIDTH_BYTES) {
+    return direct_mem_;
+  }
+  direct_mem_.data = static_cast<uint8_t *>(var->datap());
+  direct_mem_.stride = stride;
+  direct_mem_.num_bits = var->packed().elements();
+  direct_mem_.depth = var->totalSize() / stride;
+#endif
+  return direct_mem_;
+}
+
 void MemArea::ReadToMinibuf(uint8_t *minibuf, uint32_t phys_addr) const {
+  const DirectMem &direct = ResolveDirectMem();
+  if (direct.data && phys_addr < direct.depth) {
+    memcpy(minibuf, direct.data + phys_addr * direct.stride, direct.stride);
+    memset(minibuf + direct.stride, 0, SV_MEM_WIDTH_BYTES - direct.stride);
+    return;
+  }
+
   SVScoped scoped(scope_);
   if (!simutil_get_mem(phys_addr, (svBitVecVal *)minibuf)) {
     std::ostringstream oss;
@@ -113,6 +157,24 @@ void MemArea::ReadToMinibuf(uint8_t *minibuf, uint32_t phys_addr) const {
 
 void MemArea::WriteFromMinibuf(uint32_t phys_addr, const uint8_t *minibuf,
                                uint32_t dst_word) const {
+  const DirectMem &direct = ResolveDirectMem();
+  if (direct.data && phys_addr < direct.depth) {
+    // Like `simutil_set_mem`, only keep the bits that fit in a word: the
+    // model expects the unused upper bits to be zero.
+    uint8_t *word = direct.data + phys_addr * direct.stride;
+    for (uint32_t i = 0; i < direct.stride; ++i) {
+      uint32_t bit = 8 * i;
+      if (bit >= direct.num_bits) {
+        word[i] = 0;
+      } else if (direct.num_bits - bit < 8) {
+        word[i] = minibuf[i] & ((1u << (direct.num_bits - bit)) - 1);
+      } else {
+        word[i] = minibuf[i];
+      }
+    }
+    return;
+  }
+
   SVScoped scoped(scope_);
   if (!simutil_set_mem(phys_addr, (const svBitVecVal *)minibuf)) {
     std::ostringstream oss;
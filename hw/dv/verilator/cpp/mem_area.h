@@ -145,6 +145,27 @@ class MemArea {
    */
   void WriteFromMinibuf(uint32_t phys_addr, const uint8_t *minibuf,
                         uint32_t dst_word) const;
+
+ private:
+  /** The simulator's storage for the memory array.
+   *
+   * When the memory array is visible to C++ (see memutil_public.vlt), words
+   * are copied straight into and out of it instead of being passed through
+   * \c simutil_set_mem and \c simutil_get_mem, which need a scope switch and
+   * a DPI call per word.
+   */
+  struct DirectMem {
+    bool resolved;      ///< Whether ResolveDirectMem() has run
+    uint8_t *data;      ///< First word of the array, or null if not visible
+    size_t stride;      ///< Size of each word in the array in bytes
+    uint32_t num_bits;  ///< Width of each word in bits
+    uint32_t depth;     ///< Number of words in the array
+  };
+
+  /** Look up the storage for the memory array once, on first access */
+  const DirectMem &ResolveDirectMem() const;
+
+  mutable DirectMem direct_mem_;
 };
 
 #endif  // OPENTITAN_HW_DV_VERILATOR_CPP_MEM_AREA_H_
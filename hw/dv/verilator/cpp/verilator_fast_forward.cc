@@ -0,0 +1,157 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_fast_forward.h"
+
+#include <getopt.h>
+#include <iostream>
+
+namespace {
+// Cycles before the next timer event at which the clocks are restarted, which
+// leaves time for the event to cross into the other clock domains.
+const uint64_t kWakeupMargin = 256;
+}  // namespace
+
+VerilatorFastForward *VerilatorFastForward::instance_ = nullptr;
+
+VerilatorFastForward::VerilatorFastForward()
+    : mode_(kOff),
+      cycle_(0),
+      enter_cycle_(0),
+      next_event_(0),
+      num_periods_(0),
+      quiescent_cycles_(0),
+      skipped_cycles_(0),
+      early_wakeups_(0) {
+  instance_ = this;
+}
+
+VerilatorFastForward::~VerilatorFastForward() {
+  if (instance_ == this) {
+    instance_ = nullptr;
+  }
+}
+
+// Print a usage message to stdout
+static void PrintHelp() {
+  std::cout << "Fast-forwarding:\n\n"
+               "--fast-forward\n"
+               "  Stop all clocks but the AON clock while the core waits for\n"
+               "  an interrupt, the chip is otherwise idle and a timer is\n"
+               "  enabled, until shortly before the next timer event.\n\n"
+               "--fast-forward-check\n"
+               "  Keep the clocks running, but report quiescent periods that\n"
+               "  end before the predicted timer event, which fast-forwarding\n"
+               "  would have delayed.\n\n"
+               "-h|--help\n"
+               "  Show help\n\n";
+}
+
+bool VerilatorFastForward::ParseCLIArguments(int argc, char **argv,
+                                             bool &exit_app) {
+  const struct option long_options[] = {
+      {"fast-forward", no_argument, nullptr, 'F'},
+      {"fast-forward-check", no_argument, nullptr, 'K'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    // Disable error reporting by getopt
+    opterr = 0;
+
+    switch (c) {
+      case 0:
+      case 1:
+        break;
+      case 'F':
+        mode_ = kSkip;
+        break;
+      case 'K':
+        mode_ = kCheck;
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+  return true;
+}
+
+void VerilatorFastForward::OnClock(unsigned long sim_time) {
+  cycle_ = sim_time / 2;
+}
+
+void VerilatorFastForward::PostExec() {
+  if (mode_ == kOff) {
+    return;
+  }
+  std::cout << std::endl
+            << "Fast-forwarding statistics" << std::endl
+            << "==========================" << std::endl
+            << "Quiescent periods: " << num_periods_ << std::endl
+            << "Quiescent cycles:  " << quiescent_cycles_ << std::endl
+            << "Skipped cycles:    " << skipped_cycles_ << std::endl;
+  if (mode_ == kCheck) {
+    std::cout << "Early wakeups:     " << early_wakeups_ << std::endl;
+  }
+}
+
+uint64_t VerilatorFastForward::Enter(uint64_t next_event) {
+  enter_cycle_ = cycle_;
+  next_event_ = next_event;
+  ++num_periods_;
+
+  if (mode_ != kSkip || next_event <= 2 * kWakeupMargin) {
+    return 0;
+  }
+  uint64_t skip = next_event - kWakeupMargin;
+  skipped_cycles_ += skip;
+  return skip;
+}
+
+void VerilatorFastForward::Exit() {
+  unsigned long cycles = cycle_ - enter_cycle_;
+  quiescent_cycles_ += cycles;
+
+  if (mode_ == kCheck && cycles + kWakeupMargin < next_event_) {
+    ++early_wakeups_;
+    std::cerr << "WARNING: Quiescent period starting at cycle " << enter_cycle_
+              << " ended after " << cycles << " cycles, "
+              << next_event_ - cycles
+              << " cycles before the next timer event." << std::endl;
+  }
+}
+
+extern "C" {
+long long verilator_fast_forward_enter(long long next_event) {
+  VerilatorFastForward *ff = VerilatorFastForward::GetInstance();
+  if (!ff) {
+    return 0;
+  }
+  return static_cast<long long>(
+      ff->Enter(static_cast<uint64_t>(next_event)));
+}
+
+void verilator_fast_forward_exit() {
+  VerilatorFastForward *ff = VerilatorFastForward::GetInstance();
+  if (ff) {
+    ff->Exit();
+  }
+}
+}
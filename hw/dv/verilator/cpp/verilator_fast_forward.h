@@ -0,0 +1,72 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_FAST_FORWARD_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_FAST_FORWARD_H_
+
+//
+// A SimCtrlExtension that fast-forwards quiescent periods of the chip.
+//
+// `verilator_fast_forward.sv` reports when the core waits for an interrupt
+// while the rest of the chip is idle, together with the number of cycles until
+// the next timer event. With `--fast-forward`, this extension then stops the
+// clocks of all but the timers' domain until shortly before that event, which
+// skips the evaluation of most of the design. With `--fast-forward-check`, the
+// clocks keep running and the extension instead checks that the core did not
+// wake up before the predicted event, which would have been delayed by
+// fast-forwarding.
+//
+
+#include <cstdint>
+
+#include "sim_ctrl_extension.h"
+
+class VerilatorFastForward : public SimCtrlExtension {
+ public:
+  VerilatorFastForward();
+  ~VerilatorFastForward() override;
+
+  // Declared in SimCtrlExtension
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+  void OnClock(unsigned long sim_time) override;
+  void PostExec() override;
+
+  /**
+   * The chip became quiescent with the next timer event in `next_event`
+   * cycles.
+   *
+   * @return the number of cycles to stop the clocks for.
+   */
+  uint64_t Enter(uint64_t next_event);
+
+  /**
+   * The chip is no longer quiescent.
+   */
+  void Exit();
+
+  /**
+   * The most recently constructed instance, which receives the calls from the
+   * DPI functions.
+   */
+  static VerilatorFastForward *GetInstance() { return instance_; }
+
+ private:
+  enum Mode { kOff, kCheck, kSkip };
+
+  static VerilatorFastForward *instance_;
+
+  Mode mode_;
+  unsigned long cycle_;
+
+  // The current quiescent period
+  unsigned long enter_cycle_;
+  uint64_t next_event_;
+
+  // Statistics
+  unsigned long num_periods_;
+  unsigned long quiescent_cycles_;
+  unsigned long skipped_cycles_;
+  unsigned long early_wakeups_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_FAST_FORWARD_H_
@@ -13,6 +13,8 @@
 #include <string>
 #include <vector>
 
+#include "verilator_sim_stats.h"
+
 namespace {
 // An instruction to load the file at filepath to the memory called name. If
 // name is the empty string then type must be kMemImageElf and this is an
@@ -190,6 +192,8 @@ bool VerilatorMemUtil::ParseCLIArguments(int argc, char **argv,
     }
   }
 
+  ScopedSimStatsTimer timer(
+      VerilatorSimStats::GetInstance().GetTimer("memutil.load"));
   for (const LoadArg &arg : load_args) {
     try {
       if (!arg.name.empty()) {
@@ -0,0 +1,368 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_sw_logger.h"
+
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <getopt.h>
+#include <iostream>
+#include <libelf.h>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace {
+const char kLogFieldsSection[] = ".logs.fields";
+
+// The section starts with the offset that software adds to the link-time
+// address of each record, see sw/device/info_sections.ld.
+const size_t kLogFieldsHeaderSize = 4;
+
+// Owns the libelf handle and the file descriptor of an ELF file.
+class ElfReader {
+ public:
+  explicit ElfReader(const std::string &path) : path_(path) {
+    if (elf_version(EV_CURRENT) == EV_NONE) {
+      throw std::runtime_error(elf_errmsg(-1));
+    }
+    fd_ = open(path.c_str(), O_RDONLY, 0);
+    if (fd_ < 0) {
+      Fail("could not open file.");
+    }
+    elf_ = elf_begin(fd_, ELF_C_READ, nullptr);
+    if (!elf_ || elf_kind(elf_) != ELF_K_ELF) {
+      if (elf_) {
+        elf_end(elf_);
+      }
+      close(fd_);
+      Fail("not an ELF file.");
+    }
+  }
+
+  ~ElfReader() {
+    elf_end(elf_);
+    close(fd_);
+  }
+
+  [[noreturn]] void Fail(const std::string &msg) const {
+    throw std::runtime_error("ELF file `" + path_ + "': " + msg);
+  }
+
+  Elf *elf_;
+
+ private:
+  std::string path_;
+  int fd_;
+};
+
+void Pad(std::string *str, size_t width, bool zero) {
+  if (str->size() < width) {
+    str->insert(0, width - str->size(), zero ? '0' : ' ');
+  }
+}
+
+std::string ToBase(uint32_t value, unsigned base, bool upper) {
+  const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+  std::string result;
+  do {
+    result.insert(result.begin(), digits[value % base]);
+    value /= base;
+  } while (value != 0);
+  return result;
+}
+}  // namespace
+
+VerilatorSwLogger *VerilatorSwLogger::instance_ = nullptr;
+
+VerilatorSwLogger::VerilatorSwLogger() : pending_(nullptr), counter_(0) {
+  instance_ = this;
+}
+
+VerilatorSwLogger::~VerilatorSwLogger() {
+  if (instance_ == this) {
+    instance_ = nullptr;
+  }
+}
+
+// Print a usage message to stdout
+static void PrintHelp() {
+  std::cout << "Software log bypass:\n\n"
+               "--log-elf=FILE\n"
+               "  Decode bypassed software logs with the log records of\n"
+               "  FILE (elf). May be given more than once.\n\n"
+               "-h|--help\n"
+               "  Show help\n\n";
+}
+
+bool VerilatorSwLogger::ParseCLIArguments(int argc, char **argv,
+                                          bool &exit_app) {
+  const struct option long_options[] = {
+      {"log-elf", required_argument, nullptr, 'L'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    // Disable error reporting by getopt
+    opterr = 0;
+
+    switch (c) {
+      case 0:
+      case 1:
+        break;
+      case 'L':
+        try {
+          LoadElf(optarg);
+        } catch (const std::exception &err) {
+          std::cerr << "ERROR: " << err.what() << std::endl;
+          return false;
+        }
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+  return true;
+}
+
+void VerilatorSwLogger::PostExec() {
+  if (pending_) {
+    std::cerr << "WARNING: Software log truncated after " << args_.size()
+              << " of " << pending_->nargs << " arguments." << std::endl;
+    Emit();
+  }
+}
+
+void VerilatorSwLogger::LoadElf(const std::string &path) {
+  ElfReader reader(path);
+
+  size_t shstrndx;
+  if (elf_getshdrstrndx(reader.elf_, &shstrndx) != 0) {
+    reader.Fail(elf_errmsg(-1));
+  }
+
+  bool found_records = false;
+  Elf_Scn *scn = nullptr;
+  while ((scn = elf_nextscn(reader.elf_, scn)) != nullptr) {
+    const Elf32_Shdr *shdr = elf32_getshdr(scn);
+    if (!shdr) {
+      reader.Fail(elf_errmsg(-1));
+    }
+    const char *name = elf_strptr(reader.elf_, shstrndx, shdr->sh_name);
+    if (!name || shdr->sh_type != SHT_PROGBITS) {
+      continue;
+    }
+    Elf_Data *data = elf_getdata(scn, nullptr);
+    if (!data || !data->d_buf) {
+      continue;
+    }
+    const char *bytes = static_cast<const char *>(data->d_buf);
+
+    if (strcmp(name, kLogFieldsSection) == 0) {
+      if (data->d_size < kLogFieldsHeaderSize) {
+        reader.Fail("truncated log fields section.");
+      }
+      uint32_t offset;
+      memcpy(&offset, bytes, sizeof(offset));
+      for (size_t pos = kLogFieldsHeaderSize;
+           pos + sizeof(LogFields) <= data->d_size; pos += sizeof(LogFields)) {
+        LogFields fields;
+        memcpy(&fields, bytes + pos, sizeof(fields));
+        records_[offset + pos] = fields;
+      }
+      found_records = true;
+    } else if (shdr->sh_flags & SHF_ALLOC) {
+      sections_.push_back(
+          {shdr->sh_addr, std::vector<char>(bytes, bytes + data->d_size)});
+    }
+  }
+
+  if (!found_records) {
+    reader.Fail(std::string("no ") + kLogFieldsSection + " section.");
+  }
+}
+
+std::string VerilatorSwLogger::GetString(uint32_t addr) const {
+  // Strings may be referenced by an address inside them, for example when
+  // `__FILE__` is shared with a longer path.
+  for (const Section &section : sections_) {
+    if (addr < section.addr || addr - section.addr >= section.data.size()) {
+      continue;
+    }
+    size_t start = addr - section.addr;
+    size_t max_len = section.data.size() - start;
+    return std::string(&section.data[start],
+                       strnlen(&section.data[start], max_len));
+  }
+  std::ostringstream oss;
+  oss << "<0x" << std::hex << addr << ">";
+  return oss.str();
+}
+
+std::string VerilatorSwLogger::Format(const LogFields &fields,
+                                      const std::vector<uint32_t> &args) const {
+  std::string format = GetString(fields.format);
+  std::string result;
+  size_t arg = 0;
+  auto next = [&]() -> uint32_t { return arg < args.size() ? args[arg++] : 0; };
+
+  for (size_t i = 0; i < format.size(); ++i) {
+    if (format[i] != '%' || i + 1 == format.size()) {
+      result += format[i];
+      continue;
+    }
+    ++i;
+    bool bang = format[i] == '!';
+    if (bang) {
+      ++i;
+    }
+    bool zero = i < format.size() && format[i] == '0';
+    size_t width = 0;
+    while (i < format.size() && format[i] >= '0' && format[i] <= '9') {
+      width = width * 10 + (format[i++] - '0');
+    }
+    if (i == format.size()) {
+      break;
+    }
+
+    std::string field;
+    char spec = format[i];
+    switch (spec) {
+      case '%':
+        field = "%";
+        break;
+      case 'c':
+        field = static_cast<char>(next() & 0xff);
+        break;
+      case 'C': {
+        uint32_t value = next();
+        for (int j = 0; j < 4; ++j) {
+          char c = static_cast<char>(value >> (8 * j));
+          field += isprint(c) ? c : '?';
+        }
+        break;
+      }
+      case 's':
+        if (bang) {
+          uint32_t len = next();
+          field = GetString(next()).substr(0, len);
+        } else {
+          field = GetString(next());
+        }
+        break;
+      case 'd':
+      case 'i':
+        field = std::to_string(static_cast<int32_t>(next()));
+        break;
+      case 'u':
+        field = std::to_string(next());
+        break;
+      case 'o':
+        field = ToBase(next(), 8, false);
+        break;
+      case 'b':
+        field = bang ? (next() ? "true" : "false") : ToBase(next(), 2, false);
+        break;
+      case 'x':
+      case 'X':
+      case 'h':
+      case 'H':
+      case 'y':
+      case 'Y':
+        if (bang) {
+          // Hex dumps of buffers need the device memory; print the buffer's
+          // length and address instead.
+          uint32_t len = next();
+          std::ostringstream oss;
+          oss << "<" << len << " bytes at 0x" << std::hex << next() << ">";
+          field = oss.str();
+        } else {
+          field = ToBase(next(), 16, spec == 'X' || spec == 'H');
+        }
+        break;
+      case 'p':
+        field = "0x" + ToBase(next(), 16, false);
+        Pad(&field, 10, true);
+        break;
+      case 'r':
+        // Decoding a status_t needs the module ID tables of the device
+        // library; print the raw value like the DV log monitor does.
+        field = ToBase(next(), 16, false);
+        Pad(&field, 8, true);
+        break;
+      default:
+        field = std::string("%") + spec;
+        break;
+    }
+    Pad(&field, width, zero);
+    result += field;
+  }
+  return result;
+}
+
+void VerilatorSwLogger::Emit() {
+  static const char *const kSeverities[] = {"I", "W", "E", "F"};
+  const char *severity =
+      pending_->severity < 4 ? kSeverities[pending_->severity] : "?";
+
+  std::string file_name = GetString(pending_->file_name);
+  size_t slash = file_name.rfind('/');
+  if (slash != std::string::npos) {
+    file_name = file_name.substr(slash + 1);
+  }
+
+  char prefix[8];
+  snprintf(prefix, sizeof(prefix), "%05u", counter_++ & 0xffff);
+  std::cout << severity << prefix << " " << file_name << ":" << pending_->line
+            << "] " << Format(*pending_, args_) << std::endl;
+
+  pending_ = nullptr;
+  args_.clear();
+}
+
+void VerilatorSwLogger::Write(uint32_t data) {
+  if (pending_) {
+    args_.push_back(data);
+  } else {
+    auto it = records_.find(data);
+    if (it == records_.end()) {
+      std::cerr << "WARNING: No software log record at 0x" << std::hex << data
+                << std::dec << ". Was the ELF file given with --log-elf?"
+                << std::endl;
+      return;
+    }
+    pending_ = &it->second;
+  }
+  if (args_.size() == pending_->nargs) {
+    Emit();
+  }
+}
+
+extern "C" {
+void verilator_sw_logger_write(int data) {
+  VerilatorSwLogger *logger = VerilatorSwLogger::GetInstance();
+  if (logger) {
+    logger->Write(static_cast<uint32_t>(data));
+  }
+}
+}
@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_LOGGER_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_LOGGER_H_
+
+//
+// A SimCtrlExtension that decodes software logs written to the log bypass
+// address.
+//
+// Software built with the `sim_verilator_log_bypass` device library does not
+// format its log messages on the device. Instead, `base_log_internal_dv()`
+// writes the address of the message's `log_fields_t` record followed by its
+// arguments to the log bypass address, which `verilator_sw_logger.sv` forwards
+// to this extension. The records and the strings they refer to are looked up
+// in the ELF files given with `--log-elf`, and the formatted messages are
+// printed on stdout.
+//
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim_ctrl_extension.h"
+
+class VerilatorSwLogger : public SimCtrlExtension {
+ public:
+  VerilatorSwLogger();
+  ~VerilatorSwLogger() override;
+
+  // Declared in SimCtrlExtension
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+  void PostExec() override;
+
+  /**
+   * Load the log records and strings of an ELF file.
+   *
+   * Throws a std::exception on failure.
+   */
+  void LoadElf(const std::string &path);
+
+  /**
+   * Process one word written by software to the log bypass address.
+   */
+  void Write(uint32_t data);
+
+  /**
+   * The most recently constructed instance, which receives the words from the
+   * DPI function.
+   */
+  static VerilatorSwLogger *GetInstance() { return instance_; }
+
+ private:
+  // The in-memory layout of `log_fields_t` in sw/device/lib/runtime/log.h.
+  struct LogFields {
+    uint32_t severity;
+    uint32_t file_name;
+    uint32_t line;
+    uint32_t nargs;
+    uint32_t format;
+  };
+
+  // An allocated section that may contain strings referenced by log records.
+  struct Section {
+    uint32_t addr;
+    std::vector<char> data;
+  };
+
+  std::string GetString(uint32_t addr) const;
+  std::string Format(const LogFields &fields,
+                     const std::vector<uint32_t> &args) const;
+  void Emit();
+
+  static VerilatorSwLogger *instance_;
+
+  // Log records, keyed by the address software writes for them.
+  std::map<uint32_t, LogFields> records_;
+  std::vector<Section> sections_;
+
+  // The record being received and the arguments received for it so far.
+  const LogFields *pending_;
+  std::vector<uint32_t> args_;
+  unsigned counter_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_LOGGER_H_
@@ -0,0 +1,278 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_sw_mailbox.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+
+#include "verilator_sim_ctrl.h"
+
+namespace {
+// The words of the sim SRAM which software reads the result and the current
+// response word from.
+const uint32_t kResultWord = 5;
+const uint32_t kResponseWord = 6;
+
+// Terminal test states, see sw_test_status_pkg.sv.
+const uint32_t kTestStatusInTest = 0x4354;
+const uint32_t kTestStatusPassed = 0x900d;
+const uint32_t kTestStatusFailed = 0xbaad;
+
+// Limit on the length of a file read, to not allocate whatever software asks
+// for.
+const uint32_t kMaxReadBytes = 1 << 20;
+}  // namespace
+
+VerilatorSwMailbox *VerilatorSwMailbox::instance_ = nullptr;
+
+VerilatorSwMailbox::VerilatorSwMailbox(const MemArea *sim_sram)
+    : sim_sram_(sim_sram),
+      last_status_(0),
+      result_(0),
+      response_pos_(0),
+      changed_(false),
+      num_requests_(0) {
+  instance_ = this;
+}
+
+VerilatorSwMailbox::~VerilatorSwMailbox() {
+  if (instance_ == this) {
+    instance_ = nullptr;
+  }
+}
+
+// Print a usage message to stdout
+static void PrintHelp() {
+  std::cout << "Software mailbox:\n\n"
+               "--sw-mailbox-dir=DIR\n"
+               "  Let software read and write the files in DIR through the\n"
+               "  mailbox\n\n"
+               "-h|--help\n"
+               "  Show help\n\n";
+}
+
+bool VerilatorSwMailbox::ParseCLIArguments(int argc, char **argv,
+                                           bool &exit_app) {
+  const struct option long_options[] = {
+      {"sw-mailbox-dir", required_argument, nullptr, 'D'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  // Reset the command parsing index in-case other utils have already parsed
+  // some arguments
+  optind = 1;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    // Disable error reporting by getopt
+    opterr = 0;
+
+    switch (c) {
+      case 0:
+      case 1:
+        break;
+      case 'D':
+        dir_ = optarg;
+        break;
+      case 'h':
+        PrintHelp();
+        return true;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument." << std::endl << std::endl;
+        return false;
+      case '?':
+      default:;
+        // Ignore unrecognized options since they might be consumed by
+        // other utils
+    }
+  }
+  return true;
+}
+
+void VerilatorSwMailbox::OnClock(unsigned long sim_time) {
+  if (!changed_) {
+    return;
+  }
+  changed_ = false;
+
+  // Write outside of the evaluation of the design, like memory loads.
+  uint32_t response =
+      response_pos_ < response_.size() ? response_[response_pos_] : 0;
+  uint32_t words[2] = {static_cast<uint32_t>(result_), response};
+  std::vector<uint8_t> data(sizeof(words));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = words[i / 4] >> (8 * (i % 4));
+  }
+  static_assert(kResponseWord == kResultWord + 1,
+                "The result and response words must be adjacent.");
+  sim_sram_->Write(kResultWord, data);
+}
+
+void VerilatorSwMailbox::PostExec() {
+  if (num_requests_) {
+    std::cout << std::endl
+              << "Software mailbox requests: " << num_requests_ << std::endl;
+  }
+}
+
+void VerilatorSwMailbox::Status(uint32_t status) {
+  uint32_t last_status = last_status_;
+  last_status_ = status;
+  if (status != kTestStatusPassed && status != kTestStatusFailed) {
+    return;
+  }
+
+  // Like sw_test_status_if, only accept a pass from within the test.
+  bool passed = status == kTestStatusPassed && last_status == kTestStatusInTest;
+  std::cout << "Software test " << (passed ? "passed" : "failed")
+            << ", stopping the simulation." << std::endl;
+  VerilatorSimCtrl::GetInstance().RequestStop(passed);
+}
+
+void VerilatorSwMailbox::Write(uint32_t offset, uint32_t data) {
+  if (offset == 0) {
+    Execute(data);
+  } else {
+    args_.push_back(data);
+  }
+}
+
+void VerilatorSwMailbox::Execute(uint32_t command) {
+  changed_ = true;
+  if (command == kCmdNext) {
+    if (response_pos_ < response_.size()) {
+      ++response_pos_;
+    }
+    return;
+  }
+
+  ++num_requests_;
+  response_.clear();
+  response_pos_ = 0;
+  switch (command) {
+    case kCmdCycleCount: {
+      uint64_t cycle = VerilatorSimCtrl::GetInstance().GetTime() / 2;
+      response_.push_back(cycle);
+      response_.push_back(cycle >> 32);
+      result_ = 0;
+      break;
+    }
+    case kCmdFileRead:
+      result_ = FileRead();
+      break;
+    case kCmdFileWrite:
+    case kCmdFileAppend:
+      result_ = FileWrite(command == kCmdFileAppend);
+      break;
+    default:
+      std::cerr << "WARNING: Unknown software mailbox command " << command
+                << "." << std::endl;
+      result_ = -EINVAL;
+  }
+  args_.clear();
+}
+
+// Read the file name at args_[*pos] and advance *pos past it
+bool VerilatorSwMailbox::GetPath(size_t *pos, std::string *path) const {
+  std::string name;
+  bool terminated = false;
+  for (; *pos < args_.size() && !terminated; ++*pos) {
+    for (int i = 0; i < 4 && !terminated; ++i) {
+      char c = args_[*pos] >> (8 * i);
+      if (c == '\0') {
+        terminated = true;
+      } else {
+        name.push_back(c);
+      }
+    }
+  }
+  if (!terminated || name.empty()) {
+    return false;
+  }
+
+  // Keep software within the mailbox directory.
+  std::string padded = "/" + name + "/";
+  if (name[0] == '/' || padded.find("/../") != std::string::npos) {
+    return false;
+  }
+  *path = dir_ + "/" + name;
+  return true;
+}
+
+int32_t VerilatorSwMailbox::FileRead() {
+  if (dir_.empty()) {
+    return -EACCES;
+  }
+  size_t pos = 2;
+  std::string path;
+  if (args_.size() < pos || !GetPath(&pos, &path)) {
+    return -EINVAL;
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file || !file.seekg(args_[0])) {
+    return -ENOENT;
+  }
+  std::vector<char> data(std::min(args_[1], kMaxReadBytes));
+  file.read(data.data(), data.size());
+  size_t len = file.gcount();
+
+  response_.assign((len + 3) / 4, 0);
+  for (size_t i = 0; i < len; ++i) {
+    response_[i / 4] |= static_cast<uint32_t>(static_cast<uint8_t>(data[i]))
+                        << (8 * (i % 4));
+  }
+  return len;
+}
+
+int32_t VerilatorSwMailbox::FileWrite(bool append) {
+  if (dir_.empty()) {
+    return -EACCES;
+  }
+  size_t pos = 1;
+  std::string path;
+  if (args_.size() < pos || !GetPath(&pos, &path)) {
+    return -EINVAL;
+  }
+  size_t len = args_[0];
+  if (len > (args_.size() - pos) * 4) {
+    return -EINVAL;
+  }
+
+  std::ofstream file(path, std::ios::binary | (append ? std::ios::app
+                                                       : std::ios::trunc));
+  if (!file) {
+    return -ENOENT;
+  }
+  for (size_t i = 0; i < len; ++i) {
+    file.put(static_cast<char>(args_[pos + i / 4] >> (8 * (i % 4))));
+  }
+  if (!file.flush()) {
+    return -EIO;
+  }
+  return len;
+}
+
+extern "C" {
+void verilator_sw_mailbox_status(int status) {
+  VerilatorSwMailbox *mailbox = VerilatorSwMailbox::GetInstance();
+  if (mailbox) {
+    mailbox->Status(static_cast<uint32_t>(status));
+  }
+}
+
+void verilator_sw_mailbox_write(int offset, int data) {
+  VerilatorSwMailbox *mailbox = VerilatorSwMailbox::GetInstance();
+  if (mailbox) {
+    mailbox->Write(static_cast<uint32_t>(offset), static_cast<uint32_t>(data));
+  }
+}
+}
@@ -0,0 +1,114 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_MAILBOX_H_
+#define OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_MAILBOX_H_
+
+//
+// A SimCtrlExtension that watches the test status and serves requests from
+// software on the host.
+//
+// `verilator_sw_mailbox.sv` forwards the writes to the test status address,
+// and the simulation is stopped right after the cycle in which software writes
+// a terminal status, instead of waiting for the testbench to call `$finish`.
+//
+// It also forwards the writes to the mailbox, which occupies words 3 to 6 of
+// the sim SRAM:
+//
+//   word 3 (write): command, see `Command`
+//   word 4 (write): argument, appended to the arguments of the next command
+//   word 5 (read):  result of the last command, negative errno on errors
+//   word 6 (read):  current word of the response of the last command
+//
+// A command consumes the arguments written since the previous command and
+// makes the first word of its response available in word 6. `kCmdNext`
+// advances to the next word of the response. This extension writes the result
+// and the response word into the sim SRAM at the next clock edge, before
+// software can read them.
+//
+// File names are written as arguments, as NUL-terminated strings packed into
+// little-endian words, and are relative to the directory given with
+// `--sw-mailbox-dir`. Files cannot be accessed without it.
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mem_area.h"
+#include "sim_ctrl_extension.h"
+
+class VerilatorSwMailbox : public SimCtrlExtension {
+ public:
+  /**
+   * The mailbox commands, kept in sync with sim_mailbox_testutils.c in
+   * sw/device/lib/testing.
+   */
+  enum Command : uint32_t {
+    // Advance to the next word of the response.
+    kCmdNext = 1,
+    // Response: the current cycle as two words, low word first.
+    kCmdCycleCount = 2,
+    // Arguments: offset, maximum length in bytes, file name.
+    // Response: the data read. Result: the number of bytes read.
+    kCmdFileRead = 3,
+    // Arguments: length in bytes, file name, data.
+    // Result: the number of bytes written.
+    kCmdFileWrite = 4,
+    // Like kCmdFileWrite, but appends to the file.
+    kCmdFileAppend = 5,
+  };
+
+  /**
+   * @param sim_sram the memory of the sim SRAM, into which the results and
+   *                 responses are written
+   */
+  explicit VerilatorSwMailbox(const MemArea *sim_sram);
+  ~VerilatorSwMailbox() override;
+
+  // Declared in SimCtrlExtension
+  bool ParseCLIArguments(int argc, char **argv, bool &exit_app) override;
+  void OnClock(unsigned long sim_time) override;
+  void PostExec() override;
+
+  /**
+   * Process a write of software to the test status address.
+   */
+  void Status(uint32_t status);
+
+  /**
+   * Process a write of software to the mailbox.
+   *
+   * @param offset byte offset of the write from the command word
+   */
+  void Write(uint32_t offset, uint32_t data);
+
+  /**
+   * The most recently constructed instance, which receives the writes from
+   * the DPI functions.
+   */
+  static VerilatorSwMailbox *GetInstance() { return instance_; }
+
+ private:
+  void Execute(uint32_t command);
+  bool GetPath(size_t *pos, std::string *path) const;
+  int32_t FileRead();
+  int32_t FileWrite(bool append);
+
+  static VerilatorSwMailbox *instance_;
+
+  const MemArea *sim_sram_;
+  std::string dir_;
+  uint32_t last_status_;
+
+  std::vector<uint32_t> args_;
+  int32_t result_;
+  std::vector<uint32_t> response_;
+  size_t response_pos_;
+  // The result and response word have changed since the last clock edge.
+  bool changed_;
+
+  unsigned long num_requests_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_CPP_VERILATOR_SW_MAILBOX_H_
@@ -5,6 +5,17 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_SIM_CTRL_EXTENSION_H_
 
+/**
+ * An extension to VerilatorSimCtrl
+ *
+ * All callbacks are made from the thread that runs the simulation loop, in
+ * between evaluations of the model, so they need no locking even if the model
+ * was built with `--threads`. Code that is called from the model itself, such
+ * as DPI functions, runs on Verilator's worker threads instead. The chip-level
+ * models are built with `--threads-dpi none`, which serializes those calls,
+ * but state they share with the callbacks here must still be safe to access
+ * from another thread.
+ */
 class SimCtrlExtension {
  public:
   virtual ~SimCtrlExtension() = default;
@@ -4,12 +4,25 @@
 
 #include "verilator_sim_ctrl.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
 #include <getopt.h>
 #include <iostream>
+#include <map>
 #include <signal.h>
+#include <sstream>
 #include <sys/stat.h>
+#include <sys/wait.h>
+#include <typeinfo>
+#include <unistd.h>
 #include <verilated.h>
 
+#include "verilator_sim_stats.h"
+
 // This is defined by Verilator and passed through the command line
 #ifndef VM_TRACE
 #define VM_TRACE 0
@@ -22,6 +35,26 @@
  */
 double sc_time_stamp() { return VerilatorSimCtrl::GetInstance().GetTime(); }
 
+/**
+ * Register the fork hooks of a DPI model
+ *
+ * This overrides the weak declaration in dpi_fork.h, through which DPI models
+ * written in C register their hooks.
+ */
+extern "C" void dpi_fork_register(void *ctx, void (*prepare)(void *),
+                                  void (*child)(void *)) {
+  VerilatorSimCtrl::GetInstance().RegisterForkHooks(ctx, prepare, child);
+}
+
+/**
+ * Unregister the fork hooks of a DPI model
+ *
+ * This overrides the weak declaration in dpi_fork.h.
+ */
+extern "C" void dpi_fork_unregister(void *ctx) {
+  VerilatorSimCtrl::GetInstance().UnregisterForkHooks(ctx);
+}
+
 #ifdef VL_USER_STOP
 /**
  * A simulation stop was requested, e.g. through $stop() or $error()
@@ -34,6 +67,21 @@ void vl_stop(const char *filename, int linenum, const char *hier) VL_MT_UNSAFE {
 }
 #endif
 
+/**
+ * Switch tracing on (enable != 0) or off from SystemVerilog
+ *
+ * This allows a design, a testbench or a DPI model to trace only around an
+ * event of interest. See verilator_trace_ctrl.sv for a module that forwards
+ * writes from software.
+ */
+extern "C" void verilator_sim_ctrl_trace(int enable) {
+  if (enable) {
+    VerilatorSimCtrl::GetInstance().TraceOn();
+  } else {
+    VerilatorSimCtrl::GetInstance().TraceOff();
+  }
+}
+
 VerilatorSimCtrl &VerilatorSimCtrl::GetInstance() {
   static VerilatorSimCtrl instance;
   return instance;
@@ -111,9 +159,20 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
   const struct option long_options[] = {
       {"term-after-cycles", required_argument, nullptr, 'c'},
       {"trace", optional_argument, nullptr, 't'},
+      {"trace-start-cycle", required_argument, nullptr, 'S'},
+      {"trace-end-cycle", required_argument, nullptr, 'E'},
+      {"trace-ring", required_argument, nullptr, 'R'},
+      {"test-list", required_argument, nullptr, 'T'},
+      {"test-fork-cycle", required_argument, nullptr, 'F'},
+      {"test-jobs", required_argument, nullptr, 'J'},
+      {"stats", required_argument, nullptr, 'X'},
+      {"stats-interval", required_argument, nullptr, 'I'},
+      {"stats-stream", required_argument, nullptr, 'Y'},
       {"help", no_argument, nullptr, 'h'},
       {nullptr, no_argument, nullptr, 0}};
 
+  bool trace_requested = false;
+
   while (1) {
     int c = getopt_long(argc, argv, "-:c:th", long_options, nullptr);
     if (c == -1) {
@@ -128,16 +187,58 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
       case 1:
         break;
       case 't':
-        if (!tracing_possible_) {
-          std::cerr << "ERROR: Tracing has not been enabled at compile time."
-                    << std::endl;
+        if (optarg != nullptr) {
+          trace_file_path_.assign(optarg);
+        }
+        trace_requested = true;
+        break;
+      case 'S':
+        if (!read_ul_arg(&trace_start_cycle_, "trace-start-cycle", optarg)) {
           exit_app = true;
           return false;
         }
-        if (optarg != nullptr) {
-          trace_file_path_.assign(optarg);
+        trace_requested = true;
+        break;
+      case 'E':
+        if (!read_ul_arg(&trace_end_cycle_, "trace-end-cycle", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        trace_requested = true;
+        break;
+      case 'R':
+        if (!read_ul_arg(&trace_ring_cycles_, "trace-ring", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        trace_requested = true;
+        break;
+      case 'T':
+        test_list_path_.assign(optarg);
+        break;
+      case 'F':
+        if (!read_ul_arg(&test_fork_cycle_, "test-fork-cycle", optarg)) {
+          exit_app = true;
+          return false;
+        }
+        break;
+      case 'J':
+        if (!read_ul_arg(&test_jobs_, "test-jobs", optarg) || !test_jobs_) {
+          exit_app = true;
+          return false;
+        }
+        break;
+      case 'X':
+        stats_path_.assign(optarg);
+        break;
+      case 'I':
+        if (!read_ul_arg(&stats_interval_, "stats-interval", optarg)) {
+          exit_app = true;
+          return false;
         }
-        TraceOn();
+        break;
+      case 'Y':
+        stats_stream_path_.assign(optarg);
         break;
       case 'c':
         if (!read_ul_arg(&term_after_cycles_, "term-after-cycles", optarg)) {
@@ -160,6 +261,49 @@ bool VerilatorSimCtrl::ParseCommandArgs(int argc, char **argv, bool &exit_app) {
     }
   }
 
+  if (trace_requested) {
+    if (!test_list_path_.empty()) {
+      std::cerr << "ERROR: Tracing options must be given per test in the "
+                   "test list."
+                << std::endl;
+      exit_app = true;
+      return false;
+    }
+    if (!tracing_possible_) {
+      std::cerr << "ERROR: Tracing has not been enabled at compile time."
+                << std::endl;
+      exit_app = true;
+      return false;
+    }
+    if (trace_end_cycle_ && trace_end_cycle_ <= trace_start_cycle_) {
+      std::cerr << "ERROR: The trace end cycle must be after the start cycle."
+                << std::endl;
+      exit_app = true;
+      return false;
+    }
+    // With a start cycle, tracing is switched on by the main loop.
+    if (!trace_start_cycle_) {
+      TraceOn();
+    }
+  }
+
+  if (!stats_stream_path_.empty() && !stats_interval_) {
+    std::cerr << "ERROR: --stats-stream requires --stats-interval." << std::endl;
+    exit_app = true;
+    return false;
+  }
+  if (stats_interval_ && stats_path_.empty() && stats_stream_path_.empty()) {
+    std::cerr << "ERROR: --stats-interval requires --stats or --stats-stream."
+              << std::endl;
+    exit_app = true;
+    return false;
+  }
+  // Enable the statistics before the extensions parse their arguments, which
+  // may already do work worth timing, like loading memories.
+  if (!stats_path_.empty() || !stats_stream_path_.empty()) {
+    VerilatorSimStats::GetInstance().Enable();
+  }
+
   // Pass args to verilator
   Verilated::commandArgs(argc, argv);
 
@@ -189,6 +333,11 @@ void VerilatorSimCtrl::RunSimulation() {
   for (auto it = extension_array_.begin(); it != extension_array_.end(); ++it) {
     (*it)->PreExec();
   }
+  if (!test_list_path_.empty()) {
+    RunTestServer();
+    WriteStats();
+    return;
+  }
   // Run the simulation
   Run();
   // Call all extension post-exec methods
@@ -197,8 +346,9 @@ void VerilatorSimCtrl::RunSimulation() {
   }
   // Print simulation speed info
   PrintStatistics();
+  WriteStats();
   // Print helper message for tracing
-  if (TracingEverEnabled()) {
+  if (TracingEverEnabled() && !trace_ring_cycles_) {
     std::cout << std::endl
               << "You can view the simulation traces by calling" << std::endl
               << "$ gtkwave " << GetTraceFileName() << std::endl;
@@ -218,8 +368,12 @@ void VerilatorSimCtrl::SetTimeout(unsigned int cycles) {
 }
 
 void VerilatorSimCtrl::RequestStop(bool simulation_success) {
+  // Record the result first, so that the main loop sees it once it observes
+  // the stop request.
+  if (!simulation_success) {
+    simulation_success_ = false;
+  }
   request_stop_ = true;
-  simulation_success_ &= simulation_success;
 }
 
 void VerilatorSimCtrl::RegisterExtension(SimCtrlExtension *ext) {
@@ -238,6 +392,19 @@ VerilatorSimCtrl::VerilatorSimCtrl()
       tracing_enabled_changed_(false),
       tracing_ever_enabled_(false),
       tracing_possible_(VM_TRACE),
+      trace_start_cycle_(0),
+      trace_end_cycle_(0),
+      trace_ring_cycles_(0),
+      trace_segment_(0),
+      trace_segment_start_cycle_(0),
+      timeout_reached_(false),
+      test_fork_cycle_(0),
+      test_jobs_(1),
+      stats_interval_(0),
+      stats_next_sample_cycle_(0),
+      stats_sample_cycle_(0),
+      stats_eval_(nullptr),
+      stats_trace_(nullptr),
       initial_reset_delay_cycles_(2),
       reset_duration_cycles_(2),
       request_stop_(false),
@@ -279,10 +446,40 @@ void VerilatorSimCtrl::PrintHelp() const {
   if (tracing_possible_) {
     std::cout << "-t|--trace\n"
                  "   --trace=FILE\n"
-                 "  Write a trace file from the start\n\n";
+                 "  Write a trace file from the start\n\n"
+                 "--trace-start-cycle=N\n"
+                 "  Start tracing at cycle N instead of the start\n\n"
+                 "--trace-end-cycle=N\n"
+                 "  Stop tracing at cycle N\n\n"
+                 "--trace-ring=N\n"
+                 "  Only keep (at least) the last N cycles of the trace, in\n"
+                 "  two segment files. The segments are deleted at the end\n"
+                 "  of the simulation unless it failed or timed out.\n\n";
   }
   std::cout << "-c|--term-after-cycles=N\n"
                "  Terminate simulation after N cycles. 0 means no timeout.\n\n"
+               "--test-list=FILE\n"
+               "  Run the tests listed in FILE, one per line as a name\n"
+               "  followed by the arguments of the test, in forked copies of\n"
+               "  the simulation. The outputs of each test are written to a\n"
+               "  directory named after it.\n\n"
+               "--test-fork-cycle=N\n"
+               "  Fork the tests of the test list at cycle N instead of at\n"
+               "  the end of reset\n\n"
+               "--test-jobs=N\n"
+               "  Run up to N tests of the test list at the same time.\n"
+               "  The DPI models reopen their pseudo-terminals, FIFOs and\n"
+               "  sockets in each test, on a free port if theirs is taken.\n\n"
+               "--stats=FILE\n"
+               "  Time the evaluation of the design, tracing and the\n"
+               "  extensions, count the calls into DPI models and write\n"
+               "  these statistics as JSON to FILE at the end of the\n"
+               "  simulation. Use - for stdout.\n\n"
+               "--stats-interval=N\n"
+               "  Sample the simulation speed every N cycles\n\n"
+               "--stats-stream=FILE\n"
+               "  Write each sample as a line of JSON to FILE while the\n"
+               "  simulation runs\n\n"
                "-h|--help\n"
                "  Show help\n\n"
                "All arguments are passed to the design and can be used "
@@ -329,10 +526,51 @@ void VerilatorSimCtrl::PrintStatistics() const {
 }
 
 std::string VerilatorSimCtrl::GetTraceFileName() const {
+  if (trace_ring_cycles_) {
+    return GetTraceSegmentFileName(trace_segment_);
+  }
   return trace_file_path_;
 }
 
+std::string VerilatorSimCtrl::GetTraceSegmentFileName(
+    unsigned long segment) const {
+  // Insert the segment number before the extension: sim.fst -> sim.3.fst
+  size_t dot = trace_file_path_.rfind('.');
+  size_t slash = trace_file_path_.rfind('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    dot = trace_file_path_.size();
+  }
+  return trace_file_path_.substr(0, dot) + "." + std::to_string(segment) +
+         trace_file_path_.substr(dot);
+}
+
+void VerilatorSimCtrl::FinishTraceRing() {
+  bool keep = !simulation_success_ || timeout_reached_;
+  unsigned long first = trace_segment_ > 0 ? trace_segment_ - 1 : 0;
+
+  if (keep) {
+    std::cout << std::endl
+              << "You can view the last cycles of the simulation traces by "
+                 "calling"
+              << std::endl;
+  }
+  for (unsigned long segment = first; segment <= trace_segment_; ++segment) {
+    if (keep) {
+      std::cout << "$ gtkwave " << GetTraceSegmentFileName(segment)
+                << std::endl;
+    } else {
+      std::remove(GetTraceSegmentFileName(segment).c_str());
+    }
+  }
+}
+
 void VerilatorSimCtrl::Run() {
+  StartRun();
+  RunUntil(0);
+  FinishRun();
+}
+
+void VerilatorSimCtrl::StartRun() {
   assert(top_ && "Use SetTop() first.");
 
   // We always need to enable this as tracing can be enabled at runtime
@@ -348,59 +586,495 @@ void VerilatorSimCtrl::Run() {
             << "Simulation running, end by pressing CTRL-c." << std::endl;
 
   time_begin_ = std::chrono::steady_clock::now();
+  StartStats();
   UnsetReset();
   Trace();
+}
 
+bool VerilatorSimCtrl::RunUntil(unsigned long stop_cycle) {
   unsigned long start_reset_cycle_ = initial_reset_delay_cycles_;
   unsigned long end_reset_cycle_ = start_reset_cycle_ + reset_duration_cycles_;
 
   while (1) {
     unsigned long cycle_ = time_ / 2;
 
+    if (stop_cycle && cycle_ == stop_cycle && !*sig_clk_) {
+      return false;
+    }
+
+    if (stats_interval_ && cycle_ >= stats_next_sample_cycle_) {
+      SampleStats(cycle_);
+    }
+
     if (cycle_ == start_reset_cycle_) {
       SetReset();
     } else if (cycle_ == end_reset_cycle_) {
       UnsetReset();
     }
 
+    // Both edges of a cycle see the same cycle count, but switching tracing on
+    // or off twice has no further effect.
+    if (trace_start_cycle_ && cycle_ == trace_start_cycle_) {
+      TraceOn();
+    }
+    if (trace_end_cycle_ && cycle_ == trace_end_cycle_) {
+      TraceOff();
+    }
+
     *sig_clk_ = !*sig_clk_;
 
     // Call all extension on-clock methods
     if (*sig_clk_) {
-      for (auto it = extension_array_.begin(); it != extension_array_.end();
-           ++it) {
-        (*it)->OnClock(time_);
+      for (size_t i = 0; i < extension_array_.size(); ++i) {
+        ScopedSimStatsTimer timer(stats_on_clock_.empty() ? nullptr
+                                                          : stats_on_clock_[i]);
+        extension_array_[i]->OnClock(time_);
       }
     }
 
-    top_->eval();
+    {
+      ScopedSimStatsTimer timer(stats_eval_);
+      top_->eval();
+    }
     time_++;
 
-    Trace();
+    {
+      ScopedSimStatsTimer timer(stats_trace_);
+      Trace();
+    }
 
     if (request_stop_) {
       std::cout << "Received stop request, shutting down simulation."
                 << std::endl;
-      break;
+      return true;
     }
     if (Verilated::gotFinish()) {
       std::cout << "Received $finish() from Verilog, shutting down simulation."
                 << std::endl;
-      break;
+      return true;
     }
     if (term_after_cycles_ && (time_ / 2 >= term_after_cycles_)) {
       std::cout << "Simulation timeout of " << term_after_cycles_
                 << " cycles reached, shutting down simulation." << std::endl;
-      break;
+      timeout_reached_ = true;
+      return true;
     }
   }
+}
 
+void VerilatorSimCtrl::FinishRun() {
   top_->final();
   time_end_ = std::chrono::steady_clock::now();
 
   if (TracingEverEnabled()) {
     tracer_.close();
+    if (trace_ring_cycles_) {
+      FinishTraceRing();
+    }
+  }
+}
+
+bool VerilatorSimCtrl::ReadTestList(
+    std::vector<std::pair<std::string, std::vector<std::string>>> *tests)
+    const {
+  std::ifstream file(test_list_path_);
+  if (!file) {
+    std::cerr << "ERROR: Could not read the test list `" << test_list_path_
+              << "'." << std::endl;
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream words(line);
+    std::string name;
+    if (!(words >> name) || name[0] == '#') {
+      continue;
+    }
+    std::vector<std::string> args;
+    std::string arg;
+    while (words >> arg) {
+      args.push_back(arg);
+    }
+    tests->emplace_back(name, args);
+  }
+
+  if (tests->empty()) {
+    std::cerr << "ERROR: The test list `" << test_list_path_
+              << "' contains no tests." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Get the number of threads of this process
+ *
+ * @return the number of threads, or 0 if it is unknown
+ */
+static unsigned GetThreadCount() {
+  DIR *dir = opendir("/proc/self/task");
+  if (!dir) {
+    return 0;
+  }
+  unsigned count = 0;
+  while (struct dirent *entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') {
+      ++count;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+
+/**
+ * Get the host endpoints opened by the DPI models
+ *
+ * These are the pseudo-terminals, FIFOs and sockets this process has open,
+ * other than its standard streams.
+ *
+ * @return the paths of the endpoints, as listed in /proc/self/fd
+ */
+static std::vector<std::string> GetHostEndpoints() {
+  std::vector<std::string> endpoints;
+  DIR *dir = opendir("/proc/self/fd");
+  if (!dir) {
+    return endpoints;
+  }
+  while (struct dirent *entry = readdir(dir)) {
+    char *end;
+    long fd = strtol(entry->d_name, &end, 10);
+    if (*end != '\0' || end == entry->d_name || fd <= STDERR_FILENO ||
+        fd == dirfd(dir)) {
+      continue;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      continue;
+    }
+    if (!S_ISFIFO(st.st_mode) && !S_ISSOCK(st.st_mode) &&
+        !(S_ISCHR(st.st_mode) && isatty(fd))) {
+      continue;
+    }
+    char target[256];
+    std::string link = std::string("/proc/self/fd/") + entry->d_name;
+    ssize_t len = readlink(link.c_str(), target, sizeof(target) - 1);
+    endpoints.emplace_back(len > 0 ? std::string(target, len) : link);
+  }
+  closedir(dir);
+  return endpoints;
+}
+
+void VerilatorSimCtrl::RegisterForkHooks(void *ctx, void (*prepare)(void *),
+                                         void (*child)(void *)) {
+  fork_hooks_.push_back({ctx, prepare, child});
+}
+
+void VerilatorSimCtrl::UnregisterForkHooks(void *ctx) {
+  for (auto it = fork_hooks_.begin(); it != fork_hooks_.end(); ++it) {
+    if (it->ctx == ctx) {
+      fork_hooks_.erase(it);
+      return;
+    }
+  }
+}
+
+bool VerilatorSimCtrl::CheckTestServerForkable() const {
+  // fork() only keeps the calling thread. Threads that the prepare hooks did
+  // not stop, e.g. the worker threads of a model built with --threads N or
+  // those of a DPI model without fork hooks, would be missing in the
+  // children, which would then deadlock on the locks those threads hold.
+  unsigned threads = GetThreadCount();
+  if (threads != 1) {
+    std::cerr << "ERROR: The test server mode needs a single thread at the "
+                 "fork cycle, but "
+              << threads
+              << " are running. Build the model with "
+                 "--config=verilator_test_server, which sets --threads 1."
+              << std::endl;
+    return false;
+  }
+
+  // Tests that run at the same time would share the endpoints of the
+  // parent, and interleave their reads and writes.
+  if (test_jobs_ > 1) {
+    std::vector<std::string> endpoints = GetHostEndpoints();
+    if (!endpoints.empty()) {
+      std::cerr << "ERROR: --test-jobs must be 1 while DPI models without "
+                   "fork hooks have host endpoints open:"
+                << std::endl;
+      for (const std::string &endpoint : endpoints) {
+        std::cerr << "  " << endpoint << std::endl;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+void VerilatorSimCtrl::RunTestServer() {
+  std::vector<std::pair<std::string, std::vector<std::string>>> tests;
+  if (!ReadTestList(&tests)) {
+    simulation_success_ = false;
+    return;
+  }
+
+  unsigned long fork_cycle = test_fork_cycle_;
+  if (!fork_cycle) {
+    fork_cycle = initial_reset_delay_cycles_ + reset_duration_cycles_;
+  }
+
+  StartRun();
+  if (RunUntil(fork_cycle)) {
+    std::cerr << "ERROR: The simulation finished before the fork cycle "
+              << fork_cycle << "." << std::endl;
+    FinishRun();
+    simulation_success_ = false;
+    return;
+  }
+  // The DPI models stop their threads and close their host endpoints, which
+  // each test reopens for itself.
+  for (const ForkHooks &hooks : fork_hooks_) {
+    if (hooks.prepare) {
+      hooks.prepare(hooks.ctx);
+    }
+  }
+  if (!CheckTestServerForkable()) {
+    FinishRun();
+    simulation_success_ = false;
+    return;
+  }
+
+  std::cout << "Running " << tests.size() << " tests from cycle " << fork_cycle
+            << ", " << test_jobs_ << " at a time." << std::endl;
+  // Don't let the children print what is still buffered.
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(nullptr);
+  stats_stream_.flush();
+
+  // The wait status of each test, or -1 if it did not run.
+  std::vector<int> results(tests.size(), -1);
+  std::map<pid_t, size_t> running;
+  size_t next = 0;
+  while (true) {
+    if (next < tests.size() && running.size() < test_jobs_ && !request_stop_) {
+      pid_t pid = fork();
+      if (pid == 0) {
+        RunServerTest(tests[next].first, tests[next].second);
+      }
+      if (pid < 0) {
+        perror("ERROR: fork");
+        break;
+      }
+      running[pid] = next++;
+      continue;
+    }
+    if (running.empty()) {
+      break;
+    }
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("ERROR: waitpid");
+      break;
+    }
+    auto it = running.find(pid);
+    if (it == running.end()) {
+      continue;
+    }
+    results[it->second] = status;
+    std::cout << (WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "PASSED "
+                                                                 : "FAILED ")
+              << tests[it->second].first << std::endl;
+    running.erase(it);
   }
+
+  FinishRun();
+
+  size_t num_passed = 0;
+  std::cout << std::endl
+            << "Test results" << std::endl
+            << "============" << std::endl;
+  for (size_t i = 0; i < tests.size(); ++i) {
+    int status = results[i];
+    std::cout << tests[i].first << ": ";
+    if (status == -1) {
+      std::cout << "not run" << std::endl;
+    } else if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+      std::cout << "passed" << std::endl;
+      ++num_passed;
+    } else if (WIFEXITED(status)) {
+      std::cout << "failed with exit code " << WEXITSTATUS(status)
+                << std::endl;
+    } else {
+      std::cout << "failed with signal " << WTERMSIG(status) << std::endl;
+    }
+  }
+  std::cout << num_passed << " of " << tests.size() << " tests passed."
+            << std::endl;
+
+  if (num_passed != tests.size()) {
+    simulation_success_ = false;
+  }
+}
+
+void VerilatorSimCtrl::RunServerTest(const std::string &name,
+                                     const std::vector<std::string> &args) {
+  // Each test writes its log, and its trace if any, to a directory of its own.
+  if (mkdir(name.c_str(), 0777) != 0 && errno != EEXIST) {
+    perror(("ERROR: " + name).c_str());
+    _exit(1);
+  }
+  int fd = open((name + "/sim.log").c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                0666);
+  if (fd < 0) {
+    perror(("ERROR: " + name + "/sim.log").c_str());
+    _exit(1);
+  }
+  dup2(fd, STDOUT_FILENO);
+  dup2(fd, STDERR_FILENO);
+  close(fd);
+
+  // Apply the arguments of the test, e.g. to load its flash image. Paths are
+  // relative to the directory the server was started in.
+  std::vector<char *> argv;
+  argv.push_back(const_cast<char *>(name.c_str()));
+  for (const std::string &arg : args) {
+    argv.push_back(const_cast<char *>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  // The stream of the parent is reopened in the test directory, if the test
+  // streams samples at all.
+  stats_stream_.close();
+  test_list_path_.clear();
+  optind = 1;
+  bool exit_app = false;
+  if (!ParseCommandArgs(argv.size() - 1, argv.data(), exit_app) || exit_app ||
+      chdir(name.c_str()) != 0) {
+    std::cout.flush();
+    _exit(1);
+  }
+  for (const ForkHooks &hooks : fork_hooks_) {
+    if (hooks.child) {
+      hooks.child(hooks.ctx);
+    }
+  }
+
+  std::cout << "Running test " << name << " from cycle " << time_ / 2
+            << std::endl;
+  time_begin_ = std::chrono::steady_clock::now();
+  StartStats();
+  RunUntil(0);
+  FinishRun();
+  for (auto it = extension_array_.begin(); it != extension_array_.end(); ++it) {
+    (*it)->PostExec();
+  }
+  PrintStatistics();
+  WriteStats();
+
+  std::cout.flush();
+  fflush(nullptr);
+  // Unlike a single simulation, a test that times out has not passed.
+  _exit(WasSimulationSuccessful() && !timeout_reached_ ? 0 : 1);
+}
+
+// Get the name of the class of an extension, for the names of its statistics
+static std::string GetExtensionName(const SimCtrlExtension *ext) {
+  const char *mangled = typeid(*ext).name();
+  int status;
+  char *demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+  std::string name(status == 0 ? demangled : mangled);
+  free(demangled);
+  return name;
+}
+
+void VerilatorSimCtrl::StartStats() {
+  VerilatorSimStats &stats = VerilatorSimStats::GetInstance();
+  if (!stats.Enabled()) {
+    return;
+  }
+
+  stats_eval_ = stats.GetTimer("sim.eval");
+  stats_trace_ = stats.GetTimer("sim.trace");
+  stats_on_clock_.clear();
+  for (const SimCtrlExtension *ext : extension_array_) {
+    stats_on_clock_.push_back(
+        stats.GetTimer("on_clock." + GetExtensionName(ext)));
+  }
+
+  stats_samples_.clear();
+  stats_sample_cycle_ = time_ / 2;
+  stats_sample_time_ = time_begin_;
+  stats_next_sample_cycle_ = stats_sample_cycle_ + stats_interval_;
+
+  if (!stats_stream_path_.empty()) {
+    stats_stream_.open(stats_stream_path_);
+    if (!stats_stream_) {
+      std::cerr << "WARNING: Could not open the statistics stream `"
+                << stats_stream_path_ << "'." << std::endl;
+    }
+  }
+}
+
+void VerilatorSimCtrl::SampleStats(unsigned long cycle) {
+  auto now = std::chrono::steady_clock::now();
+  double wallclock_s =
+      std::chrono::duration<double>(now - time_begin_).count();
+  double interval_s =
+      std::chrono::duration<double>(now - stats_sample_time_).count();
+  double speed_khz = 0.0;
+  if (interval_s > 0.0) {
+    speed_khz = (cycle - stats_sample_cycle_) / interval_s / 1000.0;
+  }
+
+  std::ostringstream sample;
+  sample << "{\"cycle\": " << cycle << ", \"wallclock_s\": " << wallclock_s
+         << ", \"speed_khz\": " << speed_khz << "}";
+  stats_samples_.push_back(sample.str());
+  if (stats_stream_.is_open()) {
+    // Flush every sample, so the stream can be followed with tail -f.
+    stats_stream_ << stats_samples_.back() << std::endl;
+  }
+
+  stats_sample_cycle_ = cycle;
+  stats_sample_time_ = now;
+  stats_next_sample_cycle_ = cycle + stats_interval_;
+}
+
+void VerilatorSimCtrl::WriteStats() const {
+  if (stats_path_.empty()) {
+    return;
+  }
+
+  std::ofstream file;
+  if (stats_path_ != "-") {
+    file.open(stats_path_);
+    if (!file) {
+      std::cerr << "ERROR: Could not write the statistics to `" << stats_path_
+                << "'." << std::endl;
+      return;
+    }
+  }
+  std::ostream &os = stats_path_ == "-" ? std::cout : file;
+
+  double wallclock_s = GetExecutionTimeMs() / 1000.0;
+  os << "{\"cycles\": " << time_ / 2 << ", \"wallclock_s\": " << wallclock_s
+     << ", \"speed_khz\": "
+     << (wallclock_s > 0.0 ? time_ / 2 / wallclock_s / 1000.0 : 0.0) << ", ";
+  VerilatorSimStats::GetInstance().WriteJson(os);
+  os << ", \"samples\": [";
+  const char *sep = "";
+  for (const std::string &sample : stats_samples_) {
+    os << sep << sample;
+    sep = ", ";
+  }
+  os << "]}" << std::endl;
 }
 
 std::string VerilatorSimCtrl::GetName() const {
@@ -460,10 +1134,31 @@ void VerilatorSimCtrl::Trace() {
     return;
   }
 
+  // In ring mode, start a new segment once the current one is full and delete
+  // the one before the previous segment. This keeps at least the last
+  // trace_ring_cycles_ cycles without buffering them in memory, which the
+  // Verilator trace writers do not support.
+  if (trace_ring_cycles_ && tracer_.isOpen() &&
+      GetTime() / 2 - trace_segment_start_cycle_ >= trace_ring_cycles_) {
+    tracer_.close();
+    if (trace_segment_ > 0) {
+      std::remove(GetTraceSegmentFileName(trace_segment_ - 1).c_str());
+    }
+    trace_segment_++;
+  }
+
   if (!tracer_.isOpen()) {
     tracer_.open(GetTraceFileName().c_str());
-    std::cout << "Writing simulation traces to " << GetTraceFileName()
-              << std::endl;
+    trace_segment_start_cycle_ = GetTime() / 2;
+    if (!trace_ring_cycles_) {
+      std::cout << "Writing simulation traces to " << GetTraceFileName()
+                << std::endl;
+    } else if (trace_segment_ == 0) {
+      std::cout << "Writing the last " << trace_ring_cycles_
+                << " cycles of the simulation traces to "
+                << GetTraceSegmentFileName(0) << " and following segments"
+                << std::endl;
+    }
   }
 
   tracer_.dump(GetTime());
@@ -5,7 +5,10 @@
 #ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
 #define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_CTRL_H_
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <vector>
 
@@ -75,7 +78,7 @@ class VerilatorSimCtrl {
    * 1. Sets up a signal handler to enable tracing to be turned on/off during
    *    a run by sending SIGUSR1 to the process
    * 2. Prints some tracer-related helper messages
-   * 3. Runs the simulation
+   * 3. Runs the simulation, or the tests of the test list if one was given
    * 4. Prints some further helper messages and statistics once the simulation
    *    has run to completion
    */
@@ -108,6 +111,9 @@ class VerilatorSimCtrl {
 
   /**
    * Request the simulation to stop
+   *
+   * This may be called from DPI code and from signal handlers. The simulation
+   * stops after the current clock edge has been evaluated.
    */
   void RequestStop(bool simulation_success);
 
@@ -116,11 +122,50 @@ class VerilatorSimCtrl {
    */
   void RegisterExtension(SimCtrlExtension *ext);
 
+  /**
+   * Register the fork hooks of a DPI model
+   *
+   * In test server mode, the prepare hooks are called once before the tests
+   * are forked off, and the child hooks in each test, in the directory of the
+   * test. See dpi_fork.h.
+   *
+   * @param ctx context of the model, passed to the hooks
+   * @param prepare hook that stops the threads and closes the host endpoints
+   * @param child hook that reopens them in a test
+   */
+  void RegisterForkHooks(void *ctx, void (*prepare)(void *),
+                         void (*child)(void *));
+
+  /**
+   * Unregister the fork hooks of a DPI model
+   */
+  void UnregisterForkHooks(void *ctx);
+
   /**
    * Get the current time in ticks
    */
   unsigned long GetTime() const { return time_; }
 
+  /**
+   * Enable tracing (if possible)
+   *
+   * Enabling tracing can fail if no tracing support has been compiled into the
+   * simulation. This may be called from DPI code and from signal handlers, and
+   * takes effect at the next clock edge.
+   *
+   * @return Is tracing enabled?
+   */
+  bool TraceOn();
+
+  /**
+   * Disable tracing
+   *
+   * This may be called from DPI code and from signal handlers.
+   *
+   * @return Is tracing enabled?
+   */
+  bool TraceOff();
+
  private:
   VerilatedToplevel *top_;
   CData *sig_clk_;
@@ -132,15 +177,55 @@ class VerilatorSimCtrl {
   bool tracing_enabled_changed_;
   bool tracing_ever_enabled_;
   bool tracing_possible_;
+  // Cycles at which tracing is switched on and off, 0 if unset.
+  unsigned long trace_start_cycle_;
+  unsigned long trace_end_cycle_;
+  // In ring mode, the trace is split into segments of this many cycles of
+  // which only the last two are kept, 0 if disabled.
+  unsigned long trace_ring_cycles_;
+  unsigned long trace_segment_;
+  unsigned long trace_segment_start_cycle_;
+  bool timeout_reached_;
+  // Test server mode: the file with one test per line, the cycle at which the
+  // tests are forked off (0 for the end of reset) and the maximum number of
+  // tests running at the same time.
+  std::string test_list_path_;
+  unsigned long test_fork_cycle_;
+  unsigned long test_jobs_;
+  // Statistics: the file the JSON summary is written to ("-" for stdout), the
+  // file samples are streamed to, and the number of cycles between samples.
+  // Both files are empty if unset.
+  std::string stats_path_;
+  std::string stats_stream_path_;
+  unsigned long stats_interval_;
+  unsigned long stats_next_sample_cycle_;
+  unsigned long stats_sample_cycle_;
+  std::chrono::steady_clock::time_point stats_sample_time_;
+  std::vector<std::string> stats_samples_;
+  std::ofstream stats_stream_;
+  // Timers of the main loop, nullptr if statistics are not collected. The
+  // OnClock() timers are in the order of extension_array_.
+  uint64_t *stats_eval_;
+  uint64_t *stats_trace_;
+  std::vector<uint64_t *> stats_on_clock_;
   unsigned int initial_reset_delay_cycles_;
   unsigned int reset_duration_cycles_;
-  volatile unsigned int request_stop_;
-  volatile bool simulation_success_;
+  // Set by the signal handler and by DPI code, which may run on one of
+  // Verilator's worker threads in a multi-threaded model.
+  std::atomic<bool> request_stop_;
+  std::atomic<bool> simulation_success_;
   std::chrono::steady_clock::time_point time_begin_;
   std::chrono::steady_clock::time_point time_end_;
   VerilatedTracer tracer_;
   unsigned long term_after_cycles_;
   std::vector<SimCtrlExtension *> extension_array_;
+  // Fork hooks of the DPI models, in the order they were registered.
+  struct ForkHooks {
+    void *ctx;
+    void (*prepare)(void *);
+    void (*child)(void *);
+  };
+  std::vector<ForkHooks> fork_hooks_;
 
   /**
    * Default constructor
@@ -166,23 +251,6 @@ class VerilatorSimCtrl {
    */
   void PrintHelp() const;
 
-  /**
-   * Enable tracing (if possible)
-   *
-   * Enabling tracing can fail if no tracing support has been compiled into the
-   * simulation.
-   *
-   * @return Is tracing enabled?
-   */
-  bool TraceOn();
-
-  /**
-   * Disable tracing
-   *
-   * @return Is tracing enabled?
-   */
-  bool TraceOff();
-
   /**
    * Is tracing currently enabled?
    */
@@ -207,9 +275,24 @@ class VerilatorSimCtrl {
 
   /**
    * Get the file name of the trace file
+   *
+   * In ring mode, this is the file name of the current trace segment.
    */
   std::string GetTraceFileName() const;
 
+  /**
+   * Get the file name of a trace segment in ring mode
+   */
+  std::string GetTraceSegmentFileName(unsigned long segment) const;
+
+  /**
+   * Keep or delete the remaining trace segments at the end of a run in ring
+   * mode
+   *
+   * The segments are only kept if the simulation failed or timed out.
+   */
+  void FinishTraceRing();
+
   /**
    * Run the main loop of the simulation
    *
@@ -217,6 +300,77 @@ class VerilatorSimCtrl {
    */
   void Run();
 
+  /**
+   * Set up tracing and evaluate the initial blocks of the design
+   */
+  void StartRun();
+
+  /**
+   * Run the main loop of the simulation until it finishes or, if stop_cycle
+   * is not zero, until just before the rising clock edge of that cycle
+   *
+   * @return true if the simulation finished
+   */
+  bool RunUntil(unsigned long stop_cycle);
+
+  /**
+   * Finish the simulation and close the trace
+   */
+  void FinishRun();
+
+  /**
+   * Run the tests of the test list in forked copies of the simulation
+   *
+   * The simulation runs up to the fork cycle once, and each test then
+   * continues from a copy-on-write copy of that state in a child process,
+   * which applies the test's own arguments first. At most test_jobs_ children
+   * run at the same time.
+   */
+  void RunTestServer();
+
+  /**
+   * Check that the simulation can be forked for the tests
+   *
+   * Called after the prepare hooks of the DPI models. The process must have a
+   * single thread, and must not have any host endpoints open if several tests
+   * run at the same time, which catches models without fork hooks.
+   *
+   * @return false, after printing the reason, if it cannot be forked
+   */
+  bool CheckTestServerForkable() const;
+
+  /**
+   * Continue the simulation as a child process for one test, and exit
+   */
+  [[noreturn]] void RunServerTest(const std::string &name,
+                                  const std::vector<std::string> &args);
+
+  /**
+   * Read the test list
+   *
+   * @return false if the file could not be read
+   */
+  bool ReadTestList(
+      std::vector<std::pair<std::string, std::vector<std::string>>> *tests)
+      const;
+
+  /**
+   * Look up the timers of the main loop and open the sample stream
+   *
+   * Does nothing if statistics are not collected.
+   */
+  void StartStats();
+
+  /**
+   * Record the simulation speed since the last sample
+   */
+  void SampleStats(unsigned long cycle);
+
+  /**
+   * Write the statistics as JSON if requested
+   */
+  void WriteStats() const;
+
   /**
    * Get a name for this simulation
    *
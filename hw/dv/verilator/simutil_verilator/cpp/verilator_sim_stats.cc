@@ -0,0 +1,67 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "verilator_sim_stats.h"
+
+/**
+ * Get the call counter of a DPI model
+ *
+ * This overrides the weak declaration in dpi_stats.h, through which DPI models
+ * written in C count their calls.
+ */
+extern "C" uint64_t *dpi_stats_counter(const char *model) {
+  return VerilatorSimStats::GetInstance().GetCounter(std::string("dpi.") +
+                                                     model);
+}
+
+VerilatorSimStats &VerilatorSimStats::GetInstance() {
+  static VerilatorSimStats instance;
+  return instance;
+}
+
+uint64_t *VerilatorSimStats::GetCounter(const std::string &name) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  return &counters_[name];
+}
+
+uint64_t *VerilatorSimStats::GetTimer(const std::string &name) {
+  if (!enabled_) {
+    return nullptr;
+  }
+  return &timers_[name];
+}
+
+// Write a JSON string, escaping the characters that need it in names
+static void WriteJsonString(std::ostream &os, const std::string &str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+void VerilatorSimStats::WriteJson(std::ostream &os) const {
+  os << "\"counters\": {";
+  const char *sep = "";
+  for (const auto &counter : counters_) {
+    os << sep;
+    WriteJsonString(os, counter.first);
+    os << ": " << counter.second;
+    sep = ", ";
+  }
+  os << "}, \"timers_s\": {";
+  sep = "";
+  for (const auto &timer : timers_) {
+    os << sep;
+    WriteJsonString(os, timer.first);
+    os << ": " << timer.second / 1e9;
+    sep = ", ";
+  }
+  os << "}";
+}
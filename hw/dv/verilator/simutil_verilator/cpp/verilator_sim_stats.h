@@ -0,0 +1,103 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_STATS_H_
+#define OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_STATS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+/**
+ * Named counters and timers of a simulation
+ *
+ * VerilatorSimCtrl enables the statistics with --stats. Until then, and in
+ * simulations that do not enable them, GetCounter() and GetTimer() return
+ * nullptr, which the users of the statistics take as a request to not collect
+ * them, so that the hot paths of the simulation only pay for a test against
+ * nullptr.
+ */
+class VerilatorSimStats {
+ public:
+  /**
+   * Get the statistics instance
+   */
+  static VerilatorSimStats &GetInstance();
+
+  VerilatorSimStats(VerilatorSimStats const &) = delete;
+  void operator=(VerilatorSimStats const &) = delete;
+
+  /**
+   * Start collecting statistics
+   */
+  void Enable() { enabled_ = true; }
+
+  /**
+   * Are statistics collected?
+   */
+  bool Enabled() const { return enabled_; }
+
+  /**
+   * Get a counter, creating it if necessary
+   *
+   * @return a counter that stays valid for the rest of the simulation, or
+   *         nullptr if statistics are not collected
+   */
+  uint64_t *GetCounter(const std::string &name);
+
+  /**
+   * Get a timer accumulating nanoseconds, creating it if necessary
+   *
+   * @return a timer that stays valid for the rest of the simulation, or
+   *         nullptr if statistics are not collected
+   */
+  uint64_t *GetTimer(const std::string &name);
+
+  /**
+   * Write the counters and timers as the members "counters" and "timers_s" of
+   * a JSON object
+   */
+  void WriteJson(std::ostream &os) const;
+
+ private:
+  bool enabled_;
+  // Values of a std::map keep their address when other values are inserted.
+  std::map<std::string, uint64_t> counters_;
+  std::map<std::string, uint64_t> timers_;
+
+  VerilatorSimStats() : enabled_(false) {}
+};
+
+/**
+ * Add the lifetime of this object to a timer of VerilatorSimStats
+ *
+ * Does nothing if the timer is nullptr.
+ */
+class ScopedSimStatsTimer {
+ public:
+  explicit ScopedSimStatsTimer(uint64_t *timer) : timer_(timer) {
+    if (timer_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedSimStatsTimer() {
+    if (timer_) {
+      *timer_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     std::chrono::steady_clock::now() - start_)
+                     .count();
+    }
+  }
+
+  ScopedSimStatsTimer(ScopedSimStatsTimer const &) = delete;
+  void operator=(ScopedSimStatsTimer const &) = delete;
+
+ private:
+  uint64_t *timer_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#endif  // OPENTITAN_HW_DV_VERILATOR_SIMUTIL_VERILATOR_CPP_VERILATOR_SIM_STATS_H_
@@ -0,0 +1,83 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Detects when the chip is quiescent, i.e. the core sleeps in WFI and the rest of the chip is
+// idle, and reports the number of cycles until the next event of the enabled timers to the
+// VerilatorFastForward simulation extension. If the extension decides to fast-forward,
+// fast_forward_o stops the clocks of all but the domain of the timers for that many cycles, so
+// that the simulation only evaluates the timers until shortly before they wake up the core.
+module verilator_fast_forward #(
+  parameter int unsigned NumTimers = 1,
+  // Number of cycles the chip must be quiescent before it is reported as such, to let
+  // outstanding work settle.
+  parameter int unsigned MinQuiescentCycles = 16
+) (
+  input  logic                       clk_i,
+  input  logic                       rst_ni,
+  // The core is sleeping
+  input  logic                       core_sleep_i,
+  // The buses and peripherals outside of the timers' clock domain are idle
+  input  logic                       idle_i,
+  // Enabled timers and the number of clk_i cycles until their next event
+  input  logic [NumTimers-1:0]       timer_en_i,
+  input  logic [NumTimers-1:0][63:0] timer_cycles_i,
+  // Stop all clocks but the one of the timers
+  output logic                       fast_forward_o
+);
+
+  import "DPI-C" function
+    longint verilator_fast_forward_enter(input longint next_event);
+  import "DPI-C" function
+    void verilator_fast_forward_exit();
+
+  logic quiescent;
+  assign quiescent = rst_ni & core_sleep_i & idle_i & |timer_en_i;
+
+  logic [63:0] next_event;
+  always_comb begin
+    next_event = '1;
+    for (int i = 0; i < NumTimers; i++) begin
+      if (timer_en_i[i] && timer_cycles_i[i] < next_event) begin
+        next_event = timer_cycles_i[i];
+      end
+    end
+  end
+
+  // The inputs other than the timers do not change while the clocks are stopped, so the chip
+  // stays quiescent until skip_cycles has counted down.
+  logic [31:0] quiescent_cycles;
+  logic [63:0] skip_cycles;
+  logic        reported;
+
+  always_ff @(posedge clk_i or negedge rst_ni) begin
+    if (!rst_ni) begin
+      // A reset ends the quiescent period like any other event.
+      if (reported) begin
+        verilator_fast_forward_exit();
+      end
+      reported         <= 1'b0;
+      quiescent_cycles <= '0;
+      skip_cycles      <= '0;
+    end else if (!quiescent) begin
+      if (reported) begin
+        verilator_fast_forward_exit();
+      end
+      reported         <= 1'b0;
+      quiescent_cycles <= '0;
+      skip_cycles      <= '0;
+    end else if (!reported) begin
+      if (quiescent_cycles == MinQuiescentCycles) begin
+        reported    <= 1'b1;
+        skip_cycles <= verilator_fast_forward_enter(next_event);
+      end else begin
+        quiescent_cycles <= quiescent_cycles + 1;
+      end
+    end else if (skip_cycles != '0) begin
+      skip_cycles <= skip_cycles - 1;
+    end
+  end
+
+  assign fast_forward_o = reported & (skip_cycles != '0);
+
+endmodule
@@ -0,0 +1,27 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Forwards the words that software writes to the log bypass address to the
+// VerilatorSwLogger simulation extension, which decodes them into log messages.
+module verilator_sw_logger (
+  input logic        clk_i,
+  input logic        rst_ni,
+  input logic        wr_valid,
+  input logic [31:0] addr,
+  input logic [31:0] data
+);
+
+  import "DPI-C" function
+    void verilator_sw_logger_write(input int data);
+
+  // Log bypass address - set by the testbench.
+  logic [31:0] sw_log_addr;
+
+  always_ff @(posedge clk_i) begin
+    if (rst_ni && wr_valid && addr == sw_log_addr) begin
+      verilator_sw_logger_write(data);
+    end
+  end
+
+endmodule
@@ -0,0 +1,37 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Forwards the test status and the mailbox requests that software writes to the sim SRAM to the
+// VerilatorSwMailbox simulation extension, which ends the simulation as soon as a terminal test
+// status is written and serves the requests on the host. The extension writes its responses back
+// into the sim SRAM, from where software reads them.
+module verilator_sw_mailbox (
+  input logic        clk_i,
+  input logic        rst_ni,
+  input logic        wr_valid,
+  input logic [31:0] addr,
+  input logic [31:0] data
+);
+
+  import "DPI-C" function
+    void verilator_sw_mailbox_status(input int status);
+  import "DPI-C" function
+    void verilator_sw_mailbox_write(input int offset, input int data);
+
+  // Test status and mailbox addresses - set by the testbench. Software writes the command to the
+  // mailbox address and the command's arguments to the word after it.
+  logic [31:0] sw_test_status_addr;
+  logic [31:0] sw_mailbox_addr;
+
+  always_ff @(posedge clk_i) begin
+    if (rst_ni && wr_valid) begin
+      if (addr == sw_test_status_addr) begin
+        verilator_sw_mailbox_status({16'h0, data[15:0]});
+      end else if (addr == sw_mailbox_addr || addr == sw_mailbox_addr + 4) begin
+        verilator_sw_mailbox_write(addr - sw_mailbox_addr, data);
+      end
+    end
+  end
+
+endmodule
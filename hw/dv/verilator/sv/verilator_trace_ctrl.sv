@@ -0,0 +1,27 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+//
+// Lets software switch waveform tracing on and off: a write of a non-zero value
+// to the trace control address enables tracing, a write of zero disables it.
+module verilator_trace_ctrl (
+  input logic        clk_i,
+  input logic        rst_ni,
+  input logic        wr_valid,
+  input logic [31:0] addr,
+  input logic [31:0] data
+);
+
+  import "DPI-C" function
+    void verilator_sim_ctrl_trace(input int enable);
+
+  // Trace control address - set by the testbench.
+  logic [31:0] trace_ctrl_addr;
+
+  always_ff @(posedge clk_i) begin
+    if (rst_ni && wr_valid && addr == trace_ctrl_addr) begin
+      verilator_sim_ctrl_trace(data);
+    end
+  end
+
+endmodule
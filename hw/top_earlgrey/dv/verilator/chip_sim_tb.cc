@@ -8,12 +8,17 @@
 #include <vector>
 
 #include "verilated_toplevel.h"
+#include "verilator_fast_forward.h"
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
+#include "verilator_sw_logger.h"
+#include "verilator_sw_mailbox.h"
 
 int main(int argc, char **argv) {
   chip_sim_tb top;
   VerilatorMemUtil memutil;
+  VerilatorSwLogger sw_logger;
+  VerilatorFastForward fast_forward;
   VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
   simctrl.SetTop(&top, &top.clk_i, &top.rst_ni,
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
@@ -43,12 +48,19 @@ int main(int argc, char **argv) {
 
   MemArea otp(top_scope + ".u_otp_macro." + ram1p_adv_scope, 0x4000 / 4, 4);
 
+  // The mailbox writes its responses into the sim SRAM.
+  MemArea sim_sram("TOP.chip_sim_tb.u_sim_sram.gen_sram_inst.u_sram", 8, 4);
+  VerilatorSwMailbox sw_mailbox(&sim_sram);
+
   memutil.RegisterMemoryArea("rom0", 0x8000, &rom0);
   memutil.RegisterMemoryArea("ram", 0x10000000u, &ram);
   memutil.RegisterMemoryArea("flash0", 0x20000000u, &flash0);
   memutil.RegisterMemoryArea("flash1", 0x20080000u, &flash1);
   memutil.RegisterMemoryArea("otp", 0x40000000u /* (bogus LMA) */, &otp);
   simctrl.RegisterExtension(&memutil);
+  simctrl.RegisterExtension(&sw_logger);
+  simctrl.RegisterExtension(&sw_mailbox);
+  simctrl.RegisterExtension(&fast_forward);
 
   // The initial reset delay must be long enough such that pwr/rst/clkmgr will
   // release clocks to the entire design.  This allows for synchronous resets
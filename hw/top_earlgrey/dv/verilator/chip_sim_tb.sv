@@ -26,9 +26,12 @@ module chip_sim_tb (
   logic cio_usbdev_dp_p2d, cio_usbdev_dp_d2p, cio_usbdev_dp_en_d2p;
   logic cio_usbdev_dn_p2d, cio_usbdev_dn_d2p, cio_usbdev_dn_en_d2p;
 
+  logic fast_forward;
+
   chip_earlgrey_verilator u_dut (
     .clk_i,
     .rst_ni,
+    .fast_forward_i(fast_forward),
 
     // communication with GPIO
     .cio_gpio_p2d_i(cio_gpio_p2d),
@@ -166,8 +169,11 @@ module chip_sim_tb (
   `define RV_CORE_IBEX      u_dut.top_earlgrey.u_rv_core_ibex
   `define SIM_SRAM_IF       u_sim_sram.u_sim_sram_if
 
-  // Detect SW test termination.
-  sim_sram u_sim_sram (
+  // Detect SW test termination. Software reads the responses of the mailbox from the SRAM.
+  sim_sram #(
+    .InstantiateSram(1'b1),
+    .ErrOnRead      (1'b0)
+  ) u_sim_sram (
     .clk_i    (`RV_CORE_IBEX.clk_i),
     .rst_ni   (`RV_CORE_IBEX.rst_ni),
     .tl_in_i  (tlul_pkg::tl_h2d_t'(`RV_CORE_IBEX.u_tlul_req_buf.out_o)),
@@ -192,18 +198,104 @@ module chip_sim_tb (
     .data     (`SIM_SRAM_IF.tl_h2d.a_data[15:0])
   );
 
+  // Forward software logs written to the log bypass address to the VerilatorSwLogger extension.
+  verilator_sw_logger u_sw_logger (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
+  // Let software switch waveform tracing on and off.
+  verilator_trace_ctrl u_trace_ctrl (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
+  // End the simulation as soon as software writes a terminal test status, and serve the requests
+  // of software written to the mailbox.
+  verilator_sw_mailbox u_sw_mailbox (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
   // Set the start address of the simulation SRAM.
-  // Use offset 0 within the sim SRAM for SW test status indication.
+  // Use offset 0 within the sim SRAM for SW test status indication, offset 4 for the
+  // software log bypass, offset 8 for trace control and offsets 12 to 24 for the mailbox.
   initial begin
     `SIM_SRAM_IF.start_addr = `VERILATOR_TEST_STATUS_ADDR;
     u_sw_test_status_if.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
+    u_sw_logger.sw_log_addr = `SIM_SRAM_IF.start_addr + 4;
+    u_trace_ctrl.trace_ctrl_addr = `SIM_SRAM_IF.start_addr + 8;
+    u_sw_mailbox.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
+    u_sw_mailbox.sw_mailbox_addr = `SIM_SRAM_IF.start_addr + 12;
   end
 
+  // Fast-forward to the next AON timer event while Ibex waits for an interrupt and the rest of
+  // the chip is idle. The rv_timer runs on a stopped clock, so it must not be active. A WFI with
+  // the low power hint set is not fast-forwarded, since pwrmgr then sequences the clocks and
+  // resets of the domains that would be stopped. Stimulus from the host (uartdpi, gpiodpi and
+  // spidpi input) is not supported: it is not seen while the clocks are stopped.
+  `define TOP u_dut.top_earlgrey
+
+  aon_timer_reg_pkg::aon_timer_reg2hw_t aon_timer_regs;
+  assign aon_timer_regs = `TOP.u_aon_timer_aon.reg2hw;
+
+  logic [63:0] wkup_count, wkup_thold;
+  assign wkup_count = {aon_timer_regs.wkup_count_hi.q, aon_timer_regs.wkup_count_lo.q};
+  assign wkup_thold = {aon_timer_regs.wkup_thold_hi.q, aon_timer_regs.wkup_thold_lo.q};
+
+  // Cycles of clk_i until the wakeup timer fires and the watchdog barks or bites. The AON clock
+  // runs at a quarter of clk_i, see chip_earlgrey_verilator.sv.
+  logic [2:0]       ff_timer_en;
+  logic [2:0][63:0] ff_timer_cycles;
+  assign ff_timer_en = {{2{aon_timer_regs.wdog_ctrl.enable.q}}, aon_timer_regs.wkup_ctrl.enable.q};
+  assign ff_timer_cycles[0] = wkup_thold > wkup_count ?
+      (wkup_thold - wkup_count) * (64'(aon_timer_regs.wkup_ctrl.prescaler.q) + 1) * 4 : '0;
+  assign ff_timer_cycles[1] = aon_timer_regs.wdog_bark_thold.q > aon_timer_regs.wdog_count.q ?
+      64'(aon_timer_regs.wdog_bark_thold.q - aon_timer_regs.wdog_count.q) * 4 : '0;
+  assign ff_timer_cycles[2] = aon_timer_regs.wdog_bite_thold.q > aon_timer_regs.wdog_count.q ?
+      64'(aon_timer_regs.wdog_bite_thold.q - aon_timer_regs.wdog_count.q) * 4 : '0;
+
+  logic ff_idle;
+  assign ff_idle = ~`TOP.main_tl_rv_core_ibex__corei_req.a_valid &
+                   ~`TOP.main_tl_rv_core_ibex__cored_req.a_valid &
+                   (`TOP.clkmgr_aon_idle == {4{prim_mubi_pkg::MuBi4True}}) &
+                   `TOP.u_uart0.hw2reg.status.txidle.d &
+                   ~`TOP.u_rv_timer.reg2hw.ctrl[0].q &
+                   (`TOP.u_pwrmgr_aon.u_fsm.state_q == pwrmgr_pkg::FastPwrStateActive) &
+                   ~`TOP.u_pwrmgr_aon.low_power_hint;
+
+  verilator_fast_forward #(
+    .NumTimers(3)
+  ) u_fast_forward (
+    .clk_i,
+    .rst_ni,
+    .core_sleep_i  (`TOP.rv_core_ibex_pwrmgr.core_sleeping),
+    .idle_i        (ff_idle),
+    .timer_en_i    (ff_timer_en),
+    .timer_cycles_i(ff_timer_cycles),
+    .fast_forward_o(fast_forward)
+  );
+
+  `undef TOP
+
   always @(posedge clk_i) begin
     if (u_sw_test_status_if.sw_test_done) begin
       $display("Verilator sim termination requested");
       $display("Your simulation wrote to 0x%h", u_sw_test_status_if.sw_test_status_addr);
       dv_test_status_pkg::dv_test_status(u_sw_test_status_if.sw_test_passed);
+      // Let VerilatorSimCtrl exit with an error code, e.g. for its test server mode.
+      if (!u_sw_test_status_if.sw_test_passed) begin
+        $error("Software test failed");
+      end
       $finish;
     end
   end
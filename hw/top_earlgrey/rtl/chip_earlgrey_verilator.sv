@@ -7,6 +7,9 @@ module chip_earlgrey_verilator (
   input clk_i,
   input rst_ni,
 
+  // Stops the clocks of all but the AON domain, see verilator_fast_forward.sv
+  input fast_forward_i,
+
   // communication with GPIO
   input [31:0] cio_gpio_p2d_i,
   output logic [31:0] cio_gpio_d2p_o,
@@ -236,6 +239,18 @@ module chip_earlgrey_verilator (
     .clk_o(clk_aon)
   );
 
+  // The clock of the main, IO and USB domains, which the testbench stops while the chip waits for
+  // the next AON timer event to skip ahead to it.
+  logic clk_ff;
+  prim_clock_gating #(
+    .NoFpgaGate(1'b1)
+  ) u_fast_forward_cg (
+    .clk_i,
+    .en_i(~fast_forward_i),
+    .test_en_i(1'b0),
+    .clk_o(clk_ff)
+  );
+
   ast_pkg::clks_osc_byp_t clks_osc_byp;
   assign clks_osc_byp = '{
     usb: clk_i,
@@ -501,9 +516,9 @@ module chip_earlgrey_verilator (
   ) top_earlgrey (
     // update por / reset connections, this is not quite right here
     .por_n_i                      (por_n                ),
-    .clk_main_i                   (clk_i                ),
-    .clk_io_i                     (clk_i                ),
-    .clk_usb_i                    (clk_i                ),
+    .clk_main_i                   (clk_ff               ),
+    .clk_io_i                     (clk_ff               ),
+    .clk_usb_i                    (clk_ff               ),
     .clk_aon_i                    (clk_aon              ),
     // change the above
     .clks_ast_o                   (clkmgr_aon_clocks    ),
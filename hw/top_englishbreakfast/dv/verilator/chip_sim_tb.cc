@@ -7,10 +7,13 @@
 #include "verilated_toplevel.h"
 #include "verilator_memutil.h"
 #include "verilator_sim_ctrl.h"
+#include "verilator_sw_logger.h"
+#include "verilator_sw_mailbox.h"
 
 int main(int argc, char **argv) {
   chip_sim_tb top;
   VerilatorMemUtil memutil;
+  VerilatorSwLogger sw_logger;
   VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
   simctrl.SetTop(&top, &top.clk_i, &top.rst_ni,
                  VerilatorSimCtrlFlags::ResetPolarityNegative);
@@ -29,10 +32,16 @@ int main(int argc, char **argv) {
                      "gen_prim_flash_banks[0].u_prim_flash_bank.u_mem",
                  0x100000 / 8, 8);
 
+  // The mailbox writes its responses into the sim SRAM.
+  MemArea sim_sram("TOP.chip_sim_tb.u_sim_sram.gen_sram_inst.u_sram", 8, 4);
+  VerilatorSwMailbox sw_mailbox(&sim_sram);
+
   memutil.RegisterMemoryArea("rom", 0x8000, &rom);
   memutil.RegisterMemoryArea("ram", 0x10000000u, &ram);
   memutil.RegisterMemoryArea("flash0", 0x20000000u, &flash0);
   simctrl.RegisterExtension(&memutil);
+  simctrl.RegisterExtension(&sw_logger);
+  simctrl.RegisterExtension(&sw_mailbox);
 
   // see chip_earlgrey_verilator.cc for justification and explanation
   simctrl.SetInitialResetDelay(1000);
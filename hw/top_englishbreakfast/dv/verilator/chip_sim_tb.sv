@@ -323,8 +323,11 @@ module chip_sim_tb (
   `define RV_CORE_IBEX      top_englishbreakfast.u_rv_core_ibex
   `define SIM_SRAM_IF       u_sim_sram.u_sim_sram_if
 
-  // Detect SW test termination.
-  sim_sram u_sim_sram (
+  // Detect SW test termination. Software reads the responses of the mailbox from the SRAM.
+  sim_sram #(
+    .InstantiateSram(1'b1),
+    .ErrOnRead      (1'b0)
+  ) u_sim_sram (
     .clk_i    (`RV_CORE_IBEX.clk_i),
     .rst_ni   (`RV_CORE_IBEX.rst_ni),
     .tl_in_i  (tlul_pkg::tl_h2d_t'(`RV_CORE_IBEX.u_tlul_req_buf.out_o)),
@@ -346,11 +349,44 @@ module chip_sim_tb (
     .data     (`SIM_SRAM_IF.tl_h2d.a_data[15:0])
   );
 
+  // Forward software logs written to the log bypass address to the VerilatorSwLogger extension.
+  verilator_sw_logger u_sw_logger (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
+  // Let software switch waveform tracing on and off.
+  verilator_trace_ctrl u_trace_ctrl (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
+  // End the simulation as soon as software writes a terminal test status, and serve the requests
+  // of software written to the mailbox.
+  verilator_sw_mailbox u_sw_mailbox (
+    .clk_i    (`SIM_SRAM_IF.clk_i),
+    .rst_ni   (`SIM_SRAM_IF.rst_ni),
+    .wr_valid (`SIM_SRAM_IF.wr_valid),
+    .addr     (`SIM_SRAM_IF.tl_h2d.a_address),
+    .data     (`SIM_SRAM_IF.tl_h2d.a_data)
+  );
+
   // Set the start address of the simulation SRAM.
-  // Use offset 0 within the sim SRAM for SW test status indication.
+  // Use offset 0 within the sim SRAM for SW test status indication, offset 4 for the
+  // software log bypass, offset 8 for trace control and offsets 12 to 24 for the mailbox.
   initial begin
     `SIM_SRAM_IF.start_addr = `VERILATOR_TEST_STATUS_ADDR;
     u_sw_test_status_if.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
+    u_sw_logger.sw_log_addr = `SIM_SRAM_IF.start_addr + 4;
+    u_trace_ctrl.trace_ctrl_addr = `SIM_SRAM_IF.start_addr + 8;
+    u_sw_mailbox.sw_test_status_addr = `SIM_SRAM_IF.start_addr;
+    u_sw_mailbox.sw_mailbox_addr = `SIM_SRAM_IF.start_addr + 12;
   end
 
   always @(posedge clk_i) begin
@@ -358,6 +394,10 @@ module chip_sim_tb (
       $display("Verilator sim termination requested");
       $display("Your simulation wrote to 0x%h", u_sw_test_status_if.sw_test_status_addr);
       dv_test_status_pkg::dv_test_status(u_sw_test_status_if.sw_test_passed);
+      // Let VerilatorSimCtrl exit with an error code, e.g. for its test server mode.
+      if (!u_sw_test_status_if.sw_test_passed) begin
+        $error("Software test failed");
+      end
       $finish;
     end
   end
@@ -72,4 +72,11 @@ uintptr_t device_test_status_address(void) {
   return rv_core_ibex_base() + RV_CORE_IBEX_DV_SIM_WINDOW_REG_OFFSET;
 }
 
-uintptr_t device_log_bypass_uart_address(void) { return 0; }
+uintptr_t device_log_bypass_uart_address(void) {
+#ifdef OT_SIM_VERILATOR_LOG_BYPASS
+  // Decoded by `VerilatorSwLogger` in hw/dv/verilator/cpp.
+  return device_test_status_address() + 0x04;
+#else
+  return 0;
+#endif
+}
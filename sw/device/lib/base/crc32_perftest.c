@@ -15,6 +15,27 @@
 
 OTTF_DEFINE_TEST_CONFIG();
 
+/**
+ * Buffer sizes for the throughput sweep, in bytes.
+ */
+static const size_t kSweepLens[] = {16, 64, 256, 1024, 4096};
+
+/**
+ * Log the throughput of a CRC32 run in bytes per 1000 cycles.
+ *
+ * @param name Label of the measured code path.
+ * @param len Number of bytes processed.
+ * @param num_cycles Number of cycles taken.
+ */
+static void log_throughput(const char *name, size_t len, uint64_t num_cycles) {
+  CHECK(num_cycles <= UINT32_MAX && num_cycles > 0);
+  const uint32_t num_cycles_u32 = (uint32_t)num_cycles;
+  const uint32_t bytes_per_kcycle =
+      (uint32_t)(((uint64_t)len * 1000) / num_cycles_u32);
+  LOG_INFO("%s: %d bytes in %d cycles (%d bytes/kcycle).", name, len,
+           num_cycles_u32, bytes_per_kcycle);
+}
+
 bool test_main(void) {
   uint8_t buf[4096];
   for (size_t i = 0; i < ARRAYSIZE(buf); ++i) {
@@ -39,5 +60,34 @@ bool test_main(void) {
       return false;
     }
   }
+
+  // Compare the bulk `crc32_add` path against feeding the same data byte by
+  // byte, for aligned and misaligned buffers.
+  for (size_t i = 0; i < ARRAYSIZE(kSweepLens); ++i) {
+    for (size_t offset = 0; offset < 2; ++offset) {
+      const size_t len = kSweepLens[i] - offset;
+      const uint8_t *data = &buf[offset];
+
+      uint32_t ctx;
+      crc32_init(&ctx);
+      uint64_t start_cycles = ibex_mcycle_read();
+      crc32_add(&ctx, data, len);
+      uint64_t end_cycles = ibex_mcycle_read();
+      const uint32_t bulk_crc = crc32_finish(&ctx);
+      log_throughput(offset == 0 ? "crc32_add (aligned)"
+                                 : "crc32_add (misaligned)",
+                     len, end_cycles - start_cycles);
+
+      crc32_init(&ctx);
+      start_cycles = ibex_mcycle_read();
+      for (size_t j = 0; j < len; ++j) {
+        crc32_add8(&ctx, data[j]);
+      }
+      end_cycles = ibex_mcycle_read();
+      log_throughput("crc32_add8", len, end_cycles - start_cycles);
+
+      CHECK(crc32_finish(&ctx) == bulk_crc);
+    }
+  }
   return true;
 }
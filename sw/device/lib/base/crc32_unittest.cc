@@ -6,6 +6,7 @@
 
 #include <cstring>
 #include <stdint.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -87,5 +88,64 @@ TEST_F(CrcTest, Crc32Add32) {
   EXPECT_EQ(crc32_finish(&ctx), kExpCrc);
 }
 
+/**
+ * Bit-serial CRC32 used as a reference for the table-driven implementation.
+ */
+uint32_t ReferenceCrc32(const uint8_t *data, size_t len) {
+  uint32_t crc = UINT32_MAX;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (size_t j = 0; j < 8; ++j) {
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+  }
+  return crc ^ UINT32_MAX;
+}
+
+TEST_F(CrcTest, MatchesReferenceAllLengthsAndAlignments) {
+  // Cover the byte-wise head and tail and the slicing-by-8 body.
+  std::vector<uint8_t> buf(300 + sizeof(uint64_t));
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<uint8_t>(i * 131 + 7);
+  }
+  for (size_t offset = 0; offset < sizeof(uint64_t); ++offset) {
+    for (size_t len = 0; len + offset <= buf.size(); ++len) {
+      const uint8_t *data = buf.data() + offset;
+      EXPECT_EQ(crc32(data, len), ReferenceCrc32(data, len))
+          << "offset: " << offset << ", length: " << len;
+    }
+  }
+}
+
+TEST_F(CrcTest, EveryTableEntry) {
+  // A single non-zero byte at each position of the first two slicing-by-8
+  // chunks looks up every entry of every table.
+  alignas(uint64_t) uint8_t buf[2 * sizeof(uint64_t)];
+  for (size_t pos = 0; pos < sizeof(buf); ++pos) {
+    for (uint32_t val = 0; val <= UINT8_MAX; ++val) {
+      std::memset(buf, 0, sizeof(buf));
+      buf[pos] = static_cast<uint8_t>(val);
+      EXPECT_EQ(crc32(buf, sizeof(buf)), ReferenceCrc32(buf, sizeof(buf)))
+          << "position: " << pos << ", value: " << val;
+    }
+  }
+}
+
+TEST_F(CrcTest, Crc32AddSplit) {
+  // Feeding a buffer in two pieces must give the same result as one call.
+  std::vector<uint8_t> buf(256);
+  for (size_t i = 0; i < buf.size(); ++i) {
+    buf[i] = static_cast<uint8_t>(i);
+  }
+  const uint32_t exp_crc = ReferenceCrc32(buf.data(), buf.size());
+  for (size_t split = 0; split <= buf.size(); ++split) {
+    uint32_t ctx;
+    crc32_init(&ctx);
+    crc32_add(&ctx, buf.data(), split);
+    crc32_add(&ctx, buf.data() + split, buf.size() - split);
+    EXPECT_EQ(crc32_finish(&ctx), exp_crc) << "split: " << split;
+  }
+}
+
 }  // namespace
 }  // namespace crc32_unittest
@@ -58,6 +58,124 @@ static uint32_t repeat_byte_to_u32(uint8_t byte) {
   return word << 24 | word << 16 | word << 8 | word;
 }
 
+enum {
+  /**
+   * Number of words handled per iteration of the unrolled loops.
+   */
+  kUnrollWords = 4,
+  /**
+   * Number of bytes handled per iteration of the unrolled loops.
+   */
+  kUnrollBytes = kUnrollWords * sizeof(uint32_t),
+};
+
+/**
+ * Find the bytes of a word that are zero.
+ *
+ * With Zbb, this is a single `orc.b`. Otherwise, it uses the exact (no false
+ * positives) variant of the "has zero byte" bit trick.
+ *
+ * @param word Input word.
+ * @return A word that is nonzero exactly in the bytes where `word` is zero.
+ */
+static inline uint32_t zero_byte_mask(uint32_t word) {
+#ifdef __riscv_zbb
+  uint32_t nonzero_bytes;
+  asm("orc.b %0, %1" : "=r"(nonzero_bytes) : "r"(word));
+  return ~nonzero_bytes;
+#else
+  return ~(((word & 0x7f7f7f7f) + 0x7f7f7f7f) | word | 0x7f7f7f7f);
+#endif
+}
+
+/**
+ * Index of the lowest-addressed nonzero byte of a `zero_byte_mask` result.
+ *
+ * @param mask Nonzero mask.
+ * @return Byte index in [0, 3].
+ */
+static inline size_t first_marked_byte(uint32_t mask) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "first_marked_byte assumes that the system is little endian.");
+#if defined(__riscv_zbb) || !defined(OT_PLATFORM_RV32)
+  return (size_t)__builtin_ctz(mask) / 8;
+#else
+  if ((mask & 0xff) != 0) {
+    return 0;
+  }
+  if ((mask & 0xff00) != 0) {
+    return 1;
+  }
+  if ((mask & 0xff0000) != 0) {
+    return 2;
+  }
+  return 3;
+#endif
+}
+
+/**
+ * Index of the highest-addressed nonzero byte of a `zero_byte_mask` result.
+ *
+ * @param mask Nonzero mask.
+ * @return Byte index in [0, 3].
+ */
+static inline size_t last_marked_byte(uint32_t mask) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "last_marked_byte assumes that the system is little endian.");
+#if defined(__riscv_zbb) || !defined(OT_PLATFORM_RV32)
+  return 3 - (size_t)__builtin_clz(mask) / 8;
+#else
+  if ((mask & 0xff000000) != 0) {
+    return 3;
+  }
+  if ((mask & 0xff0000) != 0) {
+    return 2;
+  }
+  if ((mask & 0xff00) != 0) {
+    return 1;
+  }
+  return 0;
+#endif
+}
+
+/**
+ * Copy from a source that is not word-aligned to a word-aligned destination.
+ *
+ * Reads whole aligned words from the source and merges neighbouring words
+ * with shifts, so that every load and store is a word access. Only aligned
+ * source words that lie entirely inside the buffer are read; the first partial
+ * word is assembled byte by byte and the remaining tail is left to the caller.
+ *
+ * @param dest8 Word-aligned destination.
+ * @param src8 Source with a nonzero misalignment.
+ * @param len Number of bytes available in both buffers.
+ * @return Number of bytes copied (a multiple of the word size).
+ */
+static size_t memcpy_shift_merge(unsigned char *dest8,
+                                 const unsigned char *src8, size_t len) {
+  const size_t misalignment = OT_UNSIGNED(misalignment32_of((uintptr_t)src8));
+  const size_t head = sizeof(uint32_t) - misalignment;
+  const unsigned shift_right = (unsigned)misalignment * 8;
+  const unsigned shift_left = 32 - shift_right;
+
+  // `carry` holds the source bytes belonging to the next destination word that
+  // come from the current aligned source word, in the low bytes.
+  uint32_t carry = 0;
+  for (size_t i = 0; i < head && i < len; ++i) {
+    carry |= (uint32_t)src8[i] << (8 * i);
+  }
+  const unsigned char *src_aligned = src8 + head;
+
+  size_t copied = 0;
+  for (; copied + head + sizeof(uint32_t) <= len;
+       copied += sizeof(uint32_t)) {
+    uint32_t next = read_32(&src_aligned[copied]);
+    write_32(carry | (next << shift_left), &dest8[copied]);
+    carry = next >> shift_right;
+  }
+  return copied;
+}
+
 void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
                                     const void *restrict src, size_t len) {
   if (dest == NULL || src == NULL) {
@@ -65,12 +183,36 @@ void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
   }
   unsigned char *dest8 = (unsigned char *)dest;
   const unsigned char *src8 = (const unsigned char *)src;
+  if (len >= kUnrollBytes && misalignment32_of((uintptr_t)dest) !=
+                                 misalignment32_of((uintptr_t)src)) {
+    // Align the destination, then merge shifted source words.
+    size_t i = 0;
+    for (; misalignment32_of((uintptr_t)&dest8[i]) != 0; ++i) {
+      dest8[i] = src8[i];
+    }
+    i += memcpy_shift_merge(&dest8[i], &src8[i], len - i);
+    for (; i < len; ++i) {
+      dest8[i] = src8[i];
+    }
+    return dest;
+  }
+
   size_t body_offset, tail_offset;
   compute_alignment(dest, src, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     dest8[i] = src8[i];
   }
+  for (; i + kUnrollBytes <= tail_offset; i += kUnrollBytes) {
+    uint32_t word0 = read_32(&src8[i]);
+    uint32_t word1 = read_32(&src8[i + 4]);
+    uint32_t word2 = read_32(&src8[i + 8]);
+    uint32_t word3 = read_32(&src8[i + 12]);
+    write_32(word0, &dest8[i]);
+    write_32(word1, &dest8[i + 4]);
+    write_32(word2, &dest8[i + 8]);
+    write_32(word3, &dest8[i + 12]);
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
     uint32_t word = read_32(&src8[i]);
     write_32(word, &dest8[i]);
@@ -92,6 +234,12 @@ void *OT_PREFIX_IF_NOT_RV32(memset)(void *dest, int value, size_t len) {
     dest8[i] = value8;
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
+  for (; i + kUnrollBytes <= tail_offset; i += kUnrollBytes) {
+    write_32(value32, &dest8[i]);
+    write_32(value32, &dest8[i + 4]);
+    write_32(value32, &dest8[i + 8]);
+    write_32(value32, &dest8[i + 12]);
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
     write_32(value32, &dest8[i]);
   }
@@ -121,6 +269,17 @@ int OT_PREFIX_IF_NOT_RV32(memcmp)(const void *lhs, const void *rhs,
       return kMemCmpGt;
     }
   }
+  // Skip over equal chunks quickly; the word loop below locates the
+  // difference in the first chunk that does not match.
+  for (; i + kUnrollBytes <= tail_offset; i += kUnrollBytes) {
+    uint32_t diff = (read_32(&lhs8[i]) ^ read_32(&rhs8[i])) |
+                    (read_32(&lhs8[i + 4]) ^ read_32(&rhs8[i + 4])) |
+                    (read_32(&lhs8[i + 8]) ^ read_32(&rhs8[i + 8])) |
+                    (read_32(&lhs8[i + 12]) ^ read_32(&rhs8[i + 12]));
+    if (diff != 0) {
+      break;
+    }
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
 #if OT_BUILD_FOR_STATIC_ANALYZER
     assert(&lhs8[i] != NULL);
@@ -201,21 +360,9 @@ void *OT_PREFIX_IF_NOT_RV32(memchr)(const void *ptr, int value, size_t len) {
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
   for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word = read_32(&ptr8[i]);
-    uint32_t bits_eq = ~(word ^ value32);
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memchr assumes that the system is little endian.");
-    if ((bits_eq & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i];
-    }
-    if (((bits_eq >> 8) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 1];
-    }
-    if (((bits_eq >> 16) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 2];
-    }
-    if (((bits_eq >> 24) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 3];
+    uint32_t match = zero_byte_mask(read_32(&ptr8[i]) ^ value32);
+    if (match != 0) {
+      return (void *)&ptr8[i + first_marked_byte(match)];
     }
   }
   for (; i < len; ++i) {
@@ -243,21 +390,9 @@ void *OT_PREFIX_IF_NOT_RV32(memrchr)(const void *ptr, int value, size_t len) {
   const uint32_t value32 = repeat_byte_to_u32(value8);
   for (; end > body_offset; end -= sizeof(uint32_t)) {
     const size_t i = end - sizeof(uint32_t);
-    uint32_t word = read_32(&ptr8[i]);
-    uint32_t bits_eq = ~(word ^ value32);
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memrchr assumes that the system is little endian.");
-    if (((bits_eq >> 24) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 3];
-    }
-    if (((bits_eq >> 16) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 2];
-    }
-    if (((bits_eq >> 8) & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i + 1];
-    }
-    if ((bits_eq & UINT8_MAX) == UINT8_MAX) {
-      return (void *)&ptr8[i];
+    uint32_t match = zero_byte_mask(read_32(&ptr8[i]) ^ value32);
+    if (match != 0) {
+      return (void *)&ptr8[i + last_marked_byte(match)];
     }
   }
   for (; end > 0; --end) {
@@ -218,7 +218,57 @@ static const perf_test_t kPerfTests[] = {
 static uint8_t buf1[kBufLen];
 static uint8_t buf2[kBufLen];
 
+// Buffer sizes for the size/alignment sweep. Each must leave room for the
+// largest offset within `kBufLen`.
+static const size_t kSweepLens[] = {16, 64, 256, 992};
+
+typedef struct sweep_test {
+  // A human-readable name for the function under test.
+  const char *label;
+  // The function under test; same contract as `perf_test_t.func`.
+  void (*func)(uint8_t *buf1, uint8_t *buf2, size_t len);
+} sweep_test_t;
+
+static const sweep_test_t kSweepTests[] = {
+    {.label = "memcpy", .func = &test_memcpy},
+    {.label = "memset", .func = &test_memset},
+    {.label = "memcmp", .func = &test_memcmp},
+    {.label = "memchr", .func = &test_memchr},
+    {.label = "memrchr", .func = &test_memrchr},
+};
+
+/**
+ * Log the cycle counts of each function per buffer size and alignment.
+ *
+ * `buf1` is offset by 0-3 bytes and `buf2` is kept word-aligned, so that the
+ * misaligned paths (e.g. the shift-and-merge copy in `memcpy`) are covered.
+ * These numbers are informational only and do not affect the test result.
+ */
+static void run_sweep(void) {
+  for (size_t i = 0; i < ARRAYSIZE(kSweepTests); ++i) {
+    for (size_t j = 0; j < ARRAYSIZE(kSweepLens); ++j) {
+      for (size_t offset = 0; offset < sizeof(uint32_t); ++offset) {
+        const size_t len = kSweepLens[j];
+        CHECK(len + offset <= kBufLen);
+        fill_buf_zeroes(buf1, kBufLen);
+        fill_buf_zeroes(buf2, kBufLen);
+
+        uint64_t start_cycles = ibex_mcycle_read();
+        kSweepTests[i].func(&buf1[offset], buf2, len);
+        uint64_t end_cycles = ibex_mcycle_read();
+
+        const uint64_t num_cycles = end_cycles - start_cycles;
+        CHECK(num_cycles < UINT32_MAX);
+        LOG_INFO("%s: len=%4d offset=%d: %6d cycles", kSweepTests[i].label,
+                 len, offset, (uint32_t)num_cycles);
+      }
+    }
+  }
+}
+
 bool test_main(void) {
+  run_sweep();
+
   bool all_expectations_match = true;
   for (size_t i = 0; i < ARRAYSIZE(kPerfTests); ++i) {
     const perf_test_t *test = &kPerfTests[i];
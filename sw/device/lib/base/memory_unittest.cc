@@ -193,6 +193,35 @@ TEST_P(MemCpyTest, VaryDestAlignment) {
   }
 }
 
+TEST_P(MemCpyTest, AllAlignmentsAndLengths) {
+  auto memcpy_func = GetParam();
+
+  // Exercise the unrolled body and the shift-and-merge path for misaligned
+  // buffers, and check that no byte outside the destination range is touched.
+  static constexpr size_t kMaxLen = 80;
+  static constexpr size_t kMaxOffset = 8;
+  std::vector<uint8_t> src(kMaxLen + kMaxOffset);
+  for (size_t i = 0; i < src.size(); ++i) {
+    src[i] = static_cast<uint8_t>(i + 1);
+  }
+
+  for (size_t src_offset = 0; src_offset < kMaxOffset; ++src_offset) {
+    for (size_t dest_offset = 0; dest_offset < kMaxOffset; ++dest_offset) {
+      for (size_t len = 0; len <= kMaxLen; ++len) {
+        SCOPED_TRACE(testing::Message()
+                     << "src_offset=" << src_offset
+                     << " dest_offset=" << dest_offset << " len=" << len);
+        std::vector<uint8_t> dest(kMaxLen + 2 * kMaxOffset, 0xee);
+        memcpy_func(&dest[dest_offset], &src[src_offset], len);
+
+        std::vector<uint8_t> expected(dest.size(), 0xee);
+        std::copy_n(&src[src_offset], len, &expected[dest_offset]);
+        ASSERT_EQ(dest, expected);
+      }
+    }
+  }
+}
+
 TEST_P(MemCmpTest, NullParam) {
   auto memcmp_func = GetParam();
 
@@ -217,6 +246,31 @@ TEST_P(MemCmpTest, ZeroesVaryingOffsetsAndLengths) {
   }
 }
 
+TEST_P(MemCmpTest, LongBuffersDifferAtEachPosition) {
+  auto memcmp_func = GetParam();
+
+  const bool reverse = memcmp_func == &memrcmp || memcmp_func == &ref_memrcmp;
+
+  static constexpr size_t kLen = 64;
+  alignas(uint32_t) uint8_t xs[kLen] = {0};
+  for (size_t pos = 0; pos < kLen; ++pos) {
+    SCOPED_TRACE(testing::Message() << "pos=" << pos);
+    alignas(uint32_t) uint8_t ys[kLen] = {0};
+    ys[pos] = 1;
+    // A second, larger difference further along the comparison order must not
+    // change the result.
+    if (!reverse && pos + 1 < kLen) {
+      xs[kLen - 1] = 2;
+    } else if (reverse && pos > 0) {
+      xs[0] = 2;
+    }
+    EXPECT_LT(memcmp_func(xs, ys, kLen), 0);
+    EXPECT_GT(memcmp_func(ys, xs, kLen), 0);
+    xs[0] = 0;
+    xs[kLen - 1] = 0;
+  }
+}
+
 TEST_P(MemSetTest, Null) {
   auto memset_func = GetParam();
 
@@ -329,6 +383,34 @@ TEST_P(MemChrTest, VaryingLengths) {
   }
 }
 
+TEST_P(MemChrTest, EachPositionAndAlignment) {
+  auto memchr_func = GetParam();
+
+  const bool reverse =
+      memchr_func == &ot_memrchr || memchr_func == &ref_memrchr;
+
+  // Place the needle (and a decoy copy on the far side) at every position for
+  // every start alignment. Neighbouring bytes differ from the needle in a
+  // single bit, so a sloppy zero-byte test would report false positives.
+  static constexpr size_t kLen = 40;
+  static constexpr uint8_t kNeedle = 0x80;
+  for (size_t offset = 0; offset < sizeof(uint32_t); ++offset) {
+    for (size_t pos = 0; pos < kLen; ++pos) {
+      SCOPED_TRACE(testing::Message() << "offset=" << offset << " pos=" << pos);
+      alignas(uint32_t) uint8_t buf[kLen + sizeof(uint32_t)];
+      std::fill_n(buf, sizeof(buf), kNeedle ^ 0x01);
+      uint8_t *data = buf + offset;
+      data[pos] = kNeedle;
+      if (!reverse && pos + 1 < kLen) {
+        data[kLen - 1] = kNeedle;
+      } else if (reverse && pos > 0) {
+        data[0] = kNeedle;
+      }
+      EXPECT_EQ(memchr_func(data, kNeedle, kLen), data + pos);
+    }
+  }
+}
+
 TEST_P(MemChrTest, RepeatedBytes) {
   auto memchr_func = GetParam();
 
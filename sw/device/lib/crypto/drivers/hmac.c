@@ -26,6 +26,23 @@ static inline uint32_t hmac_base(void) {
   return dt_hmac_primary_reg_block(kHmacDt);
 }
 
+/**
+ * Whether owner tracking is enabled for streaming operations.
+ *
+ * See `hmac_owner_tracking_set`.
+ */
+static hardened_bool_t owner_tracking = kHardenedBoolFalse;
+
+/**
+ * Streaming context whose state is currently live in the HMAC block.
+ *
+ * Only ever non-NULL when `owner_tracking` is enabled. The pointer is used
+ * solely for identity comparisons and is never dereferenced. Since another
+ * context can later occupy the same address, `context_resume` also checks the
+ * saved digest of the context against the block.
+ */
+static const hmac_ctx_t *owner = NULL;
+
 OT_ASSERT_ENUM_VALUE(HMAC_KEY_1_REG_OFFSET, HMAC_KEY_0_REG_OFFSET + 4);
 OT_ASSERT_ENUM_VALUE(HMAC_KEY_2_REG_OFFSET, HMAC_KEY_1_REG_OFFSET + 4);
 OT_ASSERT_ENUM_VALUE(HMAC_KEY_3_REG_OFFSET, HMAC_KEY_2_REG_OFFSET + 4);
@@ -300,6 +317,66 @@ static void context_save(hmac_ctx_t *ctx) {
   ctx->upper = abs_mmio_read32(hmac_base() + HMAC_MSG_LENGTH_UPPER_REG_OFFSET);
 }
 
+/**
+ * Release the HMAC block from the streaming context that currently owns it.
+ *
+ * No-op if no context is live in the hardware.
+ *
+ * @return Result of the operation.
+ */
+static status_t owner_release(void) {
+  if (owner != NULL) {
+    owner = NULL;
+    HARDENED_TRY(clear());
+  }
+  return OTCRYPTO_OK;
+}
+
+/**
+ * Check that the digest registers hold the saved digest of `ctx`.
+ *
+ * @param ctx Context object to compare with.
+ * @return `kHardenedBoolTrue` if the digests match.
+ */
+static hardened_bool_t digest_matches(const hmac_ctx_t *ctx) {
+  uint32_t digest[kHmacMaxDigestWords];
+  digest_read(digest, kHmacMaxDigestWords);
+  return hardened_memeq(digest, ctx->H, kHmacMaxDigestWords);
+}
+
+/**
+ * Resume a streaming operation, skipping the restore if possible.
+ *
+ * If `ctx` is the context that was last left in the hardware (see
+ * `hmac_owner_tracking_set`) and the configuration, message length and digest
+ * registers still match it, the block only needs a `continue` command.
+ * Otherwise, this falls back to `context_restore`.
+ *
+ * @param ctx Context object to resume.
+ * @return Result of the operation.
+ */
+static status_t context_resume(hmac_ctx_t *ctx) {
+  const uint32_t kBase = hmac_base();
+  if (launder32(owner_tracking) == kHardenedBoolTrue && owner == ctx &&
+      (ctx->lower != 0 || ctx->upper != 0) &&
+      abs_mmio_read32(kBase + HMAC_CFG_REG_OFFSET) == ctx->cfg_reg &&
+      abs_mmio_read32(kBase + HMAC_MSG_LENGTH_LOWER_REG_OFFSET) ==
+          ctx->lower &&
+      abs_mmio_read32(kBase + HMAC_MSG_LENGTH_UPPER_REG_OFFSET) ==
+          ctx->upper &&
+      launder32(digest_matches(ctx)) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(owner_tracking, kHardenedBoolTrue);
+    uint32_t cmd = bitfield_bit32_write(HMAC_CMD_REG_RESVAL,
+                                        HMAC_CMD_HASH_CONTINUE_BIT, 1);
+    abs_mmio_write32(kBase + HMAC_CMD_REG_OFFSET, cmd);
+    return OTCRYPTO_OK;
+  }
+
+  // `context_restore` clears the block, so no context is live anymore.
+  owner = NULL;
+  return context_restore(ctx);
+}
+
 /**
  * Wipes the ctx struct by replacing sensitive data with randomness from the
  * Ibex EDN interface. Non-sensitive variables are zeroized.
@@ -427,6 +504,9 @@ static status_t oneshot(const uint32_t cfg, const hmac_key_t *key,
   // Make sure that the entropy complex is configured correctly.
   HARDENED_TRY(entropy_complex_check());
 
+  // Evict any streaming context that is still live in the block.
+  HARDENED_TRY(owner_release());
+
   // Configure the HMAC block.
   abs_mmio_write32(hmac_base() + HMAC_CFG_REG_OFFSET, cfg);
 
@@ -742,9 +822,9 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   size_t len_rem = len % block_bytelen;
   size_t leftover_len = (ctx->partial_block_bytelen + len_rem) % block_bytelen;
 
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
-  HARDENED_TRY(context_restore(ctx));
+  // Resume will restore the context (unless it is still live in the block)
+  // and also hit start or continue button as necessary.
+  HARDENED_TRY(context_resume(ctx));
 
   // Write the partial block, then the new bytes.
   HARDENED_TRY(msg_fifo_write((unsigned char *)ctx->partial_block,
@@ -765,6 +845,15 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len) {
   memcpy(ctx->partial_block, data + (len - leftover_len), leftover_len);
   ctx->partial_block_bytelen = leftover_len;
 
+  // With owner tracking, leave the state in the block so that the next update
+  // of the same stream can skip the restore. The saved context stays valid in
+  // case another stream takes over in between.
+  if (launder32(owner_tracking) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(owner_tracking, kHardenedBoolTrue);
+    owner = ctx;
+    return OTCRYPTO_OK;
+  }
+
   // Clean up.
   HARDENED_TRY(clear());
   return OTCRYPTO_OK;
@@ -774,9 +863,10 @@ status_t hmac_final(hmac_ctx_t *ctx, uint32_t *digest) {
   // Make sure that the entropy complex is configured correctly.
   HARDENED_TRY(entropy_complex_check());
 
-  // Retore context will restore the context and also hit start or continue
-  // button as necessary.
-  HARDENED_TRY(context_restore(ctx));
+  // Resume will restore the context (unless it is still live in the block)
+  // and also hit start or continue button as necessary.
+  HARDENED_TRY(context_resume(ctx));
+  owner = NULL;
 
   // Feed the final leftover bytes to HMAC HWIP.
   HARDENED_TRY(msg_fifo_write((unsigned char *)ctx->partial_block,
@@ -798,3 +888,14 @@ status_t hmac_final(hmac_ctx_t *ctx, uint32_t *digest) {
   HARDENED_TRY(clear());
   return OTCRYPTO_OK;
 }
+
+status_t hmac_owner_tracking_set(hardened_bool_t enable) {
+  if (enable != kHardenedBoolTrue && enable != kHardenedBoolFalse) {
+    return OTCRYPTO_BAD_ARGS;
+  }
+  // Wipe whatever is left in the block before changing modes, so that
+  // disabling the mode restores the clear-after-every-call behaviour.
+  HARDENED_TRY(owner_release());
+  owner_tracking = enable;
+  return OTCRYPTO_OK;
+}
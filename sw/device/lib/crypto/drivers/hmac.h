@@ -339,6 +339,33 @@ status_t hmac_update(hmac_ctx_t *ctx, const uint8_t *data, size_t len);
 OT_WARN_UNUSED_RESULT
 status_t hmac_final(hmac_ctx_t *ctx, uint32_t *digest);
 
+/**
+ * Enable or disable owner tracking for streaming operations.
+ *
+ * By default, `hmac_update` restores the context into the HMAC block, feeds
+ * the message, saves the context back and clears the block on every call. With
+ * owner tracking enabled, the driver remembers which context was last left in
+ * the block and does not clear it after an update; a subsequent update or
+ * final call on the same context then only issues a `continue` command instead
+ * of rewriting the configuration, key, digest and length registers. Any other
+ * context, or a one-shot operation, evicts the owner with a full clear first.
+ * Contexts are told apart by their address and their saved digest, so a new
+ * context at the address of the owner is restored as well.
+ *
+ * The context is still saved after every update, so streams may be
+ * interleaved freely. The tradeoff is that the key and intermediate digest of
+ * the owning stream stay in the HMAC block between calls instead of being
+ * wiped, so only enable this where that is acceptable.
+ *
+ * Disabling owner tracking clears the block if a context is live.
+ *
+ * @param enable `kHardenedBoolTrue` to enable, `kHardenedBoolFalse` to
+ * disable.
+ * @return OK or error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t hmac_owner_tracking_set(hardened_bool_t enable);
+
 #ifdef __cplusplus
 }
 #endif
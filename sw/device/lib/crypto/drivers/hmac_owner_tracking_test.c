@@ -0,0 +1,116 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "hw/top/dt/hmac.h"
+#include "sw/device/lib/base/abs_mmio.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/drivers/hmac.h"
+#include "sw/device/lib/crypto/impl/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+#include "hw/top/hmac_regs.h"  // Generated.
+
+enum {
+  // Length of each message chunk, a multiple of the SHA-256 block size so
+  // that every update reaches the hardware.
+  kChunkBytes = 2 * kHmacSha256BlockBytes,
+};
+
+static uint8_t msg_a[2 * kChunkBytes];
+static uint8_t msg_b[2 * kChunkBytes];
+
+/**
+ * Builds an HMAC-SHA256 key whose block is filled with `fill`.
+ */
+static hmac_key_t key_make(uint32_t fill) {
+  hmac_key_t key = {.key_len = kHmacSha256BlockWords};
+  for (size_t i = 0; i < kHmacSha256BlockWords; ++i) {
+    key.key_block[i] = fill ^ i;
+  }
+  key.checksum = hmac_key_integrity_checksum(&key);
+  return key;
+}
+
+static uint32_t hmac_reg_read(uint32_t offset) {
+  return abs_mmio_read32(dt_hmac_primary_reg_block(kDtHmac) + offset);
+}
+
+/**
+ * A stream that only ever resumes itself takes the CONTINUE-only path: the
+ * block keeps its state between updates and the tag is still correct.
+ */
+static status_t continue_only_test(void) {
+  hmac_key_t key = key_make(0xa5a5a5a5);
+  uint32_t expected[kHmacSha256DigestWords];
+  TRY(hmac_hmac_sha256(&key, msg_a, sizeof(msg_a), expected));
+
+  TRY(hmac_owner_tracking_set(kHardenedBoolTrue));
+  hmac_ctx_t ctx;
+  hmac_hmac_sha256_init(key, &ctx);
+  TRY(hmac_update(&ctx, msg_a, kChunkBytes));
+  // The block was left populated for the next update of this stream.
+  TRY_CHECK(hmac_reg_read(HMAC_MSG_LENGTH_LOWER_REG_OFFSET) == ctx.lower);
+  TRY_CHECK(ctx.lower != 0);
+  TRY(hmac_update(&ctx, &msg_a[kChunkBytes], kChunkBytes));
+  uint32_t tag[kHmacSha256DigestWords];
+  TRY(hmac_final(&ctx, tag));
+  TRY(hmac_owner_tracking_set(kHardenedBoolFalse));
+
+  TRY_CHECK_ARRAYS_EQ(tag, expected, ARRAYSIZE(expected));
+  return OK_STATUS();
+}
+
+/**
+ * A different context at the address of the live one, with the same
+ * configuration and message length, must not resume the state in the block.
+ */
+static status_t eviction_test(void) {
+  hmac_key_t key_a = key_make(0x3c3c3c3c);
+  hmac_key_t key_b = key_make(0xc3c3c3c3);
+  uint32_t expected[kHmacSha256DigestWords];
+  TRY(hmac_hmac_sha256(&key_b, msg_b, sizeof(msg_b), expected));
+
+  TRY(hmac_owner_tracking_set(kHardenedBoolTrue));
+
+  // Take a snapshot of stream B after its first chunk.
+  hmac_ctx_t ctx_b;
+  hmac_hmac_sha256_init(key_b, &ctx_b);
+  TRY(hmac_update(&ctx_b, msg_b, kChunkBytes));
+  hmac_ctx_t snapshot = ctx_b;
+
+  // Make stream A live in the block, then replace it with the snapshot of B
+  // in place. Only the digests tell them apart.
+  hmac_ctx_t ctx;
+  hmac_hmac_sha256_init(key_a, &ctx);
+  TRY(hmac_update(&ctx, msg_a, kChunkBytes));
+  TRY_CHECK(ctx.cfg_reg == snapshot.cfg_reg && ctx.lower == snapshot.lower &&
+            ctx.upper == snapshot.upper);
+  memcpy(&ctx, &snapshot, sizeof(ctx));
+
+  TRY(hmac_update(&ctx, &msg_b[kChunkBytes], kChunkBytes));
+  uint32_t tag[kHmacSha256DigestWords];
+  TRY(hmac_final(&ctx, tag));
+  TRY(hmac_owner_tracking_set(kHardenedBoolFalse));
+
+  TRY_CHECK_ARRAYS_EQ(tag, expected, ARRAYSIZE(expected));
+  return OK_STATUS();
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+
+bool test_main(void) {
+  CHECK_STATUS_OK(entropy_complex_init());
+  for (size_t i = 0; i < sizeof(msg_a); ++i) {
+    msg_a[i] = (uint8_t)i;
+    msg_b[i] = (uint8_t)(3 * i + 1);
+  }
+
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, continue_only_test);
+  EXECUTE_TEST(result, eviction_test);
+  return status_ok(result);
+}
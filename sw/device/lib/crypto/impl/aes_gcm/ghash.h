@@ -80,6 +80,44 @@ typedef struct ghash_context {
   uint32_t checksum;
 } ghash_context_t;
 
+enum {
+  /**
+   * Number of entries in a product table of the fast GHASH engine.
+   *
+   * The fast engine uses 8-bit windows, so each table has one entry per
+   * possible byte value.
+   */
+  kGhashFastTableNumEntries = 1 << 8,
+  /**
+   * Number of blocks the fast GHASH engine aggregates per reduction chain.
+   */
+  kGhashFastAggregateNumBlocks = 2,
+};
+
+/**
+ * Context for the fast (unmasked) GHASH engine.
+ *
+ * This engine trades memory for speed: it keeps 8-bit window product tables
+ * for both H and H^2 (8KiB in total), which allows it to process two blocks
+ * with a single shift-and-reduce chain. It does not implement the masking
+ * scheme or the integrity checks of `ghash_context_t`, so it must only be used
+ * where side-channel and fault-injection hardening of GHASH is not required.
+ */
+typedef struct ghash_fast_context {
+  /**
+   * Precomputed product table for the hash subkey H.
+   */
+  ghash_block_t tbl[kGhashFastTableNumEntries];
+  /**
+   * Precomputed product table for H^2.
+   */
+  ghash_block_t tbl_sq[kGhashFastTableNumEntries];
+  /**
+   * Cipher block representing the current GHASH state.
+   */
+  ghash_block_t state;
+} ghash_fast_context_t;
+
 /**
  * Compute the checksum of a ghash context.
  *
@@ -217,6 +255,54 @@ status_t ghash_handle_enc_initial_counter_block(
  */
 status_t ghash_final(ghash_context_t *ctx, uint32_t *result);
 
+/**
+ * Precompute hash subkey information for the fast GHASH engine.
+ *
+ * Computes the 8-bit window product tables for H and H^2. As with
+ * `ghash_init_subkey`, this is expensive and should be done once per key; the
+ * context can then be reused for several operations via `ghash_fast_init`.
+ *
+ * @param hash_subkey Subkey for the GHASH operation (`kGhashBlockNumWords`
+ * words).
+ * @param[out] ctx Context object with populated product tables.
+ */
+status_t ghash_fast_init_subkey(const uint32_t *hash_subkey,
+                                ghash_fast_context_t *ctx);
+
+/**
+ * Start a fast GHASH operation.
+ *
+ * Resets the state to zero without touching the product tables.
+ *
+ * @param[out] ctx Context object with GHASH state reset to zero.
+ */
+status_t ghash_fast_init(ghash_fast_context_t *ctx);
+
+/**
+ * Update the state of a fast GHASH operation.
+ *
+ * Same semantics as `ghash_update`: the input is padded with 0s on the
+ * right-hand side to a multiple of the block size. Full blocks are processed
+ * in pairs with aggregated reduction.
+ *
+ * @param ctx Context object.
+ * @param input_len Number of bytes in the input.
+ * @param input Pointer to input buffer.
+ */
+status_t ghash_fast_update(ghash_fast_context_t *ctx, size_t input_len,
+                           const uint8_t *input);
+
+/**
+ * Write out the result of a fast GHASH operation.
+ *
+ * The caller must ensure that at least `kGhashBlockNumWords` words are
+ * allocated in the `result` buffer.
+ *
+ * @param ctx Context object.
+ * @param[out] result Buffer in which to write the GHASH result block.
+ */
+status_t ghash_fast_final(ghash_fast_context_t *ctx, uint32_t *result);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
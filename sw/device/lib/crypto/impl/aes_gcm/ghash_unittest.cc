@@ -5,6 +5,8 @@
 #include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
 
 #include <array>
+#include <cstring>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -389,5 +391,154 @@ TEST(Ghash, McGrawViegaTestCase18) {
   EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
 }
 
+/**
+ * Reference GHASH from NIST SP800-38D, algorithms 1 and 2 (bit-serial).
+ *
+ * Operates directly on the byte representation of the blocks.
+ */
+std::array<uint8_t, kGhashBlockNumBytes> ReferenceGhash(
+    const std::array<uint8_t, kGhashBlockNumBytes> &h,
+    const std::vector<uint8_t> &input) {
+  std::array<uint8_t, kGhashBlockNumBytes> y = {0};
+  for (size_t offset = 0; offset < input.size();
+       offset += kGhashBlockNumBytes) {
+    for (size_t i = 0; i < kGhashBlockNumBytes && offset + i < input.size();
+         ++i) {
+      y[i] ^= input[offset + i];
+    }
+    std::array<uint8_t, kGhashBlockNumBytes> z = {0};
+    std::array<uint8_t, kGhashBlockNumBytes> v = h;
+    for (size_t i = 0; i < kGhashBlockNumBytes * 8; ++i) {
+      if ((y[i / 8] >> (7 - (i % 8))) & 1) {
+        for (size_t j = 0; j < kGhashBlockNumBytes; ++j) {
+          z[j] ^= v[j];
+        }
+      }
+      uint8_t lsb = v[kGhashBlockNumBytes - 1] & 1;
+      for (size_t j = kGhashBlockNumBytes - 1; j > 0; --j) {
+        v[j] = static_cast<uint8_t>((v[j] >> 1) | (v[j - 1] << 7));
+      }
+      v[0] >>= 1;
+      if (lsb) {
+        v[0] ^= 0xe1;
+      }
+    }
+    y = z;
+  }
+  return y;
+}
+
+TEST(GhashFast, McGrawViegaTestCase2) {
+  // Same vector as `Ghash.McGrawViegaTestCase2`, computed with the fast
+  // engine.
+  std::array<uint32_t, 4> H = {
+      0xd44be966,
+      0x3b2c8aef,
+      0x59fa4c88,
+      0x2e2b34ca,
+  };
+  std::array<uint32_t, 4> C = {
+      0xceda8803,
+      0x92a3b660,
+      0xb9c228f3,
+      0x78feb271,
+  };
+  std::array<uint32_t, 4> exp_result = {
+      0x1abb8cf3,
+      0xdc2392d6,
+      0xe57a45c3,
+      0x85f8b0b6,
+  };
+  std::array<uint64_t, 2> bitlengths = {
+      0,
+      __builtin_bswap64(C.size() * sizeof(uint32_t) * 8),
+  };
+
+  ghash_fast_context_t ctx;
+  EXPECT_OK(ghash_fast_init_subkey(H.data(), &ctx));
+  EXPECT_OK(ghash_fast_init(&ctx));
+  EXPECT_OK(ghash_fast_update(&ctx, C.size() * sizeof(uint32_t),
+                              (unsigned char *)C.data()));
+  EXPECT_OK(ghash_fast_update(&ctx, bitlengths.size() * sizeof(uint64_t),
+                              (unsigned char *)bitlengths.data()));
+  uint32_t result[kGhashBlockNumWords];
+  EXPECT_OK(ghash_fast_final(&ctx, result));
+
+  EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
+}
+
+TEST(GhashFast, McGrawViegaTestCase18) {
+  // Same vector as `Ghash.McGrawViegaTestCase18`. The ciphertext is an odd
+  // number of blocks with a partial last block, so this covers both the
+  // aggregated and the single-block paths.
+  std::array<uint32_t, 4> H = {
+      0x05f2beac,
+      0xebb8b479,
+      0xac9b88ce,
+      0xd7da3287,
+  };
+  std::array<uint32_t, 5> A = {
+      0xcefaedfe, 0xefbeadde, 0xcefaedfe, 0xefbeadde, 0xd2daadab,
+  };
+  std::array<uint32_t, 15> C = {
+      0x2fef8d5a, 0xf1539e0c, 0x53785df7, 0x202a9e65, 0x2ab2b2ee,
+      0x1964deaf, 0x4fab58a0, 0xf46b746f, 0xb7c3c00f, 0x4544f280,
+      0xf1eba32d, 0xde2cd8c5, 0x978941a2, 0x2ef80e20, 0x3f7eae44,
+  };
+  std::array<uint32_t, 4> exp_result = {
+      0x6fcfffd5,
+      0x694dacc5,
+      0x42872172,
+      0x0b177f1a,
+  };
+  std::array<uint64_t, 2> bitlengths = {
+      __builtin_bswap64(A.size() * sizeof(uint32_t) * 8),
+      __builtin_bswap64(C.size() * sizeof(uint32_t) * 8),
+  };
+
+  ghash_fast_context_t ctx;
+  EXPECT_OK(ghash_fast_init_subkey(H.data(), &ctx));
+  EXPECT_OK(ghash_fast_init(&ctx));
+  EXPECT_OK(ghash_fast_update(&ctx, A.size() * sizeof(uint32_t),
+                              (unsigned char *)A.data()));
+  EXPECT_OK(ghash_fast_update(&ctx, C.size() * sizeof(uint32_t),
+                              (unsigned char *)C.data()));
+  EXPECT_OK(ghash_fast_update(&ctx, bitlengths.size() * sizeof(uint64_t),
+                              (unsigned char *)bitlengths.data()));
+  uint32_t result[kGhashBlockNumWords];
+  EXPECT_OK(ghash_fast_final(&ctx, result));
+
+  EXPECT_THAT(result, testing::ElementsAreArray(exp_result));
+}
+
+TEST(GhashFast, MatchesReferenceForAllLengths) {
+  // Check every input length up to a few aggregated chunks against the
+  // bit-serial reference, so that pair, single and partial block handling are
+  // all exercised.
+  std::array<uint8_t, kGhashBlockNumBytes> h_bytes = {
+      0xac, 0xbe, 0xf2, 0x05, 0x79, 0xb4, 0xb8, 0xeb,
+      0xce, 0x88, 0x9b, 0xac, 0x87, 0x32, 0xda, 0xd7,
+  };
+  std::array<uint32_t, kGhashBlockNumWords> H;
+  std::memcpy(H.data(), h_bytes.data(), kGhashBlockNumBytes);
+
+  std::vector<uint8_t> input(5 * kGhashBlockNumBytes);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 37 + 11);
+  }
+
+  ghash_fast_context_t ctx;
+  EXPECT_OK(ghash_fast_init_subkey(H.data(), &ctx));
+  for (size_t len = 0; len <= input.size(); ++len) {
+    std::vector<uint8_t> msg(input.begin(), input.begin() + len);
+    EXPECT_OK(ghash_fast_init(&ctx));
+    EXPECT_OK(ghash_fast_update(&ctx, msg.size(), msg.data()));
+    std::array<uint8_t, kGhashBlockNumBytes> result;
+    EXPECT_OK(ghash_fast_final(&ctx, (uint32_t *)result.data()));
+    EXPECT_THAT(result, ElementsAreArray(ReferenceGhash(h_bytes, msg)))
+        << "length: " << len;
+  }
+}
+
 }  // namespace
 }  // namespace ghash_unittest
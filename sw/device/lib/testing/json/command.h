@@ -28,6 +28,7 @@ extern "C" {
     value(_, MemWrite32) \
     value(_, PinmuxConfig) \
     value(_, PinmuxAttrConfig) \
+    value(_, ProfileDump) \
     value(_, SpiConfigureJedecId) \
     value(_, SpiReadStatus) \
     value(_, SpiWaitForUpload) \
@@ -0,0 +1,38 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_CRYPTOLIB_BENCH_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_CRYPTOLIB_BENCH_H_
+
+#include "sw/device/lib/ujson/ujson_derive.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format off
+
+#define MODULE_ID MAKE_MODULE_ID('j', 'c', 'b')
+
+// One measurement of the cryptolib benchmark. The device sends `num_results`
+// of these in order of `index`. `bytes` is zero for operations that do not
+// depend on a message length, in which case `millicycles_per_byte` is zero
+// too.
+#define STRUCT_CRYPTOLIB_BENCH_RESULT(field, string) \
+    field(index, uint32_t) \
+    field(num_results, uint32_t) \
+    string(primitive, 32) \
+    field(bytes, uint32_t) \
+    field(runs, uint32_t) \
+    field(min_cycles, uint32_t) \
+    field(max_cycles, uint32_t) \
+    field(mean_cycles, uint32_t) \
+    field(millicycles_per_byte, uint32_t)
+UJSON_SERDE_STRUCT(CryptolibBenchResult, cryptolib_bench_result_t, STRUCT_CRYPTOLIB_BENCH_RESULT);
+
+#undef MODULE_ID
+
+// clang-format on
+#ifdef __cplusplus
+}
+#endif
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_CRYPTOLIB_BENCH_H_
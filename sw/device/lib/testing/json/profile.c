@@ -0,0 +1,42 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#define UJSON_SERDE_IMPL 1
+#include "sw/device/lib/testing/json/profile.h"
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
+
+#define MODULE_ID MAKE_MODULE_ID('j', 's', 'p')
+
+static_assert(ARRAYSIZE(((profile_region_resp_t *)NULL)->histogram) ==
+                  kProfileHistogramNumBuckets,
+              "Histogram size of the dump response must match profile.h");
+
+status_t ujcmd_profile_dump(ujson_t *uj) {
+  profile_dump_req_t op;
+  profile_region_resp_t resp;
+  TRY(UJSON_WITH_CRC(ujson_deserialize_profile_dump_req_t, uj, &op));
+  memset(&resp, 0, sizeof(resp));
+  resp.num_regions = (uint32_t)profile_region_count();
+
+  const profile_region_t *region = profile_region_get(op.index);
+  if (region != NULL) {
+    for (size_t i = 0; i < sizeof(resp.name) - 1 && region->name[i] != '\0';
+         ++i) {
+      resp.name[i] = region->name[i];
+    }
+    resp.count = region->count;
+    resp.min_cycles = region->min_cycles;
+    resp.max_cycles = region->max_cycles;
+    resp.mean_cycles = profile_region_mean(region);
+    resp.total_cycles = region->total_cycles;
+    resp.total_instret = region->total_instret;
+    resp.total_lsu_stalls = region->total_lsu_stalls;
+    resp.total_fetch_stalls = region->total_fetch_stalls;
+    memcpy(resp.histogram, region->histogram, sizeof(resp.histogram));
+  }
+  return RESP_OK(ujson_serialize_profile_region_resp_t, uj, &resp);
+}
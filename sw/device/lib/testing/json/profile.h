@@ -0,0 +1,47 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILE_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILE_H_
+
+#include "sw/device/lib/ujson/ujson_derive.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+// clang-format off
+
+#define MODULE_ID MAKE_MODULE_ID('j', 'p', 'h')
+
+#define STRUCT_PROFILE_DUMP_REQ(field, string) \
+    field(index, uint32_t)
+UJSON_SERDE_STRUCT(ProfileDumpReq, profile_dump_req_t, STRUCT_PROFILE_DUMP_REQ);
+
+// If `index` is not smaller than `num_regions`, all other fields are zero.
+#define STRUCT_PROFILE_REGION_RESP(field, string) \
+    field(num_regions, uint32_t) \
+    string(name, 32) \
+    field(count, uint32_t) \
+    field(min_cycles, uint32_t) \
+    field(max_cycles, uint32_t) \
+    field(mean_cycles, uint32_t) \
+    field(total_cycles, uint64_t) \
+    field(total_instret, uint64_t) \
+    field(total_lsu_stalls, uint64_t) \
+    field(total_fetch_stalls, uint64_t) \
+    field(histogram, uint32_t, 16)
+UJSON_SERDE_STRUCT(ProfileRegionResp, profile_region_resp_t, STRUCT_PROFILE_REGION_RESP);
+
+#ifndef RUST_PREPROCESSOR_EMIT
+
+status_t ujcmd_profile_dump(ujson_t *uj);
+
+#endif
+
+#undef MODULE_ID
+
+// clang-format on
+#ifdef __cplusplus
+}
+#endif
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_JSON_PROFILE_H_
@@ -4,7 +4,12 @@
 
 #include "sw/device/lib/testing/profile.h"
 
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/csr.h"
+#include "sw/device/lib/base/math.h"
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 
 uint64_t profile_start(void) { return ibex_mcycle_read(); }
@@ -22,3 +27,133 @@ uint32_t profile_end_and_print(uint64_t t_start, char *name) {
   LOG_INFO("%s took %u cycles or %u ms @ 100 MHz.", name, cycles, time_ms);
   return cycles;
 }
+
+enum {
+  /**
+   * `mcountinhibit` bits for `minstret`, `mhpmcounter3` and `mhpmcounter4`.
+   */
+  kCountInhibitMask = (1 << 2) | (1 << 3) | (1 << 4),
+};
+
+static bool counters_enabled = false;
+static profile_region_t *regions_head = NULL;
+static profile_region_t *regions_tail = NULL;
+static size_t regions_count = 0;
+
+void profile_counters_enable(bool enable) {
+  if (enable) {
+    CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, kCountInhibitMask);
+  }
+  counters_enabled = enable;
+}
+
+profile_sample_t profile_region_begin(void) {
+  profile_sample_t sample = {0};
+  if (counters_enabled) {
+    CSR_READ(CSR_REG_MINSTRET, &sample.instret);
+    CSR_READ(CSR_REG_MHPMCOUNTER3, &sample.lsu_stalls);
+    CSR_READ(CSR_REG_MHPMCOUNTER4, &sample.fetch_stalls);
+  }
+  // Read the cycle counter last so that the reads above are not counted.
+  sample.cycles = ibex_mcycle_read();
+  return sample;
+}
+
+/**
+ * Returns the histogram bucket for a sample of `cycles` cycles.
+ */
+static size_t histogram_bucket(uint32_t cycles) {
+  if (cycles == 0) {
+    return 0;
+  }
+  size_t log2 = 31 - (size_t)bitfield_count_leading_zeroes32(cycles);
+  return log2 / 2;
+}
+
+static void region_register(profile_region_t *region) {
+  region->registered = true;
+  region->next = NULL;
+  if (regions_tail == NULL) {
+    regions_head = region;
+  } else {
+    regions_tail->next = region;
+  }
+  regions_tail = region;
+  ++regions_count;
+}
+
+uint32_t profile_region_end(profile_region_t *region,
+                            const profile_sample_t *start) {
+  uint32_t cycles = profile_end(start->cycles);
+  if (counters_enabled) {
+    uint32_t instret, lsu_stalls, fetch_stalls;
+    CSR_READ(CSR_REG_MINSTRET, &instret);
+    CSR_READ(CSR_REG_MHPMCOUNTER3, &lsu_stalls);
+    CSR_READ(CSR_REG_MHPMCOUNTER4, &fetch_stalls);
+    // The counters may be narrower than 64 bits; unsigned wraparound gives
+    // the right delta as long as a sample is shorter than 2^32 events.
+    region->total_instret += instret - start->instret;
+    region->total_lsu_stalls += lsu_stalls - start->lsu_stalls;
+    region->total_fetch_stalls += fetch_stalls - start->fetch_stalls;
+  }
+  profile_region_add(region, cycles);
+  return cycles;
+}
+
+void profile_region_add(profile_region_t *region, uint32_t cycles) {
+  if (!region->registered) {
+    region_register(region);
+  }
+  if (region->count == 0 || cycles < region->min_cycles) {
+    region->min_cycles = cycles;
+  }
+  if (cycles > region->max_cycles) {
+    region->max_cycles = cycles;
+  }
+  ++region->count;
+  region->total_cycles += cycles;
+  ++region->histogram[histogram_bucket(cycles)];
+}
+
+void profile_region_reset(profile_region_t *region) {
+  region->count = 0;
+  region->min_cycles = 0;
+  region->max_cycles = 0;
+  region->total_cycles = 0;
+  region->total_instret = 0;
+  region->total_lsu_stalls = 0;
+  region->total_fetch_stalls = 0;
+  memset(region->histogram, 0, sizeof(region->histogram));
+}
+
+size_t profile_region_count(void) { return regions_count; }
+
+const profile_region_t *profile_region_get(size_t index) {
+  const profile_region_t *region = regions_head;
+  for (; region != NULL && index > 0; --index) {
+    region = region->next;
+  }
+  return region;
+}
+
+uint32_t profile_region_mean(const profile_region_t *region) {
+  if (region->count == 0) {
+    return 0;
+  }
+  return (uint32_t)udiv64_slow(region->total_cycles, region->count, NULL);
+}
+
+void profile_region_log_all(void) {
+  for (const profile_region_t *region = regions_head; region != NULL;
+       region = region->next) {
+    LOG_INFO("%s: n=%u min=%u max=%u mean=%u cycles", region->name,
+             region->count, region->min_cycles, region->max_cycles,
+             profile_region_mean(region));
+    if (region->total_instret != 0) {
+      LOG_INFO("%s: instret=%u lsu_stalls=%u fetch_stalls=%u (totals)",
+               region->name, (uint32_t)region->total_instret,
+               (uint32_t)region->total_lsu_stalls,
+               (uint32_t)region->total_fetch_stalls);
+    }
+  }
+}
@@ -5,6 +5,8 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_PROFILE_H_
 #define OPENTITAN_SW_DEVICE_LIB_TESTING_PROFILE_H_
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -50,6 +52,181 @@ uint32_t profile_end(uint64_t t_start);
  */
 uint32_t profile_end_and_print(uint64_t t_start, char *name);
 
+enum {
+  /**
+   * Number of histogram buckets kept for each profile region.
+   *
+   * Bucket `i` counts the samples whose cycle count `c` satisfies
+   * `4^i <= c < 4^(i+1)` (samples of zero cycles go into bucket 0), so the
+   * buckets cover the whole 32-bit range.
+   */
+  kProfileHistogramNumBuckets = 16,
+};
+
+/**
+ * A snapshot of the Ibex performance counters taken at the start of a region.
+ *
+ * The counters other than `cycles` are only sampled while counter collection
+ * is enabled with `profile_counters_enable()`.
+ */
+typedef struct profile_sample {
+  /**
+   * Value of `mcycle`.
+   */
+  uint64_t cycles;
+  /**
+   * Low word of `minstret`.
+   */
+  uint32_t instret;
+  /**
+   * Value of `mhpmcounter3` (cycles waiting for loads and stores).
+   */
+  uint32_t lsu_stalls;
+  /**
+   * Value of `mhpmcounter4` (cycles waiting for instruction fetches).
+   */
+  uint32_t fetch_stalls;
+} profile_sample_t;
+
+/**
+ * Accumulated statistics for a named profile region.
+ *
+ * Regions should be defined with `PROFILE_REGION()` and are registered for
+ * `profile_region_get()` the first time a sample is recorded. Registration
+ * links the region into a list that lives until reset, so regions must have
+ * static storage duration.
+ */
+typedef struct profile_region {
+  /**
+   * Name of the region, used when logging and dumping.
+   */
+  const char *name;
+  /**
+   * Next registered region; managed by the profile library.
+   */
+  struct profile_region *next;
+  /**
+   * Whether this region has been added to the list of registered regions.
+   */
+  bool registered;
+  /**
+   * Number of recorded samples.
+   */
+  uint32_t count;
+  /**
+   * Smallest and largest sample, in cycles.
+   */
+  uint32_t min_cycles;
+  uint32_t max_cycles;
+  /**
+   * Sum of all samples, in cycles.
+   */
+  uint64_t total_cycles;
+  /**
+   * Sums of the retired instructions and stall cycles of all samples taken
+   * while counter collection was enabled.
+   */
+  uint64_t total_instret;
+  uint64_t total_lsu_stalls;
+  uint64_t total_fetch_stalls;
+  /**
+   * Histogram of the samples; see `kProfileHistogramNumBuckets`.
+   */
+  uint32_t histogram[kProfileHistogramNumBuckets];
+} profile_region_t;
+
+/**
+ * Defines a named profile region with static storage duration.
+ *
+ * Basic usage:
+ *   PROFILE_REGION(aes_region, "aes_encrypt");
+ *
+ *   profile_sample_t start = profile_region_begin();
+ *   // Do some stuff
+ *   profile_region_end(&aes_region, &start);
+ *
+ * The region is declared `static`, also when defined inside a function, since
+ * it stays linked into the list of registered regions.
+ *
+ * @param var_ Name of the `profile_region_t` variable to define.
+ * @param name_ Name of the region, as a string literal.
+ */
+#define PROFILE_REGION(var_, name_) \
+  static profile_region_t var_ = {.name = name_}
+
+/**
+ * Enables or disables sampling of the retired-instruction and stall counters.
+ *
+ * When enabling, the counters are also un-inhibited in `mcountinhibit`. Cycle
+ * counts are always collected.
+ *
+ * @param enable Whether to sample the additional counters.
+ */
+void profile_counters_enable(bool enable);
+
+/**
+ * Takes a snapshot of the performance counters at the start of a region.
+ *
+ * @return Counter snapshot to pass to `profile_region_end()`.
+ */
+profile_sample_t profile_region_begin(void);
+
+/**
+ * Records a sample for `region`, measured from `start` to now.
+ *
+ * @param region The region to update.
+ * @param start A snapshot returned by `profile_region_begin()`.
+ * @return Number of cycles in this sample.
+ */
+uint32_t profile_region_end(profile_region_t *region,
+                            const profile_sample_t *start);
+
+/**
+ * Records a sample of `cycles` cycles for `region`.
+ *
+ * This is `profile_region_end()` for samples measured by the caller; the
+ * counter totals are not updated.
+ *
+ * @param region The region to update.
+ * @param cycles Number of cycles in this sample.
+ */
+void profile_region_add(profile_region_t *region, uint32_t cycles);
+
+/**
+ * Clears the statistics of `region`. The region stays registered.
+ *
+ * @param region The region to clear.
+ */
+void profile_region_reset(profile_region_t *region);
+
+/**
+ * Returns the number of registered regions.
+ *
+ * @return Number of regions that have recorded at least one sample.
+ */
+size_t profile_region_count(void);
+
+/**
+ * Returns a registered region by index, in registration order.
+ *
+ * @param index Index of the region.
+ * @return The region, or NULL if `index` is out of range.
+ */
+const profile_region_t *profile_region_get(size_t index);
+
+/**
+ * Returns the mean sample of `region`, in cycles.
+ *
+ * @param region The region to query.
+ * @return Mean number of cycles, or zero if there are no samples.
+ */
+uint32_t profile_region_mean(const profile_region_t *region);
+
+/**
+ * Logs the statistics of all registered regions.
+ */
+void profile_region_log_all(void);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
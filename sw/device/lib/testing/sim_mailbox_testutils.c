@@ -0,0 +1,151 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/sim_mailbox_testutils.h"
+
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/mmio.h"
+
+#define MODULE_ID MAKE_MODULE_ID('s', 'm', 'b')
+
+enum {
+  /**
+   * Offset of the mailbox from the test status address.
+   */
+  kSimMailboxOffset = 0x0c,
+
+  /**
+   * Offsets of the registers from the mailbox, see verilator_sw_mailbox.h.
+   */
+  kSimMailboxCommand = 0x0,
+  kSimMailboxArgument = 0x4,
+  kSimMailboxResult = 0x8,
+  kSimMailboxResponse = 0xc,
+};
+
+/**
+ * Mailbox commands, kept in sync with `VerilatorSwMailbox::Command`.
+ */
+typedef enum sim_mailbox_command {
+  kSimMailboxCmdNext = 1,
+  kSimMailboxCmdCycleCount = 2,
+  kSimMailboxCmdFileRead = 3,
+  kSimMailboxCmdFileWrite = 4,
+  kSimMailboxCmdFileAppend = 5,
+} sim_mailbox_command_t;
+
+static status_t mailbox_get(mmio_region_t *mailbox) {
+  if (kDeviceType != kDeviceSimVerilator) {
+    return UNIMPLEMENTED();
+  }
+  *mailbox =
+      mmio_region_from_addr(device_test_status_address() + kSimMailboxOffset);
+  return OK_STATUS();
+}
+
+/**
+ * Writes a NUL-terminated string as arguments, packed into words.
+ */
+static void mailbox_write_string(mmio_region_t mailbox, const char *str) {
+  uint32_t word = 0;
+  size_t i = 0;
+  do {
+    word |= (uint32_t)(uint8_t)str[i] << (8 * (i % sizeof(uint32_t)));
+    if (i % sizeof(uint32_t) == sizeof(uint32_t) - 1 || str[i] == '\0') {
+      mmio_region_write32(mailbox, kSimMailboxArgument, word);
+      word = 0;
+    }
+  } while (str[i++] != '\0');
+}
+
+/**
+ * Runs a command on the arguments written so far.
+ *
+ * The host writes the result before software can read it: the core waits for
+ * the response to the write of the command, and the host serves the command
+ * at the next clock edge.
+ *
+ * @return The non-negative result of the command, or the error code of the
+ * host as the argument of a `kInternal` status.
+ */
+static status_t mailbox_execute(mmio_region_t mailbox,
+                                sim_mailbox_command_t command) {
+  mmio_region_write32(mailbox, kSimMailboxCommand, command);
+  int32_t result = (int32_t)mmio_region_read32(mailbox, kSimMailboxResult);
+  if (result < 0) {
+    return INTERNAL(-result);
+  }
+  return OK_STATUS(result);
+}
+
+/**
+ * Reads the next word of the response of the last command.
+ */
+static uint32_t mailbox_read_response(mmio_region_t mailbox) {
+  uint32_t word = mmio_region_read32(mailbox, kSimMailboxResponse);
+  mmio_region_write32(mailbox, kSimMailboxCommand, kSimMailboxCmdNext);
+  return word;
+}
+
+status_t sim_mailbox_testutils_cycle_count(uint64_t *cycles) {
+  mmio_region_t mailbox;
+  TRY(mailbox_get(&mailbox));
+  TRY(mailbox_execute(mailbox, kSimMailboxCmdCycleCount));
+  uint64_t lo = mailbox_read_response(mailbox);
+  uint64_t hi = mailbox_read_response(mailbox);
+  *cycles = hi << 32 | lo;
+  return OK_STATUS();
+}
+
+status_t sim_mailbox_testutils_file_read(const char *name, size_t offset,
+                                         void *buf, size_t len,
+                                         size_t *read_len) {
+  mmio_region_t mailbox;
+  TRY(mailbox_get(&mailbox));
+  mmio_region_write32(mailbox, kSimMailboxArgument, offset);
+  mmio_region_write32(mailbox, kSimMailboxArgument, len);
+  mailbox_write_string(mailbox, name);
+  size_t result = (size_t)TRY(mailbox_execute(mailbox, kSimMailboxCmdFileRead));
+  if (result > len) {
+    return INTERNAL();
+  }
+
+  uint8_t *bytes = (uint8_t *)buf;
+  uint32_t word = 0;
+  for (size_t i = 0; i < result; ++i) {
+    if (i % sizeof(uint32_t) == 0) {
+      word = mailbox_read_response(mailbox);
+    }
+    bytes[i] = (uint8_t)(word >> (8 * (i % sizeof(uint32_t))));
+  }
+  if (read_len != NULL) {
+    *read_len = result;
+  }
+  return OK_STATUS();
+}
+
+status_t sim_mailbox_testutils_file_write(const char *name, const void *buf,
+                                          size_t len, bool append) {
+  mmio_region_t mailbox;
+  TRY(mailbox_get(&mailbox));
+  mmio_region_write32(mailbox, kSimMailboxArgument, len);
+  mailbox_write_string(mailbox, name);
+
+  const uint8_t *bytes = (const uint8_t *)buf;
+  uint32_t word = 0;
+  for (size_t i = 0; i < len; ++i) {
+    word |= (uint32_t)bytes[i] << (8 * (i % sizeof(uint32_t)));
+    if (i % sizeof(uint32_t) == sizeof(uint32_t) - 1 || i == len - 1) {
+      mmio_region_write32(mailbox, kSimMailboxArgument, word);
+      word = 0;
+    }
+  }
+
+  size_t result = (size_t)TRY(mailbox_execute(
+      mailbox, append ? kSimMailboxCmdFileAppend : kSimMailboxCmdFileWrite));
+  if (result != len) {
+    return INTERNAL();
+  }
+  return OK_STATUS();
+}
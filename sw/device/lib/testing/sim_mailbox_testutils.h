@@ -0,0 +1,63 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_SIM_MAILBOX_TESTUTILS_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_SIM_MAILBOX_TESTUTILS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+
+/**
+ * Requests to the Verilator simulation host.
+ *
+ * Tests can offload work that is expensive on the simulated core, such as
+ * generating large test vectors, to the host through the mailbox in the sim
+ * SRAM, which `VerilatorSwMailbox` in hw/dv/verilator/cpp serves. Files are
+ * relative to the directory the simulation was started with
+ * `--sw-mailbox-dir`.
+ *
+ * All functions return `kUnimplemented` on devices other than Verilator.
+ */
+
+/**
+ * Gets the current cycle of the simulation.
+ *
+ * @param[out] cycles The number of cycles of the simulation clock.
+ * @return The status of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t sim_mailbox_testutils_cycle_count(uint64_t *cycles);
+
+/**
+ * Reads a file on the simulation host.
+ *
+ * @param name Name of the file.
+ * @param offset Offset in the file to read from.
+ * @param[out] buf Buffer to read to.
+ * @param len Maximum number of bytes to read.
+ * @param[out] read_len The number of bytes read, may be NULL.
+ * @return The status of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t sim_mailbox_testutils_file_read(const char *name, size_t offset,
+                                         void *buf, size_t len,
+                                         size_t *read_len);
+
+/**
+ * Writes a file on the simulation host.
+ *
+ * @param name Name of the file.
+ * @param buf Data to write.
+ * @param len Number of bytes to write.
+ * @param append Whether to append to the file instead of replacing it.
+ * @return The status of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t sim_mailbox_testutils_file_write(const char *name, const void *buf,
+                                          size_t len, bool append);
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_SIM_MAILBOX_TESTUTILS_H_
@@ -26,6 +26,13 @@ static status_t ottf_console_null_getc(void *io) {
   return UNAVAILABLE();
 }
 
+static status_t ottf_console_null_read(void *io, char *buf, size_t len) {
+  OT_DISCARD(io);
+  OT_DISCARD(buf);
+  OT_DISCARD(len);
+  return UNAVAILABLE();
+}
+
 static size_t ottf_console_null_sink(void *io, const char *buf, size_t len) {
   OT_DISCARD(io);
   OT_DISCARD(buf);
@@ -34,9 +41,21 @@ static size_t ottf_console_null_sink(void *io, const char *buf, size_t len) {
 
 void ottf_console_configure_null(ottf_console_t *console) {
   console->getc = ottf_console_null_getc;
+  console->read = ottf_console_null_read;
   console->sink = ottf_console_null_sink;
 }
 
+// Sends data through the console's sink and accounts for it in the
+// throughput counters.
+static size_t ottf_console_sink(void *io, const char *buf, size_t len) {
+  ottf_console_t *console = io;
+  uint64_t start = ibex_mcycle_read();
+  size_t written_len = console->sink(io, buf, len);
+  console->stats.tx_cycles += ibex_mcycle_read() - start;
+  console->stats.tx_bytes += written_len;
+  return written_len;
+}
+
 void ottf_console_init(void) {
   // Initialize/Configure the console device.
   uintptr_t base_addr = kOttfTestConfig.console.base_addr;
@@ -79,7 +98,7 @@ void ottf_console_init(void) {
   }
 
   base_set_stdout((buffer_sink_t){.data = (void *)&main_console,
-                                  .sink = main_console.sink});
+                                  .sink = ottf_console_sink});
 }
 
 uint32_t ottf_console_get_flow_control_irqs(void) { return flow_control_irqs; }
@@ -118,7 +137,8 @@ void ottf_console_set_buffering(ottf_console_t *console, bool enabled,
 
 status_t ottf_console_flush(ottf_console_t *console) {
   if (console->buffered && console->buf_end > 0) {
-    size_t written_len = console->sink(console, console->buf, console->buf_end);
+    size_t written_len =
+        ottf_console_sink(console, console->buf, console->buf_end);
     size_t lost = console->buf_end - written_len;
     console->buf_end = 0;
     if (lost > 0) {
@@ -132,7 +152,7 @@ status_t ottf_console_flush(ottf_console_t *console) {
 
 static status_t ottf_console_write_unbuffered(ottf_console_t *console,
                                               const char *buf, size_t len) {
-  size_t written_len = console->sink(console, buf, len);
+  size_t written_len = ottf_console_sink(console, buf, len);
   if (written_len < len) {
     return DATA_LOSS((int32_t)(len - written_len));
   } else {
@@ -185,5 +205,25 @@ status_t ottf_console_putbuf(void *io, const char *buf, size_t len) {
 
 status_t ottf_console_getc(void *io) {
   ottf_console_t *console = io;
-  return console->getc(io);
+  status_t s = console->getc(io);
+  if (status_ok(s)) {
+    console->stats.rx_bytes += 1;
+  }
+  return s;
+}
+
+status_t ottf_console_read(void *io, char *buf, size_t len) {
+  ottf_console_t *console = io;
+  size_t read_len = (size_t)TRY(console->read(io, buf, len));
+  console->stats.rx_bytes += read_len;
+  return OK_STATUS((int32_t)read_len);
+}
+
+void ottf_console_get_stats(const ottf_console_t *console,
+                            ottf_console_stats_t *stats) {
+  *stats = console->stats;
+}
+
+void ottf_console_reset_stats(ottf_console_t *console) {
+  console->stats = (ottf_console_stats_t){0};
 }
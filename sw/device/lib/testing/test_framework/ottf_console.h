@@ -18,6 +18,20 @@
 #include "sw/device/lib/runtime/print.h"
 #include "sw/device/lib/testing/test_framework/ottf_console_types.h"
 
+/**
+ * OTTF console throughput counters.
+ */
+typedef struct ottf_console_stats {
+  /** Number of bytes received. */
+  uint32_t rx_bytes;
+  /** Number of bytes sent. */
+  uint32_t tx_bytes;
+  /** CPU cycles spent in the data sink sending `tx_bytes`. */
+  uint64_t tx_cycles;
+  /** Largest number of bytes waiting in the software RX buffer. */
+  uint32_t rx_buffer_peak;
+} ottf_console_stats_t;
+
 /**
  * OTTF console state.
  *
@@ -30,6 +44,13 @@ struct ottf_console {
   sink_func_ptr sink;
   /* Function pointer to a function that retrieves a single character. */
   status_t (*getc)(void *);
+  /*
+   * Function pointer to a function that retrieves up to `len` characters,
+   * blocking until at least one is available.
+   */
+  status_t (*read)(void *, char *, size_t);
+  /** Throughput counters. */
+  ottf_console_stats_t stats;
   /* Enable SW buffering. */
   bool buffered;
   /** Staging buffer. */
@@ -132,4 +153,33 @@ status_t ottf_console_flushbuf(void *io);
  */
 status_t ottf_console_getc(void *io);
 
+/**
+ * Read up to `len` characters from the OTTF console.
+ *
+ * Blocks until at least one character is available, then returns whatever is
+ * already buffered without waiting for more.
+ *
+ * @param io An IO context: pointer to an `ottf_console_t`.
+ * @param[out] buf The buffer to read into.
+ * @param len The length of the buffer.
+ * @return The number of characters read or an error.
+ */
+status_t ottf_console_read(void *io, char *buf, size_t len);
+
+/**
+ * Returns the throughput counters of an OTTF console.
+ *
+ * @param console Pointer to the console.
+ * @param[out] stats The counters.
+ */
+void ottf_console_get_stats(const ottf_console_t *console,
+                            ottf_console_stats_t *stats);
+
+/**
+ * Resets the throughput counters of an OTTF console.
+ *
+ * @param console Pointer to the console.
+ */
+void ottf_console_reset_stats(ottf_console_t *console);
+
 #endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_H_
@@ -322,6 +322,23 @@ static size_t ottf_console_spi_sink(void *io, const char *buf, size_t len) {
   return write_data_len;
 }
 
+// Upload currently being consumed by `ottf_console_spi_getc` and
+// `ottf_console_spi_read`.
+static upload_info_t rx_upload;
+static size_t rx_index;
+
+// Waits for the host to upload more data if the current upload is exhausted.
+static void rx_upload_refill(ottf_console_t *console) {
+  dif_spi_device_handle_t *spi_device = &console->data.spi.dif;
+  while (rx_index >= rx_upload.data_len) {
+    memset(&rx_upload, 0, sizeof(upload_info_t));
+    CHECK_STATUS_OK(
+        spi_device_testutils_wait_for_upload(spi_device, &rx_upload));
+    rx_index = 0;
+    CHECK_DIF_OK(dif_spi_device_set_flash_status_registers(spi_device, 0x00));
+  }
+}
+
 /*
  * The user of this function needs to be aware of the following:
  * 1. The exact amount of data expected to be sent from the host side must be
@@ -330,18 +347,24 @@ static size_t ottf_console_spi_sink(void *io, const char *buf, size_t len) {
  * available. Failure to do so may result in an SPI transaction timeout.
  */
 static status_t ottf_console_spi_getc(void *io) {
-  ottf_console_t *console = io;
-  dif_spi_device_handle_t *spi_device = &console->data.spi.dif;
-  static size_t index = 0;
-  static upload_info_t info = {0};
-  if (index == info.data_len) {
-    memset(&info, 0, sizeof(upload_info_t));
-    CHECK_STATUS_OK(spi_device_testutils_wait_for_upload(spi_device, &info));
-    index = 0;
-    CHECK_DIF_OK(dif_spi_device_set_flash_status_registers(spi_device, 0x00));
-  }
+  rx_upload_refill(io);
+  return OK_STATUS(rx_upload.data[rx_index++]);
+}
 
-  return OK_STATUS(info.data[index++]);
+// Same caveats as `ottf_console_spi_getc`, but copies out the rest of the
+// current upload at once.
+static status_t ottf_console_spi_read(void *io, char *buf, size_t len) {
+  if (len == 0) {
+    return OK_STATUS(0);
+  }
+  rx_upload_refill(io);
+  size_t count = rx_upload.data_len - rx_index;
+  if (count > len) {
+    count = len;
+  }
+  memcpy(buf, &rx_upload.data[rx_index], count);
+  rx_index += count;
+  return OK_STATUS((int32_t)count);
 }
 
 void ottf_console_configure_spi_device(ottf_console_t *console,
@@ -454,5 +477,6 @@ void ottf_console_configure_spi_device(ottf_console_t *console,
   }
 
   console->getc = ottf_console_spi_getc;
+  console->read = ottf_console_spi_read;
   console->sink = ottf_console_spi_sink;
 }
@@ -2,9 +2,11 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <assert.h>
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/dif/dif_pinmux.h"
@@ -24,8 +26,8 @@ enum {
   /**
    * Flow control parameters.
    */
-  kFlowControlLowWatermark = 4,   // bytes
-  kFlowControlHighWatermark = 8,  // bytes
+  kFlowControlLowWatermark = kOttfConsoleUartRxRingSize / 4,       // bytes
+  kFlowControlHighWatermark = kOttfConsoleUartRxRingSize * 3 / 4,  // bytes
   kFlowControlRxWatermark = kDifUartWatermarkByte8,
   /**
    * HART PLIC Target.
@@ -33,21 +35,115 @@ enum {
   kPlicTarget = 0,
 };
 
-static status_t ottf_console_uart_getc(void *io) {
+static_assert((kOttfConsoleUartRxRingSize &
+               (kOttfConsoleUartRxRingSize - 1)) == 0,
+              "The RX ring size must be a power of two");
+
+// Moves as much of the RX FIFO as fits into the ring buffer.
+//
+// This is called from the RX watermark ISR, so callers outside of the ISR must
+// mask the UART interrupts.
+static status_t rx_ring_fill(ottf_console_t *console) {
+  ottf_console_uart_t *uart = &console->data.uart;
+  uint32_t head = uart->rx_head;
+  uint32_t avail;
+  TRY(dif_uart_rx_bytes_available(&uart->dif, &avail));
+  uint32_t room = kOttfConsoleUartRxRingSize - (head - uart->rx_tail);
+  if (avail > room) {
+    avail = room;
+  }
+  while (avail > 0) {
+    // Receive up to the end of the ring in one go.
+    uint32_t offset = head & (kOttfConsoleUartRxRingSize - 1);
+    size_t len = kOttfConsoleUartRxRingSize - offset;
+    if (len > avail) {
+      len = avail;
+    }
+    size_t received;
+    TRY(dif_uart_bytes_receive(&uart->dif, len, &uart->rx_ring[offset],
+                               &received));
+    head += received;
+    avail -= received;
+    if (received < len) {
+      break;
+    }
+  }
+  uart->rx_head = head;
+  uint32_t level = head - uart->rx_tail;
+  if (level > console->stats.rx_buffer_peak) {
+    console->stats.rx_buffer_peak = level;
+  }
+  return OK_STATUS();
+}
+
+// Copies up to `len` bytes out of the ring buffer. Only the reader updates
+// `rx_tail`, so this does not need to mask interrupts.
+static size_t rx_ring_read(ottf_console_uart_t *uart, char *buf, size_t len) {
+  uint32_t tail = uart->rx_tail;
+  size_t count = uart->rx_head - tail;
+  if (count > len) {
+    count = len;
+  }
+  uint32_t offset = tail & (kOttfConsoleUartRxRingSize - 1);
+  size_t first = kOttfConsoleUartRxRingSize - offset;
+  if (first > count) {
+    first = count;
+  }
+  memcpy(buf, &uart->rx_ring[offset], first);
+  memcpy(&buf[first], uart->rx_ring, count - first);
+  uart->rx_tail = tail + (uint32_t)count;
+  return count;
+}
+
+static status_t rx_ring_fill_masked(ottf_console_t *console) {
+  const dif_uart_t *uart = &console->data.uart.dif;
+  dif_uart_irq_enable_snapshot_t snapshot;
+  TRY(dif_uart_irq_disable_all(uart, &snapshot));
+  status_t s = rx_ring_fill(console);
+  TRY(dif_uart_irq_restore_all(uart, &snapshot));
+  return s;
+}
+
+static status_t ottf_console_uart_read(void *io, char *buf, size_t len) {
   ottf_console_t *console = io;
-  uint8_t byte;
-  TRY(dif_uart_byte_receive_polled(&console->data.uart.dif, &byte));
+  if (len == 0) {
+    return OK_STATUS(0);
+  }
+  size_t count;
+  do {
+    TRY(rx_ring_fill_masked(console));
+    count = rx_ring_read(&console->data.uart, buf, len);
+  } while (count == 0);
   TRY(ottf_console_flow_control(io, kOttfConsoleFlowControlAuto));
-  return OK_STATUS(byte);
+  return OK_STATUS((int32_t)count);
+}
+
+static status_t ottf_console_uart_getc(void *io) {
+  char ch;
+  TRY(ottf_console_uart_read(io, &ch, 1));
+  return OK_STATUS((uint8_t)ch);
 }
 
 static size_t ottf_console_uart_sink(void *io, const char *buf, size_t len) {
   ottf_console_t *console = io;
-  for (size_t i = 0; i < len; ++i) {
-    if (dif_uart_byte_send_polled(&console->data.uart.dif, (uint8_t)buf[i]) !=
-        kDifOk) {
-      return i;
+  if (len == 0) {
+    return 0;
+  }
+  // Keep the TX FIFO topped up and only wait for the transmitter to go idle
+  // after the last byte, so that the data is on the wire when we return.
+  size_t sent = 0;
+  while (sent < len - 1) {
+    size_t written;
+    if (dif_uart_bytes_send(&console->data.uart.dif,
+                            (const uint8_t *)&buf[sent], len - 1 - sent,
+                            &written) != kDifOk) {
+      return sent;
     }
+    sent += written;
+  }
+  if (dif_uart_byte_send_polled(&console->data.uart.dif,
+                                (uint8_t)buf[sent]) != kDifOk) {
+    return sent;
   }
   return len;
 }
@@ -70,7 +166,11 @@ void ottf_console_configure_uart(ottf_console_t *console, uintptr_t base_addr) {
                              .rx_enable = kDifToggleEnabled,
                          }));
 
+  console->data.uart.flow_control_state = kOttfConsoleFlowControlNone;
+  console->data.uart.rx_head = 0;
+  console->data.uart.rx_tail = 0;
   console->getc = ottf_console_uart_getc;
+  console->read = ottf_console_uart_read;
   console->sink = ottf_console_uart_sink;
 }
 
@@ -111,6 +211,18 @@ void ottf_console_uart_flow_control_enable(ottf_console_t *console) {
   ottf_console_flow_control(console, kOttfConsoleFlowControlResume);
 }
 
+// The RX watermark interrupt is status type, so keep it disabled while flow
+// control is paused to avoid an infinite loop of ISRs with a full ring buffer.
+static void rx_watermark_irq_update(ottf_console_t *console) {
+  ottf_console_flow_control_t state = console->data.uart.flow_control_state;
+  if (state == kOttfConsoleFlowControlNone) {
+    return;
+  }
+  CHECK_DIF_OK(dif_uart_irq_set_enabled(
+      &console->data.uart.dif, kDifUartIrqRxWatermark,
+      dif_bool_to_toggle(state != kOttfConsoleFlowControlPause)));
+}
+
 // This version of the function is safe to call from within the ISR.
 static status_t manage_flow_control(ottf_console_t *console,
                                     ottf_console_flow_control_t ctrl) {
@@ -120,24 +232,15 @@ static status_t manage_flow_control(ottf_console_t *console,
     return OK_STATUS((int32_t)console->data.uart.flow_control_state);
   }
   if (ctrl == kOttfConsoleFlowControlAuto) {
-    uint32_t avail;
-    TRY(dif_uart_rx_bytes_available(uart, &avail));
-    if (avail < kFlowControlLowWatermark &&
+    uint32_t level = console->data.uart.rx_head - console->data.uart.rx_tail;
+    if (level < kFlowControlLowWatermark &&
         console->data.uart.flow_control_state !=
             kOttfConsoleFlowControlResume) {
-      // Enable RX watermark interrupt when RX FIFO level is below the
-      // watermark.
-      CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
-                                            kDifToggleEnabled));
       ctrl = kOttfConsoleFlowControlResume;
-    } else if (avail >= kFlowControlHighWatermark &&
+    } else if (level >= kFlowControlHighWatermark &&
                console->data.uart.flow_control_state !=
                    kOttfConsoleFlowControlPause) {
       ctrl = kOttfConsoleFlowControlPause;
-      // RX watermark interrupt is status type, so disable the interrupt whilst
-      // RX FIFO is above the watermark to avoid an inifite loop of ISRs.
-      CHECK_DIF_OK(dif_uart_irq_set_enabled(uart, kDifUartIrqRxWatermark,
-                                            kDifToggleDisabled));
     } else {
       return OK_STATUS((int32_t)console->data.uart.flow_control_state);
     }
@@ -155,7 +258,9 @@ bool ottf_console_uart_flow_control_isr(uint32_t *exc_info,
   bool rx;
   CHECK_DIF_OK(dif_uart_irq_is_pending(uart, kDifUartIrqRxWatermark, &rx));
   if (rx) {
+    CHECK_STATUS_OK(rx_ring_fill(console));
     manage_flow_control(console, kOttfConsoleFlowControlAuto);
+    rx_watermark_irq_update(console);
     CHECK_DIF_OK(dif_uart_irq_acknowledge(uart, kDifUartIrqRxWatermark));
     return true;
   }
@@ -172,5 +277,8 @@ status_t ottf_console_uart_flow_control(ottf_console_t *console,
   CHECK_DIF_OK(dif_uart_irq_disable_all(uart, &snapshot));
   status_t s = manage_flow_control(console, ctrl);
   CHECK_DIF_OK(dif_uart_irq_restore_all(uart, &snapshot));
+  // Restoring the snapshot undoes any change made to the RX watermark
+  // interrupt, so apply it afterwards.
+  rx_watermark_irq_update(console);
   return s;
 }
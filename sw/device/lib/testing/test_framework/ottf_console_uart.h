@@ -8,12 +8,25 @@
 #include "sw/device/lib/dif/dif_uart.h"
 #include "sw/device/lib/testing/test_framework/ottf_console_types.h"
 
+enum {
+  /**
+   * Size of the software RX ring buffer, must be a power of two.
+   */
+  kOttfConsoleUartRxRingSize = 256,
+};
+
 typedef struct ottf_console_uart {
   // DIF handle.
   dif_uart_t dif;
   // This variable is shared between the interrupt service handler and user
   // code.
   volatile ottf_console_flow_control_t flow_control_state;
+  // Software RX ring buffer. It is filled from the RX FIFO by the RX watermark
+  // interrupt handler when flow control is enabled and by the reader
+  // otherwise. `rx_head` and `rx_tail` are free-running counters.
+  uint8_t rx_ring[kOttfConsoleUartRxRingSize];
+  volatile uint32_t rx_head;
+  volatile uint32_t rx_tail;
 } ottf_console_uart_t;
 
 /**
@@ -28,9 +41,10 @@ void ottf_console_configure_uart(ottf_console_t *console, uintptr_t base_addr);
  * Enable flow control for the OTTF console.
  *
  * Enables flow control on the UART associated with the OTTF console. Flow
- * control is managed by enabling the RX watermark IRQ and sending a `Pause`
- * (aka XOFF) when the RX FIFO depth reaches 16 bytes.  A `Resume` (aka XON) is
- * sent when the RX FIFO has been drained to 4 bytes.
+ * control is managed by enabling the RX watermark IRQ, whose handler drains
+ * the RX FIFO into the console's software ring buffer, and sending a `Pause`
+ * (aka XOFF) when the ring buffer is three quarters full. A `Resume` (aka XON)
+ * is sent when the ring buffer has been drained to a quarter.
  *
  * This function configures UART interrupts at the PLIC and enables interrupts
  * at the CPU.
@@ -9,7 +9,10 @@
 #include "sw/device/lib/testing/test_framework/ottf_console.h"
 #include "sw/device/lib/ujson/ujson.h"
 
+// Read-ahead window shared by all ujson contexts on the main console.
+static ujson_rx_window_t console_rx;
+
 ujson_t ujson_ottf_console(void) {
-  return ujson_init(ottf_console_get(), ottf_console_getc, ottf_console_putbuf,
-                    ottf_console_flushbuf);
+  return ujson_init_read(ottf_console_get(), ottf_console_read, &console_rx,
+                         ottf_console_putbuf, ottf_console_flushbuf);
 }
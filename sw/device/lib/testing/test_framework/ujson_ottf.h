@@ -29,6 +29,14 @@ extern "C" {
 /**
  * Initializes and returns a ujson context linked to the OTTF console.
  *
+ * The context reads the console in blocks through a read-ahead window shared
+ * by all contexts returned by this function. Input should therefore not be
+ * mixed with direct calls to `ottf_console_getc`.
+ *
+ * The host may switch the context to the binary encoding (see
+ * `ujson_detect_framing`), which then lasts for the lifetime of the context,
+ * so a test should use a single context for the whole session.
+ *
  * @return An initialized ujson_t context.
  */
 ujson_t ujson_ottf_console(void);
@@ -67,14 +75,14 @@ ujson_t ujson_ottf_console(void);
  *
  * @param uj_ctx_ A `ujson_t` representing the IO context.
  */
-#define RESP_CRC(uj_ctx_)                         \
-  ({                                              \
-    uint32_t crc = ujson_crc32_finish(uj_ctx_);   \
-    TRY(ujson_putbuf(uj_ctx_, " CRC:", 5));       \
-    TRY(ujson_serialize_uint32_t(uj_ctx_, &crc)); \
-    TRY(ujson_putbuf(uj_ctx_, "\n", 1));          \
-    TRY(ujson_flushbuf(uj));                      \
-    OK_STATUS();                                  \
+#define RESP_CRC(uj_ctx_)                       \
+  ({                                            \
+    uint32_t crc = ujson_crc32_finish(uj_ctx_); \
+    TRY(ujson_putbuf(uj_ctx_, " CRC:", 5));     \
+    TRY(ujson_putbuf_decimal(uj_ctx_, crc));    \
+    TRY(ujson_putbuf(uj_ctx_, "\n", 1));        \
+    TRY(ujson_flushbuf(uj));                    \
+    OK_STATUS();                                \
   })
 
 /**
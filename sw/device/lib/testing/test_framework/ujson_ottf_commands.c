@@ -5,6 +5,7 @@
 #include "sw/device/lib/testing/test_framework/ujson_ottf_commands.h"
 
 #include "sw/device/lib/testing/json/mem.h"
+#include "sw/device/lib/testing/json/profile.h"
 #include "sw/device/lib/testing/test_framework/ujson_ottf.h"
 
 status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
@@ -24,6 +25,9 @@ status_t ujson_ottf_dispatch(ujson_t *uj, test_command_t command) {
     case kTestCommandMemWrite:
       RESP_ERR(uj, ujcmd_mem_write(uj));
       break;
+    case kTestCommandProfileDump:
+      RESP_ERR(uj, ujcmd_profile_dump(uj));
+      break;
     default:
       return UNIMPLEMENTED();
   }
@@ -63,6 +63,19 @@ UJSON_SERDE_STRUCT(Rect, rect, STRUCT_RECT);
     field(k, int32_t, 3, 5)
 UJSON_SERDE_STRUCT(Matrix, matrix, STRUCT_MATRIX);
 
+// Arrays of `uint8_t` are serialized as arrays of numbers in JSON and as
+// byte strings in the binary encoding:
+// typedef struct Blob {
+//     uint16_t id;
+//     uint8_t data[16];
+// } blob;
+// status_t ujson_serialize_blob(ujson_t *context, const blob *self);
+// status_t ujson_deserialize_blob(ujson_t *context, blob *self);
+#define STRUCT_BLOB(field, string) \
+    field(id, uint16_t) \
+    field(data, uint8_t, 16)
+UJSON_SERDE_STRUCT(Blob, blob, STRUCT_BLOB);
+
 /////////////////////////////////////////////////////////////////////////////
 // Automatic generation of enums with serialize/deserialize functions:
 //
@@ -12,6 +12,7 @@
 #include "sw/device/lib/ujson/test_helpers.h"
 #include "sw/device/lib/ujson/ujson.h"
 namespace {
+using test_helpers::FromHex;
 using test_helpers::SourceSink;
 
 TEST(Derive, FooSerialize) {
@@ -213,4 +214,100 @@ TEST(Derive, FuzzyBoolDeserialize) {
   EXPECT_EQ(ujson_crc32_finish(&uj), 0xe301b3ec);
 }
 
+TEST(Derive, FooBinary) {
+  foo expected = {-5, 150000, "Kilroy was here"};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_foo(&uj, &expected)));
+  EXPECT_EQ(ss.Sink(), "83241a000249f06f4b696c726f79207761732068657265");
+
+  // The host selects the binary encoding with a marker byte.
+  foo got{};
+  ss.Reset("\xc1" + FromHex(ss.Sink()));
+  uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_deserialize_foo(&uj, &got)));
+  EXPECT_TRUE(uj.binary);
+  EXPECT_EQ(memcmp(&got, &expected, sizeof(got)), 0);
+
+  // Structs with the wrong number of fields are rejected.
+  ss.Reset(FromHex("82241a000249f0"));
+  EXPECT_EQ(status_err(ujson_deserialize_foo(&uj, &got)), kInvalidArgument);
+}
+
+TEST(Derive, MatrixBinary) {
+  matrix expected = {
+      {{0, 1, 0, 0, 0}, {2, 3, 4, 5, 0}, {-1, 0, 0, 0, 0}},
+  };
+  matrix m{};
+  SourceSink ss(FromHex("818382000184020304058120"));
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  EXPECT_TRUE(status_ok(ujson_deserialize_matrix(&uj, &m)));
+  EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
+
+  ss.Reset();
+  EXPECT_TRUE(status_ok(ujson_serialize_matrix(&uj, &m)));
+  EXPECT_EQ(ss.Sink(), "8183850001000000850203040500852000000000");
+}
+
+TEST(Derive, BlobBinary) {
+  blob b = {0x1234, {0xde, 0xad, 0xbe, 0xef}};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_blob(&uj, &b)));
+  EXPECT_EQ(ss.Sink(), "8219123450deadbeef000000000000000000000000");
+
+  // Byte strings and arrays of numbers are both accepted.
+  blob expected = {7, {1, 2, 3}};
+  blob got{};
+  ss.Reset(FromHex("820743010203"));
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &got)));
+  EXPECT_EQ(memcmp(&got, &expected, sizeof(got)), 0);
+  got = {};
+  ss.Reset(FromHex("820783010203"));
+  EXPECT_TRUE(status_ok(ujson_deserialize_blob(&uj, &got)));
+  EXPECT_EQ(memcmp(&got, &expected, sizeof(got)), 0);
+
+  // Byte strings longer than the field are rejected.
+  ss.Reset(FromHex("8207510000000000000000000000000000000000"));
+  EXPECT_EQ(status_err(ujson_deserialize_blob(&uj, &got)), kOutOfRange);
+}
+
+TEST(Derive, DirectionBinary) {
+  direction d = kDirectionEast;
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_direction(&uj, &d)));
+  EXPECT_EQ(ss.Sink(), "6445617374");
+
+  ss.Reset();
+  d = static_cast<direction>(120);
+  EXPECT_TRUE(status_ok(ujson_serialize_direction(&uj, &d)));
+  EXPECT_EQ(ss.Sink(), "a168496e7456616c75651878");
+
+  ss.Reset(FromHex("6457657374"));
+  EXPECT_TRUE(status_ok(ujson_deserialize_direction(&uj, &d)));
+  EXPECT_EQ(d, kDirectionWest);
+
+  ss.Reset(FromHex("a168496e7456616c75651823"));
+  EXPECT_TRUE(status_ok(ujson_deserialize_direction(&uj, &d)));
+  EXPECT_EQ(d, static_cast<direction>(35));
+}
+
+TEST(Derive, FuzzyBoolBinary) {
+  fuzzy_bool d = static_cast<fuzzy_bool>(75);
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_fuzzy_bool(&uj, &d)));
+  EXPECT_EQ(ss.Sink(), "184b");
+
+  ss.Reset(FromHex("1864"));
+  EXPECT_TRUE(status_ok(ujson_deserialize_fuzzy_bool(&uj, &d)));
+  EXPECT_EQ(d, kFuzzyBoolTrue);
+}
+
 }  // namespace
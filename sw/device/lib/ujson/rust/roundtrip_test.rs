@@ -5,7 +5,10 @@
 use anyhow::Result;
 use crc::{CRC_32_ISO_HDLC, Crc};
 use opentitanlib::test_utils::status::Status;
+use opentitanlib::test_utils::ubin;
 use opentitanlib::with_unknown;
+use serde::Serialize;
+use serde::de::DeserializeOwned;
 use std::io::{Read, Write};
 use std::process::{Command, Stdio};
 
@@ -59,6 +62,43 @@ fn roundtrip(name: &str, data: &str, check_crc: bool) -> Result<String> {
     Ok(msg)
 }
 
+// Like `roundtrip`, but switches the client to the binary encoding first.
+// The client answers with the binary encoding in hex.
+fn roundtrip_binary<T: Serialize + DeserializeOwned>(name: &str, before: &T) -> Result<T> {
+    let mut command = Command::new(std::env::var("ROUNDTRIP_CLIENT")?);
+    command.args([name]);
+    let mut child = command
+        .stdin(Stdio::piped())
+        .stdout(Stdio::piped())
+        .stderr(Stdio::inherit())
+        .spawn()?;
+
+    let data = ubin::to_vec(before)?;
+    let crc32 = Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(&data);
+    eprintln!("sending: '{}'", hex::encode(&data));
+    let mut stdin = child.stdin.take().unwrap();
+    stdin.write_all(&[ubin::BINARY_FRAMING_MARKER])?;
+    stdin.write_all(&data)?;
+    stdin.write_all(format!("\n{crc32:x}\n").as_bytes())?;
+
+    let exit_code = child.wait()?;
+    if !exit_code.success() {
+        panic!("{exit_code}");
+    }
+
+    let mut msg = String::new();
+    let mut stdout = child.stdout.take().unwrap();
+    stdout.read_to_string(&mut msg)?;
+    eprintln!("recv: '{msg}'");
+    let (data, crc32_str) = msg.split_once('\n').expect("Expected two lines.");
+    let crc32 = u32::from_str_radix(crc32_str, 16)?;
+    assert_eq!(
+        crc32,
+        Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(data.as_bytes())
+    );
+    Ok(ubin::from_slice(&hex::decode(data)?)?)
+}
+
 #[cfg(test)]
 mod test {
     use super::*;
@@ -165,4 +205,39 @@ mod test {
         assert_eq!(before, after);
         Ok(())
     }
+
+    #[test]
+    fn test_binary() -> Result<()> {
+        let foo = example::Foo {
+            foo: -5,
+            bar: 10,
+            message: "Hello".into(),
+        };
+        assert_eq!(roundtrip_binary("foo", &foo)?, foo);
+
+        let matrix = example::Matrix {
+            k: [
+                [0, 1, 2, 3, 4].into(),
+                [100, 200, 300, 400, 500].into(),
+                [-1, -2, -3, -4, -5].into(),
+            ]
+            .into(),
+        };
+        assert_eq!(roundtrip_binary("matrix", &matrix)?, matrix);
+
+        let mut data = arrayvec::ArrayVec::new();
+        data.extend(0..16);
+        let blob = example::Blob { id: 0x1234, data };
+        assert_eq!(roundtrip_binary("blob", &blob)?, blob);
+
+        let direction = example::Direction::IntValue(45);
+        assert_eq!(roundtrip_binary("direction", &direction)?, direction);
+
+        let misc = example::Misc {
+            value: true,
+            status: Status::InvalidArgument("FOO".into(), 5),
+        };
+        assert_eq!(roundtrip_binary("misc", &misc)?, misc);
+        Ok(())
+    }
 }
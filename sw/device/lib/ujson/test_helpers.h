@@ -5,12 +5,24 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 #define OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
 #include "sw/device/lib/base/status.h"
 #include "sw/device/lib/ujson/ujson.h"
 
 namespace test_helpers {
+// Decodes a string of hex digits, such as the output of a binary serializer.
+inline std::string FromHex(const std::string &hex) {
+  std::string bytes;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    bytes.push_back(
+        static_cast<char>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+  }
+  return bytes;
+}
+
 class SourceSink {
  public:
   SourceSink() {}
@@ -23,8 +35,20 @@ class SourceSink {
                       nullptr);
   }
 
+  // Returns a context that reads at most `chunk` bytes per `read` call.
+  ujson_t UJsonRead(size_t chunk = kUjsonRxWindowSize) {
+    chunk_ = chunk;
+    rx_ = {};
+    return ujson_init_read((void *)this, &SourceSink::read, &rx_,
+                           &SourceSink::putbuf, nullptr);
+  }
+
+  size_t Reads() const { return reads_; }
+
   void Reset() {
     pos_ = 0;
+    reads_ = 0;
+    rx_ = {};
     sink_.clear();
   }
 
@@ -41,6 +65,17 @@ class SourceSink {
     }
   }
 
+  status_t Read(char *buf, size_t len) {
+    if (pos_ >= source_.size()) {
+      return RESOURCE_EXHAUSTED();
+    }
+    size_t n = std::min({len, chunk_, source_.size() - pos_});
+    memcpy(buf, source_.data() + pos_, n);
+    pos_ += n;
+    ++reads_;
+    return OK_STATUS(static_cast<int32_t>(n));
+  }
+
   status_t PutBuf(const char *buf, size_t len) {
     sink_.append(buf, len);
     return OK_STATUS();
@@ -51,11 +86,18 @@ class SourceSink {
     return static_cast<SourceSink *>(self)->GetChar();
   }
 
+  static status_t read(void *self, char *buf, size_t len) {
+    return static_cast<SourceSink *>(self)->Read(buf, len);
+  }
+
   static status_t putbuf(void *self, const char *buf, size_t len) {
     return static_cast<SourceSink *>(self)->PutBuf(buf, len);
   }
 
   size_t pos_ = 0;
+  size_t chunk_ = kUjsonRxWindowSize;
+  size_t reads_ = 0;
+  ujson_rx_window_t rx_ = {};
   std::string source_;
   std::string sink_;
 };
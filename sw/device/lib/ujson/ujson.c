@@ -23,9 +23,52 @@ ujson_t ujson_init(void *context, status_t (*getc)(void *),
   return u;
 }
 
-void ujson_crc32_reset(ujson_t *uj) { crc32_init(&uj->crc32); }
+ujson_t ujson_init_read(void *context,
+                        status_t (*read)(void *, char *, size_t),
+                        ujson_rx_window_t *rx,
+                        status_t (*putbuf)(void *, const char *, size_t),
+                        status_t (*flushbuf)(void *)) {
+  ujson_t u = UJSON_INIT(context, NULL, putbuf, flushbuf);
+  u.read = read;
+  u.rx = rx;
+  return u;
+}
+
+// Adds the bytes consumed from the read-ahead window since the last call to
+// the CRC32.
+static void rx_crc32_update(ujson_t *uj) {
+  ujson_rx_window_t *rx = uj->rx;
+  if (rx != NULL && rx->pos > rx->crc_pos) {
+    crc32_add(&uj->crc32, &rx->data[rx->crc_pos], rx->pos - rx->crc_pos);
+    rx->crc_pos = rx->pos;
+  }
+}
 
-uint32_t ujson_crc32_finish(ujson_t *uj) { return crc32_finish(&uj->crc32); }
+static status_t rx_refill(ujson_t *uj) {
+  ujson_rx_window_t *rx = uj->rx;
+  rx_crc32_update(uj);
+  size_t len =
+      (size_t)TRY(uj->read(uj->io_context, rx->data, sizeof(rx->data)));
+  if (len == 0 || len > sizeof(rx->data)) {
+    return INTERNAL();
+  }
+  rx->pos = 0;
+  rx->end = len;
+  rx->crc_pos = 0;
+  return OK_STATUS();
+}
+
+void ujson_crc32_reset(ujson_t *uj) {
+  crc32_init(&uj->crc32);
+  if (uj->rx != NULL) {
+    uj->rx->crc_pos = uj->rx->pos;
+  }
+}
+
+uint32_t ujson_crc32_finish(ujson_t *uj) {
+  rx_crc32_update(uj);
+  return crc32_finish(&uj->crc32);
+}
 
 status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len) {
   crc32_add(&uj->crc32, buf, len);
@@ -47,6 +90,12 @@ status_t ujson_getc(ujson_t *uj) {
   if (buffer >= 0) {
     uj->buffer = -1;
     return OK_STATUS(buffer);
+  } else if (uj->rx != NULL) {
+    ujson_rx_window_t *rx = uj->rx;
+    if (rx->pos == rx->end) {
+      TRY(rx_refill(uj));
+    }
+    return OK_STATUS((uint8_t)rx->data[rx->pos++]);
   } else {
     status_t s = uj->getc(uj->io_context);
     if (!status_err(s)) {
@@ -60,10 +109,131 @@ status_t ujson_ungetc(ujson_t *uj, char ch) {
   if (uj->buffer >= 0) {
     return FAILED_PRECONDITION();
   }
-  uj->buffer = ch;
+  uj->buffer = (uint8_t)ch;
   return OK_STATUS();
 }
 
+// Reads `len` bytes of binary input, discarding them if `buf` is NULL.
+static status_t bin_read(ujson_t *uj, uint8_t *buf, size_t len) {
+  while (len > 0) {
+    ujson_rx_window_t *rx = uj->rx;
+    if (rx != NULL && uj->buffer < 0 && rx->pos < rx->end) {
+      size_t copy = rx->end - rx->pos;
+      if (copy > len) {
+        copy = len;
+      }
+      if (buf != NULL) {
+        memcpy(buf, &rx->data[rx->pos], copy);
+        buf += copy;
+      }
+      rx->pos += copy;
+      len -= copy;
+    } else {
+      uint8_t ch = (uint8_t)TRY(ujson_getc(uj));
+      if (buf != NULL) {
+        *buf++ = ch;
+      }
+      --len;
+    }
+  }
+  return OK_STATUS();
+}
+
+static const char hex[] = "0123456789abcdef";
+
+// Writes binary output. Each byte is sent as two hex digits so that responses
+// remain lines of text on the console.
+static status_t bin_write(ujson_t *uj, const void *buf, size_t len) {
+  const uint8_t *bytes = (const uint8_t *)buf;
+  char text[32];
+  while (len > 0) {
+    size_t n = 0;
+    while (len > 0 && n < sizeof(text)) {
+      text[n++] = hex[*bytes >> 4];
+      text[n++] = hex[*bytes & 0xf];
+      ++bytes;
+      --len;
+    }
+    TRY(ujson_putbuf(uj, text, n));
+  }
+  return OK_STATUS();
+}
+
+status_t ujson_bin_put_head(ujson_t *uj, ujson_bin_major_t major,
+                            uint64_t value) {
+  uint8_t buf[9];
+  size_t len;
+  if (value < 24) {
+    buf[0] = (uint8_t)value;
+    len = 0;
+  } else if (value <= UINT8_MAX) {
+    buf[0] = 24;
+    len = 1;
+  } else if (value <= UINT16_MAX) {
+    buf[0] = 25;
+    len = 2;
+  } else if (value <= UINT32_MAX) {
+    buf[0] = 26;
+    len = 4;
+  } else {
+    buf[0] = 27;
+    len = 8;
+  }
+  buf[0] |= (uint8_t)(major << 5);
+  for (size_t i = len; i > 0; --i) {
+    buf[i] = (uint8_t)value;
+    value >>= 8;
+  }
+  return bin_write(uj, buf, len + 1);
+}
+
+status_t ujson_bin_get_head(ujson_t *uj, ujson_bin_major_t major,
+                            uint64_t *value) {
+  uint8_t head = (uint8_t)TRY(ujson_getc(uj));
+  if (head >> 5 != major) {
+    TRY(ujson_ungetc(uj, (char)head));
+    return NOT_FOUND();
+  }
+  uint8_t info = head & 0x1f;
+  if (info < 24) {
+    *value = info;
+    return OK_STATUS();
+  }
+  if (info > 27) {
+    // Indefinite lengths and reserved values are not supported.
+    return OUT_OF_RANGE();
+  }
+  uint8_t buf[8];
+  size_t len = 1u << (info - 24);
+  TRY(bin_read(uj, buf, len));
+  *value = 0;
+  for (size_t i = 0; i < len; ++i) {
+    *value = (*value << 8) | buf[i];
+  }
+  return OK_STATUS();
+}
+
+status_t ujson_bin_peek(ujson_t *uj) {
+  uint8_t head = (uint8_t)TRY(ujson_getc(uj));
+  TRY(ujson_ungetc(uj, (char)head));
+  return OK_STATUS(head >> 5);
+}
+
+status_t ujson_bin_put_bytes(ujson_t *uj, const void *buf, size_t len) {
+  TRY(ujson_bin_put_head(uj, kUjsonBinBytes, len));
+  return bin_write(uj, buf, len);
+}
+
+status_t ujson_bin_get_bytes(ujson_t *uj, void *buf, size_t len) {
+  uint64_t n;
+  TRY(ujson_bin_get_head(uj, kUjsonBinBytes, &n));
+  if (n > len) {
+    return OUT_OF_RANGE();
+  }
+  TRY(bin_read(uj, buf, (size_t)n));
+  return OK_STATUS((int32_t)n);
+}
+
 bool ujson_streq(const char *a, const char *b) {
   while (*a && *b && *a == *b) {
     ++a;
@@ -81,6 +251,20 @@ static status_t consume_whitespace(ujson_t *uj) {
   return OK_STATUS(ch);
 }
 
+status_t ujson_detect_framing(ujson_t *uj) {
+  if (uj->binary) {
+    return OK_STATUS();
+  }
+  char ch = (char)TRY(consume_whitespace(uj));
+  if ((uint8_t)ch == kUjsonBinaryFramingMarker) {
+    uj->binary = true;
+    // The marker is not part of the message that follows it.
+    ujson_crc32_reset(uj);
+    return OK_STATUS();
+  }
+  return ujson_ungetc(uj, ch);
+}
+
 static status_t consume_hexdigit(ujson_t *uj) {
   int ch = TRY(ujson_getc(uj));
   if (ch >= '0' && ch <= '9') {
@@ -118,12 +302,44 @@ status_t ujson_consume_maybe(ujson_t *uj, char ch) {
   return OK_STATUS(1);
 }
 
+// Reads a text string of the binary encoding, truncating it to `len - 1`
+// characters.
+static status_t bin_parse_text(ujson_t *uj, char *str, size_t len) {
+  uint64_t n;
+  TRY(ujson_bin_get_head(uj, kUjsonBinText, &n));
+  size_t copy = n < len - 1 ? (size_t)n : len - 1;
+  TRY(bin_read(uj, (uint8_t *)str, copy));
+  TRY(bin_read(uj, NULL, (size_t)n - copy));
+  str[copy] = '\0';
+  return OK_STATUS((int32_t)copy);
+}
+
 status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
+  if (uj->binary) {
+    return bin_parse_text(uj, str, len);
+  }
   char ch;
   int n = 0;
   len--;  // One char for the nul terminator.
   TRY(ujson_consume(uj, '"'));
   while (true) {
+    // Copy runs of unescaped characters straight out of the read-ahead window.
+    ujson_rx_window_t *rx = uj->rx;
+    if (rx != NULL && uj->buffer < 0) {
+      size_t run = rx->pos;
+      while (run < rx->end && rx->data[run] != '"' && rx->data[run] != '\\') {
+        ++run;
+      }
+      size_t copy = run - rx->pos;
+      if (copy > len) {
+        copy = len;
+      }
+      memcpy(str, &rx->data[rx->pos], copy);
+      str += copy;
+      len -= copy;
+      n += (int)copy;
+      rx->pos = run;
+    }
     ch = (char)TRY(ujson_getc(uj));
     if (ch == '\"')
       break;
@@ -166,7 +382,27 @@ status_t ujson_parse_qs(ujson_t *uj, char *str, size_t len) {
   return OK_STATUS(n);
 }
 
+// Reads an integer of the binary encoding.
+static status_t bin_parse_integer(ujson_t *uj, void *result, size_t rsz) {
+  uint64_t value;
+  if (TRY(ujson_bin_peek(uj)) == kUjsonBinNegInt) {
+    TRY(ujson_bin_get_head(uj, kUjsonBinNegInt, &value));
+    if (value > INT64_MAX) {
+      return OUT_OF_RANGE();
+    }
+    int64_t neg_value = -1 - (int64_t)value;
+    memcpy(result, &neg_value, rsz);
+  } else {
+    TRY(ujson_bin_get_head(uj, kUjsonBinUint, &value));
+    memcpy(result, &value, rsz);
+  }
+  return OK_STATUS();
+}
+
 status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
+  if (uj->binary) {
+    return bin_parse_integer(uj, result, rsz);
+  }
   char ch = (char)TRY(consume_whitespace(uj));
   bool neg = false;
 
@@ -212,6 +448,16 @@ status_t ujson_parse_integer(ujson_t *uj, void *result, size_t rsz) {
 }
 
 status_t ujson_deserialize_bool(ujson_t *uj, bool *value) {
+  if (uj->binary) {
+    // CBOR encodes false and true as the simple values 20 and 21.
+    uint64_t simple;
+    TRY(ujson_bin_get_head(uj, kUjsonBinSimple, &simple));
+    if (simple != 20 && simple != 21) {
+      return NOT_FOUND();
+    }
+    *value = simple == 21;
+    return OK_STATUS();
+  }
   char got = (char)TRY(consume_whitespace(uj));
   if (got == 't') {
     TRY(ujson_consume(uj, 'r'));
@@ -259,9 +505,12 @@ status_t ujson_deserialize_int8_t(ujson_t *uj, int8_t *value) {
   return ujson_parse_integer(uj, (void *)value, sizeof(*value));
 }
 
-static const char hex[] = "0123456789abcdef";
-
 status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
+  if (uj->binary) {
+    size_t len = strlen(buf);
+    TRY(ujson_bin_put_head(uj, kUjsonBinText, len));
+    return bin_write(uj, buf, len);
+  }
   uint8_t ch;
   TRY(ujson_putbuf(uj, "\"", 1));
   while ((ch = (uint8_t)*buf) != '\0') {
@@ -304,6 +553,11 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
 
 static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
                                           bool neg) {
+  if (uj->binary) {
+    // Negative integers are encoded as `-1 - value`, which is `~value`.
+    return neg ? ujson_bin_put_head(uj, kUjsonBinNegInt, ~value)
+               : ujson_bin_put_head(uj, kUjsonBinUint, value);
+  }
   char buf[24];
   char *end = buf + sizeof(buf);
   size_t len = 0;
@@ -327,8 +581,24 @@ static status_t ujson_serialize_integer64(ujson_t *uj, uint64_t value,
   return OK_STATUS();
 }
 
+status_t ujson_putbuf_decimal(ujson_t *uj, uint32_t value) {
+  char buf[10];
+  char *end = buf + sizeof(buf);
+  size_t len = 0;
+  do {
+    *--end = '0' + value % 10;
+    value /= 10;
+    ++len;
+  } while (value);
+  return ujson_putbuf(uj, end, len);
+}
+
 static status_t ujson_serialize_integer32(ujson_t *uj, uint32_t value,
                                           bool neg) {
+  if (uj->binary) {
+    return ujson_serialize_integer64(
+        uj, neg ? (uint64_t)(int64_t)(int32_t)value : value, neg);
+  }
   char buf[24];
   char *end = buf + sizeof(buf);
   size_t len = 0;
@@ -351,6 +621,9 @@ static status_t ujson_serialize_integer32(ujson_t *uj, uint32_t value,
 }
 
 status_t ujson_serialize_bool(ujson_t *uj, const bool *value) {
+  if (uj->binary) {
+    return ujson_bin_put_head(uj, kUjsonBinSimple, *value ? 21 : 20);
+  }
   if (*value) {
     TRY(ujson_putbuf(uj, "true", 4));
   } else {
@@ -398,7 +671,39 @@ status_t ujson_serialize_int8_t(ujson_t *uj, const int8_t *value) {
   return ujson_serialize_integer32(uj, (uint32_t)*value, *value < 0);
 }
 
+// Reads a `status_t` of the binary encoding: a map with a single entry from
+// the status code to either the argument or an array of the module and the
+// argument.
+static status_t bin_deserialize_status(ujson_t *uj, status_t *value) {
+  private_status_t code;
+  uint32_t module_id = 0;
+  uint32_t arg = 0;
+  uint64_t n;
+  TRY(ujson_bin_get_head(uj, kUjsonBinMap, &n));
+  if (n != 1) {
+    return INVALID_ARGUMENT();
+  }
+  TRY(ujson_deserialize_private_status_t(uj, &code));
+  if (TRY(ujson_bin_peek(uj)) == kUjsonBinArray) {
+    TRY(ujson_bin_get_head(uj, kUjsonBinArray, &n));
+    if (n != 2) {
+      return INVALID_ARGUMENT();
+    }
+    char module[4];
+    TRY(ujson_parse_qs(uj, module, sizeof(module)));
+    module_id = MAKE_MODULE_ID(module[0], module[1], module[2]);
+  }
+  TRY(ujson_deserialize_uint32_t(uj, &arg));
+  *value =
+      status_create((absl_status_t)code, module_id, __FILE__, (int32_t)arg);
+  return OK_STATUS();
+}
+
 status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value) {
+  TRY(ujson_detect_framing(uj));
+  if (uj->binary) {
+    return bin_deserialize_status(uj, value);
+  }
   private_status_t code;
   uint32_t module_id = 0;
   uint32_t arg = 0;
@@ -422,6 +727,20 @@ status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value) {
 }
 
 status_t ujson_serialize_status_t(ujson_t *uj, const status_t *value) {
+  if (uj->binary) {
+    char mod[4] = {0};
+    int32_t arg;
+    const char *code;
+    bool err = status_extract(*value, &code, &arg, mod);
+    TRY(ujson_bin_put_head(uj, kUjsonBinMap, 1));
+    TRY(ujson_serialize_string(uj, code));
+    if (err) {
+      TRY(ujson_bin_put_head(uj, kUjsonBinArray, 2));
+      TRY(ujson_serialize_string(uj, mod));
+    }
+    uint32_t uarg = (uint32_t)arg;
+    return ujson_serialize_uint32_t(uj, &uarg);
+  }
   buffer_sink_t out = {
       .data = uj,
       .sink = (sink_func_ptr)ujson_putbuf_sink,
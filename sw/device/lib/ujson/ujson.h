@@ -11,6 +11,55 @@
 extern "C" {
 #endif
 
+enum {
+  /** Size of the read-ahead window used with a block `read` function. */
+  kUjsonRxWindowSize = 64,
+  /**
+   * Byte sent by the host to switch a session to the binary encoding.
+   *
+   * 0xc1 never appears in UTF-8 text, so it cannot start a JSON value.
+   */
+  kUjsonBinaryFramingMarker = 0xc1,
+};
+
+/**
+ * Major types of the binary encoding.
+ *
+ * The binary encoding is a subset of CBOR (RFC 8949): every item starts with
+ * a head holding the major type in its top three bits and an argument (a
+ * value, a length or an element count) either in its low five bits or in the
+ * 1, 2, 4 or 8 big-endian bytes that follow. Structs are encoded as arrays of
+ * their fields in declaration order, `uint8_t` arrays as byte strings and
+ * enums as the name of the variant, like in JSON.
+ */
+typedef enum ujson_bin_major {
+  kUjsonBinUint = 0,
+  kUjsonBinNegInt = 1,
+  kUjsonBinBytes = 2,
+  kUjsonBinText = 3,
+  kUjsonBinArray = 4,
+  kUjsonBinMap = 5,
+  kUjsonBinSimple = 7,
+} ujson_bin_major_t;
+
+/**
+ * Read-ahead window for contexts that read their input in blocks.
+ *
+ * The window lives outside of `ujson_t` so that every context reading from
+ * the same input can share it: bytes fetched ahead of the parser are not lost
+ * when a context goes out of scope and another one is created.
+ */
+typedef struct ujson_rx_window {
+  /** Bytes fetched from the input. */
+  char data[kUjsonRxWindowSize];
+  /** Index of the next byte to hand to the parser. */
+  size_t pos;
+  /** Number of valid bytes in `data`. */
+  size_t end;
+  /** Index of the first consumed byte not yet added to the CRC32. */
+  size_t crc_pos;
+} ujson_rx_window_t;
+
 /**
  * Input/Output context for ujson.
  */
@@ -23,10 +72,25 @@ typedef struct ujson {
   status_t (*flushbuf)(void *);
   /** A pointer to an IO function for reading data from the input. */
   status_t (*getc)(void *);
+  /**
+   * An optional IO function for reading up to `len` bytes from the input.
+   *
+   * It must block until at least one byte is available and return the number
+   * of bytes read. When set, `getc` is not used.
+   */
+  status_t (*read)(void *, char *, size_t);
+  /** Read-ahead window for `read`. */
+  ujson_rx_window_t *rx;
   /** An internal single character buffer for ungetting a character. */
   int16_t buffer;
   /** Holds the rolling CRC32 of characters that are sent and received.*/
   uint32_t crc32;
+  /**
+   * Whether the session uses the binary encoding.
+   *
+   * Binary output is hex-encoded so that responses remain lines of text.
+   */
+  bool binary;
 } ujson_t;
 
 // clang-format off
@@ -53,6 +117,24 @@ ujson_t ujson_init(void *context, status_t (*getc)(void *),
                    status_t (*putbuf)(void *, const char *, size_t),
                    status_t (*flushbuf)(void *));
 
+/**
+ * Initializes and returns a ujson context that reads its input in blocks.
+ *
+ * The parser consumes characters directly from `rx` and only calls `read` when
+ * the window runs dry, and the CRC32 is updated a window at a time.
+ *
+ * @param context An IO context for the `read` and `putbuf` functions.
+ * @param read A function to read a block of data from the input.
+ * @param rx The read-ahead window; shared by all contexts on the same input.
+ * @param putbuf A function to write a buffer to the output.
+ * @return An initialized ujson_t context.
+ */
+ujson_t ujson_init_read(void *context,
+                        status_t (*read)(void *, char *, size_t),
+                        ujson_rx_window_t *rx,
+                        status_t (*putbuf)(void *, const char *, size_t),
+                        status_t (*flushbuf)(void *));
+
 /**
  * Gets a single character from the input.
  *
@@ -202,6 +284,83 @@ status_t ujson_deserialize_bool(ujson_t *uj, bool *value);
  */
 status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value);
 
+/**
+ * Switches the context to the binary encoding if the host asked for it.
+ *
+ * In JSON mode, consumes whitespace and checks whether the next character is
+ * `kUjsonBinaryFramingMarker`. If so, the marker is consumed and the rest of
+ * the session uses the binary encoding. Called at the start of every
+ * generated deserializer.
+ *
+ * @param uj A ujson IO context.
+ * @return OK or an error.
+ */
+status_t ujson_detect_framing(ujson_t *uj);
+
+/**
+ * Writes the head of a binary item.
+ *
+ * @param uj A ujson IO context.
+ * @param major The major type of the item.
+ * @param value The argument of the item.
+ * @return OK or an error.
+ */
+status_t ujson_bin_put_head(ujson_t *uj, ujson_bin_major_t major,
+                            uint64_t value);
+
+/**
+ * Reads the head of a binary item.
+ *
+ * If the item is not of the expected major type, it is left in the input and
+ * `kNotFound` is returned.
+ *
+ * @param uj A ujson IO context.
+ * @param major The expected major type.
+ * @param[out] value The argument of the item.
+ * @return OK or an error.
+ */
+status_t ujson_bin_get_head(ujson_t *uj, ujson_bin_major_t major,
+                            uint64_t *value);
+
+/**
+ * Returns the major type of the next binary item without consuming it.
+ *
+ * @param uj A ujson IO context.
+ * @return The `ujson_bin_major_t` of the next item or an error.
+ */
+status_t ujson_bin_peek(ujson_t *uj);
+
+/**
+ * Writes a byte string.
+ *
+ * @param uj A ujson IO context.
+ * @param buf The bytes to write.
+ * @param len The number of bytes.
+ * @return OK or an error.
+ */
+status_t ujson_bin_put_bytes(ujson_t *uj, const void *buf, size_t len);
+
+/**
+ * Reads a byte string.
+ *
+ * @param uj A ujson IO context.
+ * @param[out] buf Buffer to read into.
+ * @param len The size of `buf`. Longer byte strings are rejected.
+ * @return The number of bytes read or an error.
+ */
+status_t ujson_bin_get_bytes(ujson_t *uj, void *buf, size_t len);
+
+/**
+ * Writes an integer as decimal text, regardless of the encoding.
+ *
+ * This is meant for the text framing around messages, such as the CRC.
+ *
+ * @param uj A ujson IO context.
+ * @param value The value to write.
+ * @return OK or an error.
+ */
+status_t ujson_putbuf_decimal(ujson_t *uj, uint32_t value);
+
 /**
  * Serialize a string.
  *
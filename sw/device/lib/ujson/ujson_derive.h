@@ -74,6 +74,10 @@
 // Helper to count number of fields.
 #define ujson_count(name_, type_, ...) +1
 
+// Helper to detect arrays that are encoded as byte strings in binary mode.
+#define ujson_is_byte_type(type_) \
+    _Generic((type_ *)0, uint8_t *: true, default: false)
+
 //////////////////////////////////////////////////////////////////////
 // Serialize Implementation
 //////////////////////////////////////////////////////////////////////
@@ -119,9 +123,56 @@
         if (--nfield) TRY(ujson_putbuf(uj, ",", 1)); \
     }
 
+// In binary mode, structs are arrays of their fields in declaration order and
+// the innermost dimension of `uint8_t` arrays is a byte string.
+#define ujson_bin_ser_loop_indirect() ujson_bin_ser_loop
+#define ujson_bin_ser_loop(bytes, expr, count, ...) \
+    OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+    ( /*then*/ \
+        if (bytes) { \
+            TRY(ujson_bin_put_bytes(uj, p, count)); \
+            p += count; \
+        } else { \
+            TRY(ujson_bin_put_head(uj, kUjsonBinArray, count)); \
+            for(size_t x=0; x < count; ++x) { expr; } \
+        } \
+    , /*else*/ \
+        TRY(ujson_bin_put_head(uj, kUjsonBinArray, count)); \
+        for(size_t x=0; x < count; ++x) { \
+            OT_OBSTRUCT(ujson_bin_ser_loop_indirect)()(bytes, expr, __VA_ARGS__) \
+        } \
+    ) /*endif*/
+
+#define ujson_bin_ser_field(name_, type_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_serialize_##type_(uj, &self->name_)); \
+        , /*else*/ \
+            const type_ *p = (const type_*)self->name_; \
+            OT_EVAL(ujson_bin_ser_loop(ujson_is_byte_type(type_), \
+                    TRY(ujson_serialize_##type_(uj, p++)), __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
+#define ujson_bin_ser_string(name_, size_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_serialize_string(uj, self->name_)); \
+        , /*else*/ \
+            const char *p = (const char*)self->name_; \
+            OT_EVAL(ujson_bin_ser_loop(false, \
+                    TRY(ujson_serialize_string(uj, p)); p+=size_, __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
 #define UJSON_IMPL_SERIALIZE_STRUCT(name_, decl_) \
     status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
         size_t nfield = decl_(ujson_count, ujson_count); \
+        if (uj->binary) { \
+            TRY(ujson_bin_put_head(uj, kUjsonBinArray, nfield)); \
+            decl_(ujson_bin_ser_field, ujson_bin_ser_string) \
+            return OK_STATUS(); \
+        } \
         TRY(ujson_putbuf(uj, "{", 1)); \
         decl_(ujson_ser_field, ujson_ser_string) \
         TRY(ujson_putbuf(uj, "}", 1)); \
@@ -141,6 +192,10 @@
                 const uint32_t value = (uint32_t)(*self); \
                 if (ujson_get_flags(__VA_ARGS__) & WITH_UNKNOWN) { \
                     TRY(ujson_serialize_uint32_t(uj, &value)); \
+                } else if (uj->binary) { \
+                    TRY(ujson_bin_put_head(uj, kUjsonBinMap, 1)); \
+                    TRY(ujson_serialize_string(uj, RUST_ENUM_INTVALUE_STR)); \
+                    TRY(ujson_serialize_uint32_t(uj, &value)); \
                 } else { \
                     TRY(ujson_putbuf(uj, \
                         "{\"" RUST_ENUM_INTVALUE_STR "\":", \
@@ -201,10 +256,67 @@
         ) /*endif*/ \
     }
 
+// Arrays shorter than the field leave the remaining elements untouched, like
+// in JSON. Byte strings are accepted wherever an array of `uint8_t` is.
+#define ujson_bin_de_loop_indirect() ujson_bin_de_loop
+#define ujson_bin_de_loop(bytes, mult, expr, count, ...) { \
+    uint64_t n; \
+    OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+    ( /*then*/ \
+        if (bytes && TRY(ujson_bin_peek(uj)) == kUjsonBinBytes) { \
+            TRY(ujson_bin_get_bytes(uj, p, count)); \
+            p += count; \
+        } else { \
+            TRY(ujson_bin_get_head(uj, kUjsonBinArray, &n)); \
+            if (n > count) return OUT_OF_RANGE(); \
+            for(size_t i=0; i < n; ++i) { expr; } \
+            p += (count - n) * mult; \
+        } \
+    , /*else*/ \
+        TRY(ujson_bin_get_head(uj, kUjsonBinArray, &n)); \
+        if (n > count) return OUT_OF_RANGE(); \
+        for(size_t x=0; x < n; ++x) { \
+            OT_OBSTRUCT(ujson_bin_de_loop_indirect)()(bytes, mult, expr, __VA_ARGS__) \
+        } \
+    ) /*endif*/ \
+    }
+
+#define ujson_bin_de_field(name_, type_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_deserialize_##type_(uj, &self->name_)); \
+        , /*else*/ \
+            type_ *p = (type_*)self->name_; \
+            OT_EVAL(ujson_bin_de_loop(ujson_is_byte_type(type_), 1, \
+                TRY(ujson_deserialize_##type_(uj, p++)), __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
+#define ujson_bin_de_string(name_, size_, ...) { \
+        OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
+        ( /*then*/ \
+            TRY(ujson_parse_qs(uj, self->name_, sizeof(self->name_))); \
+        , /*else*/ \
+            char *p = (char*)self->name_; \
+            OT_EVAL(ujson_bin_de_loop(false, size_, \
+                TRY(ujson_parse_qs(uj, p, size_)); p+=size_, __VA_ARGS__)) \
+        ) /*endif*/ \
+    }
+
 #define UJSON_IMPL_DESERIALIZE_STRUCT(name_, decl_) \
     status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
         size_t nfield = 0; \
         char key[128]; \
+        TRY(ujson_detect_framing(uj)); \
+        if (uj->binary) { \
+            uint64_t n; \
+            TRY(ujson_bin_get_head(uj, kUjsonBinArray, &n)); \
+            if (n != (decl_(ujson_count, ujson_count))) { \
+                return INVALID_ARGUMENT(); \
+            } \
+            decl_(ujson_bin_de_field, ujson_bin_de_string) \
+            return OK_STATUS(); \
+        } \
         TRY(ujson_consume(uj, '{')); \
         while(TRY(ujson_consume_maybe(uj, '}')) == 0) { \
             if (nfield++ > 0) { \
@@ -228,23 +340,40 @@
 #define UJSON_IMPL_DESERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
         char value[128]; \
-        if (TRY(ujson_consume_maybe(uj, '"'))) { \
+        bool by_name = false; \
+        bool int_value = false; \
+        TRY(ujson_detect_framing(uj)); \
+        if (uj->binary) { \
+            int32_t major = TRY(ujson_bin_peek(uj)); \
+            by_name = major == kUjsonBinText; \
+            if (major == kUjsonBinMap) { \
+                uint64_t n; \
+                TRY(ujson_bin_get_head(uj, kUjsonBinMap, &n)); \
+                if (n != 1) return INVALID_ARGUMENT(); \
+                int_value = true; \
+            } \
+        } else if (TRY(ujson_consume_maybe(uj, '"'))) { \
             TRY(ujson_ungetc(uj, '"')); \
+            by_name = true; \
+        } else { \
+            int_value = TRY(ujson_consume_maybe(uj, '{')); \
+        } \
+        if (by_name) { \
             TRY(ujson_parse_qs(uj, value, sizeof(value))); \
             if (0) {} \
             decl_(formal_name_, ujson_de_enum) \
             else { \
                 return INVALID_ARGUMENT(); \
             } \
-        } else if(TRY(ujson_consume_maybe(uj, '{'))) { \
+        } else if (int_value) { \
             TRY(ujson_parse_qs(uj, value, sizeof(value))); \
-            TRY(ujson_consume(uj, ':')); \
+            if (!uj->binary) TRY(ujson_consume(uj, ':')); \
             if (ujson_streq(value, RUST_ENUM_INTVALUE_STR)) { \
                 TRY(ujson_deserialize_uint32_t(uj, (uint32_t*)self)); \
             } else { \
                 return INVALID_ARGUMENT(); \
             } \
-            TRY(ujson_consume(uj, '}')); \
+            if (!uj->binary) TRY(ujson_consume(uj, '}')); \
         } else { \
             TRY(ujson_deserialize_uint32_t(uj, (uint32_t*)self)); \
         } \
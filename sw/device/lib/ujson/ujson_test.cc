@@ -11,6 +11,7 @@
 #include "sw/device/lib/ujson/test_helpers.h"
 
 namespace {
+using test_helpers::FromHex;
 using test_helpers::SourceSink;
 
 TEST(UJson, GetC) {
@@ -265,4 +266,239 @@ TEST(UJson, DeerializeStatus) {
   EXPECT_EQ(arg, 77);
 }
 
+TEST(UJson, ReadGetC) {
+  SourceSink ss("abc123");
+  ujson_t uj = ss.UJsonRead(4);
+
+  EXPECT_EQ(ujson_getc(&uj).value, 'a');
+  EXPECT_EQ(ujson_getc(&uj).value, 'b');
+  EXPECT_EQ(ujson_getc(&uj).value, 'c');
+  EXPECT_EQ(status_err(ujson_ungetc(&uj, 'd')), kOk);
+  EXPECT_EQ(ujson_getc(&uj).value, 'd');
+  EXPECT_EQ(ujson_getc(&uj).value, '1');
+  EXPECT_EQ(ujson_getc(&uj).value, '2');
+  EXPECT_EQ(ujson_getc(&uj).value, '3');
+  EXPECT_EQ(status_err(ujson_getc(&uj)), kResourceExhausted);
+  EXPECT_EQ(ss.Reads(), 2);
+}
+
+TEST(UJson, ReadSharedWindow) {
+  SourceSink ss("12 34");
+  ujson_t uj = ss.UJsonRead();
+  uint32_t val;
+
+  // A second context on the same window sees the bytes the first one fetched.
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 12);
+  ujson_t uj2 = uj;
+  uj2.buffer = -1;
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj2, &val)));
+  EXPECT_EQ(val, 34);
+  EXPECT_EQ(ss.Reads(), 1);
+}
+
+TEST(UJson, BinaryHead) {
+  const std::pair<uint64_t, std::string> kHeads[] = {
+      {0, "00"},
+      {23, "17"},
+      {24, "1818"},
+      {255, "18ff"},
+      {256, "190100"},
+      {65536, "1a00010000"},
+      {1ULL << 32, "1b0000000100000000"},
+  };
+  for (const auto &[value, hex] : kHeads) {
+    SourceSink ss;
+    ujson_t uj = ss.UJson();
+    EXPECT_TRUE(status_ok(ujson_bin_put_head(&uj, kUjsonBinUint, value)));
+    EXPECT_EQ(ss.Sink(), hex);
+
+    ss.Reset(FromHex(hex));
+    uint64_t got;
+    EXPECT_TRUE(status_ok(ujson_bin_get_head(&uj, kUjsonBinUint, &got)));
+    EXPECT_EQ(got, value);
+  }
+
+  // A head of another major type is left in the input.
+  SourceSink ss("\x65hello");
+  ujson_t uj = ss.UJson();
+  uint64_t got;
+  EXPECT_EQ(status_err(ujson_bin_get_head(&uj, kUjsonBinUint, &got)),
+            kNotFound);
+  EXPECT_EQ(ujson_bin_peek(&uj).value, kUjsonBinText);
+  EXPECT_TRUE(status_ok(ujson_bin_get_head(&uj, kUjsonBinText, &got)));
+  EXPECT_EQ(got, 5);
+}
+
+#define BIN_INT(type_, hex_, value_)                                \
+  do {                                                              \
+    SourceSink ss;                                                  \
+    ujson uj = ss.UJson();                                          \
+    uj.binary = true;                                               \
+    type_ x = value_;                                               \
+    EXPECT_TRUE(status_ok(ujson_serialize_##type_(&uj, &x)));       \
+    EXPECT_EQ(ss.Sink(), hex_);                                     \
+    ss.Reset(FromHex(hex_));                                        \
+    type_ y = 0;                                                    \
+    EXPECT_TRUE(status_ok(ujson_deserialize_##type_(&uj, &y)));     \
+    EXPECT_EQ(x, y);                                                \
+  } while (0)
+
+TEST(UJson, BinaryIntegers) {
+  BIN_INT(uint64_t, "1b8000000000000000", 1ULL << 63);
+  BIN_INT(uint32_t, "1affffffff", 0xFFFFFFFF);
+  BIN_INT(uint16_t, "198000", 0x8000);
+  BIN_INT(uint8_t, "1881", 129);
+
+  BIN_INT(int64_t, "3b7fffffffffffffff", INT64_MIN);
+  BIN_INT(int32_t, "20", -1);
+  BIN_INT(int16_t, "397fff", INT16_MIN);
+  BIN_INT(int8_t, "21", -2);
+}
+
+TEST(UJson, BinaryBoolAndString) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  bool value = true;
+  EXPECT_TRUE(status_ok(ujson_serialize_bool(&uj, &value)));
+  EXPECT_TRUE(status_ok(ujson_serialize_string(&uj, "a\"b")));
+  EXPECT_EQ(ss.Sink(), "f563612262");
+
+  ss.Reset(FromHex("f463612262"));
+  char buf[8];
+  EXPECT_TRUE(status_ok(ujson_deserialize_bool(&uj, &value)));
+  EXPECT_FALSE(value);
+  EXPECT_EQ(ujson_parse_qs(&uj, buf, sizeof(buf)).value, 3);
+  EXPECT_EQ(std::string(buf), "a\"b");
+}
+
+TEST(UJson, BinaryStatus) {
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  uj.binary = true;
+  status_t val = status_create(
+      kInvalidArgument, MAKE_MODULE_ID('F', 'O', 'O'), __FILE__, 77);
+  EXPECT_TRUE(status_ok(ujson_serialize_status_t(&uj, &val)));
+
+  status_t got;
+  const char *code;
+  char mod_id[4] = {0};
+  int32_t arg;
+  ss.Reset(FromHex(ss.Sink()));
+  EXPECT_TRUE(status_ok(ujson_deserialize_status_t(&uj, &got)));
+  OT_DISCARD(status_extract(got, &code, &arg, mod_id));
+  EXPECT_EQ(status_err(got), kInvalidArgument);
+  EXPECT_EQ(std::string(mod_id), "FOO");
+  EXPECT_EQ(arg, 77);
+
+  ss.Reset();
+  val = OK_STATUS(1234);
+  EXPECT_TRUE(status_ok(ujson_serialize_status_t(&uj, &val)));
+  EXPECT_EQ(ss.Sink(), "a1624f6b1904d2");
+}
+
+TEST(UJson, DetectFraming) {
+  // JSON input is left untouched.
+  SourceSink ss(" 5");
+  ujson_t uj = ss.UJson();
+  uint32_t val;
+  EXPECT_TRUE(status_ok(ujson_detect_framing(&uj)));
+  EXPECT_FALSE(uj.binary);
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 5);
+
+  // The marker switches to binary and is not part of the CRC.
+  SourceSink bin("\x18\x2a");
+  ujson_t expected = bin.UJson();
+  expected.binary = true;
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&expected, &val)));
+
+  ss.Reset("\xc1\x18\x2a");
+  ujson_crc32_reset(&uj);
+  EXPECT_TRUE(status_ok(ujson_detect_framing(&uj)));
+  EXPECT_TRUE(uj.binary);
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 42);
+  EXPECT_EQ(ujson_crc32_finish(&uj), ujson_crc32_finish(&expected));
+}
+
+class UJsonReadTest : public testing::TestWithParam<size_t> {};
+
+TEST_P(UJsonReadTest, ParseQuotedString) {
+  std::string expected;
+  std::string json = "  \"";
+  for (size_t i = 0; i < 200; ++i) {
+    char ch = static_cast<char>('a' + i % 26);
+    if (i % 37 == 0) {
+      json += "\\n";
+      expected += '\n';
+    } else {
+      json += ch;
+      expected += ch;
+    }
+  }
+  json += "\" 5";
+
+  SourceSink ss(json);
+  ujson_t uj = ss.UJsonRead(GetParam());
+  char buf[256];
+  status_t s = ujson_parse_qs(&uj, buf, sizeof(buf));
+  EXPECT_EQ(status_err(s), kOk);
+  EXPECT_EQ(s.value, expected.size());
+  EXPECT_EQ(std::string(buf), expected);
+  uint32_t val;
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 5);
+
+  // A short buffer truncates the string but still consumes all of it.
+  ss.Reset();
+  uj = ss.UJsonRead(GetParam());
+  s = ujson_parse_qs(&uj, buf, 11);
+  EXPECT_EQ(status_err(s), kOk);
+  EXPECT_EQ(std::string(buf), expected.substr(0, 10));
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 5);
+}
+
+TEST_P(UJsonReadTest, Crc32) {
+  const std::string json = R"json( "prefix" {"Ok":1234} "suffix")json";
+  char buf[16];
+  status_t val;
+
+  // The CRC over the block-read input matches the one computed per character.
+  SourceSink ref(json);
+  ujson_t uj_ref = ref.UJson();
+  EXPECT_TRUE(status_ok(ujson_parse_qs(&uj_ref, buf, sizeof(buf))));
+  ujson_crc32_reset(&uj_ref);
+  EXPECT_TRUE(status_ok(ujson_deserialize_status_t(&uj_ref, &val)));
+  uint32_t expected = ujson_crc32_finish(&uj_ref);
+
+  SourceSink ss(json);
+  ujson_t uj = ss.UJsonRead(GetParam());
+  EXPECT_TRUE(status_ok(ujson_parse_qs(&uj, buf, sizeof(buf))));
+  ujson_crc32_reset(&uj);
+  EXPECT_TRUE(status_ok(ujson_deserialize_status_t(&uj, &val)));
+  EXPECT_EQ(ujson_crc32_finish(&uj), expected);
+  EXPECT_TRUE(status_ok(ujson_parse_qs(&uj, buf, sizeof(buf))));
+  EXPECT_EQ(std::string(buf), "suffix");
+}
+
+TEST_P(UJsonReadTest, BinaryText) {
+  SourceSink ss(std::string("\xc1\x78\x1a") + "abcdefghijklmnopqrstuvwxyz" +
+                "\x65hello");
+  ujson_t uj = ss.UJsonRead(GetParam());
+  char buf[8];
+
+  // Long strings are truncated and the rest of the string is skipped.
+  EXPECT_TRUE(status_ok(ujson_detect_framing(&uj)));
+  EXPECT_EQ(ujson_parse_qs(&uj, buf, sizeof(buf)).value, 7);
+  EXPECT_EQ(std::string(buf), "abcdefg");
+  EXPECT_EQ(ujson_parse_qs(&uj, buf, sizeof(buf)).value, 5);
+  EXPECT_EQ(std::string(buf), "hello");
+}
+
+INSTANTIATE_TEST_SUITE_P(ChunkSizes, UJsonReadTest,
+                         testing::Values(1, 3, kUjsonRxWindowSize));
+
 }  // namespace
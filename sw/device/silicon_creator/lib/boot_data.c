@@ -314,11 +314,88 @@ typedef struct active_page_info {
   size_t last_valid_index;
 } active_page_info_t;
 
+/**
+ * Checks whether the boot data entry at the given page and index is empty.
+ *
+ * The entry is sniffed first and only read in full if it can be empty.
+ *
+ * @param page A boot data page.
+ * @param index Index of the entry to check in the given page.
+ * @param[out] is_empty Whether the entry is empty.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_entry_is_empty(const flash_ctrl_info_page_t *page,
+                                            size_t index,
+                                            hardened_bool_t *is_empty) {
+  *is_empty = kHardenedBoolFalse;
+  uint32_t masked_identifier;
+  HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, index, &masked_identifier));
+  if (masked_identifier == kFlashCtrlErasedWord) {
+    boot_data_t buf;
+    HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, index, &buf));
+    *is_empty = boot_data_is_empty(&buf);
+  }
+  return kErrorOk;
+}
+
+enum {
+  /**
+   * Maximum number of iterations of the binary search in
+   * `boot_data_first_empty_find()`, i.e. `ceil(log2(kBootDataEntriesPerPage +
+   * 1))`.
+   */
+  kFirstEmptySearchMaxIterations = 5,
+};
+static_assert(kBootDataEntriesPerPage < (1 << kFirstEmptySearchMaxIterations),
+              "kFirstEmptySearchMaxIterations is too small");
+
+/**
+ * Finds the first empty entry of a page.
+ *
+ * Entries are only ever appended to a page after it is erased, so the entries
+ * of a page are all non-empty up to the first empty entry and all empty after
+ * it. Invalidated and torn (partially written) entries are non-empty. This
+ * allows for a binary search that reads O(log n) entries.
+ *
+ * @param page A boot data page.
+ * @param[out] first_empty_index Index of the first empty entry, or
+ * `kBootDataEntriesPerPage` if the page is full.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t boot_data_first_empty_find(
+    const flash_ctrl_info_page_t *page, size_t *first_empty_index) {
+  // Invariant: entries before `lo` are non-empty and entries at or after `hi`
+  // are empty.
+  size_t lo = 0, hi = kBootDataEntriesPerPage;
+  size_t iter = 0;
+  for (; launder32(lo) < hi &&
+         launder32(iter) < kFirstEmptySearchMaxIterations;
+       ++iter) {
+    size_t mid = lo + (hi - lo) / 2;
+    hardened_bool_t is_empty;
+    HARDENED_RETURN_IF_ERROR(boot_data_entry_is_empty(page, mid, &is_empty));
+    if (launder32(is_empty) == kHardenedBoolTrue) {
+      HARDENED_CHECK_EQ(is_empty, kHardenedBoolTrue);
+      hi = mid;
+    } else {
+      HARDENED_CHECK_NE(is_empty, kHardenedBoolTrue);
+      lo = mid + 1;
+    }
+  }
+  HARDENED_CHECK_LE(iter, kFirstEmptySearchMaxIterations);
+  HARDENED_CHECK_EQ(lo, hi);
+  HARDENED_CHECK_LE(lo, kBootDataEntriesPerPage);
+  *first_empty_index = lo;
+  return kErrorOk;
+}
+
 /**
  * Updates the given active page info struct and last valid boot data entry
  * using the given page.
  *
- * This function performs a forward search to find the first empty boot data
+ * This function performs a binary search to find the first empty boot data
  * entry followed by a backward search to find the last valid boot data entry.
  * If the page has an entry that is newer than the one passed in, this function
  * updates `page_info` and `boot_data`. Reads must be enabled for the given page
@@ -335,43 +412,37 @@ OT_WARN_UNUSED_RESULT
 static rom_error_t boot_data_page_info_update_impl(
     const flash_ctrl_info_page_t *page, active_page_info_t *page_info,
     boot_data_t *boot_data) {
-  uint32_t sniff_results[kBootDataEntriesPerPage];
-
   boot_data_t buf;
 
-  // Perform a forward search to find the first empty entry.
+  size_t first_empty_index;
+  HARDENED_RETURN_IF_ERROR(
+      boot_data_first_empty_find(page, &first_empty_index));
   hardened_bool_t has_empty_entry = kHardenedBoolFalse;
-  size_t i = 0, r = kBootDataEntriesPerPage - 1;
-  for (; launder32(i) < kBootDataEntriesPerPage &&
-         launder32(r) < kBootDataEntriesPerPage;
-       ++i, --r) {
-    // Read and cache the identifier to quickly determine if an entry can be
-    // empty or valid.
-    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
-    // Check all words of this entry only if it can be empty.
-    if (sniff_results[i] == kFlashCtrlErasedWord) {
-      HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
-      has_empty_entry = boot_data_is_empty(&buf);
-      if (launder32(has_empty_entry) == kHardenedBoolTrue) {
-        HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolTrue);
-        break;
-      }
-      HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolFalse);
-    }
+  if (launder32(first_empty_index) < kBootDataEntriesPerPage) {
+    HARDENED_CHECK_LT(first_empty_index, kBootDataEntriesPerPage);
+    has_empty_entry = kHardenedBoolTrue;
   }
-  // At the end of this loop, `i` is the index of the first empty entry if any
-  // and `kBootDataEntriesPerPage` otherwise.
-  HARDENED_CHECK_LE(i, kBootDataEntriesPerPage);
-  size_t first_empty_index = i;
-  HARDENED_CHECK_EQ(i + r, kBootDataEntriesPerPage - 1);
+  size_t i = first_empty_index, r = kBootDataEntriesPerPage - 1 - i;
 
   // Perform a backward search to find the last valid entry.
+  //
+  // Only the entries after the last valid entry can be torn (a failed write is
+  // retried at the next empty entry), and an entry is invalidated only after a
+  // newer entry was written successfully. So, the search can stop at the first
+  // invalidated entry: any valid entry before it is older than the one that
+  // caused it to be invalidated.
   hardened_bool_t has_valid_entry = kHardenedBoolFalse;
   for (--i, ++r; launder32(i) < kBootDataEntriesPerPage &&
                  launder32(r) < kBootDataEntriesPerPage;
        --i, ++r) {
+    uint32_t masked_identifier;
+    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &masked_identifier));
+    if (masked_identifier == 0) {
+      // Invalidated entry.
+      break;
+    }
     // Check the digest only if this entry can be valid.
-    if (sniff_results[i] == kBootDataIdentifier) {
+    if (masked_identifier == kBootDataIdentifier) {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
       rom_error_t is_valid = boot_data_check(&buf);
       if (launder32(is_valid) == kErrorOk) {
@@ -384,9 +455,9 @@ static rom_error_t boot_data_page_info_update_impl(
       HARDENED_CHECK_EQ(is_valid, kErrorBootDataInvalid);
     }
   }
-  // At the end of this loop, `i` is the index of the last valid entry if any
-  // and `UINT32_MAX`, otherwise. `r` must be less than or equal to
-  // `first_empty_index`.
+  // At the end of this loop, `i` is the index of the last valid entry if any,
+  // the index of an invalidated entry, or `UINT32_MAX`. `r` must be less than
+  // or equal to `first_empty_index`.
   HARDENED_CHECK_EQ(i + r, kBootDataEntriesPerPage - 1);
 
   if (launder32(has_valid_entry) == kHardenedBoolTrue) {
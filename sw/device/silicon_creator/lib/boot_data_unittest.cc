@@ -4,8 +4,10 @@
 
 #include "sw/device/silicon_creator/lib/boot_data.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
@@ -87,120 +89,167 @@ constexpr boot_data_t kDefaultEntry = {
 namespace boot_data_unittest {
 namespace {
 using ::testing::_;
-using ::testing::DoAll;
 using ::testing::Return;
-using ::testing::SetArgPointee;
 
-class BootDataTest : public rom_test::RomTest {
+using entry_raw_t = std::array<uint32_t, kBootDataNumWords>;
+
+class BootDataTest : public rom_test::Unordered<rom_test::RomTest> {
  protected:
   rom_test::MockFlashCtrl flash_ctrl_;
   rom_test::MockHmac hmac_;
   rom_test::MockOtp otp_;
 
+  // Contents of the boot data pages, indexed by `PageIndex()`.
+  std::array<std::array<entry_raw_t, kBootDataEntriesPerPage>, 2> pages_;
+  // Entries whose digests are considered valid by the mocked `hmac_sha256()`.
+  std::vector<boot_data_t> sealed_entries_;
+  // Number of `flash_ctrl_info_read()` calls per page.
+  std::array<size_t, 2> read_counts_ = {};
+
   // Data for an entry which is fully erased.
-  std::array<uint32_t, kBootDataNumWords> erased_entry_ = {};
+  entry_raw_t erased_entry_ = {};
   // Data for a non-erased but non-bootable entry.
-  std::array<uint32_t, kBootDataNumWords> non_erased_entry_ = {};
-  // Data for a `boot_data_t` entry with only the first three words erased.
-  std::array<uint32_t, kBootDataNumWords> part_erased_entry_ = {};
+  entry_raw_t non_erased_entry_ = {};
+  // Data for a `boot_data_t` entry with only the sniffed words erased.
+  entry_raw_t part_erased_entry_ = {};
 
   BootDataTest() {
     std::fill_n(erased_entry_.begin(), kBootDataNumWords, kFlashCtrlErasedWord);
     std::fill_n(non_erased_entry_.begin(), kBootDataNumWords, 0x01234567);
     std::fill_n(part_erased_entry_.begin(), kBootDataNumWords, 0x01234567);
-    std::fill_n(part_erased_entry_.begin(), 3, kFlashCtrlErasedWord);
+    std::fill_n(part_erased_entry_.begin() + kIsValidWordOffset, 3,
+                kFlashCtrlErasedWord);
+    for (auto &page : pages_) {
+      page.fill(erased_entry_);
+    }
+    Seal(kDefaultEntry);
+
+    // Serve sniffs and full reads from `pages_`.
+    EXPECT_CALL(flash_ctrl_, InfoRead(_, _, _, _))
+        .WillRepeatedly([this](const flash_ctrl_info_page_t *page,
+                               uint32_t offset, uint32_t num_words,
+                               void *out) {
+          size_t page_index = PageIndex(page);
+          ++read_counts_[page_index];
+          EXPECT_EQ(offset % sizeof(uint32_t), 0);
+          size_t index = offset / sizeof(boot_data_t);
+          size_t word = offset % sizeof(boot_data_t) / sizeof(uint32_t);
+          EXPECT_LT(index, kBootDataEntriesPerPage);
+          EXPECT_LE(word + num_words, kBootDataNumWords);
+          std::copy_n(pages_[page_index][index].begin() + word, num_words,
+                      static_cast<uint32_t *>(out));
+          return kErrorOk;
+        });
+
+    // Return the digest of a matching sealed entry, or one that matches no
+    // entry in this test.
+    EXPECT_CALL(hmac_, sha256(_, kDigestRegionSize, _))
+        .WillRepeatedly(
+            [this](const void *region, size_t, hmac_digest_t *digest) {
+              for (const auto &entry : sealed_entries_) {
+                if (std::memcmp(region,
+                                reinterpret_cast<const char *>(&entry) +
+                                    kDigestRegionOffset,
+                                kDigestRegionSize) == 0) {
+                  *digest = entry.digest;
+                  return;
+                }
+              }
+              std::fill_n(digest->digest, kHmacDigestNumWords, 0xdeadbeef);
+            });
+  }
+
+  static constexpr size_t kDigestRegionOffset = sizeof(boot_data_t::digest);
+  static constexpr size_t kDigestRegionSize =
+      sizeof(boot_data_t) - kDigestRegionOffset;
+  static constexpr size_t kIsValidWordOffset =
+      offsetof(boot_data_t, is_valid) / sizeof(uint32_t);
+
+  static size_t PageIndex(const flash_ctrl_info_page_t *page) {
+    if (page == &kFlashCtrlInfoPageBootData0) {
+      return 0;
+    }
+    EXPECT_EQ(page, &kFlashCtrlInfoPageBootData1);
+    return 1;
+  }
+
+  static entry_raw_t ToRaw(const boot_data_t &boot_data) {
+    entry_raw_t raw;
+    std::memcpy(raw.data(), &boot_data, sizeof(boot_data_t));
+    return raw;
   }
 
   /**
-   * Sets an expectation that a given boot data entry in the given info page
-   * is read. The data and return value given by the read can be specified.
-   *
-   * @param page   The info page containing the boot data entry.
-   * @param index  The index of the boot data entry in the page.
-   * @param offset Offset into the boot data entry expected to be read from.
-   * @param data   Mock data to be read at this entry. The number of words is
-   *               unchecked and can be less than (or greater) than the boot
-   *               data entry size.
-   * @param error  Value to be returned by the read.
-   * @param count  Optionally the number of values expected to be read from the
-   *               start of the entry. Useful for expecting sniffs.
+   * Marks the digest of the given entry as valid, i.e. the mocked
+   * `hmac_sha256()` returns `boot_data.digest` for its digest region.
    */
-  void ExpectRead(const flash_ctrl_info_page_t *page, size_t index,
-                  std::array<uint32_t, kBootDataNumWords> data,
-                  rom_error_t error) {
-    size_t offset = index * sizeof(boot_data_t);
-
-    // Mock out flash_ctrl_page_info_read to pass the given `data` and return
-    // the given `error`.
-    //
-    // Using a lambda rather than `.SetArrayArgument(...).Return(error)`
-    // because we have to cast the `void*` argument to a real pointer type
-    // before we can write to it.
-    EXPECT_CALL(flash_ctrl_, InfoRead(page, offset, kBootDataNumWords, _))
-        .WillOnce([data, error](auto, auto, auto, void *out) {
-          uint32_t *out_words = static_cast<uint32_t *>(out);
-          std::copy_n(data.begin(), kBootDataNumWords, out_words);
-          return error;
-        });
+  void Seal(const boot_data_t &boot_data) {
+    sealed_entries_.push_back(boot_data);
   }
 
   /**
-   * Sets an expectation that a given boot data entry in an info page was
-   * sniffed (i.e. with `boot_data_sniff`).
-   *
-   * @param page  The info page containing the boot entry.
-   * @param index The index of the boot info entry in the page.
-   * @param data  Data of the boot data entry (only first three words read).
-   * @param error Value to be returned by the read.
+   * Writes an entry to the given page of the model.
    */
-  template <size_t N>
-  void ExpectSniff(const flash_ctrl_info_page_t *page, size_t index,
-                   std::array<uint32_t, N> data, rom_error_t error) {
-    static_assert(N > 3, "Data must be at least three words for a sniff");
-
-    constexpr uint32_t kIsValidOffset = offsetof(boot_data_t, is_valid);
-    size_t offset = index * sizeof(boot_data_t) + kIsValidOffset;
-
-    // As with `ExpectRead`, provide the given `data` and `error` using a lambda
-    // to support casting the `void*` parameter before writing.
-    EXPECT_CALL(flash_ctrl_, InfoRead(page, offset, 3, _))
-        .WillOnce([data, error](auto, auto, auto, void *out) {
-          uint32_t *out_words = static_cast<uint32_t *>(out);
-          std::copy_n(data.begin(), 3, out_words);
-          return error;
-        });
+  void SetEntry(const flash_ctrl_info_page_t *page, size_t index,
+                entry_raw_t data) {
+    pages_[PageIndex(page)][index] = data;
   }
 
   /**
-   * Sets an expectation that a digest for the given `boot` data is computed.
+   * Writes a sealed entry to the given page of the model.
+   */
+  void SetValidEntry(const flash_ctrl_info_page_t *page, size_t index,
+                     const boot_data_t &boot_data) {
+    Seal(boot_data);
+    SetEntry(page, index, ToRaw(boot_data));
+  }
+
+  /**
+   * Writes an invalidated copy of the given entry to the given page of the
+   * model.
+   */
+  void SetInvalidatedEntry(const flash_ctrl_info_page_t *page, size_t index,
+                           boot_data_t boot_data) {
+    Seal(boot_data);
+    boot_data.is_valid = kBootDataInvalidEntry;
+    SetEntry(page, index, ToRaw(boot_data));
+  }
+
+  /**
+   * Writes a copy of the given entry that was torn after its first `num_words`
+   * words were programmed to the given page of the model. `is_valid` is left
+   * erased as it is written last.
+   */
+  void SetTornEntry(const flash_ctrl_info_page_t *page, size_t index,
+                    const boot_data_t &boot_data, size_t num_words) {
+    entry_raw_t raw = ToRaw(boot_data);
+    std::fill(raw.begin() + num_words, raw.end(), kFlashCtrlErasedWord);
+    std::fill_n(raw.begin() + kIsValidWordOffset, 2, kFlashCtrlErasedWord);
+    SetEntry(page, index, raw);
+  }
+
+  /**
+   * Populates the given page of the model with the following layout:
+   * #0. Non-erased but non-bootable.
+   * #1. Non-erased and bootable provided `boot_data`.
+   * #2. Non-erased and bootable but invalid digest.
+   * #3. Entry with sniffed area erased but the rest not.
+   * #4... Fully erased entries.
    *
-   * @param boot_data The boot data expected to be used in computation.
-   * @param valid     Whether the mocked digest computed should match.
+   * @param page         The page to populate.
+   * @param boot_data    Bootable boot data entry to be inserted into the page.
+   * @param valid_digest Whether `boot_data`'s digest is valid.
    */
-  void ExpectDigestCompute(boot_data_t boot_data, bool valid) {
-    constexpr size_t kDigestRegionOffset = sizeof(boot_data.digest);
-    constexpr size_t kDigestRegionSize =
-        sizeof(boot_data_t) - kDigestRegionOffset;
-
-    // If mocking as invalid, break the digest.
-    hmac_digest_t digest = boot_data.digest;
-    if (!valid) {
-      digest.digest[0] += 1;
+  void EntryPage(const flash_ctrl_info_page_t *page, boot_data_t boot_data,
+                 bool valid_digest = true) {
+    if (valid_digest) {
+      Seal(boot_data);
     }
-
-    // Check the post-digest data we're computing with matches what's given.
-    EXPECT_CALL(hmac_, sha256(_, kDigestRegionSize, _))
-        .WillOnce(DoAll([boot_data, kDigestRegionSize, digest](
-                            const void *digest_region, size_t size,
-                            hmac_digest_t *digest_) {
-          int digest_region_cmp = std::memcmp(
-              digest_region,
-              reinterpret_cast<const char *>(&boot_data) + kDigestRegionOffset,
-              kDigestRegionSize);
-          EXPECT_EQ(digest_region_cmp, 0);
-          EXPECT_EQ(size, kDigestRegionSize);
-          *digest_ = digest;
-        }));
+    SetEntry(page, 0, non_erased_entry_);
+    SetEntry(page, 1, ToRaw(boot_data));
+    boot_data.digest.digest[0] += 1;
+    SetEntry(page, 2, ToRaw(boot_data));
+    SetEntry(page, 3, part_erased_entry_);
   }
 
   /**
@@ -223,78 +272,15 @@ class BootDataTest : public rom_test::RomTest {
   }
 
   /**
-   * Sets an expectation that the given page is searched for its last valid boot
-   * data entry.
-   *
-   * This acts as a wrapper around the provided function which should contain
-   * the expectations of sniffs and reads that happen within the given page.
-   *
-   * @param page  The page expected to be searched for boot data entries.
-   * @param reads Function given the `page` containing expectations of the reads
-   *              happening there.
-   */
-  void ExpectPageScan(
-      const flash_ctrl_info_page_t *page,
-      std::function<void(const flash_ctrl_info_page_t *)> reads) {
-    ExpectPermsSet(page, true, false, false);
-    reads(page);
-    ExpectPermsSet(page, false, false, false);
-  }
-
-  /**
-   * Provides a lambda function mocking a page containing various boot
-   * data entries (all non-bootable or invalid) plus the given `boot_data` which
-   * is expected to be bootable.
-   *
-   * @param boot_data    Bootable boot data entry to be inserted into the page.
-   * @param valid_digest Whether to mock that `boot_data`'s digest is valid.
-   * @return Lambda function for use with `ExpectPageScan`.
+   * Sets an expectation that both pages are searched for their last valid boot
+   * data entries.
    */
-  auto EntryPage(boot_data_t boot_data, bool valid_digest = true) {
-    // Ensures the following memcpy is safe
-    static_assert(sizeof(uint32_t) * kBootDataNumWords == sizeof(boot_data_t),
-                  "`kBootDataNumWords` must match size of `boot_data_t`");
-
-    // Convert the given boot data into an array of words.
-    std::array<uint32_t, kBootDataNumWords> boot_data_raw = {};
-    std::memcpy(boot_data_raw.data(), &boot_data, sizeof(boot_data_t));
-
-    // Mock the page to have the following layout:
-    // #0. Non-erased but non-bootable.
-    // #1. Non-erased and bootable provided boot_data.
-    // #2. Non-erased and bootable but invalid digest.
-    // #3. Entry with sniffed area erased but the rest not.
-    // #4. Fully erased entry.
-    return [=](const flash_ctrl_info_page_t *page) {
-      // Expect to sniff each entry, fully reading if it could be erased.
-      ExpectSniff(page, 0, non_erased_entry_, kErrorOk);
-      ExpectSniff(page, 1, boot_data_raw, kErrorOk);
-      ExpectSniff(page, 2, boot_data_raw, kErrorOk);
-      ExpectSniff(page, 3, part_erased_entry_, kErrorOk);
-      ExpectRead(page, 3, part_erased_entry_, kErrorOk);
-      ExpectSniff(page, 4, erased_entry_, kErrorOk);
-      ExpectRead(page, 4, erased_entry_, kErrorOk);
-
-      // Check the last seen bootable entry's digest (mocked as invalid).
-      ExpectRead(page, 2, boot_data_raw, kErrorOk);
-      ExpectDigestCompute(boot_data, false);
-
-      // Step back to the previously seen bootable entry (provided `boot_data`).
-      ExpectRead(page, 1, boot_data_raw, kErrorOk);
-      ExpectDigestCompute(boot_data, valid_digest);
-    };
-  }
-
-  /**
-   * Provides a lambda function mocking a page with only an erased entry.
-   *
-   * @return Lambda function for use with `ExpectPageScan`.
-   */
-  auto ErasedPage() {
-    return [this](auto page) {
-      ExpectSniff(page, 0, erased_entry_, kErrorOk);
-      ExpectRead(page, 0, erased_entry_, kErrorOk);
-    };
+  void ExpectPageScans() {
+    for (auto page : {&kFlashCtrlInfoPageBootData0,
+                      &kFlashCtrlInfoPageBootData1}) {
+      ExpectPermsSet(page, true, false, false);
+      ExpectPermsSet(page, false, false, false);
+    }
   }
 
   /**
@@ -313,8 +299,7 @@ class BootDataTest : public rom_test::RomTest {
   }
 
   /**
-   * Sets an expectation that the default boot data entry is loaded and its
-   * digest is checked.
+   * Sets an expectation that the default boot data entry is loaded.
    */
   void ExpectDefaultEntryRead() {
     EXPECT_CALL(
@@ -323,8 +308,6 @@ class BootDataTest : public rom_test::RomTest {
     EXPECT_CALL(otp_,
                 read32(OTP_CTRL_PARAM_CREATOR_SW_CFG_MIN_SEC_VER_BL0_OFFSET))
         .WillOnce(Return(kDefaultEntry.min_security_version_bl0));
-
-    ExpectDigestCompute(kDefaultEntry, true);
   }
 };
 
@@ -332,8 +315,9 @@ class BootDataReadTest : public BootDataTest {};
 
 TEST_F(BootDataReadTest, ReadBothValidTest1) {
   // Expect both pages to be checked, with both giving valid entries.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1));
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntry0);
+  EntryPage(&kFlashCtrlInfoPageBootData1, kValidEntry1);
+  ExpectPageScans();
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -343,8 +327,9 @@ TEST_F(BootDataReadTest, ReadBothValidTest1) {
 
 TEST_F(BootDataReadTest, ReadBothValidTest2) {
   // Same as above, but swap which page contains `test_entry_1`.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry1));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry0));
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntry1);
+  EntryPage(&kFlashCtrlInfoPageBootData1, kValidEntry0);
+  ExpectPageScans();
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -354,8 +339,8 @@ TEST_F(BootDataReadTest, ReadBothValidTest2) {
 
 TEST_F(BootDataReadTest, ReadOneEntryTest) {
   // Expect both pages to be searched, but give only a valid entry for one.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntry0);
+  ExpectPageScans();
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -364,8 +349,9 @@ TEST_F(BootDataReadTest, ReadOneEntryTest) {
 
 TEST_F(BootDataReadTest, ReadOneValidTest) {
   // Expect both pages to be searched, but give only a valid entry for one.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1, false));
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntry0);
+  EntryPage(&kFlashCtrlInfoPageBootData1, kValidEntry1, false);
+  ExpectPageScans();
 
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
@@ -376,8 +362,7 @@ TEST_F(BootDataReadTest, ReadOneValidTest) {
 
 TEST_F(BootDataReadTest, ReadErasedDefaultTest) {
   // Expect both pages to be searched, but give no entry for either.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, ErasedPage());
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectPageScans();
 
   // Expect to fall back to loading the default entry.
   ExpectAllowedInProdCheck(false);
@@ -390,8 +375,9 @@ TEST_F(BootDataReadTest, ReadErasedDefaultTest) {
 
 TEST_F(BootDataReadTest, ReadInvalidDefaultTest) {
   // Expect both pages to be searched, but give invalid entries for both.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntry0, false));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, EntryPage(kValidEntry1, false));
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntry0, false);
+  EntryPage(&kFlashCtrlInfoPageBootData1, kValidEntry1, false);
+  ExpectPageScans();
 
   // Expect to fall back to loading the default entry.
   ExpectAllowedInProdCheck(false);
@@ -404,8 +390,7 @@ TEST_F(BootDataReadTest, ReadInvalidDefaultTest) {
 
 TEST_F(BootDataReadTest, ReadDefaultAllowedInProdTest) {
   // Expect both pages to be searched, but give no entry for either.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, ErasedPage());
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectPageScans();
 
   // Expect to fall back to loading the default entry (allowed in prod).
   ExpectAllowedInProdCheck(true);
@@ -418,8 +403,7 @@ TEST_F(BootDataReadTest, ReadDefaultAllowedInProdTest) {
 
 TEST_F(BootDataReadTest, ReadDefaultNotAllowedInProdTest) {
   // Expect both pages to be searched, but give no entry for either.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, ErasedPage());
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  ExpectPageScans();
 
   // Expect to fall back to loading the default entry (now allowed in prod).
   ExpectAllowedInProdCheck(false);
@@ -431,19 +415,93 @@ TEST_F(BootDataReadTest, ReadDefaultNotAllowedInProdTest) {
 
 TEST_F(BootDataReadTest, ReadV1AsV2Test) {
   // Expect both to be searched, but only provide an entry in one.
-  ExpectPageScan(&kFlashCtrlInfoPageBootData0, EntryPage(kValidEntryV1));
-  ExpectPageScan(&kFlashCtrlInfoPageBootData1, ErasedPage());
+  EntryPage(&kFlashCtrlInfoPageBootData0, kValidEntryV1);
+  ExpectPageScans();
 
   // Expect a new digest computation on version 2 of the boot data.
-  ExpectDigestCompute(kValidEntry0, true);
+  Seal(kValidEntry0);
 
   // Expect to read the version 1 boot data.
   boot_data_t boot_data = {{0}};
   EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
   EXPECT_EQ(boot_data, kValidEntry0);
+}
 
+TEST_F(BootDataReadTest, ReadTornAfterValidTest) {
+  // A valid entry followed by torn writes of a newer entry.
+  SetInvalidatedEntry(&kFlashCtrlInfoPageBootData0, 0, kValidEntry0);
+  SetValidEntry(&kFlashCtrlInfoPageBootData0, 1, kValidEntry0);
+  SetTornEntry(&kFlashCtrlInfoPageBootData0, 2, kValidEntry1, 4);
+  SetTornEntry(&kFlashCtrlInfoPageBootData0, 3, kValidEntry1,
+               kBootDataNumWords);
+  ExpectPageScans();
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
   EXPECT_EQ(boot_data, kValidEntry0);
 }
 
+TEST_F(BootDataReadTest, ReadTornBeforeErasedTest) {
+  // Torn writes whose sniffed words are still erased must not be mistaken for
+  // the first empty entry.
+  SetValidEntry(&kFlashCtrlInfoPageBootData1, 0, kValidEntry1);
+  for (size_t i = 1; i < 8; ++i) {
+    SetTornEntry(&kFlashCtrlInfoPageBootData1, i, kValidEntry0, 1);
+  }
+  ExpectPageScans();
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadPageRolloverTest) {
+  // A full page whose entries were all invalidated after a newer entry was
+  // written to the other page.
+  for (size_t i = 0; i < kBootDataEntriesPerPage; ++i) {
+    SetInvalidatedEntry(&kFlashCtrlInfoPageBootData0, i, kValidEntry0);
+  }
+  SetValidEntry(&kFlashCtrlInfoPageBootData1, 0, kValidEntry1);
+  ExpectPageScans();
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadFullPageTest) {
+  // A full page whose last entry is valid.
+  for (size_t i = 0; i < kBootDataEntriesPerPage - 1; ++i) {
+    SetInvalidatedEntry(&kFlashCtrlInfoPageBootData0, i, kValidEntry0);
+  }
+  SetValidEntry(&kFlashCtrlInfoPageBootData0, kBootDataEntriesPerPage - 1,
+                kValidEntry1);
+  ExpectPageScans();
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+}
+
+TEST_F(BootDataReadTest, ReadCountTest) {
+  // Entries 0 to 12 are invalidated, entry 13 is valid, and the rest are
+  // erased.
+  for (size_t i = 0; i < 13; ++i) {
+    SetInvalidatedEntry(&kFlashCtrlInfoPageBootData0, i, kValidEntry0);
+  }
+  SetValidEntry(&kFlashCtrlInfoPageBootData0, 13, kValidEntry1);
+  ExpectPageScans();
+
+  boot_data_t boot_data = {{0}};
+  EXPECT_EQ(boot_data_read(kLcStateTest, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data, kValidEntry1);
+
+  // The binary search sniffs at most `log2(kBootDataEntriesPerPage) + 1`
+  // entries and reads the empty ones in full, the backward search sniffs and
+  // reads the last valid entry.
+  EXPECT_LE(read_counts_[0], 2 * 5 + 2);
+  EXPECT_LE(read_counts_[1], 2 * 5);
+}
+
 }  // namespace
 }  // namespace boot_data_unittest
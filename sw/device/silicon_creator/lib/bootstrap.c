@@ -61,6 +61,24 @@ typedef enum bootstrap_state {
   kBootstrapStateProgram = 0xbdd8ca60,
 } bootstrap_state_t;
 
+/**
+ * Clears the WIP and WEL bits before a flash operation if `ack_early` is true.
+ *
+ * In pipelined mode, the host may send the next command while the current one
+ * is still being executed. This is safe because the payload of the current
+ * command has already been copied out of the SPI device and commands are
+ * executed in order: the next command is only read after the current one
+ * completes.
+ *
+ * @param ack_early Whether to clear the flash status now.
+ */
+static void bootstrap_ack_early(hardened_bool_t ack_early) {
+  if (launder32(ack_early) == kHardenedBoolTrue) {
+    HARDENED_CHECK_EQ(ack_early, kHardenedBoolTrue);
+    spi_device_flash_status_clear();
+  }
+}
+
 /**
  * Handles access permissions and erases a 4 KiB region in the data partition of
  * the embedded flash.
@@ -69,10 +87,13 @@ typedef enum bootstrap_state {
  * consecutive pages.
  *
  * @param addr Address that falls within the 4 KiB region being deleted.
+ * @param ack_early Whether to clear the flash status once `addr` is validated,
+ * i.e. before the erase completes.
  * @return Result of the operation.
  */
 OT_WARN_UNUSED_RESULT
-static rom_error_t bootstrap_sector_erase(uint32_t addr) {
+static rom_error_t bootstrap_sector_erase(uint32_t addr,
+                                          hardened_bool_t ack_early) {
   static_assert(FLASH_CTRL_PARAM_BYTES_PER_PAGE == 2048,
                 "Page size must be 2 KiB");
   enum {
@@ -86,6 +107,7 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
     return kErrorBootstrapEraseAddress;
   }
   addr &= kPageAddrMask;
+  bootstrap_ack_early(ack_early);
 
   flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
       .read = kMultiBitBool4False,
@@ -118,11 +140,14 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
  * @param data Data to write, must be word aligned. If `byte_count` is not a
  * multiple of flash word size, `data` must have enough space until the next
  * flash word.
+ * @param ack_early Whether to clear the flash status once `addr` is validated,
+ * i.e. before programming completes.
  * @return Result of the operation.
  */
 OT_WARN_UNUSED_RESULT
 static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
-                                          uint8_t *data) {
+                                          uint8_t *data,
+                                          hardened_bool_t ack_early) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_WORD) == 1,
                 "Bytes per flash word must be a power of two.");
   enum {
@@ -157,6 +182,7 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
     }
   }
   size_t rem_word_count = byte_count / sizeof(uint32_t);
+  bootstrap_ack_early(ack_early);
 
   flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
       .read = kMultiBitBool4False,
@@ -259,11 +285,22 @@ static rom_error_t bootstrap_handle_erase_verify(bootstrap_state_t *state) {
 /**
  * Bootstrap state 3: (Erase/)Program loop.
  *
+ * In pipelined mode, PAGE_PROGRAM and SECTOR_ERASE commands are acknowledged
+ * (WIP and WEL cleared) as soon as they are validated, so that the host
+ * transfers the next page into the SPI device while flash is busy with the
+ * current one. The SPI device sets WIP again when the next command arrives, so
+ * the host still sees the usual SPI flash protocol. If a flash operation
+ * fails, this function returns an error without acknowledging the next
+ * command, i.e. the host sees the error one command later than in the default
+ * mode.
+ *
  * @param state Bootstrap state.
+ * @param pipelined Whether to acknowledge commands before they complete.
  * @return Result of the operation.
  */
 OT_WARN_UNUSED_RESULT
-static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
+static rom_error_t bootstrap_handle_program(bootstrap_state_t *state,
+                                            hardened_bool_t pipelined) {
   static_assert(alignof(spi_device_cmd_t) >= sizeof(uint32_t) &&
                     offsetof(spi_device_cmd_t, payload) >= sizeof(uint32_t),
                 "Payload must be word aligned.");
@@ -283,16 +320,20 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
   }
 
   rom_error_t error = kErrorUnknown;
+  // Whether the status was cleared before the operation completed.
+  hardened_bool_t acked = kHardenedBoolFalse;
   switch (cmd.opcode) {
     case kSpiDeviceOpcodeChipErase:
       error = bootstrap_chip_erase();
       break;
     case kSpiDeviceOpcodeSectorErase:
-      error = bootstrap_sector_erase(cmd.address);
+      acked = pipelined;
+      error = bootstrap_sector_erase(cmd.address, pipelined);
       break;
     case kSpiDeviceOpcodePageProgram:
+      acked = pipelined;
       error = bootstrap_page_program(cmd.address, cmd.payload_byte_count,
-                                     cmd.payload);
+                                     cmd.payload, pipelined);
       break;
     case kSpiDeviceOpcodeReset:
       // In a normal build, this function inlines to nothing.
@@ -314,11 +355,23 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
   }
   HARDENED_RETURN_IF_ERROR(error);
 
-  spi_device_flash_status_clear();
+  // Clearing the status again would drop the WIP and WEL bits of a command
+  // the host may already have sent.
+  if (launder32(acked) != kHardenedBoolTrue) {
+    spi_device_flash_status_clear();
+  }
   return error;
 }
 
-rom_error_t enter_bootstrap(void) {
+/**
+ * Bootstrap event loop.
+ *
+ * @param pipelined Whether to acknowledge program and erase commands before
+ * they complete; see `bootstrap_handle_program()`.
+ * @return The result of the flash loop.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t bootstrap_loop(hardened_bool_t pipelined) {
   spi_device_init();
 
   // Bootstrap event loop.
@@ -336,7 +389,7 @@ rom_error_t enter_bootstrap(void) {
         break;
       case kBootstrapStateProgram:
         HARDENED_CHECK_EQ(state, kBootstrapStateProgram);
-        error = bootstrap_handle_program(&state);
+        error = bootstrap_handle_program(&state, pipelined);
         break;
       default:
         error = kErrorBootstrapInvalidState;
@@ -345,3 +398,9 @@ rom_error_t enter_bootstrap(void) {
   }
   HARDENED_TRAP();
 }
+
+rom_error_t enter_bootstrap(void) { return bootstrap_loop(kHardenedBoolFalse); }
+
+rom_error_t enter_bootstrap_pipelined(void) {
+  return bootstrap_loop(kHardenedBoolTrue);
+}
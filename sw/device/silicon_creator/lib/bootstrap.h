@@ -36,6 +36,26 @@ extern "C" {
 OT_WARN_UNUSED_RESULT
 rom_error_t enter_bootstrap(void);
 
+/**
+ * @public
+ * Enters flash programming mode, overlapping flash operations with SPI
+ * transfers.
+ *
+ * Same as `enter_bootstrap()`, except that PAGE_PROGRAM and SECTOR_ERASE
+ * commands are acknowledged as soon as they are validated. This lets the host
+ * send the next page while the current one is being programmed, hiding SPI
+ * transfer time behind flash programming. The SPI flash protocol is unchanged,
+ * so existing host tools work as is.
+ *
+ * A failing flash operation stops bootstrap before the next command is
+ * acknowledged, so the host observes the error on the command after the one
+ * that failed.
+ *
+ * @return The result of the flash loop.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t enter_bootstrap_pipelined(void);
+
 /**
  * @private @pure
  * Handles access permissions and erases both data banks of the embedded flash.
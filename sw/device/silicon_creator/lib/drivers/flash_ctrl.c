@@ -182,9 +182,27 @@ static rom_error_t wait_for_done(rom_error_t error) {
 }
 
 /**
- * Writes data to the given partition.
+ * Waits for the in-flight program window of a stream, if any.
  *
- * @param addr Full byte address to write to.
+ * @param stream Stream state.
+ * @param error Error code to return in case of a flash controller error.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t write_stream_wait(flash_ctrl_write_stream_t *stream,
+                                     rom_error_t error) {
+  if (launder32(stream->pending) == kHardenedBoolFalse) {
+    return kErrorOk;
+  }
+  HARDENED_CHECK_EQ(stream->pending, kHardenedBoolTrue);
+  stream->pending = kHardenedBoolFalse;
+  return wait_for_done(error);
+}
+
+/**
+ * Programs data to the given partition, leaving the last window in flight.
+ *
+ * @param stream Stream state.
  * @param partition The partition to write to.
  * @param word_count Number of bus words to write.
  * @param data Data to write.
@@ -192,34 +210,37 @@ static rom_error_t wait_for_done(rom_error_t error) {
  * @return Result of the operation.
  */
 OT_WARN_UNUSED_RESULT
-static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
-                         uint32_t word_count, const void *data,
-                         rom_error_t error) {
+static rom_error_t write_stream(flash_ctrl_write_stream_t *stream,
+                                flash_ctrl_partition_t partition,
+                                uint32_t word_count, const void *data,
+                                rom_error_t error) {
   enum {
     kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t)
   };
 
   // Find the number of words that can be written in the first window.
   uint32_t window_word_count =
-      kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
+      kWindowWordCount - ((stream->addr / sizeof(uint32_t)) % kWindowWordCount);
   while (word_count > 0) {
     // Program operations can't cross window boundaries.
     window_word_count =
         word_count < window_word_count ? word_count : window_word_count;
 
+    // Only one transaction can be in flight: wait for the previous window,
+    // which may have been started by an earlier call.
+    RETURN_IF_ERROR(write_stream_wait(stream, error));
     transaction_start((transaction_params_t){
-        .addr = addr,
+        .addr = stream->addr,
         .op_type = FLASH_CTRL_CONTROL_OP_VALUE_PROG,
         .partition = partition,
         .word_count = window_word_count,
         // Does not apply to program transactions.
         .erase_type = kFlashCtrlEraseTypePage,
     });
-
     fifo_write(window_word_count, data);
-    RETURN_IF_ERROR(wait_for_done(error));
+    stream->pending = kHardenedBoolTrue;
 
-    addr += window_word_count * sizeof(uint32_t);
+    stream->addr += window_word_count * sizeof(uint32_t);
     data = (const char *)data + window_word_count * sizeof(uint32_t);
     word_count -= window_word_count;
     window_word_count = kWindowWordCount;
@@ -228,6 +249,28 @@ static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
   return kErrorOk;
 }
 
+/**
+ * Writes data to the given partition.
+ *
+ * @param addr Full byte address to write to.
+ * @param partition The partition to write to.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write.
+ * @param error Error code to return in case of a flash controller error.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
+                         uint32_t word_count, const void *data,
+                         rom_error_t error) {
+  flash_ctrl_write_stream_t stream = {
+      .addr = addr,
+      .pending = kHardenedBoolFalse,
+  };
+  RETURN_IF_ERROR(write_stream(&stream, partition, word_count, data, error));
+  return write_stream_wait(&stream, error);
+}
+
 /**
  * Disables all access to a page until next reset.
  *
@@ -357,6 +400,50 @@ rom_error_t flash_ctrl_data_read(uint32_t addr, uint32_t word_count,
   return wait_for_done(kErrorFlashCtrlDataRead);
 }
 
+static_assert(kFlashCtrlMaxTransactionWords ==
+                  FLASH_CTRL_CONTROL_NUM_MASK + 1,
+              "Maximum transaction size does not match CONTROL.NUM");
+
+rom_error_t flash_ctrl_data_read_stream_start(flash_ctrl_read_stream_t *stream,
+                                              uint32_t addr,
+                                              uint32_t word_count) {
+  if (word_count == 0 || word_count > kFlashCtrlMaxTransactionWords) {
+    return kErrorFlashCtrlDataRead;
+  }
+  transaction_start((transaction_params_t){
+      .addr = addr,
+      .op_type = FLASH_CTRL_CONTROL_OP_VALUE_READ,
+      .partition = kFlashCtrlPartitionData,
+      .word_count = word_count,
+      // Does not apply to read transactions.
+      .erase_type = kFlashCtrlEraseTypePage,
+  });
+  stream->word_count = word_count;
+  return kErrorOk;
+}
+
+rom_error_t flash_ctrl_data_read_stream_next(flash_ctrl_read_stream_t *stream,
+                                             uint32_t word_count, void *data) {
+  if (word_count > stream->word_count) {
+    return kErrorFlashCtrlDataRead;
+  }
+  if (word_count > 0) {
+    fifo_read(word_count, data);
+  }
+  stream->word_count -= word_count;
+  return kErrorOk;
+}
+
+rom_error_t flash_ctrl_data_read_stream_finish(
+    flash_ctrl_read_stream_t *stream) {
+  // The transaction only completes once the read FIFO has been drained.
+  if (launder32(stream->word_count) != 0) {
+    return kErrorFlashCtrlDataRead;
+  }
+  HARDENED_CHECK_EQ(stream->word_count, 0);
+  return wait_for_done(kErrorFlashCtrlDataRead);
+}
+
 rom_error_t flash_ctrl_info_read(const flash_ctrl_info_page_t *info_page,
                                  uint32_t offset, uint32_t word_count,
                                  void *data) {
@@ -398,6 +485,23 @@ rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                kErrorFlashCtrlDataWrite);
 }
 
+void flash_ctrl_data_write_stream_start(flash_ctrl_write_stream_t *stream,
+                                        uint32_t addr) {
+  stream->addr = addr;
+  stream->pending = kHardenedBoolFalse;
+}
+
+rom_error_t flash_ctrl_data_write_stream_append(
+    flash_ctrl_write_stream_t *stream, uint32_t word_count, const void *data) {
+  return write_stream(stream, kFlashCtrlPartitionData, word_count, data,
+                      kErrorFlashCtrlDataWrite);
+}
+
+rom_error_t flash_ctrl_data_write_stream_finish(
+    flash_ctrl_write_stream_t *stream) {
+  return write_stream_wait(stream, kErrorFlashCtrlDataWrite);
+}
+
 rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data) {
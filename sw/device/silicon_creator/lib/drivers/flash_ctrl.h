@@ -389,6 +389,136 @@ rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data);
 
+/**
+ * State of a streaming program operation on the data partition.
+ *
+ * Callers should treat this struct as opaque and only use it with the
+ * `flash_ctrl_data_write_stream_*()` functions.
+ */
+typedef struct flash_ctrl_write_stream {
+  /**
+   * Address of the next word to program.
+   */
+  uint32_t addr;
+  /**
+   * Whether a program transaction is in flight.
+   */
+  hardened_bool_t pending;
+} flash_ctrl_write_stream_t;
+
+/**
+ * Starts a streaming program operation on the data partition.
+ *
+ * Streaming writes split the data into program windows exactly like
+ * `flash_ctrl_data_write()` but do not wait for the last window of each call to
+ * complete. The caller can prepare the next chunk of data (e.g. receive it
+ * over SPI) while flash programs the previous one; completion is only awaited
+ * by the next `flash_ctrl_data_write_stream_append()` or by
+ * `flash_ctrl_data_write_stream_finish()`.
+ *
+ * The flash controller only supports one transaction at a time, so no other
+ * flash operation may be issued until the stream is finished.
+ *
+ * @param[out] stream Stream state.
+ * @param addr Address to start writing at.
+ */
+void flash_ctrl_data_write_stream_start(flash_ctrl_write_stream_t *stream,
+                                        uint32_t addr);
+
+/**
+ * Appends data to a streaming program operation.
+ *
+ * Waits for the previous window, if any, before programming each window. The
+ * last window of `data` is still being programmed when this function returns.
+ *
+ * @param stream Stream state.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write. Must be word aligned. All words have been pushed
+ * into the program FIFO when this function returns, so `data` can be reused.
+ * @return Result of the operation, including errors of the window that was in
+ * flight when this function was called.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_write_stream_append(
+    flash_ctrl_write_stream_t *stream, uint32_t word_count, const void *data);
+
+/**
+ * Waits for the last window of a streaming program operation to complete.
+ *
+ * @param stream Stream state.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_write_stream_finish(
+    flash_ctrl_write_stream_t *stream);
+
+/**
+ * State of a streaming read operation on the data partition.
+ *
+ * Callers should treat this struct as opaque and only use it with the
+ * `flash_ctrl_data_read_stream_*()` functions.
+ */
+typedef struct flash_ctrl_read_stream {
+  /**
+   * Number of words that have not been drained from the read FIFO yet.
+   */
+  uint32_t word_count;
+} flash_ctrl_read_stream_t;
+
+enum {
+  /**
+   * Maximum number of bus words in a single flash transaction.
+   */
+  kFlashCtrlMaxTransactionWords = 1 << 12,
+};
+
+/**
+ * Starts a streaming read operation on the data partition.
+ *
+ * This issues a single read transaction for `word_count` words. The flash
+ * controller keeps filling its read FIFO while the caller processes the
+ * chunks returned by `flash_ctrl_data_read_stream_next()`, so that e.g.
+ * hashing a region overlaps with reading it.
+ *
+ * The flash controller only supports one transaction at a time, so no other
+ * flash operation may be issued until the stream is finished.
+ *
+ * @param[out] stream Stream state.
+ * @param addr Address to read from.
+ * @param word_count Number of bus words to read, at most
+ * `kFlashCtrlMaxTransactionWords`.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_read_stream_start(flash_ctrl_read_stream_t *stream,
+                                              uint32_t addr,
+                                              uint32_t word_count);
+
+/**
+ * Drains the next chunk of a streaming read operation.
+ *
+ * @param stream Stream state.
+ * @param word_count Number of bus words to drain. Must not exceed the number of
+ * words remaining in the stream.
+ * @param[out] data Buffer to store the read data. Must be word aligned.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_read_stream_next(flash_ctrl_read_stream_t *stream,
+                                             uint32_t word_count, void *data);
+
+/**
+ * Finishes a streaming read operation.
+ *
+ * All words of the stream must have been drained.
+ *
+ * @param stream Stream state.
+ * @return Result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t flash_ctrl_data_read_stream_finish(
+    flash_ctrl_read_stream_t *stream);
+
 /*
  * Encoding generated with
  * $ ./util/design/sparse-fsm-encode.py -d 5 -m 2 -n 32 \
@@ -0,0 +1,161 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/silicon_creator/lib/base/sec_mmio.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/error.h"
+
+#include "hw/top/flash_ctrl_regs.h"  // Generated.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /**
+   * Last page of the second data bank, which is not used by the test image.
+   */
+  kTestPageAddr =
+      2 * FLASH_CTRL_PARAM_BYTES_PER_BANK - FLASH_CTRL_PARAM_BYTES_PER_PAGE,
+  /**
+   * Number of words in a page.
+   */
+  kPageWords = FLASH_CTRL_PARAM_BYTES_PER_PAGE / sizeof(uint32_t),
+  /**
+   * Number of words in a chunk, i.e. a SPI flash page in bootstrap.
+   */
+  kChunkWords = 256 / sizeof(uint32_t),
+};
+
+static uint32_t chunk[kChunkWords];
+static uint32_t page[kPageWords];
+
+/**
+ * Generates chunk `index` of the test pattern.
+ *
+ * Stands in for the work done between flash operations, e.g. receiving the
+ * next chunk over SPI.
+ */
+static void chunk_generate(size_t index, uint32_t *buf) {
+  for (size_t i = 0; i < kChunkWords; ++i) {
+    buf[i] = 0xa5a50000 ^ (uint32_t)(index * kChunkWords + i);
+  }
+}
+
+/**
+ * Stands in for the work done on each chunk that was read, e.g. hashing it.
+ */
+static uint32_t chunk_checksum(const uint32_t *buf, uint32_t acc) {
+  for (size_t i = 0; i < kChunkWords; ++i) {
+    acc = (acc << 1 | acc >> 31) ^ buf[i];
+  }
+  return acc;
+}
+
+static rom_error_t page_erase(void) {
+  return flash_ctrl_data_erase(kTestPageAddr, kFlashCtrlEraseTypePage);
+}
+
+static rom_error_t page_check(void) {
+  RETURN_IF_ERROR(flash_ctrl_data_read(kTestPageAddr, kPageWords, page));
+  for (size_t i = 0; i < kPageWords / kChunkWords; ++i) {
+    chunk_generate(i, chunk);
+    CHECK_ARRAYS_EQ(&page[i * kChunkWords], chunk, kChunkWords);
+  }
+  return kErrorOk;
+}
+
+static uint32_t cycles_since(uint64_t start) {
+  uint64_t cycles = ibex_mcycle_read() - start;
+  CHECK(cycles <= UINT32_MAX, "Cycle count must fit in uint32_t");
+  return (uint32_t)cycles;
+}
+
+rom_error_t write_blocking_test(void) {
+  RETURN_IF_ERROR(page_erase());
+  uint64_t start = ibex_mcycle_read();
+  for (size_t i = 0; i < kPageWords / kChunkWords; ++i) {
+    chunk_generate(i, chunk);
+    RETURN_IF_ERROR(flash_ctrl_data_write(
+        kTestPageAddr + i * sizeof(chunk), kChunkWords, chunk));
+  }
+  LOG_INFO("flash_ctrl_data_write(): %u cycles/page", cycles_since(start));
+  return page_check();
+}
+
+rom_error_t write_stream_test(void) {
+  RETURN_IF_ERROR(page_erase());
+  uint64_t start = ibex_mcycle_read();
+  flash_ctrl_write_stream_t stream;
+  flash_ctrl_data_write_stream_start(&stream, kTestPageAddr);
+  for (size_t i = 0; i < kPageWords / kChunkWords; ++i) {
+    chunk_generate(i, chunk);
+    RETURN_IF_ERROR(
+        flash_ctrl_data_write_stream_append(&stream, kChunkWords, chunk));
+  }
+  RETURN_IF_ERROR(flash_ctrl_data_write_stream_finish(&stream));
+  LOG_INFO("flash_ctrl_data_write_stream_*(): %u cycles/page",
+           cycles_since(start));
+  return page_check();
+}
+
+rom_error_t read_blocking_test(void) {
+  uint32_t acc = 0;
+  uint64_t start = ibex_mcycle_read();
+  for (size_t i = 0; i < kPageWords / kChunkWords; ++i) {
+    RETURN_IF_ERROR(flash_ctrl_data_read(kTestPageAddr + i * sizeof(chunk),
+                                         kChunkWords, chunk));
+    acc = chunk_checksum(chunk, acc);
+  }
+  LOG_INFO("flash_ctrl_data_read(): %u cycles/page (checksum 0x%08x)",
+           cycles_since(start), acc);
+  return kErrorOk;
+}
+
+rom_error_t read_stream_test(void) {
+  uint32_t acc = 0;
+  uint64_t start = ibex_mcycle_read();
+  flash_ctrl_read_stream_t stream;
+  RETURN_IF_ERROR(
+      flash_ctrl_data_read_stream_start(&stream, kTestPageAddr, kPageWords));
+  for (size_t i = 0; i < kPageWords / kChunkWords; ++i) {
+    RETURN_IF_ERROR(
+        flash_ctrl_data_read_stream_next(&stream, kChunkWords, chunk));
+    acc = chunk_checksum(chunk, acc);
+  }
+  RETURN_IF_ERROR(flash_ctrl_data_read_stream_finish(&stream));
+  LOG_INFO("flash_ctrl_data_read_stream_*(): %u cycles/page (checksum 0x%08x)",
+           cycles_since(start), acc);
+  return kErrorOk;
+}
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+
+  // Initialize the sec_mmio table so that we can run this test with both rom
+  // and test_rom.
+  sec_mmio_init();
+  flash_ctrl_init();
+  SEC_MMIO_WRITE_INCREMENT(kFlashCtrlSecMmioInit);
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4True,
+      .write = kMultiBitBool4True,
+      .erase = kMultiBitBool4True,
+  });
+
+  EXECUTE_TEST(result, write_blocking_test);
+  EXECUTE_TEST(result, write_stream_test);
+  // Both read tests must report the same checksum.
+  EXECUTE_TEST(result, read_blocking_test);
+  EXECUTE_TEST(result, read_stream_test);
+
+  return status_ok(result);
+}
@@ -418,6 +418,97 @@ TEST_F(TransferTest, ProgAcrossWindows) {
             kErrorOk);
 }
 
+TEST_F(TransferTest, WriteStreamDefersWait) {
+  static const uint32_t kWinSize = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES;
+  const std::vector<uint32_t> first(words_.begin(), words_.begin() + 2);
+  const std::vector<uint32_t> second(words_.begin() + 2, words_.end());
+
+  flash_ctrl_write_stream_t stream;
+  flash_ctrl_data_write_stream_start(&stream, kWinSize);
+
+  // The first append returns with its window in flight.
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, kWinSize,
+                      first.size());
+  ExpectProgData(first);
+  EXPECT_EQ(flash_ctrl_data_write_stream_append(&stream, first.size(),
+                                                &first.front()),
+            kErrorOk);
+
+  // The second append waits for the first window before starting.
+  ExpectWaitForDone(false, false);
+  ExpectWaitForDone(true, false);
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+                      kWinSize + first.size() * sizeof(uint32_t),
+                      second.size());
+  ExpectProgData(second);
+  EXPECT_EQ(flash_ctrl_data_write_stream_append(&stream, second.size(),
+                                                &second.front()),
+            kErrorOk);
+
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_data_write_stream_finish(&stream), kErrorOk);
+  // Finishing again is a no-op.
+  EXPECT_EQ(flash_ctrl_data_write_stream_finish(&stream), kErrorOk);
+}
+
+TEST_F(TransferTest, WriteStreamError) {
+  flash_ctrl_write_stream_t stream;
+  flash_ctrl_data_write_stream_start(&stream, 0);
+
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, 0,
+                      words_.size());
+  ExpectProgData(words_);
+  EXPECT_EQ(flash_ctrl_data_write_stream_append(&stream, words_.size(),
+                                                &words_.front()),
+            kErrorOk);
+
+  // The error of the in-flight window is reported by the next call.
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_data_write_stream_append(&stream, words_.size(),
+                                                &words_.front()),
+            kErrorFlashCtrlDataWrite);
+  EXPECT_EQ(flash_ctrl_data_write_stream_finish(&stream), kErrorOk);
+}
+
+TEST_F(TransferTest, ReadStreamOk) {
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234567,
+                      words_.size());
+  flash_ctrl_read_stream_t stream;
+  EXPECT_EQ(
+      flash_ctrl_data_read_stream_start(&stream, 0x01234567, words_.size()),
+      kErrorOk);
+
+  std::vector<uint32_t> words_out(words_.size());
+  ExpectReadData({words_[0]});
+  EXPECT_EQ(flash_ctrl_data_read_stream_next(&stream, 1, &words_out[0]),
+            kErrorOk);
+  ExpectReadData({words_[1], words_[2], words_[3]});
+  EXPECT_EQ(flash_ctrl_data_read_stream_next(&stream, 3, &words_out[1]),
+            kErrorOk);
+
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_data_read_stream_finish(&stream), kErrorOk);
+  EXPECT_EQ(words_out, words_);
+}
+
+TEST_F(TransferTest, ReadStreamBadArgs) {
+  flash_ctrl_read_stream_t stream;
+  EXPECT_EQ(flash_ctrl_data_read_stream_start(&stream, 0, 0),
+            kErrorFlashCtrlDataRead);
+  EXPECT_EQ(flash_ctrl_data_read_stream_start(
+                &stream, 0, kFlashCtrlMaxTransactionWords + 1),
+            kErrorFlashCtrlDataRead);
+
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0, 2);
+  EXPECT_EQ(flash_ctrl_data_read_stream_start(&stream, 0, 2), kErrorOk);
+  std::vector<uint32_t> words_out(words_.size());
+  // Reading past the end of the stream and finishing early both fail.
+  EXPECT_EQ(flash_ctrl_data_read_stream_next(&stream, 3, &words_out.front()),
+            kErrorFlashCtrlDataRead);
+  EXPECT_EQ(flash_ctrl_data_read_stream_finish(&stream),
+            kErrorFlashCtrlDataRead);
+}
+
 TEST_F(TransferTest, TransferInternalError) {
   ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234567,
                       words_.size());
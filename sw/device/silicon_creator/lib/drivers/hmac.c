@@ -89,12 +89,16 @@ static void wait_for_done(void) {
   abs_mmio_write32(hmac_base() + HMAC_INTR_STATE_REG_OFFSET, reg);
 }
 
-void hmac_sha256_final_truncated(uint32_t *digest, size_t len) {
-  wait_for_done();
-
+/**
+ * Reads the digest of the current operation.
+ *
+ * @param cfg Value of the configuration register.
+ * @param[out] digest Buffer to copy digest to.
+ * @param len Requested digest length in 32-bit words.
+ */
+static void digest_read(uint32_t cfg, uint32_t *digest, size_t len) {
   uint32_t result, incr;
-  uint32_t reg = abs_mmio_read32(hmac_base() + HMAC_CFG_REG_OFFSET);
-  if (bitfield_bit32_read(reg, HMAC_CFG_DIGEST_SWAP_BIT)) {
+  if (bitfield_bit32_read(cfg, HMAC_CFG_DIGEST_SWAP_BIT)) {
     // Big-endian output.
     result = HMAC_DIGEST_0_REG_OFFSET;
     incr = sizeof(uint32_t);
@@ -115,6 +119,17 @@ void hmac_sha256_final_truncated(uint32_t *digest, size_t len) {
   }
 }
 
+void hmac_sha256_final_truncated(uint32_t *digest, size_t len) {
+  wait_for_done();
+  digest_read(abs_mmio_read32(hmac_base() + HMAC_CFG_REG_OFFSET), digest, len);
+}
+
+void hmac_sha256_clear(void) {
+  // Clearing the config stops the SHA engine and clears the digest.
+  abs_mmio_write32(hmac_base() + HMAC_CFG_REG_OFFSET, 0u);
+  abs_mmio_write32(hmac_base() + HMAC_INTR_STATE_REG_OFFSET, UINT32_MAX);
+}
+
 void hmac_sha256(const void *data, size_t len, hmac_digest_t *digest) {
   hmac_sha256_init();
   hmac_sha256_update(data, len);
@@ -122,7 +137,13 @@ void hmac_sha256(const void *data, size_t len, hmac_digest_t *digest) {
   hmac_sha256_final(digest);
 }
 
-void hmac_sha256_save(hmac_context_t *ctx) {
+/**
+ * Saves the working state of the current operation.
+ *
+ * @param[out] ctx Saved operation state.
+ * @return Value of the configuration register.
+ */
+static uint32_t save(hmac_context_t *ctx) {
   // Issue the STOP command to halt the operation and compute the intermediate
   // digest.
   uint32_t cmd = bitfield_bit32_write(0, HMAC_CMD_HASH_STOP_BIT, true);
@@ -150,12 +171,20 @@ void hmac_sha256_save(hmac_context_t *ctx) {
 
   // Restore the full original configuration.
   abs_mmio_write32(hmac_base() + HMAC_CFG_REG_OFFSET, cfg);
+  return cfg;
 }
 
-void hmac_sha256_restore(const hmac_context_t *ctx) {
+void hmac_sha256_save(hmac_context_t *ctx) { save(ctx); }
+
+/**
+ * Restores the working state of an operation.
+ *
+ * @param ctx Saved operation state.
+ * @param cfg Value of the configuration register.
+ */
+static void restore(const hmac_context_t *ctx, uint32_t cfg) {
   // Clear the `sha_en` bit to ensure the message length registers are
   // writeable. Leave the rest of the configuration unchanged.
-  uint32_t cfg = abs_mmio_read32(hmac_base() + HMAC_CFG_REG_OFFSET);
   cfg = bitfield_bit32_write(cfg, HMAC_CFG_SHA_EN_BIT, false);
   abs_mmio_write32(hmac_base() + HMAC_CFG_REG_OFFSET, cfg);
 
@@ -183,5 +212,23 @@ void hmac_sha256_restore(const hmac_context_t *ctx) {
   abs_mmio_write32(hmac_base() + HMAC_CMD_REG_OFFSET, cmd);
 }
 
+void hmac_sha256_restore(const hmac_context_t *ctx) {
+  restore(ctx, abs_mmio_read32(hmac_base() + HMAC_CFG_REG_OFFSET));
+}
+
+void hmac_sha256_cfg_cached_save(hmac_cfg_cached_context_t *ctx) {
+  ctx->cfg = save(&ctx->ctx);
+}
+
+void hmac_sha256_cfg_cached_restore(const hmac_cfg_cached_context_t *ctx) {
+  restore(&ctx->ctx, ctx->cfg);
+}
+
+void hmac_sha256_cfg_cached_final_truncated(
+    const hmac_cfg_cached_context_t *ctx, uint32_t *digest, size_t len) {
+  wait_for_done();
+  digest_read(ctx->cfg, digest, len);
+}
+
 extern void hmac_sha256_init(void);
 extern void hmac_sha256_final(hmac_digest_t *digest);
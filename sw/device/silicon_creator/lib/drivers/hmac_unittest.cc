@@ -132,6 +132,16 @@ TEST_F(Sha256FinalTest, GetDigest) {
   EXPECT_THAT(got_digest.digest, ElementsAreArray(kExpectedDigest));
 }
 
+class Sha256ClearTest : public HmacTest {};
+
+TEST_F(Sha256ClearTest, Clear) {
+  EXPECT_ABS_WRITE32(base_ + HMAC_CFG_REG_OFFSET, 0u);
+  EXPECT_ABS_WRITE32(base_ + HMAC_INTR_STATE_REG_OFFSET,
+                     std::numeric_limits<uint32_t>::max());
+
+  hmac_sha256_clear();
+}
+
 class Sha256Test : public HmacTest {};
 
 TEST_F(Sha256Test, Sha256) {
@@ -153,5 +163,74 @@ TEST_F(Sha256Test, Sha256) {
   EXPECT_THAT(act_digest.digest, ElementsAreArray(kExpectedDigest));
 }
 
+class Sha256CfgCachedTest : public HmacTest {
+ protected:
+  void ExpectDone() {
+    EXPECT_ABS_READ32(base_ + HMAC_INTR_STATE_REG_OFFSET,
+                      {
+                          {HMAC_INTR_STATE_HMAC_DONE_BIT, true},
+                      });
+    EXPECT_ABS_WRITE32(base_ + HMAC_INTR_STATE_REG_OFFSET,
+                       {
+                           {HMAC_INTR_STATE_HMAC_DONE_BIT, true},
+                       });
+  }
+
+  // Little-endian digest with the SHA engine enabled.
+  const uint32_t cfg_ = 1u << HMAC_CFG_SHA_EN_BIT;
+};
+
+TEST_F(Sha256CfgCachedTest, SaveRestoreFinal) {
+  constexpr std::array<uint32_t, 8> kState = {
+      0x00000000, 0x11111111, 0x22222222, 0x33333333,
+      0x44444444, 0x55555555, 0x66666666, 0x77777777,
+  };
+
+  // Saving reads the configuration register once.
+  EXPECT_ABS_WRITE32(base_ + HMAC_CMD_REG_OFFSET,
+                     {{HMAC_CMD_HASH_STOP_BIT, true}});
+  ExpectDone();
+  for (size_t i = 0; i < kState.size(); ++i) {
+    EXPECT_ABS_READ32(
+        base_ + HMAC_DIGEST_0_REG_OFFSET + i * sizeof(uint32_t), kState[i]);
+  }
+  EXPECT_ABS_READ32(base_ + HMAC_MSG_LENGTH_LOWER_REG_OFFSET, 512);
+  EXPECT_ABS_READ32(base_ + HMAC_MSG_LENGTH_UPPER_REG_OFFSET, 0);
+  EXPECT_ABS_READ32(base_ + HMAC_CFG_REG_OFFSET, cfg_);
+  EXPECT_ABS_WRITE32(base_ + HMAC_CFG_REG_OFFSET, 0);
+  EXPECT_ABS_WRITE32(base_ + HMAC_CFG_REG_OFFSET, cfg_);
+
+  hmac_cfg_cached_context_t ctx;
+  hmac_sha256_cfg_cached_save(&ctx);
+  EXPECT_EQ(ctx.cfg, cfg_);
+  EXPECT_THAT(ctx.ctx.digest, ElementsAreArray(kState));
+
+  // Restoring does not read the configuration register.
+  EXPECT_ABS_WRITE32(base_ + HMAC_CFG_REG_OFFSET, 0);
+  for (size_t i = 0; i < kState.size(); ++i) {
+    EXPECT_ABS_WRITE32(
+        base_ + HMAC_DIGEST_0_REG_OFFSET + i * sizeof(uint32_t), kState[i]);
+  }
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_LENGTH_LOWER_REG_OFFSET, 512);
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_LENGTH_UPPER_REG_OFFSET, 0);
+  EXPECT_ABS_WRITE32(base_ + HMAC_CFG_REG_OFFSET, cfg_);
+  EXPECT_ABS_WRITE32(base_ + HMAC_CMD_REG_OFFSET,
+                     {{HMAC_CMD_HASH_CONTINUE_BIT, true}});
+
+  hmac_sha256_cfg_cached_restore(&ctx);
+
+  // Neither does reading the digest.
+  ExpectDone();
+  EXPECT_ABS_READ32(base_ + HMAC_DIGEST_7_REG_OFFSET, 0xa0a0a0a0);
+  EXPECT_ABS_READ32(base_ + HMAC_DIGEST_6_REG_OFFSET, 0xa1a1a1a1);
+  EXPECT_ABS_READ32(base_ + HMAC_DIGEST_5_REG_OFFSET, 0xa2a2a2a2);
+  EXPECT_ABS_READ32(base_ + HMAC_DIGEST_4_REG_OFFSET, 0xa3a3a3a3);
+
+  std::array<uint32_t, 4> digest;
+  hmac_sha256_cfg_cached_final_truncated(&ctx, digest.data(), digest.size());
+  EXPECT_THAT(digest, ElementsAreArray({0xa0a0a0a0, 0xa1a1a1a1, 0xa2a2a2a2,
+                                        0xa3a3a3a3}));
+}
+
 }  // namespace
 }  // namespace hmac_unittest
@@ -34,6 +34,22 @@ rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
   return MockFlashCtrl::Instance().DataWrite(addr, word_count, data);
 }
 
+void flash_ctrl_data_write_stream_start(flash_ctrl_write_stream_t *stream,
+                                        uint32_t addr) {
+  MockFlashCtrl::Instance().DataWriteStreamStart(stream, addr);
+}
+
+rom_error_t flash_ctrl_data_write_stream_append(
+    flash_ctrl_write_stream_t *stream, uint32_t word_count, const void *data) {
+  return MockFlashCtrl::Instance().DataWriteStreamAppend(stream, word_count,
+                                                         data);
+}
+
+rom_error_t flash_ctrl_data_write_stream_finish(
+    flash_ctrl_write_stream_t *stream) {
+  return MockFlashCtrl::Instance().DataWriteStreamFinish(stream);
+}
+
 rom_error_t flash_ctrl_info_write(const flash_ctrl_info_page_t *info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data) {
@@ -24,6 +24,12 @@ class MockFlashCtrl : public global_mock::GlobalMock<MockFlashCtrl> {
   MOCK_METHOD(rom_error_t, InfoRead,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t, void *));
   MOCK_METHOD(rom_error_t, DataWrite, (uint32_t, uint32_t, const void *));
+  MOCK_METHOD(void, DataWriteStreamStart,
+              (flash_ctrl_write_stream_t *, uint32_t));
+  MOCK_METHOD(rom_error_t, DataWriteStreamAppend,
+              (flash_ctrl_write_stream_t *, uint32_t, const void *));
+  MOCK_METHOD(rom_error_t, DataWriteStreamFinish,
+              (flash_ctrl_write_stream_t *));
   MOCK_METHOD(rom_error_t, InfoWrite,
               (const flash_ctrl_info_page_t *, uint32_t, uint32_t,
                const void *));
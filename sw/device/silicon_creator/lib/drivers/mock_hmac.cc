@@ -32,6 +32,8 @@ void hmac_sha256_final(hmac_digest_t *digest) {
   MockHmac::Instance().sha256_final(digest);
 }
 
+void hmac_sha256_clear(void) { MockHmac::Instance().sha256_clear(); }
+
 void hmac_sha256(const void *data, size_t len, hmac_digest_t *digest) {
   MockHmac::Instance().sha256(data, len, digest);
 }
@@ -43,5 +45,18 @@ void hmac_sha256_save(hmac_context_t *ctx) {
 void hmac_sha256_restore(const hmac_context_t *ctx) {
   MockHmac::Instance().sha256_restore(ctx);
 }
+
+void hmac_sha256_cfg_cached_save(hmac_cfg_cached_context_t *ctx) {
+  MockHmac::Instance().sha256_cfg_cached_save(ctx);
+}
+
+void hmac_sha256_cfg_cached_restore(const hmac_cfg_cached_context_t *ctx) {
+  MockHmac::Instance().sha256_cfg_cached_restore(ctx);
+}
+
+void hmac_sha256_cfg_cached_final_truncated(
+    const hmac_cfg_cached_context_t *ctx, uint32_t *digest, size_t len) {
+  MockHmac::Instance().sha256_cfg_cached_final_truncated(ctx, digest, len);
+}
 }  // extern "C"
 }  // namespace rom_test
@@ -25,9 +25,15 @@ class MockHmac : public global_mock::GlobalMock<MockHmac> {
   MOCK_METHOD(void, sha256_process, ());
   MOCK_METHOD(void, sha256_final_truncated, (uint32_t *, size_t));
   MOCK_METHOD(void, sha256_final, (hmac_digest_t *));
+  MOCK_METHOD(void, sha256_clear, ());
   MOCK_METHOD(void, sha256, (const void *, size_t, hmac_digest_t *));
   MOCK_METHOD(void, sha256_save, (hmac_context_t *));
   MOCK_METHOD(void, sha256_restore, (const hmac_context_t *));
+  MOCK_METHOD(void, sha256_cfg_cached_save, (hmac_cfg_cached_context_t *));
+  MOCK_METHOD(void, sha256_cfg_cached_restore,
+              (const hmac_cfg_cached_context_t *));
+  MOCK_METHOD(void, sha256_cfg_cached_final_truncated,
+              (const hmac_cfg_cached_context_t *, uint32_t *, size_t));
 };
 
 }  // namespace internal
@@ -69,6 +69,14 @@ rom_error_t sc_otbn_busy_wait_for_done(void) {
   return kErrorOtbnUnavailable;
 }
 
+hardened_bool_t sc_otbn_is_busy(void) {
+  uint32_t status = abs_mmio_read32(otbn_base() + OTBN_STATUS_REG_OFFSET);
+  if (status == kScOtbnStatusIdle || status == kScOtbnStatusLocked) {
+    return kHardenedBoolFalse;
+  }
+  return kHardenedBoolTrue;
+}
+
 /**
  * Helper function for writing to OTBN's DMEM or IMEM.
  *
@@ -9,6 +9,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/hardened.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
 #ifdef __cplusplus
@@ -285,6 +286,19 @@ rom_error_t sc_otbn_execute_finish(void);
 OT_WARN_UNUSED_RESULT
 rom_error_t sc_otbn_busy_wait_for_done(void);
 
+/**
+ * Checks whether OTBN is busy without blocking.
+ *
+ * This function is meant for scheduling work on Ibex while OTBN is running and
+ * must not be used in place of `sc_otbn_busy_wait_for_done()` or
+ * `sc_otbn_execute_finish()`, which also check for errors.
+ *
+ * @return `kHardenedBoolTrue` if OTBN is busy, `kHardenedBoolFalse` if it is
+ * idle or locked.
+ */
+OT_WARN_UNUSED_RESULT
+hardened_bool_t sc_otbn_is_busy(void);
+
 /**
  * Read OTBN's instruction count register.
  *
@@ -142,6 +142,21 @@ TEST_F(IsBusyTest, Success) {
   EXPECT_EQ(sc_otbn_busy_wait_for_done(), kErrorOk);
 }
 
+TEST_F(IsBusyTest, NonBlocking) {
+  EXPECT_ABS_READ32(base_ + OTBN_STATUS_REG_OFFSET, kScOtbnStatusBusyExecute);
+  EXPECT_EQ(sc_otbn_is_busy(), kHardenedBoolTrue);
+
+  EXPECT_ABS_READ32(base_ + OTBN_STATUS_REG_OFFSET,
+                    kScOtbnStatusBusySecWipeDmem);
+  EXPECT_EQ(sc_otbn_is_busy(), kHardenedBoolTrue);
+
+  EXPECT_ABS_READ32(base_ + OTBN_STATUS_REG_OFFSET, kScOtbnStatusIdle);
+  EXPECT_EQ(sc_otbn_is_busy(), kHardenedBoolFalse);
+
+  EXPECT_ABS_READ32(base_ + OTBN_STATUS_REG_OFFSET, kScOtbnStatusLocked);
+  EXPECT_EQ(sc_otbn_is_busy(), kHardenedBoolFalse);
+}
+
 class ImemSecWipeTest : public OtbnTest {};
 
 TEST_F(ImemSecWipeTest, Success) {
@@ -22,23 +22,38 @@ const uint32_t kFlashPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE;
 const uint32_t kFlashBankSize =
     kFlashPageSize * FLASH_CTRL_PARAM_REG_PAGES_PER_BANK;
 
+/**
+ * Returns the offset of the bank of the selected firmware slot.
+ */
+static uint32_t firmware_bank_offset(const rescue_state_t *state) {
+  return state->mode == kRescueModeFirmwareSlotB ? kFlashBankSize : 0;
+}
+
+/**
+ * Erases the rescue region of the selected firmware slot.
+ */
+static rom_error_t flash_firmware_erase(rescue_state_t *state,
+                                        uint32_t bank_offset) {
+  // TODO(#24428): Make sure we interact correctly with owner flash region
+  // configuration.
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4True,
+      .write = kMultiBitBool4True,
+      .erase = kMultiBitBool4True,
+  });
+  for (uint32_t addr = state->flash_start; addr < state->flash_limit;
+       addr += kFlashPageSize) {
+    HARDENED_RETURN_IF_ERROR(
+        flash_ctrl_data_erase(bank_offset + addr, kFlashCtrlEraseTypePage));
+  }
+  state->flash_offset = state->flash_start;
+  return kErrorOk;
+}
+
 rom_error_t flash_firmware_block(rescue_state_t *state) {
-  uint32_t bank_offset =
-      state->mode == kRescueModeFirmwareSlotB ? kFlashBankSize : 0;
+  uint32_t bank_offset = firmware_bank_offset(state);
   if (state->flash_offset == 0) {
-    // TODO(#24428): Make sure we interact correctly with owner flash region
-    // configuration.
-    flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
-        .read = kMultiBitBool4True,
-        .write = kMultiBitBool4True,
-        .erase = kMultiBitBool4True,
-    });
-    for (uint32_t addr = state->flash_start; addr < state->flash_limit;
-         addr += kFlashPageSize) {
-      HARDENED_RETURN_IF_ERROR(
-          flash_ctrl_data_erase(bank_offset + addr, kFlashCtrlEraseTypePage));
-    }
-    state->flash_offset = state->flash_start;
+    HARDENED_RETURN_IF_ERROR(flash_firmware_erase(state, bank_offset));
   }
   if (state->flash_offset < state->flash_limit) {
     HARDENED_RETURN_IF_ERROR(flash_ctrl_data_write(
@@ -51,6 +66,43 @@ rom_error_t flash_firmware_block(rescue_state_t *state) {
   return kErrorOk;
 }
 
+rom_error_t rescue_stream_start(rescue_state_t *state) {
+  if (state->mode != kRescueModeFirmware &&
+      state->mode != kRescueModeFirmwareSlotB) {
+    return kErrorRescueBadMode;
+  }
+  // The mode may be the initial one, which was never checked against the
+  // allowlist, so check it before erasing anything.
+  hardened_bool_t allow =
+      owner_rescue_command_allowed(state->config, state->mode);
+  if (allow != kHardenedBoolTrue) {
+    return kErrorRescueBadMode;
+  }
+  HARDENED_CHECK_EQ(allow, kHardenedBoolTrue);
+  uint32_t bank_offset = firmware_bank_offset(state);
+  HARDENED_RETURN_IF_ERROR(flash_firmware_erase(state, bank_offset));
+  flash_ctrl_data_write_stream_start(&state->flash_stream,
+                                     bank_offset + state->flash_offset);
+  state->streaming = true;
+  return kErrorOk;
+}
+
+rom_error_t rescue_stream_data(rescue_state_t *state, const uint8_t *data,
+                               size_t len) {
+  if (len > state->flash_limit - state->flash_offset) {
+    return kErrorRescueImageTooBig;
+  }
+  HARDENED_RETURN_IF_ERROR(flash_ctrl_data_write_stream_append(
+      &state->flash_stream, len / sizeof(uint32_t), data));
+  state->flash_offset += len;
+  return kErrorOk;
+}
+
+rom_error_t rescue_stream_finish(rescue_state_t *state) {
+  state->streaming = false;
+  return flash_ctrl_data_write_stream_finish(&state->flash_stream);
+}
+
 rom_error_t flash_owner_block(rescue_state_t *state, boot_data_t *bootdata) {
   if (bootdata->ownership_state == kOwnershipStateUnlockedAny ||
       bootdata->ownership_state == kOwnershipStateUnlockedSelf ||
@@ -105,6 +157,16 @@ rom_error_t rescue_validate_mode(uint32_t mode, rescue_state_t *state,
       dbg_printf("ok: wait after upload\r\n");
       state->reboot = false;
       goto exitproc;
+    case kRescueModeStream:
+      // Streaming applies to the firmware mode selected before, which
+      // `rescue_stream_start()` checks against the allowlist. Keep the current
+      // mode and upload state.
+      if (rescue_stream_start(state) != kErrorOk) {
+        dbg_printf("error: cannot stream in current mode\r\n");
+        return kErrorRescueBadMode;
+      }
+      dbg_printf("ok: stream firmware\r\n");
+      return kErrorOk;
 #ifdef ROM_EXT_KLOBBER_ALLOWED
     case kRescueModeKlobber:
       ownership_erase();
@@ -160,6 +222,10 @@ rom_error_t rescue_validate_mode(uint32_t mode, rescue_state_t *state,
     result = kErrorRescueBadMode;
   }
 exitproc:
+  if (state->streaming) {
+    // Changing modes abandons a streamed upload that has not started yet.
+    OT_DISCARD(rescue_stream_finish(state));
+  }
   state->frame = 1;
   state->offset = 0;
   state->flash_offset = 0;
@@ -266,7 +332,11 @@ rom_error_t rescue_recv_handler(rescue_state_t *state, boot_data_t *bootdata) {
 
 void rescue_state_init(rescue_state_t *state,
                        const owner_rescue_config_t *config) {
+  // The protocol selects the firmware mode first. It is not allowed by every
+  // config, so all handlers check the mode against the allowlist again.
+  state->mode = kRescueModeFirmware;
   state->config = config;
+  state->streaming = false;
   if ((hardened_bool_t)config == kHardenedBoolFalse) {
     HARDENED_CHECK_EQ((hardened_bool_t)config, kHardenedBoolFalse);
     // If there is no rescue config, then the rescue region starts immediately
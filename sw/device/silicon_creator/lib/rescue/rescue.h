@@ -10,9 +10,14 @@
 
 #include "sw/device/silicon_creator/lib/boot_data.h"
 #include "sw/device/silicon_creator/lib/dbg_print.h"
+#include "sw/device/silicon_creator/lib/drivers/flash_ctrl.h"
 #include "sw/device/silicon_creator/lib/error.h"
 #include "sw/device/silicon_creator/lib/ownership/datatypes.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
 enum {
   // Rescue is signalled by asserting serial break to the UART for at least
   // 4 byte periods.  At 115200 bps, one byte period is about 87us; four is
@@ -45,6 +50,8 @@ typedef enum {
   kRescueModeFirmwareSlotB = 0x52455342,
   /** `REBO` */
   kRescueModeReboot = 0x5245424f,
+  /** `STRM` */
+  kRescueModeStream = 0x5354524d,
   /** `WAIT` */
   kRescueModeWait = 0x57414954,
 } rescue_mode_t;
@@ -79,6 +86,11 @@ typedef struct RescueState {
   // Range to erase and write for firmware rescue (inclusive).
   uint32_t flash_start;
   uint32_t flash_limit;
+  // Whether the firmware upload is streamed, i.e. programmed into flash as it
+  // arrives without per-frame acknowledgements.
+  bool streaming;
+  // Flash program stream of a streamed firmware upload.
+  flash_ctrl_write_stream_t flash_stream;
   // Rescue configuration.
   const owner_rescue_config_t *config;
   // Data buffer to hold xmodem upload data.
@@ -105,6 +117,42 @@ rom_error_t rescue_send_handler(rescue_state_t *state, boot_data_t *bootdata);
  */
 rom_error_t rescue_recv_handler(rescue_state_t *state, boot_data_t *bootdata);
 
+/**
+ * Start a streamed firmware upload.
+ *
+ * Erases the rescue region of the selected firmware slot up front and starts a
+ * flash program stream at its beginning, so that received data can be
+ * programmed while the rest of the upload is still arriving.
+ *
+ * @param state Rescue state
+ * @return kErrorOk if the upload was started, kErrorRescueBadMode if the
+ *         current mode is not a firmware mode or is not allowed by the rescue
+ *         config, or a flash error.
+ */
+rom_error_t rescue_stream_start(rescue_state_t *state);
+
+/**
+ * Program a chunk of a streamed firmware upload.
+ *
+ * @param state Rescue state
+ * @param data The chunk to program. Must be word aligned.
+ * @param len The length of the chunk, a multiple of the flash word size.
+ * @return kErrorOk, kErrorRescueImageTooBig if the chunk does not fit into the
+ *         rescue region, or a flash error.
+ */
+rom_error_t rescue_stream_data(rescue_state_t *state, const uint8_t *data,
+                               size_t len);
+
+/**
+ * Finish a streamed firmware upload.
+ *
+ * Waits for the last chunk to be programmed.
+ *
+ * @param state Rescue state
+ * @return Result of the last program operation.
+ */
+rom_error_t rescue_stream_finish(rescue_state_t *state);
+
 /**
  * Validate a new rescue mode.
  *
@@ -145,4 +193,8 @@ rom_error_t rescue_protocol(boot_data_t *bootdata,
  */
 hardened_bool_t rescue_detect_entry(const owner_rescue_config_t *config);
 
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_RESCUE_RESCUE_H_
@@ -0,0 +1,101 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/rescue/rescue.h"
+
+#include <array>
+
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mock_abs_mmio.h"
+#include "sw/device/silicon_creator/lib/boot_data.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/ownership/datatypes.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+#include "hw/top/flash_ctrl_regs.h"
+#include "hw/top/uart_regs.h"
+
+namespace rescue_unittest {
+namespace {
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr uint32_t kPageSize = FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+
+class RescueTest : public rom_test::RomTest {
+ protected:
+  void SetUp() override {
+    // Debug messages go to the UART, which is always idle.
+    ON_CALL(mmio_, Read32(_))
+        .WillByDefault(Return(1u << UART_STATUS_TXIDLE_BIT));
+  }
+
+  /**
+   * Initializes the rescue state with a config that only allows `command`.
+   */
+  void Init(uint32_t command) {
+    config_words_.fill(0);
+    owner_rescue_config_t *config =
+        reinterpret_cast<owner_rescue_config_t *>(config_words_.data());
+    config->header.tag = kTlvTagRescueConfig;
+    config->header.length = sizeof(owner_rescue_config_t) + sizeof(uint32_t);
+    config->start = 2;
+    config->size = 2;
+    config->command_allow[0] = command;
+    rescue_state_init(&state_, config);
+  }
+
+  std::array<uint32_t, 8> config_words_;
+  rescue_state_t state_;
+  boot_data_t boot_data_{};
+  NiceMock<rom_test::internal::MockAbsMmio> mmio_;
+  rom_test::MockFlashCtrl flash_ctrl_;
+};
+
+TEST_F(RescueTest, StreamFirmware) {
+  Init(kRescueModeFirmware);
+  EXPECT_EQ(rescue_validate_mode(kRescueModeFirmware, &state_, &boot_data_),
+            kErrorOk);
+
+  EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet(_));
+  EXPECT_CALL(flash_ctrl_, DataErase(2 * kPageSize, kFlashCtrlEraseTypePage))
+      .WillOnce(Return(kErrorOk));
+  EXPECT_CALL(flash_ctrl_, DataErase(3 * kPageSize, kFlashCtrlEraseTypePage))
+      .WillOnce(Return(kErrorOk));
+  EXPECT_CALL(flash_ctrl_, DataWriteStreamStart(&state_.flash_stream,
+                                                2 * kPageSize));
+  EXPECT_EQ(rescue_validate_mode(kRescueModeStream, &state_, &boot_data_),
+            kErrorOk);
+  EXPECT_TRUE(state_.streaming);
+  EXPECT_EQ(state_.mode, kRescueModeFirmware);
+}
+
+TEST_F(RescueTest, StreamFirmwareNotAllowed) {
+  Init(kRescueModeBootLog);
+  // The initial mode is not allowed by the config, so the protocol cannot
+  // select it either.
+  EXPECT_EQ(state_.mode, kRescueModeFirmware);
+  EXPECT_EQ(rescue_validate_mode(kRescueModeFirmware, &state_, &boot_data_),
+            kErrorRescueBadMode);
+
+  // Nothing is erased or programmed.
+  EXPECT_EQ(rescue_validate_mode(kRescueModeStream, &state_, &boot_data_),
+            kErrorRescueBadMode);
+  EXPECT_FALSE(state_.streaming);
+}
+
+TEST_F(RescueTest, StreamNotFirmware) {
+  Init(kRescueModeBootLog);
+  EXPECT_EQ(rescue_validate_mode(kRescueModeBootLog, &state_, &boot_data_),
+            kErrorOk);
+
+  EXPECT_EQ(rescue_validate_mode(kRescueModeStream, &state_, &boot_data_),
+            kErrorRescueBadMode);
+  EXPECT_FALSE(state_.streaming);
+  EXPECT_EQ(state_.mode, kRescueModeBootLog);
+}
+
+}  // namespace
+}  // namespace rescue_unittest
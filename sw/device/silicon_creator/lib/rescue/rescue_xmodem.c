@@ -81,6 +81,38 @@ static rom_error_t handle_recv_modes(rescue_state_t *state,
   return error;
 }
 
+static rom_error_t stream_chunk(void *ctx, const uint8_t *data, size_t len) {
+  return rescue_stream_data((rescue_state_t *)ctx, data, len);
+}
+
+static void recv_start(const rescue_state_t *state) {
+  if (state->streaming) {
+    xmodem_recv_start_streaming(iohandle);
+  } else {
+    xmodem_recv_start(iohandle);
+  }
+}
+
+static rom_error_t recv_frame(rescue_state_t *state, size_t *rxlen,
+                              uint8_t *command) {
+  if (state->streaming) {
+    // Streamed frames are programmed while they arrive, so they don't need to
+    // be accumulated in the data buffer.
+    return xmodem_recv_frame_chunked(iohandle, state->frame, state->data,
+                                     rxlen, command, stream_chunk, state);
+  }
+  return xmodem_recv_frame(iohandle, state->frame, state->data + state->offset,
+                           rxlen, command);
+}
+
+static rom_error_t stream_abort(rescue_state_t *state, rom_error_t error) {
+  // Xmodem-G has no retransmissions, so any error ends the upload. The data
+  // programmed so far stays in flash as an incomplete image.
+  xmodem_cancel(iohandle);
+  OT_DISCARD(rescue_stream_finish(state));
+  return error;
+}
+
 static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
   rom_error_t result;
   size_t rxlen;
@@ -90,24 +122,29 @@ static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
   state->reboot = true;
   validate_mode(kRescueModeFirmware, state, bootdata);
 
-  xmodem_recv_start(iohandle);
+  recv_start(state);
   while (true) {
     HARDENED_RETURN_IF_ERROR(handle_send_modes(state, bootdata));
-    result = xmodem_recv_frame(iohandle, state->frame,
-                               state->data + state->offset, &rxlen, &command);
+    result = recv_frame(state, &rxlen, &command);
     if (state->frame == 1 && result == kErrorXModemTimeoutStart) {
-      xmodem_recv_start(iohandle);
+      recv_start(state);
       continue;
     }
     switch (result) {
       case kErrorOk:
+        if (state->streaming) {
+          // Already programmed and the sender doesn't wait for an ACK.
+          break;
+        }
         // Packet ok.
         state->offset += rxlen;
         HARDENED_RETURN_IF_ERROR(handle_recv_modes(state, bootdata));
         xmodem_ack(iohandle, true);
         break;
       case kErrorXModemEndOfFile:
-        if (state->offset % 2048 != 0) {
+        if (state->streaming) {
+          HARDENED_RETURN_IF_ERROR(rescue_stream_finish(state));
+        } else if (state->offset % 2048 != 0) {
           // If there is unhandled residue, extend out to a full block and
           // then handle it.
           while (state->offset % 2048 != 0) {
@@ -124,9 +161,15 @@ static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
         }
         return kErrorRescueReboot;
       case kErrorXModemCrc:
+        if (state->streaming) {
+          return stream_abort(state, result);
+        }
         xmodem_ack(iohandle, false);
         continue;
       case kErrorXModemCancel:
+        if (state->streaming) {
+          OT_DISCARD(rescue_stream_finish(state));
+        }
         return result;
       case kErrorXModemUnknown:
         if (state->frame == 1) {
@@ -140,6 +183,9 @@ static rom_error_t protocol(rescue_state_t *state, boot_data_t *bootdata) {
         }
         OT_FALLTHROUGH_INTENDED;
       default:
+        if (state->streaming) {
+          return stream_abort(state, result);
+        }
         return result;
     }
     state->frame += 1;
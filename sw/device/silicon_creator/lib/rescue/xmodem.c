@@ -21,11 +21,13 @@ enum {
   kXModemAck = 0x06,
   kXModemNak = 0x15,
   kXModemCancel = 0x18,
+  kXModemStreaming = 0x47,
   kXModemPoly = 0x1021,
   kXModemSendRetries = 3,
   kXModemMaxErrors = 2,
   kXModemShortTimeout = 100,
   kXModemLongTimeout = 1000,
+  kXModemChunkSize = 64,
 };
 
 #ifndef XMODEM_TESTLIB
@@ -78,12 +80,24 @@ void xmodem_recv_start(void *iohandle) {
   xmodem_putchar(iohandle, kXModemCrc16);
 }
 
+void xmodem_recv_start_streaming(void *iohandle) {
+  xmodem_putchar(iohandle, kXModemStreaming);
+}
+
 void xmodem_ack(void *iohandle, bool ack) {
   xmodem_putchar(iohandle, ack ? kXModemAck : kXModemNak);
 }
 
 rom_error_t xmodem_recv_frame(void *iohandle, uint32_t frame, uint8_t *data,
                               size_t *rxlen, uint8_t *unknown_rx) {
+  return xmodem_recv_frame_chunked(iohandle, frame, data, rxlen, unknown_rx,
+                                   NULL, NULL);
+}
+
+rom_error_t xmodem_recv_frame_chunked(void *iohandle, uint32_t frame,
+                                      uint8_t *data, size_t *rxlen,
+                                      uint8_t *unknown_rx,
+                                      xmodem_chunk_fn_t chunk_fn, void *ctx) {
   uint8_t ch;
   size_t n = xmodem_read(iohandle, &ch, sizeof(ch), kXModemLongTimeout);
   if (n == 0) {
@@ -105,9 +119,25 @@ rom_error_t xmodem_recv_frame(void *iohandle, uint32_t frame, uint8_t *data,
     // Receive the data.  At 115200 bps, 1K should take about 89ms to
     // receive a 1K frame.  A short timeout should be enough, but we'll
     // be generous and give more time.
-    n = xmodem_read(iohandle, data, len, kXModemShortTimeout * 3);
-    if (n != len) {
-      return kErrorXModemTimeoutData;
+    if (chunk_fn == NULL) {
+      n = xmodem_read(iohandle, data, len, kXModemShortTimeout * 3);
+      if (n != len) {
+        return kErrorXModemTimeoutData;
+      }
+    } else {
+      // Both frame sizes are a multiple of the chunk size. Frames with a bad
+      // frame number are received but not handed out since they will be
+      // cancelled below.
+      for (size_t i = 0; i < len; i += kXModemChunkSize) {
+        n = xmodem_read(iohandle, data + i, kXModemChunkSize,
+                        kXModemShortTimeout);
+        if (n != kXModemChunkSize) {
+          return kErrorXModemTimeoutData;
+        }
+        if (!cancel) {
+          HARDENED_RETURN_IF_ERROR(chunk_fn(ctx, data + i, kXModemChunkSize));
+        }
+      }
     }
 
     // Receive the CRC-16 from the client.
@@ -17,6 +17,18 @@
  */
 void xmodem_recv_start(void *iohandle);
 
+/**
+ * Send the Xmodem-G start sequence.
+ *
+ * Xmodem-G is a streaming variant of Xmodem-CRC: the sender transmits frames
+ * back-to-back without waiting for an ACK after each frame, and the receiver
+ * cancels the transfer on the first error instead of requesting a
+ * retransmission. Only the end of the transfer is acknowledged.
+ *
+ * @param iohandle An opaque user point associated with the io device.
+ */
+void xmodem_recv_start_streaming(void *iohandle);
+
 /**
  * Acknowledge an Xmodem frame.
  *
@@ -42,6 +54,43 @@ void xmodem_cancel(void *iohandle);
 rom_error_t xmodem_recv_frame(void *iohandle, uint32_t frame, uint8_t *data,
                               size_t *rxlen, uint8_t *unknown_rx);
 
+/**
+ * Consumes a chunk of a frame while the rest of the frame is being received.
+ *
+ * @param ctx The opaque context passed to `xmodem_recv_frame_chunked()`.
+ * @param data The received chunk.
+ * @param len The length of the chunk.
+ * @return Error value. Errors abort the reception of the frame.
+ */
+typedef rom_error_t (*xmodem_chunk_fn_t)(void *ctx, const uint8_t *data,
+                                         size_t len);
+
+/**
+ * Receive a frame using Xmodem-CRC, handing out data chunks as they arrive.
+ *
+ * Same as `xmodem_recv_frame()`, but the data of the frame is received in
+ * chunks of 64 bytes and each chunk is passed to `chunk_fn` before the next
+ * one is received. This allows the caller to process a frame, e.g. program it
+ * into flash, while the rest of it is still arriving.
+ *
+ * Note that chunks are handed out before the CRC of the frame is checked.
+ * Callers must discard everything the callback has consumed if this function
+ * does not return `kErrorOk`.
+ *
+ * @param iohandle An opaque user point associated with the io device.
+ * @param frame The frame number expected (start at 1).
+ * @param data Buffer to receive the data into.
+ * @param rxlen The length of data received.
+ * @param unknown_rx The byte received when the error is kErrorXmodemUnknown.
+ * @param chunk_fn Callback to consume chunks of the frame.
+ * @param ctx Opaque context for `chunk_fn`.
+ * @return Error value.
+ */
+rom_error_t xmodem_recv_frame_chunked(void *iohandle, uint32_t frame,
+                                      uint8_t *data, size_t *rxlen,
+                                      uint8_t *unknown_rx,
+                                      xmodem_chunk_fn_t chunk_fn, void *ctx);
+
 /**
  * Send data using Xmodem-CRC.
  *
@@ -9,19 +9,8 @@
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 
-/**
- * Subtracts the modulus of `key` from `a` in-place, i.e. `a -= n`.
- *
- * Since `a` can be smaller than the modulus, this function also returns the
- * borrow.
- *
- * @param key An RSA public key.
- * @param[in,out] a Buffer that holds `a`, little-endian.
- * @return Borrow.
- */
-OT_WARN_UNUSED_RESULT
-static uint32_t subtract_modulus(const sigverify_rsa_key_t *key,
-                                 sigverify_rsa_buffer_t *a) {
+uint32_t sigverify_mod_exp_ibex_subtract_modulus(const sigverify_rsa_key_t *key,
+                                                 sigverify_rsa_buffer_t *a) {
   uint32_t borrow = 0;
   for (size_t i = 0; i < ARRAYSIZE(a->data); ++i) {
     uint32_t temp = a->data[i] - borrow;
@@ -33,16 +22,8 @@ static uint32_t subtract_modulus(const sigverify_rsa_key_t *key,
   return borrow;
 }
 
-/**
- * Checks if `a` is greater than or equal to the modulus of `key`.
- *
- * @param key An RSA public key.
- * @param a Buffer that holds `a`, little-endian.
- * @return Comparison result.
- */
-OT_WARN_UNUSED_RESULT
-static bool greater_equal_modulus(const sigverify_rsa_key_t *key,
-                                  const sigverify_rsa_buffer_t *a) {
+bool sigverify_mod_exp_ibex_greater_equal_modulus(
+    const sigverify_rsa_key_t *key, const sigverify_rsa_buffer_t *a) {
   // Note: Loop terminates when `i` wraps around.
   for (size_t i = ARRAYSIZE(a->data) - 1; i < ARRAYSIZE(a->data); --i) {
     if (a->data[i] != key->n.data[i]) {
@@ -72,25 +53,33 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
 }
 
 /**
- * Computes the Montgomery reduction of the product of two integers.
+ * Processes the j^th word of `y` and `n` in the inner loop of
+ * `sigverify_mod_exp_ibex_mont_mul()`.
  *
- * Given an RSA public key, x, and y this function computes x*y*R^-1 mod n,
- * where
- * - x and y are integers with `kSigVerifyRsaNumWords` base 2^32 digits,
- * - n is the modulus of the key, and
- * - R is 2^`kSigVerifyRsaNumBits`, e.g. 2^3072 for RSA-3072.
- *
- * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36.
- *
- * @param key An RSA public key.
- * @param x Buffer that holds `x`, little-endian.
+ * @param x_i Current digit of `x`.
+ * @param u_i Montgomery quotient digit for `x_i`.
  * @param y Buffer that holds `y`, little-endian.
- * @param[out] result Buffer to write the result to, little-endian.
+ * @param key An RSA public key.
+ * @param[in,out] result Intermediate result, little-endian.
+ * @param j Index of the word to process, must be greater than zero.
+ * @param[in,out] acc0 Sum of the first two addends in step 2.2.
+ * @param[in,out] acc1 Sum of all three addends in step 2.2.
  */
-static void mont_mul(const sigverify_rsa_key_t *key,
-                     const sigverify_rsa_buffer_t *x,
-                     const sigverify_rsa_buffer_t *y,
-                     sigverify_rsa_buffer_t *result) {
+OT_ALWAYS_INLINE
+static void mont_mul_word(uint32_t x_i, uint32_t u_i,
+                          const sigverify_rsa_buffer_t *y,
+                          const sigverify_rsa_key_t *key,
+                          sigverify_rsa_buffer_t *result, size_t j,
+                          uint64_t *acc0, uint64_t *acc1) {
+  *acc0 = (uint64_t)x_i * y->data[j] + result->data[j] + (*acc0 >> 32);
+  *acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)*acc0 + (*acc1 >> 32);
+  result->data[j - 1] = (uint32_t)*acc1;
+}
+
+void sigverify_mod_exp_ibex_mont_mul(const sigverify_rsa_key_t *key,
+                                     const sigverify_rsa_buffer_t *x,
+                                     const sigverify_rsa_buffer_t *y,
+                                     sigverify_rsa_buffer_t *result) {
   memset(result->data, 0, sizeof(result->data));
 
   for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
@@ -104,16 +93,24 @@ static void mont_mul(const sigverify_rsa_key_t *key,
     // 0xffff_ffff_ffff_ffff.
 
     // Holds the sum of the first two addends in step 2.2.
-    uint64_t acc0 = (uint64_t)x->data[i] * y->data[0] + result->data[0];
+    const uint32_t x_i = x->data[i];
+    uint64_t acc0 = (uint64_t)x_i * y->data[0] + result->data[0];
     const uint32_t u_i = (uint32_t)acc0 * key->n0_inv[0];
     // Holds the sum of the all three addends in step 2.2.
     uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
 
-    // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
-      acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
-      result->data[j - 1] = (uint32_t)acc1;
+    // Process the i^th digit of `x`, i.e. `x[i]`, four words at a time. This
+    // keeps `x_i`, `u_i`, and the accumulators in registers and amortizes the
+    // loop overhead over four multiply-accumulate pairs.
+    size_t j = 1;
+    for (; j + 3 < ARRAYSIZE(result->data); j += 4) {
+      mont_mul_word(x_i, u_i, y, key, result, j, &acc0, &acc1);
+      mont_mul_word(x_i, u_i, y, key, result, j + 1, &acc0, &acc1);
+      mont_mul_word(x_i, u_i, y, key, result, j + 2, &acc0, &acc1);
+      mont_mul_word(x_i, u_i, y, key, result, j + 3, &acc0, &acc1);
+    }
+    for (; j < ARRAYSIZE(result->data); ++j) {
+      mont_mul_word(x_i, u_i, y, key, result, j, &acc0, &acc1);
     }
     acc0 = (acc0 >> 32) + (acc1 >> 32);
     result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
@@ -128,25 +125,19 @@ static void mont_mul(const sigverify_rsa_key_t *key,
     // not a direct comparison with the modulus, the final result is not
     // guaranteed to be the least non-negative residue of x*y*R^-1 mod n.
     if (acc0 >> 32) {
-      OT_DISCARD(subtract_modulus(key, result));
+      OT_DISCARD(sigverify_mod_exp_ibex_subtract_modulus(key, result));
     }
   }
 }
 
-/**
- * Calculates R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
- *
- * @param key An RSA public key.
- * @param[out] result Buffer to write the result to, little-endian.
- */
-static void calc_r_square(const sigverify_rsa_key_t *key,
-                          sigverify_rsa_buffer_t *result) {
+void sigverify_mod_exp_ibex_calc_r_square(const sigverify_rsa_key_t *key,
+                                          sigverify_rsa_buffer_t *result) {
   sigverify_rsa_buffer_t buf;
   memset(buf.data, 0, sizeof(result->data));
   // This subtraction sets buf = -n mod R = R - n, which is equivalent to R
   // modulo n and ensures that `buf` fits in `kSigVerifyRsaNumWords` going
   // into the loop.
-  OT_DISCARD(subtract_modulus(key, &buf));
+  OT_DISCARD(sigverify_mod_exp_ibex_subtract_modulus(key, &buf));
 
   // Compute (2^96 * R) mod n.
   // Each run of the loop doubles buf and reduces modulo n.
@@ -154,16 +145,17 @@ static void calc_r_square(const sigverify_rsa_key_t *key,
     uint32_t msb = shift_left(&buf);
     // Reduce until buf < n. Doing this at every iteration minimizes the
     // total number of subtractions that we need to perform.
-    while (msb > 0 || greater_equal_modulus(key, &buf)) {
-      msb -= subtract_modulus(key, &buf);
+    while (msb > 0 ||
+           sigverify_mod_exp_ibex_greater_equal_modulus(key, &buf)) {
+      msb -= sigverify_mod_exp_ibex_subtract_modulus(key, &buf);
     }
   }
 
   // Perform 5 montgomery squares to get RR = ((2^96)^32 * R) mod n
-  mont_mul(key, &buf, &buf, result);
+  sigverify_mod_exp_ibex_mont_mul(key, &buf, &buf, result);
   for (size_t i = 0; i < 2; ++i) {
-    mont_mul(key, result, result, &buf);
-    mont_mul(key, &buf, &buf, result);
+    sigverify_mod_exp_ibex_mont_mul(key, result, result, &buf);
+    sigverify_mod_exp_ibex_mont_mul(key, &buf, &buf, result);
   }
 }
 
@@ -172,30 +164,30 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    sigverify_rsa_buffer_t *result) {
   // Reject the signature if it is too large (n <= sig): RFC 8017, section
   // 5.2.2, step 1.
-  if (greater_equal_modulus(key, sig)) {
+  if (sigverify_mod_exp_ibex_greater_equal_modulus(key, sig)) {
     return kErrorSigverifyLargeRsaSignature;
   }
 
   sigverify_rsa_buffer_t buf;
 
   // result = R^2 mod n
-  calc_r_square(key, result);
+  sigverify_mod_exp_ibex_calc_r_square(key, result);
   // buf = sig * R mod n
-  mont_mul(key, sig, result, &buf);
+  sigverify_mod_exp_ibex_mont_mul(key, sig, result, &buf);
   for (size_t i = 0; i < 8; ++i) {
     // result = sig^{2*4^i} * R mod n (sig's exponent: 2, 8, 32, ..., 32768)
-    mont_mul(key, &buf, &buf, result);
+    sigverify_mod_exp_ibex_mont_mul(key, &buf, &buf, result);
     // buf = sig^{4^{i+1}} * R mod n (sig's exponent: 4, 16, 64, ..., 65536)
-    mont_mul(key, result, result, &buf);
+    sigverify_mod_exp_ibex_mont_mul(key, result, result, &buf);
   }
   // result = sig^65537 mod n
-  mont_mul(key, &buf, sig, result);
+  sigverify_mod_exp_ibex_mont_mul(key, &buf, sig, result);
 
   // We need this check because the result of `mont_mul` is not guaranteed to be
   // the least non-negative residue. We need to subtract the modulus n from
   // `result` at most once because R/2 < n < R.
-  if (greater_equal_modulus(key, result)) {
-    OT_DISCARD(subtract_modulus(key, result));
+  if (sigverify_mod_exp_ibex_greater_equal_modulus(key, result)) {
+    OT_DISCARD(sigverify_mod_exp_ibex_subtract_modulus(key, result));
   }
 
   return kErrorOk;
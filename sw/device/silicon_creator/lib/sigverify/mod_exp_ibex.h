@@ -23,7 +23,8 @@ extern "C" {
  * - sig is an RSA signature,
  * - e and n are the exponent and the modulus of the key, respectively.
  *
- * The key exponent is always 65537; no other exponents are supported.
+ * The key exponent is always 65537; no other exponents are supported. See
+ * `sigverify_mod_exp_ibex_exp()` for other exponents outside of ROM.
  *
  * @param key An RSA public key.
  * @param sig Buffer that holds the signature, little-endian.
@@ -35,6 +36,71 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    const sigverify_rsa_buffer_t *sig,
                                    sigverify_rsa_buffer_t *result);
 
+/**
+ * Montgomery arithmetic used by `sigverify_mod_exp_ibex()`.
+ *
+ * These are exposed for `sigverify_mod_exp_ibex_exp()`, which lives in a
+ * separate library so that ROM does not link it.
+ */
+
+/**
+ * Subtracts the modulus of `key` from `a` in-place, i.e. `a -= n`.
+ *
+ * Since `a` can be smaller than the modulus, this function also returns the
+ * borrow.
+ *
+ * @param key An RSA public key.
+ * @param[in,out] a Buffer that holds `a`, little-endian.
+ * @return Borrow.
+ */
+OT_WARN_UNUSED_RESULT
+uint32_t sigverify_mod_exp_ibex_subtract_modulus(const sigverify_rsa_key_t *key,
+                                                 sigverify_rsa_buffer_t *a);
+
+/**
+ * Checks if `a` is greater than or equal to the modulus of `key`.
+ *
+ * @param key An RSA public key.
+ * @param a Buffer that holds `a`, little-endian.
+ * @return Comparison result.
+ */
+OT_WARN_UNUSED_RESULT
+bool sigverify_mod_exp_ibex_greater_equal_modulus(
+    const sigverify_rsa_key_t *key, const sigverify_rsa_buffer_t *a);
+
+/**
+ * Computes the Montgomery reduction of the product of two integers.
+ *
+ * Given an RSA public key, x, and y this function computes x*y*R^-1 mod n,
+ * where
+ * - x and y are integers with `kSigVerifyRsaNumWords` base 2^32 digits,
+ * - n is the modulus of the key, and
+ * - R is 2^`kSigVerifyRsaNumBits`, e.g. 2^3072 for RSA-3072.
+ *
+ * The result is not guaranteed to be the least non-negative residue.
+ *
+ * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36.
+ *
+ * @param key An RSA public key.
+ * @param x Buffer that holds `x`, little-endian.
+ * @param y Buffer that holds `y`, little-endian.
+ * @param[out] result Buffer to write the result to, little-endian. Must not
+ * alias `x` or `y`.
+ */
+void sigverify_mod_exp_ibex_mont_mul(const sigverify_rsa_key_t *key,
+                                     const sigverify_rsa_buffer_t *x,
+                                     const sigverify_rsa_buffer_t *y,
+                                     sigverify_rsa_buffer_t *result);
+
+/**
+ * Calculates R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
+ *
+ * @param key An RSA public key.
+ * @param[out] result Buffer to write the result to, little-endian.
+ */
+void sigverify_mod_exp_ibex_calc_r_square(const sigverify_rsa_key_t *key,
+                                          sigverify_rsa_buffer_t *result);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
@@ -0,0 +1,151 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex_exp.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "sw/device/lib/base/bitfield.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
+
+enum {
+  /**
+   * F4, the exponent of the keys in the keyring.
+   */
+  kModExpIbexExponentF4 = 65537,
+  /**
+   * Maximum width of a sliding window in bits.
+   *
+   * Odd powers of the signature up to 2^`kModExpIbexWindowBits` are
+   * precomputed, each of which takes `kSigVerifyRsaNumBytes` on the stack.
+   */
+  kModExpIbexWindowBits = 3,
+  /**
+   * Number of precomputed odd powers of the signature.
+   */
+  kModExpIbexWindowNumPowers = 1 << (kModExpIbexWindowBits - 1),
+};
+
+/**
+ * Multiplies the accumulator of `mod_exp_sliding_window` by `y` in-place.
+ *
+ * `sigverify_mod_exp_ibex_mont_mul()` cannot write to one of its inputs, so
+ * this function writes the product to `*tmp` and then swaps `*acc` and `*tmp`.
+ *
+ * @param key An RSA public key.
+ * @param[in,out] acc Accumulator.
+ * @param[in,out] tmp Scratch buffer.
+ * @param y Multiplicand, may be `*acc`.
+ */
+static void acc_mont_mul(const sigverify_rsa_key_t *key,
+                         sigverify_rsa_buffer_t **acc,
+                         sigverify_rsa_buffer_t **tmp,
+                         const sigverify_rsa_buffer_t *y) {
+  sigverify_mod_exp_ibex_mont_mul(key, *acc, y, *tmp);
+  sigverify_rsa_buffer_t *swap = *acc;
+  *acc = *tmp;
+  *tmp = swap;
+}
+
+/**
+ * Computes sig^e mod n using left-to-right sliding window exponentiation.
+ *
+ * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.85.
+ *
+ * @param key An RSA public key.
+ * @param exponent Exponent, must be non-zero.
+ * @param sig Buffer that holds the signature, little-endian.
+ * @param[out] result Buffer to write the result to, little-endian.
+ */
+static void mod_exp_sliding_window(const sigverify_rsa_key_t *key,
+                                   uint32_t exponent,
+                                   const sigverify_rsa_buffer_t *sig,
+                                   sigverify_rsa_buffer_t *result) {
+  // powers[k] = sig^{2k+1} * R mod n
+  sigverify_rsa_buffer_t powers[kModExpIbexWindowNumPowers];
+  sigverify_rsa_buffer_t buf;
+
+  // result = R^2 mod n
+  sigverify_mod_exp_ibex_calc_r_square(key, result);
+  // powers[0] = sig * R mod n
+  sigverify_mod_exp_ibex_mont_mul(key, sig, result, &powers[0]);
+  // buf = sig^2 * R mod n
+  sigverify_mod_exp_ibex_mont_mul(key, &powers[0], &powers[0], &buf);
+  for (size_t k = 1; k < ARRAYSIZE(powers); ++k) {
+    sigverify_mod_exp_ibex_mont_mul(key, &powers[k - 1], &buf, &powers[k]);
+  }
+
+  // `acc` holds sig^{e >> i} * R mod n at the top of each iteration.
+  sigverify_rsa_buffer_t *acc = result;
+  sigverify_rsa_buffer_t *tmp = &buf;
+  // `i` is one plus the index of the next bit of the exponent to process.
+  uint32_t i = 32 - (uint32_t)bitfield_count_leading_zeroes32(exponent);
+  bool first = true;
+  while (i > 0) {
+    if (!bitfield_bit32_read(exponent, i - 1)) {
+      acc_mont_mul(key, &acc, &tmp, acc);
+      --i;
+      continue;
+    }
+    // Find the longest window that ends with a set bit.
+    uint32_t len = i < kModExpIbexWindowBits ? i : kModExpIbexWindowBits;
+    while (!bitfield_bit32_read(exponent, i - len)) {
+      --len;
+    }
+    const uint32_t window = (exponent >> (i - len)) & ((1u << len) - 1);
+    if (first) {
+      // The first window starts at the most significant set bit.
+      memcpy(acc->data, powers[window >> 1].data, sizeof(acc->data));
+      first = false;
+    } else {
+      for (size_t k = 0; k < len; ++k) {
+        acc_mont_mul(key, &acc, &tmp, acc);
+      }
+      acc_mont_mul(key, &acc, &tmp, &powers[window >> 1]);
+    }
+    i -= len;
+  }
+
+  // Convert out of the Montgomery domain: result = acc * 1 * R^-1 mod n.
+  // powers[0] is no longer needed and holds the constant one.
+  memset(powers[0].data, 0, sizeof(powers[0].data));
+  powers[0].data[0] = 1;
+  sigverify_mod_exp_ibex_mont_mul(key, acc, &powers[0], tmp);
+  if (tmp != result) {
+    memcpy(result->data, tmp->data, sizeof(result->data));
+  }
+}
+
+rom_error_t sigverify_mod_exp_ibex_exp(const sigverify_rsa_key_t *key,
+                                       uint32_t exponent,
+                                       const sigverify_rsa_buffer_t *sig,
+                                       sigverify_rsa_buffer_t *result) {
+  // RSA public exponents are odd and greater than one.
+  if (exponent < 3 || !bitfield_bit32_read(exponent, 0)) {
+    return kErrorSigverifyBadRsaKey;
+  }
+  if (exponent == kModExpIbexExponentF4) {
+    // F4 has only two set bits, so plain square-and-multiply is optimal.
+    return sigverify_mod_exp_ibex(key, sig, result);
+  }
+  // Reject the signature if it is too large (n <= sig): RFC 8017, section
+  // 5.2.2, step 1.
+  if (sigverify_mod_exp_ibex_greater_equal_modulus(key, sig)) {
+    return kErrorSigverifyLargeRsaSignature;
+  }
+
+  mod_exp_sliding_window(key, exponent, sig, result);
+
+  // We need this check because the result of Montgomery multiplication is not
+  // guaranteed to be the least non-negative residue. We need to subtract the
+  // modulus n from `result` at most once because R/2 < n < R.
+  if (sigverify_mod_exp_ibex_greater_equal_modulus(key, result)) {
+    OT_DISCARD(sigverify_mod_exp_ibex_subtract_modulus(key, result));
+  }
+
+  return kErrorOk;
+}
@@ -0,0 +1,45 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_MOD_EXP_IBEX_EXP_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_MOD_EXP_IBEX_EXP_H_
+
+#include <stdint.h>
+
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/sigverify/rsa_key.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * Computes the modular exponentiation of an RSA signature with an arbitrary
+ * public exponent on Ibex.
+ *
+ * Same as `sigverify_mod_exp_ibex()` but with an explicit exponent. 65537 is
+ * forwarded to `sigverify_mod_exp_ibex()`. Other exponents use sliding window
+ * exponentiation, which needs `kSigVerifyRsaNumBytes` of stack for each of the
+ * four precomputed odd powers of `sig`.
+ *
+ * None of the keys that ROM accepts use an exponent other than 65537, so ROM
+ * must not link this function.
+ *
+ * @param key An RSA public key.
+ * @param exponent Public exponent, must be odd and greater than one.
+ * @param sig Buffer that holds the signature, little-endian.
+ * @param result Buffer to write the result to, little-endian.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t sigverify_mod_exp_ibex_exp(const sigverify_rsa_key_t *key,
+                                       uint32_t exponent,
+                                       const sigverify_rsa_buffer_t *sig,
+                                       sigverify_rsa_buffer_t *result);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_LIB_SIGVERIFY_MOD_EXP_IBEX_EXP_H_
@@ -8,6 +8,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex_exp.h"
 #include "sw/device/silicon_creator/lib/sigverify/rsa_key.h"
 
 namespace sigverify_mod_exp_ibex_unittest {
@@ -141,5 +142,133 @@ TEST_P(ModExp, EncMsg) {
 
 INSTANTIATE_TEST_SUITE_P(AllCases, ModExp, testing::ValuesIn(kSigTestCases));
 
+/**
+ * sig^3 mod n for the signature and key of `kSigTestCases[0]`.
+ */
+constexpr sigverify_rsa_buffer_t kSigExp3 = {
+    0xf3a83f61, 0x9bd21332, 0x81307549, 0x614ff57d, 0xeb6e4afc, 0xfc59f46d,
+    0x04462c02, 0xedb49d84, 0xa64ffda1, 0x787c8e07, 0x8706f9aa, 0xfbded64c,
+    0xb0610b5d, 0x1278dbe8, 0x00617c15, 0x9718c494, 0x114cb91e, 0xb02ec46d,
+    0x5d40866f, 0x9539db19, 0x6c27fae7, 0x0caad0b0, 0xdc3c0331, 0x58034075,
+    0x1fc050ad, 0x800795f8, 0x5bcd9b35, 0x56d017e9, 0x1142fb86, 0x9df700c7,
+    0xee3750cc, 0xa48a6c97, 0x525aaa22, 0xdd9e3cf5, 0x7a980d93, 0x0fc5d33c,
+    0x7c334b58, 0xd60441b1, 0x1554e78c, 0x9cfbea5b, 0x3dbd8e44, 0x6032c7df,
+    0x4e7dd4c5, 0xecd5b3fe, 0x4cea46ae, 0xf0988c08, 0x9bc09687, 0x172dcba8,
+    0xb94e4ffd, 0x042d6309, 0x867f046b, 0x6549e9a6, 0x3554ff9b, 0x7db7a184,
+    0x5ef213f1, 0x429989ac, 0x06f6c507, 0x37b79120, 0x325e2565, 0xe1f1fe34,
+    0x70b72968, 0x7ff525f9, 0x0c6fe120, 0xb425c232, 0x4ceef4ce, 0x82280b02,
+    0xd5b6d854, 0x10665a3b, 0xa8f9e0fb, 0x084987be, 0x080c8a52, 0xcd48b6ea,
+    0x7bac15d9, 0xcd33e002, 0x72df9cc6, 0x69ced0e7, 0x331f4643, 0xb3a83037,
+    0x09dd13f3, 0x72963589, 0x138a5975, 0x3c7dfd6f, 0x20111373, 0x4ae55ae1,
+    0x31fa9575, 0xf29ea04c, 0x37e89ce0, 0xafa74acf, 0x6b292231, 0x29fea463,
+    0x42535897, 0x11b5dd08, 0x56609645, 0xcaa6cb7a, 0x3bb7d872, 0x62c24a8f,
+};
+
+/**
+ * sig^0x9d2c5681 mod n for the signature and key of `kSigTestCases[0]`.
+ */
+constexpr sigverify_rsa_buffer_t kSigExp9d2c5681 = {
+    0x3d6df923, 0x6a52ed2c, 0xc05e3a89, 0x39c1bf0d, 0x02736c04, 0x7d461ec9,
+    0x37c08e55, 0x5d205815, 0x06fcead3, 0x0db5d0c1, 0x00299e8c, 0x8e23e2fc,
+    0xa8b66672, 0xcd3bb13d, 0xb4e91c78, 0xe95a4b23, 0x78a411fa, 0xcb6d46c0,
+    0x684829cc, 0xd5cc5f9c, 0xca510cb7, 0xe4c23273, 0xd79b2cc4, 0xc8c92c27,
+    0xde9e29ce, 0x341c8e15, 0xb59c96f6, 0x0ec88496, 0xb556a06d, 0xe0520377,
+    0xf29fdbed, 0x01302a98, 0xc0f7bc4f, 0xa52aac7c, 0x75c75552, 0x5bfd8074,
+    0x7e5db143, 0xc1280ba7, 0x70178386, 0x1d3368e4, 0x41881aab, 0x037c8e4f,
+    0xb5fe19fa, 0xbb92eb83, 0xc65e966a, 0x456af637, 0x591ab047, 0x35ed78f9,
+    0xffc4683f, 0x7f75a9d0, 0x50639303, 0x67a476e6, 0x00f25bfd, 0x5afb09c2,
+    0xd3781b87, 0x758b0737, 0xb3255134, 0x16a957f7, 0xb4c8cdd3, 0xad821ae9,
+    0xe577e59b, 0x04666a3a, 0xb803bde9, 0xaacf41ca, 0xefb8537b, 0x36f70b7d,
+    0x4f0ae9d5, 0x7faa3f76, 0x623341b2, 0xd61fe0bf, 0xe8f73f0a, 0xb3bc134a,
+    0x0e16cb14, 0xc44c2312, 0xe37a62e6, 0x28b92592, 0xcc28686d, 0xd2c2bf12,
+    0x7872aeed, 0xbe5353d6, 0x8ad9f510, 0x32d28362, 0xb167e508, 0xb4a28a99,
+    0x998323c9, 0x1703b9c5, 0xbcfc3ed8, 0xbed7d143, 0x3e896df1, 0x40de9e3e,
+    0x5c7d6b56, 0xfabff0a9, 0x3645aa4a, 0xc2dd2975, 0xffe4981a, 0x46ddefa4,
+};
+
+/**
+ * sig^3 mod n' for the signature of `kSigTestCases[0]`, where n' is its
+ * modulus with bit 16 of word 48 flipped.
+ */
+constexpr sigverify_rsa_buffer_t kSigExp3OtherModulus = {
+    0xdb50deb9, 0xa62591a4, 0xe4b344c1, 0x0d2b64b7, 0x85cfdb11, 0x841f3633,
+    0xad584818, 0x3a7a1db5, 0x49e4ca7b, 0x9180e115, 0x827af5a9, 0xe9ef5a8f,
+    0x8cb5dd37, 0x05dbc49f, 0x5b75e286, 0x4f6236f4, 0xd82228bf, 0xeb4c6771,
+    0xcef1edbe, 0x3f1ecdc3, 0x861623cd, 0xd6e02629, 0x7fcd155e, 0x87aed344,
+    0xf6e47123, 0x94d8d048, 0xae76e856, 0x9d02ed60, 0x9841a1e4, 0x4392bafc,
+    0x80d2c50a, 0x723743ef, 0xdb4aeb2c, 0xdc0b93ee, 0x7afb386e, 0x6c56a5df,
+    0x5fa706c7, 0x95adfccc, 0xd6d1bfeb, 0xd8f9e6c8, 0xbcc0b8e6, 0x52d531e3,
+    0xc6b5b413, 0x3f9a19de, 0x8e9e2205, 0x1a6a569b, 0x4ade968d, 0xf2f572b3,
+    0xd69d21ac, 0x81575d1f, 0xc6f69a9f, 0x8b20c236, 0xdbff5e4c, 0x90025ade,
+    0x285d3213, 0x00c41b12, 0x882fc40d, 0x8632e0e2, 0x5a930200, 0x57e7a6d6,
+    0x30fb843e, 0xdb60e966, 0xb8693182, 0xa53515c0, 0xf2c7f3fb, 0x176f2c76,
+    0x54b97d16, 0xcd046cfb, 0x1e245d9f, 0x00e90493, 0x4ceb0638, 0xfbcada2d,
+    0x2b9b5ded, 0x5f9b5934, 0xe19ef3bf, 0xbb4b468c, 0xbe9ccade, 0x4d590263,
+    0x8d7c2023, 0xd134285b, 0x56709df4, 0xc09e2c31, 0xd8e266b1, 0x33b885a8,
+    0xe1452b45, 0x51ca9f12, 0x9140edbf, 0x068fcd5a, 0x8b4668f8, 0x0f6460d6,
+    0xb8de9fd8, 0x0fc70951, 0x41be2940, 0x2f01a7ec, 0xadd62798, 0x942b5725,
+};
+
+/**
+ * Inputs and expected values for tests with an explicit exponent.
+ */
+struct ExpTestCase {
+  /**
+   * Public exponent.
+   */
+  uint32_t exponent;
+  /**
+   * sig^exponent mod n for the signature and key of `kSigTestCases[0]`.
+   */
+  const sigverify_rsa_buffer_t *result;
+};
+
+constexpr ExpTestCase kExpTestCases[]{
+    {.exponent = 3, .result = &kSigExp3},
+    {.exponent = 65537, .result = &kEncMsgTest},
+    {.exponent = 0x9d2c5681, .result = &kSigExp9d2c5681},
+};
+
+class ModExpExp : public testing::TestWithParam<ExpTestCase> {};
+
+TEST_P(ModExpExp, Result) {
+  sigverify_rsa_buffer_t res;
+  EXPECT_EQ(sigverify_mod_exp_ibex_exp(&kSigTestCases[0].key,
+                                       GetParam().exponent,
+                                       &kSigTestCases[0].sig, &res),
+            kErrorOk);
+  EXPECT_THAT(res.data, ::testing::ElementsAreArray(GetParam().result->data));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllCases, ModExpExp, testing::ValuesIn(kExpTestCases));
+
+TEST(ModExpExpTest, BadExponent) {
+  sigverify_rsa_buffer_t res;
+  for (uint32_t exponent : {0, 1, 2, 65536}) {
+    EXPECT_EQ(sigverify_mod_exp_ibex_exp(&kSigTestCases[0].key, exponent,
+                                         &kSigTestCases[0].sig, &res),
+              kErrorSigverifyBadRsaKey);
+  }
+}
+
+TEST(ModExpExpTest, SameKeyId) {
+  // Keys with the same ID must not share any state.
+  sigverify_rsa_key_t other_key = kSigTestCases[0].key;
+  other_key.n.data[48] ^= 0x00010000;
+  ASSERT_EQ(sigverify_rsa_key_id_get(&other_key.n),
+            sigverify_rsa_key_id_get(&kSigTestCases[0].key.n));
+
+  sigverify_rsa_buffer_t res;
+  EXPECT_EQ(sigverify_mod_exp_ibex_exp(&kSigTestCases[0].key, 3,
+                                       &kSigTestCases[0].sig, &res),
+            kErrorOk);
+  EXPECT_THAT(res.data, ::testing::ElementsAreArray(kSigExp3.data));
+
+  EXPECT_EQ(
+      sigverify_mod_exp_ibex_exp(&other_key, 3, &kSigTestCases[0].sig, &res),
+      kErrorOk);
+  EXPECT_THAT(res.data, ::testing::ElementsAreArray(kSigExp3OtherModulus.data));
+}
+
 }  // namespace
 }  // namespace sigverify_mod_exp_ibex_unittest
@@ -31,7 +31,7 @@ typedef struct spx_ctx {
   /**
    * SHA256 state that absorbed pub_seed and padding.
    */
-  hmac_context_t state_seeded;
+  hmac_cfg_cached_context_t state_seeded;
 } spx_ctx_t;
 
 #ifdef __cplusplus
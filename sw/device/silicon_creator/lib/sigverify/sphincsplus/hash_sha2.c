@@ -58,7 +58,7 @@ inline rom_error_t spx_hash_initialize(spx_ctx_t *ctx) {
   uint32_t padding[kSpxSha2BlockNumWords - kSpxNWords];
   memset(padding, 0, sizeof(padding));
   hmac_sha256_update_words(padding, ARRAYSIZE(padding));
-  hmac_sha256_save(&ctx->state_seeded);
+  hmac_sha256_cfg_cached_save(&ctx->state_seeded);
   return kErrorOk;
 }
 
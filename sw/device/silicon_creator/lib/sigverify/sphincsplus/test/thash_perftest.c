@@ -0,0 +1,141 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/hash.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/params.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/thash.h"
+#include "sw/device/silicon_creator/lib/sigverify/sphincsplus/wots.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /**
+   * Number of times each operation is measured.
+   */
+  kNumRuns = 16,
+  kSpxWotsMsgBytes = ((kSpxWotsLen1 * kSpxWotsLogW + 7) / 8),
+  kSpxWotsMsgWords =
+      (kSpxWotsMsgBytes + sizeof(uint32_t) - 1) / sizeof(uint32_t),
+};
+
+PROFILE_REGION(thash_1_region, "thash_1_block");
+PROFILE_REGION(thash_2_region, "thash_2_blocks");
+PROFILE_REGION(thash_wots_pk_region, "thash_wots_pk");
+PROFILE_REGION(thash_loop_region, "thash_loop_chain");
+PROFILE_REGION(thash_chain_region, "thash_chain");
+PROFILE_REGION(wots_pk_from_sig_region, "wots_pk_from_sig");
+
+// Test context.
+static spx_ctx_t ctx = {
+    .pub_seed =
+        {
+            0x23222120,
+            0x27262524,
+            0x2b2a2928,
+            0x2f2e2d2c,
+        },
+};
+
+// Test input, large enough for a WOTS+ public key.
+static uint32_t input[kSpxWotsPkWords];
+static uint32_t wots_msg[kSpxWotsMsgWords];
+
+OT_WARN_UNUSED_RESULT
+static rom_error_t thash_perftest(void) {
+  spx_addr_t addr = {.addr = {0}};
+  spx_addr_type_set(&addr, kSpxAddrTypeWots);
+  uint32_t out[kSpxNWords];
+
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    profile_sample_t start = profile_region_begin();
+    thash(input, 1, &ctx, &addr, out);
+    profile_region_end(&thash_1_region, &start);
+
+    start = profile_region_begin();
+    thash(input, 2, &ctx, &addr, out);
+    profile_region_end(&thash_2_region, &start);
+
+    start = profile_region_begin();
+    thash(input, kSpxWotsLen, &ctx, &addr, out);
+    profile_region_end(&thash_wots_pk_region, &start);
+  }
+  return kErrorOk;
+}
+
+OT_WARN_UNUSED_RESULT
+static rom_error_t thash_chain_perftest(void) {
+  spx_addr_t addr = {.addr = {0}};
+  spx_addr_type_set(&addr, kSpxAddrTypeWots);
+  spx_addr_chain_set(&addr, 3);
+
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    // Full chain with one `thash` call per step.
+    uint32_t expected[kSpxNWords];
+    memcpy(expected, input, kSpxN);
+    profile_sample_t start = profile_region_begin();
+    for (uint8_t j = 0; j + 1 < kSpxWotsW; ++j) {
+      spx_addr_hash_set(&addr, j);
+      thash(expected, 1, &ctx, &addr, expected);
+    }
+    profile_region_end(&thash_loop_region, &start);
+
+    // Same chain with `thash_chain`.
+    uint32_t actual[kSpxNWords];
+    memcpy(actual, input, kSpxN);
+    start = profile_region_begin();
+    thash_chain(actual, 0, kSpxWotsW - 1, &ctx, &addr);
+    profile_region_end(&thash_chain_region, &start);
+
+    CHECK_ARRAYS_EQ(actual, expected, kSpxNWords);
+  }
+  return kErrorOk;
+}
+
+OT_WARN_UNUSED_RESULT
+static rom_error_t wots_perftest(void) {
+  spx_addr_t addr = {.addr = {0}};
+  spx_addr_type_set(&addr, kSpxAddrTypeWots);
+  uint32_t pk[kSpxWotsPkWords];
+
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    wots_msg[0] = i;
+    profile_sample_t start = profile_region_begin();
+    wots_pk_from_sig(input, wots_msg, &ctx, &addr, pk);
+    profile_region_end(&wots_pk_from_sig_region, &start);
+  }
+  return kErrorOk;
+}
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+
+  unsigned char *input_bytes = (unsigned char *)input;
+  for (size_t i = 0; i < sizeof(input); i++) {
+    input_bytes[i] = i & 255;
+  }
+  unsigned char *msg_bytes = (unsigned char *)wots_msg;
+  for (size_t i = 0; i < sizeof(wots_msg); i++) {
+    msg_bytes[i] = (sizeof(wots_msg) - i) & 255;
+  }
+
+  LOG_INFO("SPHINCS+-SHA2: n=%d, h=%d, d=%d, w=%d, k=%d, a=%d", kSpxN,
+           kSpxFullHeight, kSpxD, kSpxWotsW, kSpxForsTrees, kSpxForsHeight);
+  CHECK(spx_hash_initialize(&ctx) == kErrorOk);
+  profile_counters_enable(true);
+
+  EXECUTE_TEST(result, thash_perftest);
+  EXECUTE_TEST(result, thash_chain_perftest);
+  EXECUTE_TEST(result, wots_perftest);
+
+  profile_counters_enable(false);
+  profile_region_log_all();
+  return status_ok(result);
+}
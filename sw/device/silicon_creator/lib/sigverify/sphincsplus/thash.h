@@ -36,6 +36,24 @@ extern "C" {
 void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
            const spx_addr_t *addr, uint32_t *out);
 
+/**
+ * Applies the single-block tweakable hash function repeatedly.
+ *
+ * Equivalent to calling `thash()` with `inblocks = 1` on `buf` in place for
+ * each hash address in `[start, end)`. This is the WOTS+ chaining loop that
+ * used to be inlined in `gen_chain()`; the seeded state is still restored into
+ * HMAC for every step, and the next address is computed while HMAC is busy.
+ *
+ * @param[in,out] buf Input and output buffer (`kSpxNWords` words).
+ * @param start First hash address.
+ * @param end Hash address after the last one.
+ * @param ctx Context object.
+ * @param[in,out] addr Hypertree address. The hash address is set to `end` on
+ * return.
+ */
+void thash_chain(uint32_t *buf, uint8_t start, uint8_t end,
+                 const spx_ctx_t *ctx, spx_addr_t *addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,9 +13,27 @@
 
 void thash(const uint32_t *in, size_t inblocks, const spx_ctx_t *ctx,
            const spx_addr_t *addr, uint32_t *out) {
-  hmac_sha256_restore(&ctx->state_seeded);
+  hmac_sha256_cfg_cached_restore(&ctx->state_seeded);
   hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
   hmac_sha256_update_words(in, inblocks * kSpxNWords);
   hmac_sha256_process();
-  hmac_sha256_final_truncated(out, kSpxNWords);
+  hmac_sha256_cfg_cached_final_truncated(&ctx->state_seeded, out, kSpxNWords);
+}
+
+void thash_chain(uint32_t *buf, uint8_t start, uint8_t end,
+                 const spx_ctx_t *ctx, spx_addr_t *addr) {
+  // This loop is performance-critical: each iteration is `thash` with
+  // `inblocks = 1`, inlined so that the address can be updated while HMAC is
+  // processing.
+  spx_addr_hash_set(addr, start);
+  for (uint8_t i = start; i < end; i++) {
+    hmac_sha256_cfg_cached_restore(&ctx->state_seeded);
+    hmac_sha256_update((unsigned char *)addr->addr, kSpxSha256AddrBytes);
+    hmac_sha256_update_words(buf, kSpxNWords);
+    hmac_sha256_process();
+    // Update the address while HMAC is processing.
+    spx_addr_hash_set(addr, i + 1);
+    hmac_sha256_cfg_cached_final_truncated(&ctx->state_seeded, buf,
+                                           kSpxNWords);
+  }
 }
@@ -31,6 +31,7 @@ using bootstrap_unittest_util::PageProgramCmd;
 using bootstrap_unittest_util::ResetCmd;
 using bootstrap_unittest_util::SectorEraseCmd;
 
+using ::testing::InSequence;
 using ::testing::NotNull;
 using ::testing::Return;
 
@@ -492,6 +493,84 @@ TEST_F(BootstrapTest, BadEraseAddress) {
   EXPECT_EQ(bootstrap(), kErrorBootstrapEraseAddress);
 }
 
+TEST_F(BootstrapTest, PipelinedAcksBeforeProgramAndErase) {
+  InSequence seq;
+  EXPECT_CALL(spi_device_, Init());
+  // Erase
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Program: status is cleared before the flash write.
+  auto cmd = PageProgramCmd(0, 16);
+  ExpectSpiCmd(cmd);
+  ExpectSpiFlashStatusGet(true);
+
+  std::vector<uint8_t> flash_bytes(cmd.payload,
+                                   cmd.payload + cmd.payload_byte_count);
+
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  ExpectFlashCtrlWriteEnable();
+  EXPECT_CALL(flash_ctrl_, DataWrite(0, 4, HasBytes(flash_bytes)))
+      .WillOnce(Return(kErrorOk));
+  ExpectFlashCtrlAllDisable();
+  // Sector erase: status is cleared before the flash erase.
+  ExpectSpiCmd(SectorEraseCmd(4096));
+  ExpectSpiFlashStatusGet(true);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  ExpectFlashCtrlSectorErase(kErrorOk, kErrorOk, 4096);
+  // Chip erase is not pipelined.
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Reset
+  ExpectSpiCmd(ResetCmd());
+  EXPECT_CALL(rstmgr_, Reset());
+
+  EXPECT_EQ(enter_bootstrap_pipelined(), kErrorUnknown);
+}
+
+TEST_F(BootstrapTest, PipelinedDataWriteError) {
+  EXPECT_CALL(spi_device_, Init());
+  // Erase
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Program
+  auto cmd = PageProgramCmd(0, 16);
+  ExpectSpiCmd(cmd);
+  ExpectSpiFlashStatusGet(true);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  ExpectFlashCtrlWriteEnable();
+  EXPECT_CALL(flash_ctrl_, DataWrite(0, 4, NotNull()))
+      .WillOnce(Return(kErrorUnknown));
+  ExpectFlashCtrlAllDisable();
+
+  EXPECT_EQ(enter_bootstrap_pipelined(), kErrorUnknown);
+}
+
+TEST_F(BootstrapTest, PipelinedBadProgramAddress) {
+  EXPECT_CALL(spi_device_, Init());
+  // Erase
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Program: invalid commands are not acknowledged.
+  ExpectSpiCmd(PageProgramCmd(3, 16));
+  ExpectSpiFlashStatusGet(true);
+
+  EXPECT_EQ(enter_bootstrap_pipelined(), kErrorBootstrapProgramAddress);
+}
+
 TEST_F(BootstrapTest, NotRequested) {
   ExpectBootstrapRequestCheck(false);
 
@@ -0,0 +1,32 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/rom_ext/mock_rom_ext_verify.h"
+
+namespace rom_test {
+extern "C" {
+rom_error_t rom_ext_verify_prepare(const manifest_t *manifest,
+                                   const boot_data_t *boot_data,
+                                   rom_ext_verify_ctx_t *ctx) {
+  return MockRomExtVerify::Instance().Prepare(manifest, boot_data, ctx);
+}
+
+void rom_ext_verify_measure(rom_ext_verify_ctx_t *ctx,
+                            hardened_bool_t while_otbn_busy) {
+  MockRomExtVerify::Instance().Measure(ctx, while_otbn_busy);
+}
+
+rom_error_t rom_ext_verify_sig_start(rom_ext_verify_ctx_t *ctx) {
+  return MockRomExtVerify::Instance().SigStart(ctx);
+}
+
+rom_error_t rom_ext_verify_sig_finish(rom_ext_verify_ctx_t *ctx) {
+  return MockRomExtVerify::Instance().SigFinish(ctx);
+}
+
+void rom_ext_verify_commit(const rom_ext_verify_ctx_t *ctx) {
+  MockRomExtVerify::Instance().Commit(ctx);
+}
+}  // extern "C"
+}  // namespace rom_test
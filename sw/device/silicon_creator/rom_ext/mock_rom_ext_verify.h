@@ -0,0 +1,36 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_MOCK_ROM_EXT_VERIFY_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_MOCK_ROM_EXT_VERIFY_H_
+
+#include "sw/device/lib/base/global_mock.h"
+#include "sw/device/silicon_creator/rom_ext/rom_ext_verify.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+namespace rom_test {
+namespace internal {
+
+/**
+ * Mock class for the verification steps of rom_ext_verify.h, which are
+ * implemented in rom_ext.c.
+ */
+class MockRomExtVerify : public global_mock::GlobalMock<MockRomExtVerify> {
+ public:
+  MOCK_METHOD(rom_error_t, Prepare,
+              (const manifest_t *, const boot_data_t *,
+               rom_ext_verify_ctx_t *));
+  MOCK_METHOD(void, Measure, (rom_ext_verify_ctx_t *, hardened_bool_t));
+  MOCK_METHOD(rom_error_t, SigStart, (rom_ext_verify_ctx_t *));
+  MOCK_METHOD(rom_error_t, SigFinish, (rom_ext_verify_ctx_t *));
+  MOCK_METHOD(void, Commit, (const rom_ext_verify_ctx_t *));
+};
+
+}  // namespace internal
+
+using MockRomExtVerify = testing::StrictMock<internal::MockRomExtVerify>;
+
+}  // namespace rom_test
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_MOCK_ROM_EXT_VERIFY_H_
@@ -27,6 +27,7 @@
 #include "sw/device/silicon_creator/lib/drivers/hmac.h"
 #include "sw/device/silicon_creator/lib/drivers/ibex.h"
 #include "sw/device/silicon_creator/lib/drivers/lifecycle.h"
+#include "sw/device/silicon_creator/lib/drivers/otbn.h"
 #include "sw/device/silicon_creator/lib/drivers/otp.h"
 #include "sw/device/silicon_creator/lib/drivers/pinmux.h"
 #include "sw/device/silicon_creator/lib/drivers/retention_sram.h"
@@ -50,6 +51,7 @@
 #include "sw/device/silicon_creator/rom_ext/rom_ext_boot_policy.h"
 #include "sw/device/silicon_creator/rom_ext/rom_ext_boot_policy_ptrs.h"
 #include "sw/device/silicon_creator/rom_ext/rom_ext_manifest.h"
+#include "sw/device/silicon_creator/rom_ext/rom_ext_verify.h"
 #include "sw/device/silicon_creator/rom_ext/sigverify_keys.h"
 
 #include "hw/top/flash_ctrl_regs.h"                   // Generated.
@@ -294,18 +296,30 @@ static rom_error_t rom_ext_spx_verify(
   return result;
 }
 
-OT_WARN_UNUSED_RESULT
-static rom_error_t rom_ext_verify(const manifest_t *manifest,
-                                  const boot_data_t *boot_data) {
+enum {
+  /**
+   * Number of bytes sent to HMAC between checks of OTBN's status when an image
+   * is measured while OTBN is running.
+   */
+  kRomExtMeasureChunkSize = 4096,
+};
+
+rom_error_t rom_ext_verify_prepare(const manifest_t *manifest,
+                                   const boot_data_t *boot_data,
+                                   rom_ext_verify_ctx_t *ctx) {
+  ctx->manifest = manifest;
+  ctx->measured = kHardenedBoolFalse;
+  ctx->hashed_len = 0;
+  ctx->flash_exec = 0;
+  memset(ctx->digest.digest, (int)rnd_uint32(), sizeof(ctx->digest.digest));
   RETURN_IF_ERROR(rom_ext_boot_policy_manifest_check(manifest, boot_data));
 
   uint32_t key_id =
       sigverify_ecdsa_p256_key_id_get(&manifest->ecdsa_public_key);
   // Check if there is an SPX+ key.
   const manifest_ext_spx_key_t *ext_spx_key;
-  const manifest_ext_spx_signature_t *ext_spx_signature;
   rom_error_t spx_err = manifest_ext_get_spx_key(manifest, &ext_spx_key);
-  spx_err += manifest_ext_get_spx_signature(manifest, &ext_spx_signature);
+  spx_err += manifest_ext_get_spx_signature(manifest, &ctx->ext_spx_signature);
   switch ((uint32_t)spx_err) {
     case kErrorOk * 2:
       // Both extensions present: valid SPX+ signature.
@@ -319,67 +333,108 @@ static rom_error_t rom_ext_verify(const manifest_t *manifest,
       return kErrorManifestBadExtension;
   }
 
-  RETURN_IF_ERROR(owner_keyring_find_key(&keyring, key_id, &verify_key));
-  uint32_t key_alg = keyring.key[verify_key]->key_alg;
-
-  dbg_printf("verify: key=%u;%C;%C\r\n", verify_key, key_alg,
-             keyring.key[verify_key]->key_domain);
-
-  memset(boot_measurements.bl0.data, (int)rnd_uint32(),
-         sizeof(boot_measurements.bl0.data));
+  RETURN_IF_ERROR(owner_keyring_find_key(&keyring, key_id, &ctx->key_index));
+  ctx->key_alg = keyring.key[ctx->key_index]->key_alg;
 
   hmac_sha256_init();
   // Hash usage constraints.
-  manifest_usage_constraints_t usage_constraints_from_hw;
-  sigverify_usage_constraints_get(manifest->usage_constraints.selector_bits |
-                                      keyring.key[verify_key]->usage_constraint,
-                                  &usage_constraints_from_hw);
-  hmac_sha256_update(&usage_constraints_from_hw,
-                     sizeof(usage_constraints_from_hw));
-  // Hash the remaining part of the image.
-  manifest_digest_region_t digest_region = manifest_digest_region_get(manifest);
-  hmac_sha256_update(digest_region.start, digest_region.length);
+  sigverify_usage_constraints_get(
+      manifest->usage_constraints.selector_bits |
+          keyring.key[ctx->key_index]->usage_constraint,
+      &ctx->usage_constraints);
+  hmac_sha256_update(&ctx->usage_constraints, sizeof(ctx->usage_constraints));
+  // The remaining part of the image is hashed by `rom_ext_verify_measure()`.
+  ctx->digest_region = manifest_digest_region_get(manifest);
   // TODO(#19596): add owner configuration block to measurement.
-  // Verify signature
+  return kErrorOk;
+}
+
+void rom_ext_verify_measure(rom_ext_verify_ctx_t *ctx,
+                            hardened_bool_t while_otbn_busy) {
+  if (ctx->measured == kHardenedBoolTrue) {
+    return;
+  }
+  const char *start = ctx->digest_region.start;
+  while (ctx->hashed_len < ctx->digest_region.length) {
+    if (while_otbn_busy == kHardenedBoolTrue &&
+        sc_otbn_is_busy() != kHardenedBoolTrue) {
+      return;
+    }
+    size_t len = ctx->digest_region.length - ctx->hashed_len;
+    if (len > kRomExtMeasureChunkSize) {
+      len = kRomExtMeasureChunkSize;
+    }
+    hmac_sha256_update(start + ctx->hashed_len, len);
+    ctx->hashed_len += len;
+  }
+  HARDENED_CHECK_EQ(ctx->hashed_len, ctx->digest_region.length);
   hmac_sha256_process();
-  hmac_digest_t act_digest;
-  hmac_sha256_final(&act_digest);
+  hmac_sha256_final(&ctx->digest);
+  ctx->measured = kHardenedBoolTrue;
+}
 
-  static_assert(sizeof(boot_measurements.bl0) == sizeof(act_digest),
-                "Unexpected BL0 digest size.");
-  memcpy(&boot_measurements.bl0, &act_digest, sizeof(boot_measurements.bl0));
-
-  uint32_t flash_exec = 0;
-  if (key_alg == kOwnershipKeyAlgEcdsaP256) {
-    return sigverify_ecdsa_p256_verify(&manifest->ecdsa_signature,
-                                       &keyring.key[verify_key]->data.ecdsa,
-                                       &act_digest, &flash_exec);
-  } else if ((key_alg & kOwnershipKeyAlgCategoryMask) ==
+rom_error_t rom_ext_verify_sig_start(rom_ext_verify_ctx_t *ctx) {
+  HARDENED_CHECK_EQ(ctx->measured, kHardenedBoolTrue);
+  const owner_application_key_t *key = keyring.key[ctx->key_index];
+  // Logged here rather than when preparing, since the next image may be
+  // prepared before the result of the current one is known.
+  dbg_printf("verify: key=%u;%C;%C\r\n", ctx->key_index, ctx->key_alg,
+             key->key_domain);
+  if (ctx->key_alg == kOwnershipKeyAlgEcdsaP256) {
+    return sigverify_ecdsa_p256_start(&ctx->manifest->ecdsa_signature,
+                                      &key->data.ecdsa, &ctx->digest);
+  } else if ((ctx->key_alg & kOwnershipKeyAlgCategoryMask) ==
              kOwnershipKeyAlgCategoryHybrid) {
     // Hybrid signatures check both ECDSA and SPX+ signatures.
-    // Start the ECDSA verify.
-    HARDENED_RETURN_IF_ERROR(sigverify_ecdsa_p256_start(
-        &manifest->ecdsa_signature, &keyring.key[verify_key]->data.hybrid.ecdsa,
-        &act_digest));
-    // While ECDSA verify is running in OTBN, compute the SPX verify on Ibex.
-    rom_error_t spx = rom_ext_spx_verify(
-        &ext_spx_signature->signature,
-        &keyring.key[verify_key]->data.hybrid.spx, key_alg,
-        &usage_constraints_from_hw, sizeof(usage_constraints_from_hw), NULL, 0,
-        digest_region.start, digest_region.length, act_digest);
-    // ECDSA should be finished.  Poll for completeion and get the result.
-    rom_error_t ecdsa =
-        sigverify_ecdsa_p256_finish(&manifest->ecdsa_signature, &flash_exec);
-    HARDENED_RETURN_IF_ERROR(spx);
-    HARDENED_RETURN_IF_ERROR(ecdsa);
-    // Both values should be kErrorOk.  Mix them and return the result.
-    return (rom_error_t)((spx + ecdsa) >> 1);
+    return sigverify_ecdsa_p256_start(&ctx->manifest->ecdsa_signature,
+                                      &key->data.hybrid.ecdsa, &ctx->digest);
   } else {
     // TODO: consider whether an SPX+-only verify is sufficent.
     return kErrorOwnershipInvalidAlgorithm;
   }
 }
 
+rom_error_t rom_ext_verify_sig_finish(rom_ext_verify_ctx_t *ctx) {
+  if (ctx->key_alg == kOwnershipKeyAlgEcdsaP256) {
+    return sigverify_ecdsa_p256_finish(&ctx->manifest->ecdsa_signature,
+                                       &ctx->flash_exec);
+  }
+  HARDENED_CHECK_EQ(ctx->key_alg & kOwnershipKeyAlgCategoryMask,
+                    kOwnershipKeyAlgCategoryHybrid);
+  // While ECDSA verify is running in OTBN, compute the SPX verify on Ibex.
+  rom_error_t spx = rom_ext_spx_verify(
+      &ctx->ext_spx_signature->signature,
+      &keyring.key[ctx->key_index]->data.hybrid.spx, ctx->key_alg,
+      &ctx->usage_constraints, sizeof(ctx->usage_constraints), NULL, 0,
+      ctx->digest_region.start, ctx->digest_region.length, ctx->digest);
+  // ECDSA should be finished.  Poll for completeion and get the result.
+  rom_error_t ecdsa = sigverify_ecdsa_p256_finish(
+      &ctx->manifest->ecdsa_signature, &ctx->flash_exec);
+  HARDENED_RETURN_IF_ERROR(spx);
+  HARDENED_RETURN_IF_ERROR(ecdsa);
+  // Both values should be kErrorOk.  Mix them and return the result.
+  return (rom_error_t)((spx + ecdsa) >> 1);
+}
+
+void rom_ext_verify_commit(const rom_ext_verify_ctx_t *ctx) {
+  HARDENED_CHECK_EQ(ctx->measured, kHardenedBoolTrue);
+  verify_key = ctx->key_index;
+  static_assert(sizeof(boot_measurements.bl0) == sizeof(ctx->digest),
+                "Unexpected BL0 digest size.");
+  memcpy(&boot_measurements.bl0, &ctx->digest, sizeof(boot_measurements.bl0));
+}
+
+OT_WARN_UNUSED_RESULT
+static rom_error_t rom_ext_verify(const manifest_t *manifest,
+                                  const boot_data_t *boot_data) {
+  rom_ext_verify_ctx_t ctx;
+  RETURN_IF_ERROR(rom_ext_verify_prepare(manifest, boot_data, &ctx));
+  rom_ext_verify_measure(&ctx, kHardenedBoolFalse);
+  rom_ext_verify_commit(&ctx);
+  HARDENED_RETURN_IF_ERROR(rom_ext_verify_sig_start(&ctx));
+  return rom_ext_verify_sig_finish(&ctx);
+}
+
 /**
  * These symbols are defined in
  * `opentitan/sw/device/silicon_creator/rom_ext/rom_ext.ld`, and describe the
@@ -681,41 +736,23 @@ static rom_error_t rom_ext_try_next_stage(boot_data_t *boot_data,
                                           boot_log_t *boot_log) {
   rom_ext_boot_policy_manifests_t manifests =
       rom_ext_boot_policy_manifests_get(boot_data);
-  rom_error_t error = kErrorRomExtBootFailed;
-  rom_error_t slot[2] = {0, 0};
-  for (size_t i = 0; i < ARRAYSIZE(manifests.ordered); ++i) {
-    error = rom_ext_verify(manifests.ordered[i], boot_data);
-    slot[i] = error;
-    if (error != kErrorOk) {
-      continue;
-    }
+  size_t i = 0;
+  HARDENED_RETURN_IF_ERROR(rom_ext_verify_slots(&manifests, boot_data, &i));
 
-    if (manifests.ordered[i] == rom_ext_boot_policy_manifest_a_get()) {
-      boot_log->bl0_slot = kBootSlotA;
-    } else if (manifests.ordered[i] == rom_ext_boot_policy_manifest_b_get()) {
-      boot_log->bl0_slot = kBootSlotB;
-    } else {
-      return kErrorRomExtBootFailed;
-    }
-    boot_log_digest_update(boot_log);
-
-    // Boot fails if a verified ROM_EXT cannot be booted.
-    RETURN_IF_ERROR(rom_ext_boot(boot_data, boot_log, manifests.ordered[i]));
-    // `rom_ext_boot()` should never return `kErrorOk`, but if it does
-    // we must shut down the chip instead of trying the next ROM_EXT.
+  if (manifests.ordered[i] == rom_ext_boot_policy_manifest_a_get()) {
+    boot_log->bl0_slot = kBootSlotA;
+  } else if (manifests.ordered[i] == rom_ext_boot_policy_manifest_b_get()) {
+    boot_log->bl0_slot = kBootSlotB;
+  } else {
     return kErrorRomExtBootFailed;
   }
+  boot_log_digest_update(boot_log);
 
-  // If we get here, the loop exited after trying both slots.
-  // If we see kErrorBootPolicyBadIdentifier as the error, we probably have an
-  // empty slot.  In that case, the "bad identifier" error is not helpful, so
-  // maybe choose the error from the other slot.
-  if (error == kErrorBootPolicyBadIdentifier && error == slot[1]) {
-    // If the bad identifier error comes from the non-primary slot, prefer
-    // the error from the primary slot.
-    error = slot[0];
-  }
-  return error;
+  // Boot fails if a verified ROM_EXT cannot be booted.
+  RETURN_IF_ERROR(rom_ext_boot(boot_data, boot_log, manifests.ordered[i]));
+  // `rom_ext_boot()` should never return `kErrorOk`, but if it does
+  // we must shut down the chip instead of trying the next ROM_EXT.
+  return kErrorRomExtBootFailed;
 }
 
 static void rom_ext_flash_protect_self(uint32_t rom_ext_slot) {
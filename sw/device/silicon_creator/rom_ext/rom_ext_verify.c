@@ -0,0 +1,64 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/rom_ext/rom_ext_verify.h"
+
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/ownership/datatypes.h"
+
+rom_error_t rom_ext_verify_slots(
+    const rom_ext_boot_policy_manifests_t *manifests,
+    const boot_data_t *boot_data, size_t *index) {
+  rom_error_t error = kErrorRomExtBootFailed;
+  rom_error_t slot[2] = {0, 0};
+  rom_ext_verify_ctx_t ctx[2];
+  hardened_bool_t prepared[2] = {kHardenedBoolFalse, kHardenedBoolFalse};
+  for (size_t i = 0; i < ARRAYSIZE(manifests->ordered); ++i) {
+    if (prepared[i] != kHardenedBoolTrue) {
+      slot[i] =
+          rom_ext_verify_prepare(manifests->ordered[i], boot_data, &ctx[i]);
+    }
+    if (slot[i] == kErrorOk) {
+      rom_ext_verify_measure(&ctx[i], kHardenedBoolFalse);
+      slot[i] = rom_ext_verify_sig_start(&ctx[i]);
+    }
+    if (slot[i] == kErrorOk) {
+      // Hybrid verifications keep Ibex busy with SPX+, which also uses the
+      // HMAC engine, so only ECDSA-only verifications are overlapped.
+      size_t next = i + 1;
+      if (next < ARRAYSIZE(manifests->ordered) &&
+          ctx[i].key_alg == kOwnershipKeyAlgEcdsaP256) {
+        slot[next] = rom_ext_verify_prepare(manifests->ordered[next],
+                                            boot_data, &ctx[next]);
+        prepared[next] = kHardenedBoolTrue;
+        if (slot[next] == kErrorOk) {
+          rom_ext_verify_measure(&ctx[next], kHardenedBoolTrue);
+        }
+      }
+      slot[i] = rom_ext_verify_sig_finish(&ctx[i]);
+    }
+    error = slot[i];
+    if (error != kErrorOk) {
+      continue;
+    }
+    HARDENED_CHECK_EQ(slot[i], kErrorOk);
+    // Do not hand the next stage an HMAC engine in the middle of measuring
+    // the next image.
+    hmac_sha256_clear();
+    rom_ext_verify_commit(&ctx[i]);
+    *index = i;
+    return error;
+  }
+
+  // If we get here, the loop exited after trying both slots.
+  // If we see kErrorBootPolicyBadIdentifier as the error, we probably have an
+  // empty slot.  In that case, the "bad identifier" error is not helpful, so
+  // maybe choose the error from the other slot.
+  if (error == kErrorBootPolicyBadIdentifier && error == slot[1]) {
+    // If the bad identifier error comes from the non-primary slot, prefer
+    // the error from the primary slot.
+    error = slot[0];
+  }
+  return error;
+}
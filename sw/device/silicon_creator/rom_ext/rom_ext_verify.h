@@ -0,0 +1,158 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_ROM_EXT_VERIFY_H_
+#define OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_ROM_EXT_VERIFY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/silicon_creator/lib/boot_data.h"
+#include "sw/device/silicon_creator/lib/drivers/hmac.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/lib/manifest.h"
+#include "sw/device/silicon_creator/rom_ext/rom_ext_boot_policy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * State of the verification of an owner image.
+ *
+ * Verification is split into preparation, measurement, and signature
+ * verification so that the measurement of the next image can overlap with the
+ * signature verification of the current one, see `rom_ext_verify_slots()`.
+ */
+typedef struct rom_ext_verify_ctx {
+  /**
+   * Manifest of the image.
+   */
+  const manifest_t *manifest;
+  /**
+   * Index of the verifying key in the owner keyring.
+   */
+  size_t key_index;
+  /**
+   * Algorithm of the verifying key.
+   */
+  uint32_t key_alg;
+  /**
+   * SPX+ signature of the image, if any.
+   */
+  const manifest_ext_spx_signature_t *ext_spx_signature;
+  /**
+   * Usage constraints of the image, as read from the hardware.
+   */
+  manifest_usage_constraints_t usage_constraints;
+  /**
+   * Signed region of the image.
+   */
+  manifest_digest_region_t digest_region;
+  /**
+   * Number of bytes of `digest_region` that were sent to HMAC.
+   */
+  size_t hashed_len;
+  /**
+   * Whether `digest` holds the measurement of the image.
+   */
+  hardened_bool_t measured;
+  /**
+   * Measurement of the image.
+   */
+  hmac_digest_t digest;
+  /**
+   * Partial value to write to the flash_ctrl EXEC register.
+   */
+  uint32_t flash_exec;
+} rom_ext_verify_ctx_t;
+
+/**
+ * Prepares the verification of an owner image.
+ *
+ * Checks the boot policy, finds the verifying key, and starts hashing the
+ * usage constraints. The image itself is hashed by `rom_ext_verify_measure()`.
+ * This function must not be called while another image is being measured
+ * since both use the HMAC engine.
+ *
+ * @param manifest Manifest of the image.
+ * @param boot_data Boot data.
+ * @param[out] ctx Verification state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t rom_ext_verify_prepare(const manifest_t *manifest,
+                                   const boot_data_t *boot_data,
+                                   rom_ext_verify_ctx_t *ctx);
+
+/**
+ * Measures an owner image whose verification was prepared.
+ *
+ * If `while_otbn_busy` is `kHardenedBoolTrue`, this function returns as soon as
+ * OTBN becomes idle and can be called again to resume the measurement.
+ * Otherwise, it blocks until the measurement is complete. The HMAC engine must
+ * not be used by anything else between the calls.
+ *
+ * @param ctx Verification state.
+ * @param while_otbn_busy Whether to measure only while OTBN is busy.
+ */
+void rom_ext_verify_measure(rom_ext_verify_ctx_t *ctx,
+                            hardened_bool_t while_otbn_busy);
+
+/**
+ * Starts the verification of the signature of a measured owner image.
+ *
+ * ECDSA verification runs on OTBN until `rom_ext_verify_sig_finish()` is
+ * called.
+ *
+ * @param ctx Verification state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t rom_ext_verify_sig_start(rom_ext_verify_ctx_t *ctx);
+
+/**
+ * Finishes the verification of the signature of an owner image.
+ *
+ * @param ctx Verification state.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t rom_ext_verify_sig_finish(rom_ext_verify_ctx_t *ctx);
+
+/**
+ * Records the verifying key and the measurement of an owner image for the
+ * boot.
+ *
+ * @param ctx Verification state.
+ */
+void rom_ext_verify_commit(const rom_ext_verify_ctx_t *ctx);
+
+/**
+ * Verifies the owner images in boot order and commits the first valid one.
+ *
+ * Ibex only waits for OTBN to finish an ECDSA-only verification, so that time
+ * is used to measure the next image in case the current one fails. The
+ * measurement stops as soon as OTBN is done and resumes only if the next image
+ * is tried. When an image verifies, the HMAC engine is cleared before
+ * returning, so that no partial measurement of another image is left in it.
+ *
+ * @param manifests Manifests of the owner images, in boot order.
+ * @param boot_data Boot data.
+ * @param[out] index Index in `manifests->ordered` of the verified image.
+ * @return `kErrorOk` if an image verified, otherwise the error of the last
+ * image tried, or that of the first image if the last one was empty.
+ */
+OT_WARN_UNUSED_RESULT
+rom_error_t rom_ext_verify_slots(
+    const rom_ext_boot_policy_manifests_t *manifests,
+    const boot_data_t *boot_data, size_t *index);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_EXT_ROM_EXT_VERIFY_H_
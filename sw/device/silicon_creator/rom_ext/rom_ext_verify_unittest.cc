@@ -0,0 +1,157 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/rom_ext/rom_ext_verify.h"
+
+#include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_hmac.h"
+#include "sw/device/silicon_creator/lib/ownership/datatypes.h"
+#include "sw/device/silicon_creator/rom_ext/mock_rom_ext_verify.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+namespace rom_ext_verify_unittest {
+namespace {
+using ::testing::_;
+using ::testing::Field;
+using ::testing::InSequence;
+using ::testing::Invoke;
+using ::testing::Return;
+
+class RomExtVerifySlotsTest : public rom_test::RomTest {
+ protected:
+  /**
+   * Expects the preparation of `manifest` with a key of algorithm `key_alg`.
+   */
+  void ExpectPrepare(const manifest_t &manifest, uint32_t key_alg,
+                     rom_error_t result) {
+    EXPECT_CALL(verify_, Prepare(&manifest, &boot_data_, _))
+        .WillOnce(Invoke([&manifest, key_alg, result](
+                             const manifest_t *, const boot_data_t *,
+                             rom_ext_verify_ctx_t *ctx) {
+          ctx->manifest = &manifest;
+          ctx->key_alg = key_alg;
+          return result;
+        }));
+  }
+
+  static auto Ctx(const manifest_t &manifest) {
+    return Field(&rom_ext_verify_ctx_t::manifest, &manifest);
+  }
+
+  rom_error_t VerifySlots(size_t *index) {
+    rom_ext_boot_policy_manifests_t manifests = {
+        .ordered = {&primary_, &secondary_},
+    };
+    return rom_ext_verify_slots(&manifests, &boot_data_, index);
+  }
+
+  manifest_t primary_{};
+  manifest_t secondary_{};
+  boot_data_t boot_data_{};
+  rom_test::MockRomExtVerify verify_;
+  rom_test::MockHmac hmac_;
+};
+
+TEST_F(RomExtVerifySlotsTest, PrimaryOk) {
+  {
+    InSequence seq;
+    ExpectPrepare(primary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(primary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    // The secondary is measured while OTBN verifies the primary.
+    ExpectPrepare(secondary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(secondary_), kHardenedBoolTrue));
+    EXPECT_CALL(verify_, SigFinish(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    // The partial measurement of the secondary is discarded.
+    EXPECT_CALL(hmac_, sha256_clear());
+    EXPECT_CALL(verify_, Commit(Ctx(primary_)));
+  }
+
+  size_t index = 2;
+  EXPECT_EQ(VerifySlots(&index), kErrorOk);
+  EXPECT_EQ(index, 0);
+}
+
+TEST_F(RomExtVerifySlotsTest, PrimaryHybridOk) {
+  {
+    InSequence seq;
+    ExpectPrepare(primary_, kOwnershipKeyAlgHybridSpxPure, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(primary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    // SPX+ uses HMAC, so the secondary is not measured in the meantime.
+    EXPECT_CALL(verify_, SigFinish(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    EXPECT_CALL(hmac_, sha256_clear());
+    EXPECT_CALL(verify_, Commit(Ctx(primary_)));
+  }
+
+  size_t index = 2;
+  EXPECT_EQ(VerifySlots(&index), kErrorOk);
+  EXPECT_EQ(index, 0);
+}
+
+TEST_F(RomExtVerifySlotsTest, PrimaryFail) {
+  {
+    InSequence seq;
+    ExpectPrepare(primary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(primary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    ExpectPrepare(secondary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(secondary_), kHardenedBoolTrue));
+    EXPECT_CALL(verify_, SigFinish(Ctx(primary_)))
+        .WillOnce(Return(kErrorSigverifyBadEcdsaSignature));
+    // The measurement of the secondary resumes without preparing it again.
+    EXPECT_CALL(verify_, Measure(Ctx(secondary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(secondary_))).WillOnce(Return(kErrorOk));
+    EXPECT_CALL(verify_, SigFinish(Ctx(secondary_)))
+        .WillOnce(Return(kErrorOk));
+    EXPECT_CALL(hmac_, sha256_clear());
+    EXPECT_CALL(verify_, Commit(Ctx(secondary_)));
+  }
+
+  size_t index = 2;
+  EXPECT_EQ(VerifySlots(&index), kErrorOk);
+  EXPECT_EQ(index, 1);
+}
+
+TEST_F(RomExtVerifySlotsTest, BothFail) {
+  {
+    InSequence seq;
+    ExpectPrepare(primary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(primary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    ExpectPrepare(secondary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(secondary_), kHardenedBoolTrue));
+    EXPECT_CALL(verify_, SigFinish(Ctx(primary_)))
+        .WillOnce(Return(kErrorSigverifyBadEcdsaSignature));
+    EXPECT_CALL(verify_, Measure(Ctx(secondary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(secondary_))).WillOnce(Return(kErrorOk));
+    EXPECT_CALL(verify_, SigFinish(Ctx(secondary_)))
+        .WillOnce(Return(kErrorSigverifyBadSpxSignature));
+  }
+
+  size_t index = 2;
+  EXPECT_EQ(VerifySlots(&index), kErrorSigverifyBadSpxSignature);
+  EXPECT_EQ(index, 2);
+}
+
+TEST_F(RomExtVerifySlotsTest, BothFailSecondaryEmpty) {
+  {
+    InSequence seq;
+    ExpectPrepare(primary_, kOwnershipKeyAlgEcdsaP256, kErrorOk);
+    EXPECT_CALL(verify_, Measure(Ctx(primary_), kHardenedBoolFalse));
+    EXPECT_CALL(verify_, SigStart(Ctx(primary_))).WillOnce(Return(kErrorOk));
+    ExpectPrepare(secondary_, kOwnershipKeyAlgEcdsaP256,
+                  kErrorBootPolicyBadIdentifier);
+    EXPECT_CALL(verify_, SigFinish(Ctx(primary_)))
+        .WillOnce(Return(kErrorSigverifyBadEcdsaSignature));
+  }
+
+  // The error of the primary is more useful than that of an empty slot.
+  size_t index = 2;
+  EXPECT_EQ(VerifySlots(&index), kErrorSigverifyBadEcdsaSignature);
+  EXPECT_EQ(index, 2);
+}
+
+}  // namespace
+}  // namespace rom_ext_verify_unittest
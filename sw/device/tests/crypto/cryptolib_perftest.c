@@ -0,0 +1,688 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/math.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/crypto/drivers/entropy.h"
+#include "sw/device/lib/crypto/impl/integrity.h"
+#include "sw/device/lib/crypto/impl/keyblob.h"
+#include "sw/device/lib/crypto/include/aes.h"
+#include "sw/device/lib/crypto/include/aes_gcm.h"
+#include "sw/device/lib/crypto/include/datatypes.h"
+#include "sw/device/lib/crypto/include/drbg.h"
+#include "sw/device/lib/crypto/include/ecc_curve25519.h"
+#include "sw/device/lib/crypto/include/ecc_p256.h"
+#include "sw/device/lib/crypto/include/ecc_p384.h"
+#include "sw/device/lib/crypto/include/hmac.h"
+#include "sw/device/lib/crypto/include/kmac.h"
+#include "sw/device/lib/crypto/include/rsa.h"
+#include "sw/device/lib/crypto/include/sha2.h"
+#include "sw/device/lib/crypto/include/sha3.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/runtime/print.h"
+#include "sw/device/lib/testing/json/cryptolib_bench.h"
+#include "sw/device/lib/testing/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ujson_ottf.h"
+
+// Measures the cycle count of every cryptolib primitive and reports one
+// `CryptolibBenchResult` per primitive and message size on the console, for
+// `//sw/host/tests/crypto/cryptolib_bench` to compare against a baseline.
+//
+// X25519 is not measured because the cryptolib does not implement it yet.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /**
+   * Number of times each symmetric operation is measured.
+   */
+  kSymmetricRuns = 3,
+  /**
+   * Number of times each public-key operation is measured.
+   */
+  kAsymmetricRuns = 1,
+  /**
+   * Largest message length, in bytes.
+   */
+  kMaxMessageBytes = 4096,
+  kMaxMessageWords = kMaxMessageBytes / sizeof(uint32_t),
+  /**
+   * Largest symmetric key (HMAC-SHA512), in bytes.
+   */
+  kMaxKeyBytes = 512 / 8,
+  kMaxKeyWords = kMaxKeyBytes / sizeof(uint32_t),
+  kAesKeyBytes = 256 / 8,
+  kAesBlockWords = 128 / 32,
+  kAesGcmIvWords = 96 / 32,
+  kKmacKeyBytes = 256 / 8,
+  kKmacTagBytes = 256 / 8,
+  kP256PrivateKeyBytes = 256 / 8,
+  kP256PublicKeyBytes = 512 / 8,
+  kP256SignatureWords = 512 / 32,
+  kP256DigestWords = 256 / 32,
+  kP256MaskedScalarBytes = 320 / 8,
+  kP256SharedKeyBytes = 256 / 8,
+  kP384PrivateKeyBytes = 384 / 8,
+  kP384PublicKeyBytes = 768 / 8,
+  kP384SignatureWords = 768 / 32,
+  kP384DigestWords = 384 / 32,
+  kP384MaskedScalarBytes = 448 / 8,
+  kP384SharedKeyBytes = 384 / 8,
+  kEd25519PrivateKeyBytes = 256 / 8,
+  kEd25519PublicKeyBytes = 256 / 8,
+  kEd25519SignatureWords = 512 / 32,
+  kEd25519MessageBytes = 32,
+  kRsaMaxWords = 4096 / 32,
+  kRsaMaxKeyblobWords = kOtcryptoRsa4096PrivateKeyblobBytes / sizeof(uint32_t),
+  /**
+   * Upper bound on the number of results, for sizing the profile regions.
+   */
+  kMaxResults = 80,
+};
+
+/**
+ * Message lengths, in bytes, at which the symmetric primitives are measured.
+ *
+ * All lengths are multiples of the AES block size.
+ */
+static const size_t kMessageSizes[] = {16, 256, kMaxMessageBytes};
+
+static uint32_t msg_words[kMaxMessageWords];
+static uint32_t out_words[kMaxMessageWords];
+static const uint8_t *const msg = (const uint8_t *)msg_words;
+static uint8_t *const out = (uint8_t *)out_words;
+
+// Arbitrary key material and masks for the symmetric keys.
+static uint32_t key_material[kMaxKeyWords];
+static uint32_t key_mask[kMaxKeyWords];
+
+/**
+ * Defines a blinded key together with the storage for its keyblob.
+ *
+ * @param var_ Name of the `otcrypto_blinded_key_t` variable to define.
+ * @param key_mode_ Mode of the key.
+ * @param key_bytes_ Length of the key, in bytes.
+ * @param keyblob_bytes_ Length of the keyblob, in bytes.
+ */
+#define BLINDED_KEY(var_, key_mode_, key_bytes_, keyblob_bytes_)      \
+  static uint32_t var_##_keyblob[(keyblob_bytes_) / sizeof(uint32_t)]; \
+  static otcrypto_blinded_key_t var_ = {                              \
+      .config =                                                       \
+          {                                                           \
+              .version = kOtcryptoLibVersion1,                        \
+              .key_mode = key_mode_,                                  \
+              .key_length = key_bytes_,                               \
+              .hw_backed = kHardenedBoolFalse,                        \
+              .exportable = kHardenedBoolFalse,                       \
+              .security_level = kOtcryptoKeySecurityLevelLow,         \
+          },                                                          \
+      .keyblob_length = keyblob_bytes_,                               \
+      .keyblob = var_##_keyblob,                                      \
+  }
+
+/**
+ * Defines an unblinded key together with the storage for its data.
+ *
+ * @param var_ Name of the `otcrypto_unblinded_key_t` variable to define.
+ * @param key_mode_ Mode of the key.
+ * @param key_bytes_ Length of the key, in bytes.
+ */
+#define UNBLINDED_KEY(var_, key_mode_, key_bytes_)                \
+  static uint32_t var_##_data[(key_bytes_) / sizeof(uint32_t)];   \
+  static otcrypto_unblinded_key_t var_ = {                        \
+      .key_mode = key_mode_,                                      \
+      .key_length = key_bytes_,                                   \
+      .key = var_##_data,                                         \
+  }
+
+BLINDED_KEY(aes_ecb_key, kOtcryptoKeyModeAesEcb, kAesKeyBytes,
+            2 * kAesKeyBytes);
+BLINDED_KEY(aes_cbc_key, kOtcryptoKeyModeAesCbc, kAesKeyBytes,
+            2 * kAesKeyBytes);
+BLINDED_KEY(aes_ctr_key, kOtcryptoKeyModeAesCtr, kAesKeyBytes,
+            2 * kAesKeyBytes);
+BLINDED_KEY(aes_gcm_key, kOtcryptoKeyModeAesGcm, kAesKeyBytes,
+            2 * kAesKeyBytes);
+BLINDED_KEY(hmac_sha256_key, kOtcryptoKeyModeHmacSha256, 256 / 8, 512 / 8);
+BLINDED_KEY(hmac_sha512_key, kOtcryptoKeyModeHmacSha512, 512 / 8, 1024 / 8);
+BLINDED_KEY(kmac128_key, kOtcryptoKeyModeKmac128, kKmacKeyBytes,
+            2 * kKmacKeyBytes);
+BLINDED_KEY(kmac256_key, kOtcryptoKeyModeKmac256, kKmacKeyBytes,
+            2 * kKmacKeyBytes);
+
+/**
+ * Fills the keyblob of a symmetric key from `key_material` and `key_mask`.
+ *
+ * @param key Key to initialize.
+ * @return OK or error.
+ */
+static status_t symmetric_key_init(otcrypto_blinded_key_t *key) {
+  TRY_CHECK(keyblob_num_words(key->config) * sizeof(uint32_t) ==
+            key->keyblob_length);
+  TRY(keyblob_from_key_and_mask(key_material, key_mask, key->config,
+                                key->keyblob));
+  key->checksum = integrity_blinded_checksum(key);
+  return OK_STATUS();
+}
+
+static otcrypto_const_byte_buf_t msg_buf(size_t len) {
+  return (otcrypto_const_byte_buf_t){.data = msg, .len = len};
+}
+
+static status_t aes(otcrypto_blinded_key_t *key, otcrypto_aes_mode_t mode,
+                    size_t len) {
+  uint32_t iv_data[kAesBlockWords] = {0};
+  otcrypto_word32_buf_t iv = {.data = iv_data, .len = ARRAYSIZE(iv_data)};
+  return otcrypto_aes(key, iv, mode, kOtcryptoAesOperationEncrypt,
+                      msg_buf(len), kOtcryptoAesPaddingNull,
+                      (otcrypto_byte_buf_t){.data = out, .len = len});
+}
+
+static status_t aes_ecb(size_t len) {
+  return aes(&aes_ecb_key, kOtcryptoAesModeEcb, len);
+}
+
+static status_t aes_cbc(size_t len) {
+  return aes(&aes_cbc_key, kOtcryptoAesModeCbc, len);
+}
+
+static status_t aes_ctr(size_t len) {
+  return aes(&aes_ctr_key, kOtcryptoAesModeCtr, len);
+}
+
+static status_t aes_gcm(size_t len) {
+  static const uint32_t kIv[kAesGcmIvWords] = {0};
+  uint32_t tag[kAesBlockWords];
+  return otcrypto_aes_gcm_encrypt(
+      &aes_gcm_key, msg_buf(len),
+      (otcrypto_const_word32_buf_t){.data = kIv, .len = ARRAYSIZE(kIv)},
+      (otcrypto_const_byte_buf_t){.data = NULL, .len = 0},
+      kOtcryptoAesGcmTagLen128, (otcrypto_byte_buf_t){.data = out, .len = len},
+      (otcrypto_word32_buf_t){.data = tag, .len = ARRAYSIZE(tag)});
+}
+
+static status_t sha2_256(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 256 / 32};
+  return otcrypto_sha2_256(msg_buf(len), &digest);
+}
+
+static status_t sha2_384(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 384 / 32};
+  return otcrypto_sha2_384(msg_buf(len), &digest);
+}
+
+static status_t sha2_512(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 512 / 32};
+  return otcrypto_sha2_512(msg_buf(len), &digest);
+}
+
+static status_t sha3_256(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 256 / 32};
+  return otcrypto_sha3_256(msg_buf(len), &digest);
+}
+
+static status_t sha3_512(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 512 / 32};
+  return otcrypto_sha3_512(msg_buf(len), &digest);
+}
+
+static status_t shake256(size_t len) {
+  otcrypto_hash_digest_t digest = {.data = out_words, .len = 256 / 32};
+  return otcrypto_shake256(msg_buf(len), &digest);
+}
+
+static status_t hmac_sha256(size_t len) {
+  return otcrypto_hmac(&hmac_sha256_key, msg_buf(len),
+                       (otcrypto_word32_buf_t){.data = out_words, .len = 8});
+}
+
+static status_t hmac_sha512(size_t len) {
+  return otcrypto_hmac(&hmac_sha512_key, msg_buf(len),
+                       (otcrypto_word32_buf_t){.data = out_words, .len = 16});
+}
+
+static status_t kmac(otcrypto_blinded_key_t *key, size_t len) {
+  return otcrypto_kmac(
+      key, msg_buf(len), (otcrypto_const_byte_buf_t){.data = NULL, .len = 0},
+      kKmacTagBytes,
+      (otcrypto_word32_buf_t){.data = out_words,
+                              .len = kKmacTagBytes / sizeof(uint32_t)});
+}
+
+static status_t kmac128(size_t len) { return kmac(&kmac128_key, len); }
+
+static status_t kmac256(size_t len) { return kmac(&kmac256_key, len); }
+
+static status_t drbg_generate(size_t len) {
+  return otcrypto_drbg_generate(
+      (otcrypto_const_byte_buf_t){.data = NULL, .len = 0},
+      (otcrypto_word32_buf_t){.data = out_words,
+                              .len = len / sizeof(uint32_t)});
+}
+
+// Keys and signatures of the public-key benchmarks. The benchmarks of each
+// algorithm operate on the output of the previous one: keygen produces the
+// keys for sign, whose signature is checked by verify.
+BLINDED_KEY(ecdsa_p256_private_key, kOtcryptoKeyModeEcdsaP256,
+            kP256PrivateKeyBytes, 2 * kP256MaskedScalarBytes);
+UNBLINDED_KEY(ecdsa_p256_public_key, kOtcryptoKeyModeEcdsaP256,
+              kP256PublicKeyBytes);
+static uint32_t ecdsa_p256_signature[kP256SignatureWords];
+BLINDED_KEY(ecdh_p256_private_key, kOtcryptoKeyModeEcdhP256,
+            kP256PrivateKeyBytes, 2 * kP256MaskedScalarBytes);
+UNBLINDED_KEY(ecdh_p256_public_key, kOtcryptoKeyModeEcdhP256,
+              kP256PublicKeyBytes);
+BLINDED_KEY(ecdh_p256_shared_key, kOtcryptoKeyModeAesCtr, kP256SharedKeyBytes,
+            2 * kP256SharedKeyBytes);
+BLINDED_KEY(ecdsa_p384_private_key, kOtcryptoKeyModeEcdsaP384,
+            kP384PrivateKeyBytes, 2 * kP384MaskedScalarBytes);
+UNBLINDED_KEY(ecdsa_p384_public_key, kOtcryptoKeyModeEcdsaP384,
+              kP384PublicKeyBytes);
+static uint32_t ecdsa_p384_signature[kP384SignatureWords];
+BLINDED_KEY(ecdh_p384_private_key, kOtcryptoKeyModeEcdhP384,
+            kP384PrivateKeyBytes, 2 * kP384MaskedScalarBytes);
+UNBLINDED_KEY(ecdh_p384_public_key, kOtcryptoKeyModeEcdhP384,
+              kP384PublicKeyBytes);
+BLINDED_KEY(ecdh_p384_shared_key, kOtcryptoKeyModeAesCtr, kP384SharedKeyBytes,
+            2 * kP384SharedKeyBytes);
+
+/**
+ * Returns a digest of `words` words of `msg` tagged with `mode`.
+ */
+static otcrypto_hash_digest_t msg_digest(otcrypto_hash_mode_t mode,
+                                         size_t words) {
+  return (otcrypto_hash_digest_t){
+      .mode = mode,
+      .data = msg_words,
+      .len = words,
+  };
+}
+
+static status_t ecdsa_p256_keygen(size_t len) {
+  return otcrypto_ecdsa_p256_keygen(&ecdsa_p256_private_key,
+                                    &ecdsa_p256_public_key);
+}
+
+static status_t ecdsa_p256_sign(size_t len) {
+  return otcrypto_ecdsa_p256_sign(
+      &ecdsa_p256_private_key,
+      msg_digest(kOtcryptoHashModeSha256, kP256DigestWords),
+      (otcrypto_word32_buf_t){.data = ecdsa_p256_signature,
+                              .len = ARRAYSIZE(ecdsa_p256_signature)});
+}
+
+static status_t ecdsa_p256_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_ecdsa_p256_verify(
+      &ecdsa_p256_public_key,
+      msg_digest(kOtcryptoHashModeSha256, kP256DigestWords),
+      (otcrypto_const_word32_buf_t){.data = ecdsa_p256_signature,
+                                    .len = ARRAYSIZE(ecdsa_p256_signature)},
+      &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t ecdh_p256_keygen(size_t len) {
+  return otcrypto_ecdh_p256_keygen(&ecdh_p256_private_key,
+                                   &ecdh_p256_public_key);
+}
+
+static status_t ecdh_p256(size_t len) {
+  return otcrypto_ecdh_p256(&ecdh_p256_private_key, &ecdh_p256_public_key,
+                            &ecdh_p256_shared_key);
+}
+
+static status_t ecdsa_p384_keygen(size_t len) {
+  return otcrypto_ecdsa_p384_keygen(&ecdsa_p384_private_key,
+                                    &ecdsa_p384_public_key);
+}
+
+static status_t ecdsa_p384_sign(size_t len) {
+  return otcrypto_ecdsa_p384_sign(
+      &ecdsa_p384_private_key,
+      msg_digest(kOtcryptoHashModeSha384, kP384DigestWords),
+      (otcrypto_word32_buf_t){.data = ecdsa_p384_signature,
+                              .len = ARRAYSIZE(ecdsa_p384_signature)});
+}
+
+static status_t ecdsa_p384_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_ecdsa_p384_verify(
+      &ecdsa_p384_public_key,
+      msg_digest(kOtcryptoHashModeSha384, kP384DigestWords),
+      (otcrypto_const_word32_buf_t){.data = ecdsa_p384_signature,
+                                    .len = ARRAYSIZE(ecdsa_p384_signature)},
+      &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+static status_t ecdh_p384_keygen(size_t len) {
+  return otcrypto_ecdh_p384_keygen(&ecdh_p384_private_key,
+                                   &ecdh_p384_public_key);
+}
+
+static status_t ecdh_p384(size_t len) {
+  return otcrypto_ecdh_p384(&ecdh_p384_private_key, &ecdh_p384_public_key,
+                            &ecdh_p384_shared_key);
+}
+
+// Ed25519 takes its private key unblinded.
+static otcrypto_unblinded_key_t ed25519_private_key = {
+    .key_mode = kOtcryptoKeyModeEd25519,
+    .key_length = kEd25519PrivateKeyBytes,
+    .key = key_material,
+};
+UNBLINDED_KEY(ed25519_public_key, kOtcryptoKeyModeEd25519,
+              kEd25519PublicKeyBytes);
+static uint32_t ed25519_signature[kEd25519SignatureWords];
+
+static status_t ed25519_keygen(size_t len) {
+  return otcrypto_ed25519_keygen(&ed25519_private_key, &ed25519_public_key);
+}
+
+static status_t ed25519_sign(size_t len) {
+  otcrypto_word32_buf_t signature = {.data = ed25519_signature,
+                                     .len = ARRAYSIZE(ed25519_signature)};
+  return otcrypto_ed25519_sign(&ed25519_private_key,
+                               msg_buf(kEd25519MessageBytes),
+                               kOtcryptoEddsaSignModeEddsa, &signature);
+}
+
+static status_t ed25519_verify(size_t len) {
+  hardened_bool_t result;
+  TRY(otcrypto_ed25519_verify(
+      &ed25519_public_key, msg_buf(kEd25519MessageBytes),
+      kOtcryptoEddsaSignModeEddsa,
+      (otcrypto_const_word32_buf_t){.data = ed25519_signature,
+                                    .len = ARRAYSIZE(ed25519_signature)},
+      &result));
+  TRY_CHECK(result == kHardenedBoolTrue);
+  return OK_STATUS();
+}
+
+/**
+ * RSA key material.
+ *
+ * Generating RSA keys takes far too long for a benchmark and the test vectors
+ * of the functional tests only cover 2048 bits, so the keys are synthesized:
+ * the modulus is an arbitrary odd number with its top bit set and the private
+ * exponent an arbitrary number below it. The modular exponentiation runs in
+ * constant time with respect to these values, so the timing is the same as
+ * with a real key pair. Verification is expected to reject the signatures and
+ * its result is ignored.
+ */
+static uint32_t rsa_modulus[kRsaMaxWords];
+static uint32_t rsa_exponent[kRsaMaxWords];
+static uint32_t rsa_exponent_share1[kRsaMaxWords];
+static uint32_t rsa_signature[kRsaMaxWords];
+static uint32_t rsa_keyblob[kRsaMaxKeyblobWords];
+static uint32_t rsa_public_key_data[kRsaMaxWords];
+
+static status_t rsa_sign(otcrypto_rsa_size_t size, size_t bits,
+                         size_t keyblob_bytes) {
+  size_t words = bits / 32;
+  otcrypto_const_word32_buf_t modulus = {.data = rsa_modulus, .len = words};
+  otcrypto_blinded_key_t private_key = {
+      .config =
+          {
+              .version = kOtcryptoLibVersion1,
+              .key_mode = kOtcryptoKeyModeRsaSignPkcs,
+              .key_length = bits / 8,
+              .hw_backed = kHardenedBoolFalse,
+              .security_level = kOtcryptoKeySecurityLevelLow,
+          },
+      .keyblob = rsa_keyblob,
+      .keyblob_length = keyblob_bytes,
+  };
+  TRY(otcrypto_rsa_private_key_from_exponents(
+      size, modulus,
+      (otcrypto_const_word32_buf_t){.data = rsa_exponent, .len = words},
+      (otcrypto_const_word32_buf_t){.data = rsa_exponent_share1,
+                                    .len = words},
+      &private_key));
+  return otcrypto_rsa_sign(
+      &private_key, msg_digest(kOtcryptoHashModeSha256, kP256DigestWords),
+      kOtcryptoRsaPaddingPkcs,
+      (otcrypto_word32_buf_t){.data = rsa_signature, .len = words});
+}
+
+static status_t rsa_verify(otcrypto_rsa_size_t size, size_t bits) {
+  size_t words = bits / 32;
+  otcrypto_unblinded_key_t public_key = {
+      .key_mode = kOtcryptoKeyModeRsaSignPkcs,
+      .key_length = bits / 8,
+      .key = rsa_public_key_data,
+  };
+  TRY(otcrypto_rsa_public_key_construct(
+      size, (otcrypto_const_word32_buf_t){.data = rsa_modulus, .len = words},
+      &public_key));
+  hardened_bool_t result;
+  return otcrypto_rsa_verify(
+      &public_key, msg_digest(kOtcryptoHashModeSha256, kP256DigestWords),
+      kOtcryptoRsaPaddingPkcs,
+      (otcrypto_const_word32_buf_t){.data = rsa_signature, .len = words},
+      &result);
+}
+
+static status_t rsa_2048_sign(size_t len) {
+  return rsa_sign(kOtcryptoRsaSize2048, 2048,
+                  kOtcryptoRsa2048PrivateKeyblobBytes);
+}
+
+static status_t rsa_2048_verify(size_t len) {
+  return rsa_verify(kOtcryptoRsaSize2048, 2048);
+}
+
+static status_t rsa_3072_sign(size_t len) {
+  return rsa_sign(kOtcryptoRsaSize3072, 3072,
+                  kOtcryptoRsa3072PrivateKeyblobBytes);
+}
+
+static status_t rsa_3072_verify(size_t len) {
+  return rsa_verify(kOtcryptoRsaSize3072, 3072);
+}
+
+static status_t rsa_4096_sign(size_t len) {
+  return rsa_sign(kOtcryptoRsaSize4096, 4096,
+                  kOtcryptoRsa4096PrivateKeyblobBytes);
+}
+
+static status_t rsa_4096_verify(size_t len) {
+  return rsa_verify(kOtcryptoRsaSize4096, 4096);
+}
+
+/**
+ * A benchmarked operation.
+ */
+typedef struct bench {
+  /**
+   * Name of the primitive.
+   */
+  const char *name;
+  /**
+   * Runs the operation once on a message of `len` bytes.
+   */
+  status_t (*run)(size_t len);
+  /**
+   * Whether the operation is measured at each of `kMessageSizes`; otherwise it
+   * is measured once with `len` set to zero.
+   */
+  bool sized;
+  /**
+   * Number of measured runs.
+   */
+  size_t runs;
+} bench_t;
+
+#define SYMMETRIC(name_) {#name_, name_, true, kSymmetricRuns}
+#define ASYMMETRIC(name_) {#name_, name_, false, kAsymmetricRuns}
+
+static const bench_t kBenchmarks[] = {
+    SYMMETRIC(aes_ecb),
+    SYMMETRIC(aes_cbc),
+    SYMMETRIC(aes_ctr),
+    SYMMETRIC(aes_gcm),
+    SYMMETRIC(sha2_256),
+    SYMMETRIC(sha2_384),
+    SYMMETRIC(sha2_512),
+    SYMMETRIC(sha3_256),
+    SYMMETRIC(sha3_512),
+    SYMMETRIC(shake256),
+    SYMMETRIC(hmac_sha256),
+    SYMMETRIC(hmac_sha512),
+    SYMMETRIC(kmac128),
+    SYMMETRIC(kmac256),
+    SYMMETRIC(drbg_generate),
+    ASYMMETRIC(ecdsa_p256_keygen),
+    ASYMMETRIC(ecdsa_p256_sign),
+    ASYMMETRIC(ecdsa_p256_verify),
+    ASYMMETRIC(ecdh_p256_keygen),
+    ASYMMETRIC(ecdh_p256),
+    ASYMMETRIC(ecdsa_p384_keygen),
+    ASYMMETRIC(ecdsa_p384_sign),
+    ASYMMETRIC(ecdsa_p384_verify),
+    ASYMMETRIC(ecdh_p384_keygen),
+    ASYMMETRIC(ecdh_p384),
+    ASYMMETRIC(ed25519_keygen),
+    ASYMMETRIC(ed25519_sign),
+    ASYMMETRIC(ed25519_verify),
+    ASYMMETRIC(rsa_2048_sign),
+    ASYMMETRIC(rsa_2048_verify),
+    ASYMMETRIC(rsa_3072_sign),
+    ASYMMETRIC(rsa_3072_verify),
+    ASYMMETRIC(rsa_4096_sign),
+    ASYMMETRIC(rsa_4096_verify),
+};
+
+/**
+ * A measurement of one benchmark at one message length.
+ */
+typedef struct bench_result {
+  const bench_t *bench;
+  size_t bytes;
+  profile_region_t region;
+  char name[32];
+} bench_result_t;
+
+static bench_result_t results[kMaxResults];
+static size_t num_results;
+
+static status_t bench_measure(const bench_t *bench, size_t bytes) {
+  TRY_CHECK(num_results < ARRAYSIZE(results));
+  bench_result_t *result = &results[num_results++];
+  result->bench = bench;
+  result->bytes = bytes;
+  if (bench->sized) {
+    base_snprintf(result->name, sizeof(result->name), "%s/%d", bench->name,
+                  bytes);
+  } else {
+    base_snprintf(result->name, sizeof(result->name), "%s", bench->name);
+  }
+  result->region = (profile_region_t){.name = result->name};
+
+  for (size_t i = 0; i < bench->runs; ++i) {
+    profile_sample_t start = profile_region_begin();
+    TRY(bench->run(bytes));
+    profile_region_end(&result->region, &start);
+  }
+  return OK_STATUS();
+}
+
+static status_t bench_report(ujson_t *uj, size_t index) {
+  const bench_result_t *result = &results[index];
+  cryptolib_bench_result_t resp = {
+      .index = (uint32_t)index,
+      .num_results = (uint32_t)num_results,
+      .bytes = (uint32_t)result->bytes,
+      .runs = result->region.count,
+      .min_cycles = result->region.min_cycles,
+      .max_cycles = result->region.max_cycles,
+      .mean_cycles = profile_region_mean(&result->region),
+  };
+  const char *name = result->bench->name;
+  for (size_t i = 0; i < sizeof(resp.primitive) - 1 && name[i] != '\0'; ++i) {
+    resp.primitive[i] = name[i];
+  }
+  if (result->bytes > 0) {
+    resp.millicycles_per_byte = (uint32_t)udiv64_slow(
+        result->region.total_cycles * 1000,
+        (uint64_t)result->region.count * result->bytes, NULL);
+  }
+  return RESP_OK(ujson_serialize_cryptolib_bench_result_t, uj, &resp);
+}
+
+static status_t bench_setup(void) {
+  for (size_t i = 0; i < kMaxMessageWords; ++i) {
+    msg_words[i] = 0x9e3779b9 * (i + 1);
+  }
+  for (size_t i = 0; i < kMaxKeyWords; ++i) {
+    key_material[i] = 0x01234567 * (i + 1);
+    key_mask[i] = 0x89abcdef ^ (i << 8);
+  }
+  for (size_t i = 0; i < kRsaMaxWords; ++i) {
+    rsa_modulus[i] = 0x7f4a7c15 * (i + 1) + 0x3c6ef372;
+    rsa_exponent[i] = 0x2545f491 * (i + 1);
+  }
+  // Make the modulus odd and set its top bit at every key size. Clearing the
+  // top word of the exponent at the same positions keeps it below the modulus.
+  rsa_modulus[0] |= 1;
+  for (size_t bits = 2048; bits <= 4096; bits += 1024) {
+    rsa_modulus[bits / 32 - 1] |= 1u << 31;
+    rsa_exponent[bits / 32 - 1] = 0;
+  }
+
+  TRY(symmetric_key_init(&aes_ecb_key));
+  TRY(symmetric_key_init(&aes_cbc_key));
+  TRY(symmetric_key_init(&aes_ctr_key));
+  TRY(symmetric_key_init(&aes_gcm_key));
+  TRY(symmetric_key_init(&hmac_sha256_key));
+  TRY(symmetric_key_init(&hmac_sha512_key));
+  TRY(symmetric_key_init(&kmac128_key));
+  TRY(symmetric_key_init(&kmac256_key));
+  ed25519_private_key.checksum =
+      integrity_unblinded_checksum(&ed25519_private_key);
+  return otcrypto_drbg_instantiate(
+      (otcrypto_const_byte_buf_t){.data = NULL, .len = 0});
+}
+
+static status_t cryptolib_perftest(void) {
+  ujson_t uj = ujson_ottf_console();
+  TRY(bench_setup());
+
+  profile_counters_enable(true);
+  for (size_t i = 0; i < ARRAYSIZE(kBenchmarks); ++i) {
+    const bench_t *bench = &kBenchmarks[i];
+    LOG_INFO("Measuring %s", bench->name);
+    if (!bench->sized) {
+      TRY(bench_measure(bench, 0));
+      continue;
+    }
+    for (size_t j = 0; j < ARRAYSIZE(kMessageSizes); ++j) {
+      TRY(bench_measure(bench, kMessageSizes[j]));
+    }
+  }
+  profile_counters_enable(false);
+
+  profile_region_log_all();
+  for (size_t i = 0; i < num_results; ++i) {
+    TRY(bench_report(&uj, i));
+  }
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+  CHECK_STATUS_OK(entropy_complex_init());
+  EXECUTE_TEST(result, cryptolib_perftest);
+  return status_ok(result);
+}
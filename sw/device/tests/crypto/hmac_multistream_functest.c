@@ -2,6 +2,7 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "sw/device/lib/crypto/drivers/hmac.h"
 #include "sw/device/lib/crypto/impl/integrity.h"
 #include "sw/device/lib/crypto/include/datatypes.h"
 #include "sw/device/lib/crypto/include/hmac.h"
@@ -445,10 +446,22 @@ static status_t run_test(void) {
   return OK_STATUS();
 }
 
+/**
+ * Run the same interleaved vectors with driver owner tracking enabled, so that
+ * streams repeatedly evict each other from the HMAC block.
+ */
+static status_t run_test_owner_tracking(void) {
+  TRY(hmac_owner_tracking_set(kHardenedBoolTrue));
+  status_t result = run_test();
+  TRY(hmac_owner_tracking_set(kHardenedBoolFalse));
+  return result;
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 bool test_main(void) {
   LOG_INFO("Testing cryptolib SHA-2/HMAC with parallel multiple streams.");
   status_t test_result = OK_STATUS();
   EXECUTE_TEST(test_result, run_test);
+  EXECUTE_TEST(test_result, run_test_owner_tracking);
   return status_ok(test_result);
 }
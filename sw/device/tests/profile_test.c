@@ -0,0 +1,199 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/profile.h"
+
+#include "sw/device/lib/base/crc32.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/runtime/print.h"
+#include "sw/device/lib/testing/json/profile.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/ujson/ujson.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+PROFILE_REGION(sum_region, "sum");
+PROFILE_REGION(histogram_region, "histogram");
+// Never sampled, so never registered.
+PROFILE_REGION(unused_region, "unused");
+
+/**
+ * In-memory IO for the ujson context of `dump_test`.
+ */
+static struct {
+  char source[64];
+  size_t source_len;
+  size_t source_pos;
+  char sink[512];
+  size_t sink_len;
+} io;
+
+static status_t io_getc(void *context) {
+  OT_DISCARD(context);
+  if (io.source_pos >= io.source_len) {
+    return RESOURCE_EXHAUSTED();
+  }
+  return OK_STATUS((uint8_t)io.source[io.source_pos++]);
+}
+
+static status_t io_putbuf(void *context, const char *buf, size_t len) {
+  OT_DISCARD(context);
+  if (len > sizeof(io.sink) - 1 - io.sink_len) {
+    return RESOURCE_EXHAUSTED();
+  }
+  memcpy(&io.sink[io.sink_len], buf, len);
+  io.sink_len += len;
+  io.sink[io.sink_len] = '\0';
+  return OK_STATUS((int32_t)len);
+}
+
+static status_t io_flushbuf(void *context) {
+  OT_DISCARD(context);
+  return OK_STATUS();
+}
+
+/**
+ * Returns whether the output of the ujson context contains `str`.
+ */
+static bool sink_contains(const char *str) {
+  size_t len = 0;
+  while (str[len] != '\0') {
+    ++len;
+  }
+  for (size_t i = 0; i + len <= io.sink_len; ++i) {
+    if (memcmp(&io.sink[i], str, len) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Returns whether the output of the ujson context contains the JSON field
+ * `name` with the integer `value`.
+ */
+static bool sink_contains_field(const char *name, uint32_t value) {
+  // `base_snprintf()` does not terminate the string.
+  char field[48] = {0};
+  base_snprintf(field, sizeof(field) - 1, "\"%s\":%u", name, value);
+  return sink_contains(field);
+}
+
+/**
+ * Runs the ProfileDump command for region `index` and leaves the response in
+ * `io.sink`.
+ */
+static status_t profile_dump(uint32_t index) {
+  size_t req_len =
+      base_snprintf(io.source, sizeof(io.source), "{\"index\":%u}", index);
+  io.source_len =
+      req_len + base_snprintf(&io.source[req_len], sizeof(io.source) - req_len,
+                              "{\"crc\":%u}", crc32(io.source, req_len));
+  io.source_pos = 0;
+  io.sink_len = 0;
+  ujson_t uj = ujson_init(NULL, io_getc, io_putbuf, io_flushbuf);
+  return ujcmd_profile_dump(&uj);
+}
+
+static status_t accumulate_test(void) {
+  size_t num_regions = profile_region_count();
+  TRY_CHECK(!unused_region.registered);
+
+  static const uint32_t kSamples[] = {40, 10, 30, 20};
+  for (size_t i = 0; i < ARRAYSIZE(kSamples); ++i) {
+    profile_region_add(&sum_region, kSamples[i]);
+  }
+  TRY_CHECK(profile_region_count() == num_regions + 1);
+  TRY_CHECK(profile_region_get(num_regions) == &sum_region);
+  TRY_CHECK(sum_region.count == 4);
+  TRY_CHECK(sum_region.min_cycles == 10);
+  TRY_CHECK(sum_region.max_cycles == 40);
+  TRY_CHECK(sum_region.total_cycles == 100);
+  TRY_CHECK(profile_region_mean(&sum_region) == 25);
+
+  // A measured sample lands in the same statistics.
+  profile_sample_t start = profile_region_begin();
+  uint32_t cycles = profile_region_end(&sum_region, &start);
+  TRY_CHECK(sum_region.count == 5);
+  TRY_CHECK(sum_region.total_cycles == 100 + cycles);
+
+  // Resetting clears the statistics but keeps the region registered.
+  profile_region_reset(&sum_region);
+  TRY_CHECK(sum_region.count == 0 && sum_region.total_cycles == 0);
+  TRY_CHECK(profile_region_mean(&sum_region) == 0);
+  TRY_CHECK(profile_region_count() == num_regions + 1);
+  profile_region_add(&sum_region, 7);
+  TRY_CHECK(sum_region.min_cycles == 7 && sum_region.max_cycles == 7);
+  TRY_CHECK(profile_region_count() == num_regions + 1);
+  TRY_CHECK(profile_region_get(num_regions + 1) == NULL);
+  return OK_STATUS();
+}
+
+static status_t histogram_test(void) {
+  // Bucket `i` holds samples in [4^i, 4^(i+1)), and zero goes into bucket 0.
+  static const uint32_t kSamples[] = {
+      0, 1, 3, 4, 15, 16, 63, 64, 1 << 20, (1 << 22) - 1, UINT32_MAX,
+  };
+  static const uint32_t kExpected[kProfileHistogramNumBuckets] = {
+      [0] = 3, [1] = 2, [2] = 2, [3] = 1, [10] = 2, [15] = 1,
+  };
+  for (size_t i = 0; i < ARRAYSIZE(kSamples); ++i) {
+    profile_region_add(&histogram_region, kSamples[i]);
+  }
+  TRY_CHECK_ARRAYS_EQ(histogram_region.histogram, kExpected,
+                      ARRAYSIZE(kExpected));
+  TRY_CHECK(histogram_region.min_cycles == 0);
+  TRY_CHECK(histogram_region.max_cycles == UINT32_MAX);
+  return OK_STATUS();
+}
+
+static status_t dump_test(void) {
+  size_t num_regions = profile_region_count();
+  size_t index = num_regions;
+  for (size_t i = 0; i < num_regions; ++i) {
+    if (profile_region_get(i) == &histogram_region) {
+      index = i;
+    }
+  }
+  TRY_CHECK(index < num_regions);
+
+  TRY(profile_dump((uint32_t)index));
+  LOG_INFO("%s", io.sink);
+  TRY_CHECK(sink_contains("RESP_OK:{"));
+  TRY_CHECK(sink_contains_field("num_regions", (uint32_t)num_regions));
+  TRY_CHECK(sink_contains("\"name\":\"histogram\""));
+  TRY_CHECK(sink_contains_field("count", 11));
+  TRY_CHECK(sink_contains_field("min_cycles", 0));
+  TRY_CHECK(sink_contains_field("max_cycles", UINT32_MAX));
+  TRY_CHECK(sink_contains("\"histogram\":[3,2,2,1,0,0,0,0,0,0,2,0,0,0,0,1]"));
+  TRY_CHECK(sink_contains(" CRC:"));
+
+  // Past the last region, only the number of regions is reported.
+  TRY(profile_dump((uint32_t)num_regions));
+  TRY_CHECK(sink_contains_field("num_regions", (uint32_t)num_regions));
+  TRY_CHECK(sink_contains("\"name\":\"\""));
+  TRY_CHECK(sink_contains_field("count", 0));
+  TRY_CHECK(!sink_contains_field("max_cycles", UINT32_MAX));
+
+  // A request that does not match its CRC is rejected.
+  io.source_pos = 0;
+  io.source[sizeof("{\"index\":") - 1] ^= 1;
+  io.sink_len = 0;
+  ujson_t uj = ujson_init(NULL, io_getc, io_putbuf, io_flushbuf);
+  TRY_CHECK(status_err(ujcmd_profile_dump(&uj)) == kDataLoss);
+  return OK_STATUS();
+}
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+  EXECUTE_TEST(result, accumulate_test);
+  EXECUTE_TEST(result, histogram_test);
+  EXECUTE_TEST(result, dump_test);
+  profile_region_log_all();
+  return status_ok(result);
+}
@@ -0,0 +1,84 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hw/top/dt/aon_timer.h"  // Generated
+#include "hw/top/dt/rv_plic.h"    // Generated
+#include "sw/device/lib/dif/dif_aon_timer.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/aon_timer_testutils.h"
+#include "sw/device/lib/testing/rv_plic_testutils.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+// Waits for the AON wakeup timer in a plain WFI, without the low power hint,
+// which is what `--fast-forward` of the Verilator model skips. The test passes
+// with and without fast-forwarding, which only shows in the statistics that
+// the simulator prints at the end.
+
+OTTF_DEFINE_TEST_CONFIG();
+
+enum {
+  /**
+   * Number of times the test sleeps.
+   */
+  kNumSleeps = 3,
+  /**
+   * Time each sleep takes, long compared to the setup of the timer.
+   */
+  kSleepUs = 100 * 1000,
+};
+
+static const uint32_t kPlicTarget = 0;
+static dif_aon_timer_t aon_timer;
+static dt_aon_timer_t kAonTimerDt = kDtAonTimerAon;
+static dif_rv_plic_t plic;
+static dt_rv_plic_t kRvPlicDt = kDtRvPlic;
+
+static volatile bool wakeup_irq;
+
+/**
+ * External interrupt handler.
+ */
+bool ottf_handle_irq(uint32_t *exc_info, dt_instance_id_t devid,
+                     dif_rv_plic_irq_id_t irq_id) {
+  if (devid != dt_aon_timer_instance_id(kAonTimerDt) ||
+      dt_aon_timer_irq_from_plic_id(kAonTimerDt, irq_id) !=
+          kDtAonTimerIrqWkupTimerExpired) {
+    return false;
+  }
+  CHECK_DIF_OK(dif_aon_timer_wakeup_stop(&aon_timer));
+  CHECK_DIF_OK(dif_aon_timer_irq_acknowledge(&aon_timer,
+                                             kDtAonTimerIrqWkupTimerExpired));
+  wakeup_irq = true;
+  return true;
+}
+
+bool test_main(void) {
+  CHECK_DIF_OK(dif_aon_timer_init_from_dt(kAonTimerDt, &aon_timer));
+  CHECK_DIF_OK(dif_rv_plic_init_from_dt(kRvPlicDt, &plic));
+  dif_rv_plic_irq_id_t plic_id =
+      dt_aon_timer_irq_to_plic_id(kAonTimerDt, kDtAonTimerIrqWkupTimerExpired);
+  rv_plic_testutils_irq_range_enable(&plic, kPlicTarget, plic_id, plic_id);
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+
+  uint64_t wakeup_cycles = 0;
+  CHECK_STATUS_OK(
+      aon_timer_testutils_get_aon_cycles_64_from_us(kSleepUs, &wakeup_cycles));
+  for (size_t i = 0; i < kNumSleeps; ++i) {
+    LOG_INFO("Sleeping for %u us", kSleepUs);
+    wakeup_irq = false;
+    CHECK_STATUS_OK(
+        aon_timer_testutils_wakeup_config(&aon_timer, wakeup_cycles));
+    ATOMIC_WAIT_FOR_INTERRUPT(wakeup_irq);
+  }
+
+  return true;
+}
@@ -0,0 +1,138 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/sim_mailbox_testutils.h"
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+OTTF_DEFINE_TEST_CONFIG();
+
+/**
+ * Error codes of the host, as returned in the argument of `kInternal`.
+ */
+enum {
+  kHostErrorNoEntry = 2,
+  kHostErrorAccess = 13,
+  kHostErrorInvalid = 22,
+};
+
+static const char kFileName[] = "sim_mailbox_test.txt";
+static const char kHello[] = "Hello";
+static const char kWorld[] = ", mailbox!";
+
+/**
+ * Checks that `status` is the error `code` of the host.
+ */
+static status_t check_host_error(status_t status, int32_t code) {
+  const char *err;
+  int32_t arg;
+  char mod_id[3];
+  TRY_CHECK(status_extract(status, &err, &arg, mod_id));
+  TRY_CHECK(status_err(status) == kInternal);
+  TRY_CHECK(arg == code, "Expected host error %d, got %d", code, arg);
+  return OK_STATUS();
+}
+
+#ifndef SIM_MAILBOX_TEST_NO_DIR
+static status_t cycle_count_test(void) {
+  uint64_t start;
+  uint64_t end;
+  TRY(sim_mailbox_testutils_cycle_count(&start));
+  TRY(sim_mailbox_testutils_cycle_count(&end));
+  LOG_INFO("Cycle count: %u, then %u", (uint32_t)start, (uint32_t)end);
+  TRY_CHECK(start > 0);
+  TRY_CHECK(end > start);
+  return OK_STATUS();
+}
+
+static status_t file_test(void) {
+  // The lengths exclude the terminating NUL, and the first one is not a
+  // multiple of the word size.
+  TRY(sim_mailbox_testutils_file_write(kFileName, kHello, sizeof(kHello) - 1,
+                                       /*append=*/false));
+  TRY(sim_mailbox_testutils_file_write(kFileName, kWorld, sizeof(kWorld) - 1,
+                                       /*append=*/true));
+
+  static const char kExpected[] = "Hello, mailbox!";
+  uint8_t buf[32];
+  size_t read_len;
+  TRY(sim_mailbox_testutils_file_read(kFileName, 0, buf, sizeof(buf),
+                                      &read_len));
+  TRY_CHECK(read_len == sizeof(kExpected) - 1);
+  TRY_CHECK_ARRAYS_EQ(buf, (const uint8_t *)kExpected, read_len);
+
+  // Reads at an offset and of fewer bytes than the file has.
+  TRY(sim_mailbox_testutils_file_read(kFileName, 3, buf, 6, &read_len));
+  TRY_CHECK(read_len == 6);
+  TRY_CHECK_ARRAYS_EQ(buf, (const uint8_t *)&kExpected[3], read_len);
+
+  // Reads past the end of the file return nothing.
+  TRY(sim_mailbox_testutils_file_read(kFileName, sizeof(kExpected) - 1, buf,
+                                      sizeof(buf), &read_len));
+  TRY_CHECK(read_len == 0);
+
+  // Writing without appending replaces the file.
+  TRY(sim_mailbox_testutils_file_write(kFileName, kWorld, sizeof(kWorld) - 1,
+                                       /*append=*/false));
+  TRY(sim_mailbox_testutils_file_read(kFileName, 0, buf, sizeof(buf),
+                                      &read_len));
+  TRY_CHECK(read_len == sizeof(kWorld) - 1);
+  TRY_CHECK_ARRAYS_EQ(buf, (const uint8_t *)kWorld, read_len);
+  return OK_STATUS();
+}
+
+static status_t file_error_test(void) {
+  uint8_t buf[8];
+  // Files outside of the mailbox directory are not accessible.
+  TRY(check_host_error(
+      sim_mailbox_testutils_file_write("../sim_mailbox_test.txt", kHello,
+                                       sizeof(kHello) - 1, /*append=*/false),
+      kHostErrorInvalid));
+  TRY(check_host_error(
+      sim_mailbox_testutils_file_read("a/../../sim_mailbox_test.txt", 0, buf,
+                                      sizeof(buf), NULL),
+      kHostErrorInvalid));
+  TRY(check_host_error(sim_mailbox_testutils_file_read(
+                           "/etc/passwd", 0, buf, sizeof(buf), NULL),
+                       kHostErrorInvalid));
+
+  TRY(check_host_error(sim_mailbox_testutils_file_read(
+                           "sim_mailbox_test_missing.txt", 0, buf,
+                           sizeof(buf), NULL),
+                       kHostErrorNoEntry));
+  return OK_STATUS();
+}
+
+#else
+static status_t no_dir_test(void) {
+  // The cycle count does not need a directory.
+  uint64_t cycles;
+  TRY(sim_mailbox_testutils_cycle_count(&cycles));
+
+  uint8_t buf[8];
+  TRY(check_host_error(
+      sim_mailbox_testutils_file_write(kFileName, kHello, sizeof(kHello) - 1,
+                                       /*append=*/false),
+      kHostErrorAccess));
+  TRY(check_host_error(sim_mailbox_testutils_file_read(kFileName, 0, buf,
+                                                       sizeof(buf), NULL),
+                       kHostErrorAccess));
+  return OK_STATUS();
+}
+#endif
+
+bool test_main(void) {
+  status_t result = OK_STATUS();
+#ifdef SIM_MAILBOX_TEST_NO_DIR
+  EXECUTE_TEST(result, no_dir_test);
+#else
+  EXECUTE_TEST(result, cycle_count_test);
+  EXECUTE_TEST(result, file_test);
+  EXECUTE_TEST(result, file_error_test);
+#endif
+  return status_ok(result);
+}
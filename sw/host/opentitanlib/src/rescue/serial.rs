@@ -25,6 +25,8 @@ pub struct RescueSerial {
 
 impl RescueSerial {
     const ONE_SECOND: Duration = Duration::from_secs(1);
+    // Starting a streamed upload erases the whole rescue region first.
+    const STREAM_START_TIMEOUT: Duration = Duration::from_secs(30);
     pub const RESCUE: [u8; 4] = *b"RESQ";
     pub const RESCUE_B: [u8; 4] = *b"RESB";
     pub const REBOOT: [u8; 4] = *b"REBO";
@@ -38,6 +40,7 @@ impl RescueSerial {
     pub const OT_ID: [u8; 4] = *b"OTID";
     pub const ERASE_OWNER: [u8; 4] = *b"KLBR";
     pub const WAIT: [u8; 4] = *b"WAIT";
+    pub const STREAM: [u8; 4] = *b"STRM";
 
     const BAUD_115K: [u8; 4] = *b"115K";
     const BAUD_230K: [u8; 4] = *b"230K";
@@ -110,6 +113,10 @@ impl RescueSerial {
     }
 
     pub fn set_mode(&self, mode: [u8; 4]) -> Result<()> {
+        self.set_mode_with_timeout(mode, Self::ONE_SECOND)
+    }
+
+    fn set_mode_with_timeout(&self, mode: [u8; 4], timeout: Duration) -> Result<()> {
         self.uart.write(&mode)?;
         let enter = b'\r';
         self.uart.write(std::slice::from_ref(&enter))?;
@@ -119,7 +126,7 @@ impl RescueSerial {
             .wait_for_line(format!("mode: {mode}").as_str(), Self::ONE_SECOND)?;
         if let PassFailResult::Fail(result) = (&self.uart)
             .logged()
-            .wait_for_line(PassFail("ok:", regex!("error:.*")), Self::ONE_SECOND)?
+            .wait_for_line(PassFail("ok:", regex!("error:.*")), timeout)?
         {
             return Err(RescueError::BadMode(result[0].clone()).into());
         }
@@ -147,6 +154,23 @@ impl RescueSerial {
         Ok(())
     }
 
+    /// Uploads firmware with XMODEM-G.
+    ///
+    /// The device erases the rescue region before the upload and programs each
+    /// frame while the next one is arriving, so frames are not individually
+    /// acknowledged.
+    pub fn update_firmware_streaming(&self, slot: BootSlot, image: &[u8]) -> Result<()> {
+        self.set_mode(if slot == BootSlot::SlotB {
+            Self::RESCUE_B
+        } else {
+            Self::RESCUE
+        })?;
+        self.set_mode_with_timeout(Self::STREAM, Self::STREAM_START_TIMEOUT)?;
+        let xm = Xmodem::new();
+        xm.send(&*self.uart, image)?;
+        Ok(())
+    }
+
     pub fn get_raw(&self, mode: [u8; 4]) -> Result<Vec<u8>> {
         self.set_mode(mode)?;
         let mut data = Vec::new();
@@ -48,6 +48,7 @@ impl Xmodem {
     const ACK: u8 = 0x06;
     const NAK: u8 = 0x15;
     const CAN: u8 = 0x18;
+    const STREAM: u8 = 0x47;
 
     pub fn new() -> Self {
         Xmodem {
@@ -72,22 +73,31 @@ impl Xmodem {
         crc
     }
 
+    /// Sends `data` using XMODEM-CRC, or XMODEM-G if the receiver requests it.
+    ///
+    /// In XMODEM-G, frames are sent back-to-back without waiting for an ACK
+    /// and only the end of the transfer is acknowledged.  The receiver cancels
+    /// the transfer on the first error.
     pub fn send(&self, console: &dyn ConsoleDevice, data: impl Read) -> Result<()> {
-        self.send_start(console)?;
-        self.send_data(console, data)?;
+        let streaming = self.send_start(console)?;
+        self.send_data(console, data, streaming)?;
         self.send_finish(console)?;
         Ok(())
     }
 
-    fn send_start(&self, console: &dyn ConsoleDevice) -> Result<()> {
+    // Returns whether the receiver requested XMODEM-G.
+    fn send_start(&self, console: &dyn ConsoleDevice) -> Result<bool> {
         let mut ch = 0u8;
         let mut cancels = 0usize;
-        // Wait for the XMODEM CRC start sequence.
+        // Wait for the XMODEM CRC or XMODEM-G start sequence.
         loop {
             console.read(std::slice::from_mut(&mut ch))?;
             match ch {
                 Self::CRC => {
-                    return Ok(());
+                    return Ok(false);
+                }
+                Self::STREAM => {
+                    return Ok(true);
                 }
                 Self::NAK => {
                     return Err(XmodemError::UnsupportedMode("standard checksums".into()).into());
@@ -108,7 +118,12 @@ impl Xmodem {
         }
     }
 
-    fn send_data(&self, console: &dyn ConsoleDevice, mut data: impl Read) -> Result<()> {
+    fn send_data(
+        &self,
+        console: &dyn ConsoleDevice,
+        mut data: impl Read,
+        streaming: bool,
+    ) -> Result<()> {
         let mut block = 0usize;
         let mut errors = 0usize;
         loop {
@@ -129,6 +144,11 @@ impl Xmodem {
             buf.push((crc >> 8) as u8);
             buf.push((crc & 0xFF) as u8);
             log::info!("Sending block {block}");
+            if streaming {
+                // The receiver doesn't acknowledge individual frames.
+                console.write(&buf)?;
+                continue;
+            }
 
             let mut cancels = 0usize;
             loop {
@@ -164,8 +184,11 @@ impl Xmodem {
         console.write(&[Self::EOF])?;
         let mut ch = 0u8;
         console.read(std::slice::from_mut(&mut ch))?;
-        if ch != Self::ACK {
-            log::info!("Expected ACK. Got {ch:#x}.");
+        match ch {
+            Self::ACK => {}
+            // A streaming receiver reports errors by cancelling the transfer.
+            Self::CAN => return Err(XmodemError::Cancelled.into()),
+            _ => log::info!("Expected ACK. Got {ch:#x}."),
         }
         Ok(())
     }
@@ -27,10 +27,12 @@ pub mod otp_ctrl;
 #[cfg(not(feature = "english_breakfast"))]
 pub mod pinmux_config;
 pub mod poll;
+pub mod profile;
 pub mod rpc;
 pub mod spi_passthru;
 pub mod status;
 pub mod test_status;
+pub mod ubin;
 
 /// The `execute_test` macro should be used in end-to-end tests to
 /// invoke each test from the `main` function.
@@ -0,0 +1,35 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+use anyhow::Result;
+use std::time::Duration;
+
+use crate::io::console::ConsoleDevice;
+use crate::test_utils::e2e_command::TestCommand;
+use crate::test_utils::rpc::{ConsoleRecv, ConsoleSend};
+
+// Bring in the auto-generated sources.
+include!(env!("profile"));
+
+impl ProfileDumpReq {
+    /// Reads the statistics of all profile regions registered on the device.
+    pub fn execute<T>(device: &T) -> Result<Vec<ProfileRegionResp>>
+    where
+        T: ConsoleDevice + ?Sized,
+    {
+        let mut regions = Vec::new();
+        loop {
+            TestCommand::ProfileDump.send_with_crc(device)?;
+            let op = ProfileDumpReq {
+                index: regions.len() as u32,
+            };
+            op.send_with_crc(device)?;
+            let resp = ProfileRegionResp::recv(device, Duration::from_secs(300), false)?;
+            if regions.len() as u32 >= resp.num_regions {
+                return Ok(regions);
+            }
+            regions.push(resp);
+        }
+    }
+}
@@ -11,16 +11,71 @@ use crate::io::console::ext::{PassFail, PassFailResult};
 use crate::io::console::{ConsoleDevice, ConsoleError, ConsoleExt};
 use crate::regex;
 use crate::test_utils::status::Status;
+use crate::test_utils::ubin;
 
 // Bring in the auto-generated sources.
 include!(env!("ottf"));
 
+/// Encoding of the messages of a ujson session with a device.
+///
+/// The framing belongs to the session: callers keep the value returned by
+/// `negotiate_binary_framing()` next to the device it was negotiated with and
+/// pass it to the `*_framed` functions.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum Framing {
+    /// Messages are JSON text. This is how every session starts.
+    #[default]
+    Json,
+    /// Messages use the binary encoding of `ubin`.
+    Binary,
+}
+
+/// Switches the ujson session with the device to the binary encoding.
+///
+/// The device picks up the switch the next time it reads a message and keeps
+/// using the binary encoding, in both directions, until it is reset.  Responses
+/// remain lines of text, with the binary payload encoded in hex.
+///
+/// Returns the framing to use with this device until it is reset.
+pub fn negotiate_binary_framing<T: ConsoleDevice + ?Sized>(device: &T) -> Result<Framing> {
+    device.write(&[ubin::BINARY_FRAMING_MARKER])?;
+    Ok(Framing::Binary)
+}
+
+fn encode<U: Serialize + ?Sized>(value: &U, framing: Framing) -> Result<Vec<u8>> {
+    match framing {
+        Framing::Binary => {
+            let data = ubin::to_vec(value)?;
+            log::info!("Sending: {}", hex::encode(&data));
+            Ok(data)
+        }
+        Framing::Json => {
+            let s = serde_json::to_string(value)?;
+            log::info!("Sending: {}", s);
+            Ok(s.into_bytes())
+        }
+    }
+}
+
+fn decode<U: DeserializeOwned>(body: &str, framing: Framing) -> Result<U> {
+    match framing {
+        Framing::Binary => Ok(ubin::from_slice(&hex::decode(body)?)?),
+        Framing::Json => Ok(serde_json::from_str::<U>(body)?),
+    }
+}
+
 pub trait ConsoleSend<T>
 where
     T: ConsoleDevice + ?Sized,
 {
-    fn send(&self, device: &T) -> Result<()>;
-    fn send_with_crc(&self, device: &T) -> Result<()>;
+    fn send(&self, device: &T) -> Result<()> {
+        self.send_framed(device, Framing::Json)
+    }
+    fn send_with_crc(&self, device: &T) -> Result<()> {
+        self.send_with_crc_framed(device, Framing::Json)
+    }
+    fn send_framed(&self, device: &T, framing: Framing) -> Result<()>;
+    fn send_with_crc_framed(&self, device: &T, framing: Framing) -> Result<()>;
 }
 
 impl<T, U> ConsoleSend<T> for U
@@ -28,21 +83,18 @@ where
     T: ConsoleDevice + ?Sized,
     U: Serialize,
 {
-    fn send(&self, device: &T) -> Result<()> {
-        let s = serde_json::to_string(self)?;
-        log::info!("Sending: {}", s);
-        device.write(s.as_bytes())?;
+    fn send_framed(&self, device: &T, framing: Framing) -> Result<()> {
+        device.write(&encode(self, framing)?)?;
         Ok(())
     }
 
-    fn send_with_crc(&self, device: &T) -> Result<()> {
-        let s = serde_json::to_string(self)?;
-        log::info!("Sending: {}", s);
-        device.write(s.as_bytes())?;
+    fn send_with_crc_framed(&self, device: &T, framing: Framing) -> Result<()> {
+        let data = encode(self, framing)?;
+        device.write(&data)?;
         let actual_crc = OttfCrc {
-            crc: Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(s.as_bytes()),
+            crc: Crc::<u32>::new(&CRC_32_ISO_HDLC).checksum(&data),
         };
-        actual_crc.send(device)
+        actual_crc.send_framed(device, framing)
     }
 }
 
@@ -51,6 +103,12 @@ where
     T: ConsoleDevice + ?Sized,
 {
     fn recv(device: &T, timeout: Duration, quiet: bool) -> Result<Self>
+    where
+        Self: Sized,
+    {
+        Self::recv_framed(device, timeout, quiet, Framing::Json)
+    }
+    fn recv_framed(device: &T, timeout: Duration, quiet: bool, framing: Framing) -> Result<Self>
     where
         Self: Sized;
 }
@@ -60,7 +118,7 @@ where
     T: ConsoleDevice + ?Sized,
     U: DeserializeOwned,
 {
-    fn recv(device: &T, timeout: Duration, quiet: bool) -> Result<Self>
+    fn recv_framed(device: &T, timeout: Duration, quiet: bool, framing: Framing) -> Result<Self>
     where
         Self: Sized,
     {
@@ -78,13 +136,13 @@ where
                 let json_str = &cap[1];
                 let crc_str = &cap[2];
                 check_crc(json_str, crc_str)?;
-                Ok(serde_json::from_str::<Self>(json_str)?)
+                decode::<Self>(json_str, framing)
             }
             PassFailResult::Fail(cap) => {
                 let json_str = &cap[1];
                 let crc_str = &cap[2];
                 check_crc(json_str, crc_str)?;
-                Err(serde_json::from_str::<Status>(json_str)?)?
+                Err(decode::<Status>(json_str, framing)?)?
             }
         }
     }
@@ -0,0 +1,754 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+//! Binary encoding of ujson messages.
+//!
+//! The encoding is the subset of CBOR (RFC 8949) understood by the device's
+//! ujson library.  Every item starts with a head holding the major type in its
+//! top three bits and an argument in its low five bits or in the 1, 2, 4 or 8
+//! big-endian bytes that follow.  Structs are encoded as arrays of their fields
+//! in declaration order, sequences of `u8` as byte strings, unit variants as
+//! their name and other variants as a single-entry map from their name to
+//! their value.  This mirrors the layout that `ujson_derive.h` generates from
+//! the same declarations as the Rust types.
+
+use serde::de::{self, DeserializeSeed, IntoDeserializer, Visitor};
+use serde::{Deserialize, Serialize, ser};
+use thiserror::Error;
+
+/// Byte sent to the device to switch its ujson session to this encoding.
+pub const BINARY_FRAMING_MARKER: u8 = 0xc1;
+
+const MAJOR_UINT: u8 = 0;
+const MAJOR_NEGINT: u8 = 1;
+const MAJOR_BYTES: u8 = 2;
+const MAJOR_TEXT: u8 = 3;
+const MAJOR_ARRAY: u8 = 4;
+const MAJOR_MAP: u8 = 5;
+const MAJOR_SIMPLE: u8 = 7;
+
+const SIMPLE_FALSE: u64 = 20;
+const SIMPLE_TRUE: u64 = 21;
+const SIMPLE_NULL: u64 = 22;
+
+#[derive(Debug, Error, PartialEq, Eq)]
+pub enum Error {
+    #[error("{0}")]
+    Message(String),
+    #[error("unexpected end of input")]
+    Eof,
+    #[error("unexpected major type {0}")]
+    UnexpectedType(u8),
+    #[error("unsupported head {0:#04x}")]
+    UnsupportedHead(u8),
+    #[error("{0} trailing bytes")]
+    TrailingBytes(usize),
+    #[error("floating point values are not supported")]
+    Float,
+    #[error("maps must have a known length")]
+    MapLength,
+}
+
+impl ser::Error for Error {
+    fn custom<T: std::fmt::Display>(msg: T) -> Self {
+        Error::Message(msg.to_string())
+    }
+}
+
+impl de::Error for Error {
+    fn custom<T: std::fmt::Display>(msg: T) -> Self {
+        Error::Message(msg.to_string())
+    }
+}
+
+/// Serializes `value` into the binary encoding.
+pub fn to_vec<T: Serialize + ?Sized>(value: &T) -> Result<Vec<u8>, Error> {
+    let mut serializer = Serializer::default();
+    value.serialize(&mut serializer)?;
+    Ok(serializer.out)
+}
+
+/// Deserializes a `T` from the binary encoding, which must span all of `bytes`.
+pub fn from_slice<'de, T: Deserialize<'de>>(bytes: &'de [u8]) -> Result<T, Error> {
+    let mut deserializer = Deserializer { input: bytes };
+    let value = T::deserialize(&mut deserializer)?;
+    match deserializer.input.len() {
+        0 => Ok(value),
+        n => Err(Error::TrailingBytes(n)),
+    }
+}
+
+#[derive(Default)]
+pub struct Serializer {
+    out: Vec<u8>,
+    // Set when the serialized value is a single `u8`, so that sequences of
+    // them can be emitted as byte strings.
+    byte: Option<u8>,
+}
+
+impl Serializer {
+    fn head(&mut self, major: u8, value: u64) {
+        let major = major << 5;
+        if value < 24 {
+            self.out.push(major | value as u8);
+        } else if value <= u8::MAX as u64 {
+            self.out.extend_from_slice(&[major | 24, value as u8]);
+        } else if value <= u16::MAX as u64 {
+            self.out.push(major | 25);
+            self.out.extend_from_slice(&(value as u16).to_be_bytes());
+        } else if value <= u32::MAX as u64 {
+            self.out.push(major | 26);
+            self.out.extend_from_slice(&(value as u32).to_be_bytes());
+        } else {
+            self.out.push(major | 27);
+            self.out.extend_from_slice(&value.to_be_bytes());
+        }
+    }
+
+    fn int(&mut self, value: i64) {
+        if value < 0 {
+            self.head(MAJOR_NEGINT, !(value as u64));
+        } else {
+            self.head(MAJOR_UINT, value as u64);
+        }
+    }
+
+    fn variant(&mut self, variant: &str) {
+        self.head(MAJOR_MAP, 1);
+        self.head(MAJOR_TEXT, variant.len() as u64);
+        self.out.extend_from_slice(variant.as_bytes());
+    }
+}
+
+/// Buffers the elements of a sequence until it is known whether they are all
+/// `u8`, in which case they are emitted as a byte string.
+pub struct SeqSerializer<'a> {
+    parent: &'a mut Serializer,
+    items: Vec<u8>,
+    bytes: Vec<u8>,
+    all_bytes: bool,
+    len: u64,
+}
+
+impl SeqSerializer<'_> {
+    fn element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        let mut element = Serializer::default();
+        value.serialize(&mut element)?;
+        match element.byte {
+            Some(b) if self.all_bytes => self.bytes.push(b),
+            _ => self.all_bytes = false,
+        }
+        self.items.extend_from_slice(&element.out);
+        self.len += 1;
+        Ok(())
+    }
+
+    fn finish(self) -> Result<(), Error> {
+        if self.all_bytes && self.len > 0 {
+            self.parent.head(MAJOR_BYTES, self.len);
+            self.parent.out.extend_from_slice(&self.bytes);
+        } else {
+            self.parent.head(MAJOR_ARRAY, self.len);
+            self.parent.out.extend_from_slice(&self.items);
+        }
+        Ok(())
+    }
+}
+
+impl ser::SerializeSeq for SeqSerializer<'_> {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        self.element(value)
+    }
+    fn end(self) -> Result<(), Error> {
+        self.finish()
+    }
+}
+
+impl<'a> ser::Serializer for &'a mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    type SerializeSeq = SeqSerializer<'a>;
+    type SerializeTuple = Self;
+    type SerializeTupleStruct = Self;
+    type SerializeTupleVariant = Self;
+    type SerializeMap = Self;
+    type SerializeStruct = Self;
+    type SerializeStructVariant = Self;
+
+    fn serialize_bool(self, v: bool) -> Result<(), Error> {
+        self.head(MAJOR_SIMPLE, if v { SIMPLE_TRUE } else { SIMPLE_FALSE });
+        Ok(())
+    }
+    fn serialize_i8(self, v: i8) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+    fn serialize_i16(self, v: i16) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+    fn serialize_i32(self, v: i32) -> Result<(), Error> {
+        self.int(v.into());
+        Ok(())
+    }
+    fn serialize_i64(self, v: i64) -> Result<(), Error> {
+        self.int(v);
+        Ok(())
+    }
+    fn serialize_u8(self, v: u8) -> Result<(), Error> {
+        if self.out.is_empty() {
+            self.byte = Some(v);
+        }
+        self.head(MAJOR_UINT, v.into());
+        Ok(())
+    }
+    fn serialize_u16(self, v: u16) -> Result<(), Error> {
+        self.head(MAJOR_UINT, v.into());
+        Ok(())
+    }
+    fn serialize_u32(self, v: u32) -> Result<(), Error> {
+        self.head(MAJOR_UINT, v.into());
+        Ok(())
+    }
+    fn serialize_u64(self, v: u64) -> Result<(), Error> {
+        self.head(MAJOR_UINT, v);
+        Ok(())
+    }
+    fn serialize_f32(self, _v: f32) -> Result<(), Error> {
+        Err(Error::Float)
+    }
+    fn serialize_f64(self, _v: f64) -> Result<(), Error> {
+        Err(Error::Float)
+    }
+    fn serialize_char(self, v: char) -> Result<(), Error> {
+        self.serialize_str(v.encode_utf8(&mut [0u8; 4]))
+    }
+    fn serialize_str(self, v: &str) -> Result<(), Error> {
+        self.head(MAJOR_TEXT, v.len() as u64);
+        self.out.extend_from_slice(v.as_bytes());
+        Ok(())
+    }
+    fn serialize_bytes(self, v: &[u8]) -> Result<(), Error> {
+        self.head(MAJOR_BYTES, v.len() as u64);
+        self.out.extend_from_slice(v);
+        Ok(())
+    }
+    fn serialize_none(self) -> Result<(), Error> {
+        self.serialize_unit()
+    }
+    fn serialize_some<T: Serialize + ?Sized>(self, value: &T) -> Result<(), Error> {
+        value.serialize(self)
+    }
+    fn serialize_unit(self) -> Result<(), Error> {
+        self.head(MAJOR_SIMPLE, SIMPLE_NULL);
+        Ok(())
+    }
+    fn serialize_unit_struct(self, _name: &'static str) -> Result<(), Error> {
+        self.serialize_unit()
+    }
+    fn serialize_unit_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+    ) -> Result<(), Error> {
+        self.serialize_str(variant)
+    }
+    fn serialize_newtype_struct<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        value.serialize(self)
+    }
+    fn serialize_newtype_variant<T: Serialize + ?Sized>(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        self.variant(variant);
+        value.serialize(self)
+    }
+    fn serialize_seq(self, _len: Option<usize>) -> Result<SeqSerializer<'a>, Error> {
+        Ok(SeqSerializer {
+            parent: self,
+            items: Vec::new(),
+            bytes: Vec::new(),
+            all_bytes: true,
+            len: 0,
+        })
+    }
+    fn serialize_tuple(self, len: usize) -> Result<Self, Error> {
+        self.head(MAJOR_ARRAY, len as u64);
+        Ok(self)
+    }
+    fn serialize_tuple_struct(self, _name: &'static str, len: usize) -> Result<Self, Error> {
+        self.serialize_tuple(len)
+    }
+    fn serialize_tuple_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Self, Error> {
+        self.variant(variant);
+        self.serialize_tuple(len)
+    }
+    fn serialize_map(self, len: Option<usize>) -> Result<Self, Error> {
+        self.head(MAJOR_MAP, len.ok_or(Error::MapLength)? as u64);
+        Ok(self)
+    }
+    fn serialize_struct(self, _name: &'static str, len: usize) -> Result<Self, Error> {
+        self.serialize_tuple(len)
+    }
+    fn serialize_struct_variant(
+        self,
+        _name: &'static str,
+        _index: u32,
+        variant: &'static str,
+        len: usize,
+    ) -> Result<Self, Error> {
+        self.variant(variant);
+        self.serialize_tuple(len)
+    }
+}
+
+impl ser::SerializeTuple for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_element<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTupleStruct for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeTupleVariant for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeMap for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_key<T: Serialize + ?Sized>(&mut self, key: &T) -> Result<(), Error> {
+        key.serialize(&mut **self)
+    }
+    fn serialize_value<T: Serialize + ?Sized>(&mut self, value: &T) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStruct for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+impl ser::SerializeStructVariant for &mut Serializer {
+    type Ok = ();
+    type Error = Error;
+    fn serialize_field<T: Serialize + ?Sized>(
+        &mut self,
+        _key: &'static str,
+        value: &T,
+    ) -> Result<(), Error> {
+        value.serialize(&mut **self)
+    }
+    fn end(self) -> Result<(), Error> {
+        Ok(())
+    }
+}
+
+pub struct Deserializer<'de> {
+    input: &'de [u8],
+}
+
+impl<'de> Deserializer<'de> {
+    fn peek(&self) -> Result<u8, Error> {
+        self.input.first().map(|b| b >> 5).ok_or(Error::Eof)
+    }
+
+    fn take(&mut self, len: usize) -> Result<&'de [u8], Error> {
+        if self.input.len() < len {
+            return Err(Error::Eof);
+        }
+        let (head, rest) = self.input.split_at(len);
+        self.input = rest;
+        Ok(head)
+    }
+
+    fn head(&mut self, major: u8) -> Result<u64, Error> {
+        let head = *self.input.first().ok_or(Error::Eof)?;
+        if head >> 5 != major {
+            return Err(Error::UnexpectedType(head >> 5));
+        }
+        self.input = &self.input[1..];
+        let len = match head & 0x1f {
+            info @ 0..=23 => return Ok(info.into()),
+            info @ 24..=27 => 1 << (info - 24),
+            _ => return Err(Error::UnsupportedHead(head)),
+        };
+        Ok(self
+            .take(len)?
+            .iter()
+            .fold(0, |value, &b| (value << 8) | u64::from(b)))
+    }
+
+    fn len(&mut self, major: u8) -> Result<usize, Error> {
+        let len = self.head(major)?;
+        usize::try_from(len).map_err(|_| Error::Eof)
+    }
+
+    fn text(&mut self) -> Result<&'de str, Error> {
+        let len = self.len(MAJOR_TEXT)?;
+        std::str::from_utf8(self.take(len)?).map_err(|e| Error::Message(e.to_string()))
+    }
+}
+
+struct Elements<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+    remaining: usize,
+}
+
+impl<'de> de::SeqAccess<'de> for Elements<'_, 'de> {
+    type Error = Error;
+    fn next_element_seed<T: DeserializeSeed<'de>>(
+        &mut self,
+        seed: T,
+    ) -> Result<Option<T::Value>, Error> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+impl<'de> de::MapAccess<'de> for Elements<'_, 'de> {
+    type Error = Error;
+    fn next_key_seed<K: DeserializeSeed<'de>>(
+        &mut self,
+        seed: K,
+    ) -> Result<Option<K::Value>, Error> {
+        if self.remaining == 0 {
+            return Ok(None);
+        }
+        self.remaining -= 1;
+        seed.deserialize(&mut *self.de).map(Some)
+    }
+    fn next_value_seed<V: DeserializeSeed<'de>>(&mut self, seed: V) -> Result<V::Value, Error> {
+        seed.deserialize(&mut *self.de)
+    }
+    fn size_hint(&self) -> Option<usize> {
+        Some(self.remaining)
+    }
+}
+
+struct Variant<'a, 'de> {
+    de: &'a mut Deserializer<'de>,
+}
+
+impl<'a, 'de> de::EnumAccess<'de> for Variant<'a, 'de> {
+    type Error = Error;
+    type Variant = Self;
+    fn variant_seed<V: DeserializeSeed<'de>>(self, seed: V) -> Result<(V::Value, Self), Error> {
+        let variant = seed.deserialize(&mut *self.de)?;
+        Ok((variant, self))
+    }
+}
+
+impl<'de> de::VariantAccess<'de> for Variant<'_, 'de> {
+    type Error = Error;
+    fn unit_variant(self) -> Result<(), Error> {
+        de::Deserialize::deserialize(self.de)
+    }
+    fn newtype_variant_seed<T: DeserializeSeed<'de>>(self, seed: T) -> Result<T::Value, Error> {
+        seed.deserialize(self.de)
+    }
+    fn tuple_variant<V: Visitor<'de>>(self, _len: usize, visitor: V) -> Result<V::Value, Error> {
+        de::Deserializer::deserialize_seq(self.de, visitor)
+    }
+    fn struct_variant<V: Visitor<'de>>(
+        self,
+        _fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        de::Deserializer::deserialize_seq(self.de, visitor)
+    }
+}
+
+impl<'de> de::Deserializer<'de> for &mut Deserializer<'de> {
+    type Error = Error;
+
+    fn deserialize_any<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        match self.peek()? {
+            MAJOR_UINT => visitor.visit_u64(self.head(MAJOR_UINT)?),
+            MAJOR_NEGINT => {
+                let value = self.head(MAJOR_NEGINT)?;
+                match i64::try_from(value) {
+                    Ok(value) => visitor.visit_i64(-1 - value),
+                    Err(_) => Err(de::Error::invalid_value(
+                        de::Unexpected::Other("negative integer below i64::MIN"),
+                        &visitor,
+                    )),
+                }
+            }
+            MAJOR_BYTES => {
+                let len = self.len(MAJOR_BYTES)?;
+                visitor.visit_borrowed_bytes(self.take(len)?)
+            }
+            MAJOR_TEXT => visitor.visit_borrowed_str(self.text()?),
+            MAJOR_ARRAY => self.deserialize_seq(visitor),
+            MAJOR_MAP => self.deserialize_map(visitor),
+            MAJOR_SIMPLE => match self.head(MAJOR_SIMPLE)? {
+                SIMPLE_FALSE => visitor.visit_bool(false),
+                SIMPLE_TRUE => visitor.visit_bool(true),
+                SIMPLE_NULL => visitor.visit_unit(),
+                _ => Err(Error::Float),
+            },
+            major => Err(Error::UnexpectedType(major)),
+        }
+    }
+
+    fn deserialize_option<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        if self.input.first() == Some(&(MAJOR_SIMPLE << 5 | SIMPLE_NULL as u8)) {
+            self.input = &self.input[1..];
+            visitor.visit_none()
+        } else {
+            visitor.visit_some(self)
+        }
+    }
+
+    fn deserialize_seq<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        if self.peek()? == MAJOR_BYTES {
+            // Byte strings stand in for sequences of `u8`.
+            let len = self.len(MAJOR_BYTES)?;
+            let bytes = self.take(len)?;
+            return visitor.visit_seq(de::value::SeqDeserializer::<_, Error>::new(
+                bytes.iter().copied(),
+            ));
+        }
+        let remaining = self.len(MAJOR_ARRAY)?;
+        visitor.visit_seq(Elements {
+            de: self,
+            remaining,
+        })
+    }
+
+    fn deserialize_tuple<V: Visitor<'de>>(
+        self,
+        _len: usize,
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        self.deserialize_seq(visitor)
+    }
+
+    fn deserialize_tuple_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _len: usize,
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        self.deserialize_seq(visitor)
+    }
+
+    fn deserialize_map<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        let remaining = self.len(MAJOR_MAP)?;
+        visitor.visit_map(Elements {
+            de: self,
+            remaining,
+        })
+    }
+
+    fn deserialize_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _fields: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        self.deserialize_seq(visitor)
+    }
+
+    fn deserialize_enum<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        _variants: &'static [&'static str],
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        if self.peek()? == MAJOR_TEXT {
+            visitor.visit_enum(self.text()?.into_deserializer())
+        } else {
+            if self.head(MAJOR_MAP)? != 1 {
+                return Err(de::Error::invalid_length(1, &visitor));
+            }
+            visitor.visit_enum(Variant { de: self })
+        }
+    }
+
+    fn deserialize_unit<V: Visitor<'de>>(self, visitor: V) -> Result<V::Value, Error> {
+        if self.head(MAJOR_SIMPLE)? != SIMPLE_NULL {
+            return Err(Error::UnexpectedType(MAJOR_SIMPLE));
+        }
+        visitor.visit_unit()
+    }
+
+    fn deserialize_unit_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        self.deserialize_unit(visitor)
+    }
+
+    fn deserialize_newtype_struct<V: Visitor<'de>>(
+        self,
+        _name: &'static str,
+        visitor: V,
+    ) -> Result<V::Value, Error> {
+        visitor.visit_newtype_struct(self)
+    }
+
+    serde::forward_to_deserialize_any! {
+        bool i8 i16 i32 i64 i128 u8 u16 u32 u64 u128 f32 f64 char str string
+        bytes byte_buf identifier ignored_any
+    }
+}
+
+#[cfg(test)]
+mod test {
+    use super::*;
+    use crate::test_utils::status::Status;
+    use serde::{Deserialize, Serialize};
+
+    #[derive(Debug, Serialize, Deserialize, PartialEq, Eq)]
+    struct Foo {
+        foo: i32,
+        bar: u32,
+        message: String,
+    }
+
+    #[derive(Debug, Serialize, Deserialize, PartialEq, Eq)]
+    struct Blob {
+        id: u16,
+        data: arrayvec::ArrayVec<u8, 16>,
+    }
+
+    #[derive(Debug, Serialize, Deserialize, PartialEq, Eq)]
+    enum Direction {
+        North,
+        East,
+        IntValue(u32),
+    }
+
+    #[test]
+    fn test_foo() -> Result<(), Error> {
+        // Matches the output of the device for the same struct.
+        let foo = Foo {
+            foo: -5,
+            bar: 150000,
+            message: "Kilroy was here".into(),
+        };
+        let bytes = to_vec(&foo)?;
+        assert_eq!(
+            hex::encode(&bytes),
+            "83241a000249f06f4b696c726f79207761732068657265"
+        );
+        assert_eq!(from_slice::<Foo>(&bytes)?, foo);
+        Ok(())
+    }
+
+    #[test]
+    fn test_bytes() -> Result<(), Error> {
+        let blob = Blob {
+            id: 0x1234,
+            data: [0xde, 0xad, 0xbe, 0xef].iter().copied().collect(),
+        };
+        let bytes = to_vec(&blob)?;
+        assert_eq!(hex::encode(&bytes), "8219123444deadbeef");
+        assert_eq!(from_slice::<Blob>(&bytes)?, blob);
+
+        // Arrays of numbers are accepted as well.
+        let array = hex::decode("82191234821218de").unwrap();
+        assert_eq!(from_slice::<Blob>(&array)?.data[..], [0x12, 0xde]);
+
+        // Sequences of wider integers stay arrays.
+        assert_eq!(hex::encode(to_vec(&vec![1u16, 2])?), "820102");
+        assert_eq!(hex::encode(to_vec(&Vec::<u8>::new())?), "80");
+        Ok(())
+    }
+
+    #[test]
+    fn test_enums() -> Result<(), Error> {
+        assert_eq!(hex::encode(to_vec(&Direction::East)?), "6445617374");
+        assert_eq!(
+            hex::encode(to_vec(&Direction::IntValue(120))?),
+            "a168496e7456616c75651878"
+        );
+        for d in [Direction::North, Direction::IntValue(35)] {
+            assert_eq!(from_slice::<Direction>(&to_vec(&d)?)?, d);
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_status() -> Result<(), Error> {
+        assert_eq!(hex::encode(to_vec(&Status::Ok(1234))?), "a1624f6b1904d2");
+        let status = Status::InvalidArgument("FOO".into(), 77);
+        assert_eq!(from_slice::<Status>(&to_vec(&status)?)?, status);
+        Ok(())
+    }
+
+    #[test]
+    fn test_integers() -> Result<(), Error> {
+        assert_eq!(hex::encode(to_vec(&i64::MIN)?), "3b7fffffffffffffff");
+        assert_eq!(from_slice::<i64>(&to_vec(&i64::MIN)?)?, i64::MIN);
+        assert_eq!(from_slice::<i8>(&to_vec(&-2i8)?)?, -2);
+        assert_eq!(from_slice::<u64>(&to_vec(&u64::MAX)?)?, u64::MAX);
+        assert!(from_slice::<u8>(&to_vec(&256u32)?).is_err());
+        assert_eq!(
+            from_slice::<u8>(&[0x01, 0x02]),
+            Err(Error::TrailingBytes(1))
+        );
+        Ok(())
+    }
+}
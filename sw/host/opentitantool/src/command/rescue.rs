@@ -55,6 +55,12 @@ pub struct Firmware {
         help = "Render unbootable the slot not being programmed"
     )]
     erase_other_slot: bool,
+    #[arg(
+        long,
+        default_value_t = false,
+        help = "Stream the upload without per-frame acknowledgements (XMODEM-G)"
+    )]
+    streaming: bool,
     #[arg(
         long,
         default_value_t = true,
@@ -110,7 +116,11 @@ impl CommandDispatch for Firmware {
                 rescue.update_firmware(BootSlot::SlotB, &vec![0xFF; 2048])?;
             }
         }
-        rescue.update_firmware(self.slot, payload)?;
+        if self.streaming {
+            rescue.update_firmware_streaming(self.slot, payload)?;
+        } else {
+            rescue.update_firmware(self.slot, payload)?;
+        }
         if self.rate.is_some() {
             rescue.set_baud(prev_baudrate)?;
         }
@@ -0,0 +1,159 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Collects the results of `//sw/device/tests/crypto:cryptolib_perftest` and
+// compares them against a baseline written by an earlier run with `--output`.
+
+use std::fs;
+use std::path::PathBuf;
+use std::time::Duration;
+
+use anyhow::{Result, bail};
+use clap::Parser;
+
+use opentitanlib::io::console::ConsoleDevice;
+use opentitanlib::test_utils::init::InitializeTest;
+use opentitanlib::test_utils::rpc::ConsoleRecv;
+use opentitanlib::uart::console::UartConsole;
+
+mod cryptolib_bench;
+use cryptolib_bench::CryptolibBenchResult;
+
+#[derive(Debug, Parser)]
+struct Opts {
+    #[command(flatten)]
+    init: InitializeTest,
+
+    /// Console receive timeout; the results are only sent once all
+    /// benchmarks have run.
+    #[arg(long, value_parser = humantime::parse_duration, default_value = "7200s")]
+    timeout: Duration,
+
+    /// Results of a previous run to compare against.
+    #[arg(long)]
+    baseline: Option<PathBuf>,
+
+    /// Allowed increase of the mean cycle count over the baseline, in percent.
+    #[arg(long, default_value = "5")]
+    tolerance: f64,
+
+    /// File to write the results to, in the format expected by `--baseline`.
+    #[arg(long)]
+    output: Option<PathBuf>,
+}
+
+fn describe(result: &CryptolibBenchResult) -> String {
+    if result.bytes == 0 {
+        result.primitive.clone()
+    } else {
+        format!("{}/{}", result.primitive, result.bytes)
+    }
+}
+
+fn receive_results<T>(opts: &Opts, uart: &T) -> Result<Vec<CryptolibBenchResult>>
+where
+    T: ConsoleDevice + ?Sized,
+{
+    let mut results = Vec::new();
+    loop {
+        let result = CryptolibBenchResult::recv(uart, opts.timeout, true)?;
+        if result.index as usize != results.len() {
+            bail!("expected result {}, got {}", results.len(), result.index);
+        }
+        let num_results = result.num_results as usize;
+        results.push(result);
+        if results.len() >= num_results {
+            return Ok(results);
+        }
+    }
+}
+
+fn report(results: &[CryptolibBenchResult]) {
+    log::info!(
+        "{:<28} {:>6} {:>12} {:>12} {:>12} {:>10}",
+        "primitive",
+        "runs",
+        "min",
+        "mean",
+        "max",
+        "cycles/B"
+    );
+    for result in results {
+        let per_byte = if result.bytes == 0 {
+            "-".to_string()
+        } else {
+            format!("{:.3}", result.millicycles_per_byte as f64 / 1000.0)
+        };
+        log::info!(
+            "{:<28} {:>6} {:>12} {:>12} {:>12} {:>10}",
+            describe(result),
+            result.runs,
+            result.min_cycles,
+            result.mean_cycles,
+            result.max_cycles,
+            per_byte
+        );
+    }
+}
+
+/// Returns the descriptions of the results whose mean cycle count exceeds the
+/// baseline by more than `tolerance` percent.
+fn regressions(
+    results: &[CryptolibBenchResult],
+    baseline: &[CryptolibBenchResult],
+    tolerance: f64,
+) -> Vec<String> {
+    let mut regressions = Vec::new();
+    for result in results {
+        let Some(base) = baseline
+            .iter()
+            .find(|b| b.primitive == result.primitive && b.bytes == result.bytes)
+        else {
+            log::warn!("{}: not in baseline", describe(result));
+            continue;
+        };
+        let change = (result.mean_cycles as f64 / base.mean_cycles.max(1) as f64 - 1.0) * 100.0;
+        log::info!(
+            "{}: {} -> {} cycles ({:+.2}%)",
+            describe(result),
+            base.mean_cycles,
+            result.mean_cycles,
+            change
+        );
+        if change > tolerance {
+            regressions.push(format!("{} ({:+.2}%)", describe(result), change));
+        }
+    }
+    regressions
+}
+
+fn main() -> Result<()> {
+    let opts = Opts::parse();
+    opts.init.init_logging();
+    let transport = opts.init.init_target()?;
+    let uart = transport.uart("console")?;
+    let _ = UartConsole::wait_for(&*uart, r"Running ", opts.timeout)?;
+
+    let results = receive_results(&opts, &*uart)?;
+    let _ = UartConsole::wait_for(&*uart, r"PASS!", opts.timeout)?;
+    report(&results);
+
+    if let Some(output) = &opts.output {
+        fs::write(output, serde_json::to_string_pretty(&results)?)?;
+    }
+    if let Some(baseline) = &opts.baseline {
+        let baseline: Vec<CryptolibBenchResult> =
+            serde_json::from_str(&fs::read_to_string(baseline)?)?;
+        let regressions = regressions(&results, &baseline, opts.tolerance);
+        if !regressions.is_empty() {
+            bail!(
+                "{} result(s) slower than the baseline by more than {}%: {}",
+                regressions.len(),
+                opts.tolerance,
+                regressions.join(", ")
+            );
+        }
+    }
+    Ok(())
+}
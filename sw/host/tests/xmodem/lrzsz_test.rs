@@ -131,6 +131,41 @@ November 19, 1863
         Ok(())
     }
 
+    #[test]
+    fn test_xmodem_g_recv() -> Result<()> {
+        let filename = tmpfilename("test_xmodem_g_recv");
+        let gettysburg = GETTYSBURG.as_bytes();
+        std::fs::write(&filename, gettysburg)?;
+        let child = ChildConsole::spawn(&["sx", "--1k", &filename])?;
+        let xmodem = XmodemFirmware::new();
+        let mut result = Vec::new();
+        xmodem.receive_streaming(&child, &mut result)?;
+        assert!(child.wait()?.success());
+        assert_eq!(result.len() % 128, 0);
+        assert!(result.len() >= gettysburg.len());
+        assert_eq!(&result[..gettysburg.len()], gettysburg);
+        Ok(())
+    }
+
+    #[test]
+    fn test_xmodem_g_recv_with_errors() -> Result<()> {
+        let filename = tmpfilename("test_xmodem_g_recv_with_errors");
+        let gettysburg = GETTYSBURG.as_bytes();
+        std::fs::write(&filename, gettysburg)?;
+        let child = ChildConsole::spawn_corrupt(
+            &["sx", "--1k", &filename],
+            TransferState::new(&[1032]),
+            TransferState::default(),
+        )?;
+        let xmodem = XmodemFirmware::new();
+        let mut result = Vec::new();
+        // Streaming has no retransmissions: the first error cancels.
+        let err = xmodem.receive_streaming(&child, &mut result);
+        assert!(err.is_err());
+        assert_eq!(err.unwrap_err().to_string(), "Crc");
+        Ok(())
+    }
+
     #[test]
     fn test_xmodem_recv_with_errors() -> Result<()> {
         let filename = tmpfilename("test_xmodem_recv_with_errors");
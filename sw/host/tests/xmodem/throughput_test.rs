@@ -0,0 +1,101 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures how many firmware images per minute the rescue protocol can receive
+// with XMODEM-1K and with XMODEM-G, using the firmware's C implementation as
+// the receiver and `sx` from the lrzsz package as the sender.
+//
+// The child process is connected through pipes, which are much faster than the
+// UART used by rescue.  `UartLink` models the UART by charging the time each
+// byte takes on the wire plus a fixed turnaround latency every time the
+// receiver has to talk back to the sender, as is the case for every ACK in
+// XMODEM-1K.
+//
+// Run with `--nocapture` to see the results.
+#[cfg(test)]
+mod test {
+    use std::task::{Context, Poll};
+    use std::time::{Duration, Instant};
+
+    use anyhow::Result;
+    use opentitanlib::io::console::ConsoleDevice;
+    use opentitanlib::util::testing::ChildConsole;
+    use opentitanlib::util::tmpfilename;
+    use xmodem::XmodemFirmware;
+
+    // The fastest rate supported by rescue.
+    const BAUD: u64 = 1_500_000;
+    // Latency of a direction change on a USB-UART bridge.
+    const TURNAROUND: Duration = Duration::from_millis(1);
+    const IMAGE_SIZE: usize = 256 * 1024;
+
+    struct UartLink<'a> {
+        inner: &'a ChildConsole,
+    }
+
+    impl UartLink<'_> {
+        fn charge(&self, bytes: usize) {
+            // 10 bits per byte: start, 8 data and stop.
+            std::thread::sleep(Duration::from_nanos(
+                bytes as u64 * 10 * 1_000_000_000 / BAUD,
+            ));
+        }
+    }
+
+    impl ConsoleDevice for UartLink<'_> {
+        fn poll_read(&self, cx: &mut Context<'_>, buf: &mut [u8]) -> Poll<Result<usize>> {
+            let result = self.inner.poll_read(cx, buf);
+            if let Poll::Ready(Ok(n)) = result {
+                self.charge(n);
+            }
+            result
+        }
+
+        fn write(&self, buf: &[u8]) -> Result<()> {
+            std::thread::sleep(TURNAROUND);
+            self.charge(buf.len());
+            self.inner.write(buf)
+        }
+    }
+
+    fn image() -> Vec<u8> {
+        (0..IMAGE_SIZE).map(|i| (i ^ (i >> 8)) as u8).collect()
+    }
+
+    fn measure(name: &str, streaming: bool) -> Result<f64> {
+        let filename = tmpfilename(name);
+        let image = image();
+        std::fs::write(&filename, &image)?;
+        let child = ChildConsole::spawn(&["sx", "--1k", &filename])?;
+        let link = UartLink { inner: &child };
+        let xmodem = XmodemFirmware { max_errors: 2 };
+        let mut result = Vec::new();
+
+        let start = Instant::now();
+        if streaming {
+            xmodem.receive_streaming(&link, &mut result)?;
+        } else {
+            xmodem.receive(&link, &mut result)?;
+        }
+        let elapsed = start.elapsed();
+
+        assert!(child.wait()?.success());
+        assert_eq!(&result[..image.len()], image.as_slice());
+        let images_per_minute = 60.0 / elapsed.as_secs_f64();
+        println!(
+            "{name}: {IMAGE_SIZE} bytes in {elapsed:?} at {BAUD} baud: {images_per_minute:.2} images/minute"
+        );
+        Ok(images_per_minute)
+    }
+
+    #[test]
+    fn test_throughput() -> Result<()> {
+        let acked = measure("xmodem1k", false)?;
+        let streamed = measure("xmodem_g", true)?;
+        // Timings depend on the load of the machine, so they are only
+        // reported. The transfers themselves are checked by `measure`.
+        println!("xmodem_g/xmodem1k: {:.2}x", streamed / acked);
+        Ok(())
+    }
+}
@@ -118,6 +118,85 @@ impl XmodemFirmware {
     }
 }
 
+impl XmodemFirmware {
+    /// Receives data using the firmware's XMODEM-G implementation.
+    ///
+    /// Frames are handed out in chunks by `xmodem_recv_frame_chunked` just like
+    /// the firmware programs them into flash, and are not acknowledged.  Any
+    /// error cancels the transfer.
+    pub fn receive_streaming(&self, console: &dyn ConsoleDevice, data: &mut Vec<u8>) -> Result<()> {
+        // SAFETY:
+        // `iohandle` is a valid reference to a `dyn Uart` trait object.
+        let io = unsafe {
+            let io = (&console as *const &dyn ConsoleDevice) as *mut c_void;
+            xmodem_recv_start_streaming(io);
+            io
+        };
+
+        let mut frame = 1u32;
+        let mut buf = [0u8; 1024];
+        let mut rxlen = 0usize;
+        let mut unknown_rx = 0u8;
+        let mut chunks = Vec::new();
+
+        loop {
+            // SAFETY:
+            // `iohandle` is a valid reference to a `dyn Uart` trait object.
+            // `buf` points to a valid buffer whose size is large enough since
+            // `xmodem_recv_frame_chunked` will only read 128 or 1024 byte frames.
+            // `rxlen` and `unknown_rx` are valid pointers as they come from refs.
+            // `chunks` outlives the call and is only accessed by `collect_chunk`.
+            let result = unsafe {
+                XmodemResult(xmodem_recv_frame_chunked(
+                    io,
+                    frame,
+                    buf.as_mut_ptr(),
+                    &mut rxlen as *mut usize,
+                    &mut unknown_rx as *mut u8,
+                    Some(collect_chunk),
+                    &mut chunks as *mut Vec<u8> as *mut c_void,
+                ))
+            };
+
+            // SAFETY:
+            // `iohandle` is a valid reference to a `dyn Uart` trait object.
+            unsafe {
+                match result {
+                    XmodemResult::Ok => {
+                        data.append(&mut chunks);
+                        frame += 1;
+                    }
+                    XmodemResult::EndOfFile => {
+                        xmodem_ack(io, true);
+                        return Ok(());
+                    }
+                    XmodemResult::Cancel => return Err(anyhow!("{}", result)),
+                    _ => {
+                        xmodem_cancel(io);
+                        return Err(anyhow!("{}", result));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Collects the chunks handed out by `xmodem_recv_frame_chunked`.
+///
+/// # SAFETY:
+///
+/// * `ctx` must be a valid pointer to a `Vec<u8>`.
+/// * `data` must be valid for `len` bytes.
+unsafe extern "C" fn collect_chunk(ctx: *mut c_void, data: *const u8, len: usize) -> u32 {
+    // SAFETY: It's a precondition of this function that `ctx` points to a `Vec<u8>`
+    // and that `data` is valid for `len`.
+    unsafe {
+        let chunks = &mut *(ctx as *mut Vec<u8>);
+        chunks.extend_from_slice(std::slice::from_raw_parts(data, len));
+    }
+    rom_error_kErrorOk
+}
+
 /// The xmodem_{read,write} functions provide the interface to the low-level C implementation to
 /// interact with the `Uart` device provided to the `XmodemFirmware` struct.
 ///
@@ -142,13 +221,19 @@ unsafe extern "C" fn xmodem_read(
 
     // SAFETY: It's a precondition of this function that `data` is valid for `len`.
     let data = unsafe { std::slice::from_raw_parts_mut(data, len) };
-    match console.read(data) {
-        Ok(n) => n,
-        Err(e) => {
-            eprintln!("xmodem_read: {e:?}");
-            0
+    // Like `uart_read` in firmware, keep reading until `len` bytes arrived.
+    let mut total = 0;
+    while total < len {
+        match console.read(&mut data[total..]) {
+            Ok(0) => break,
+            Ok(n) => total += n,
+            Err(e) => {
+                eprintln!("xmodem_read: {e:?}");
+                break;
+            }
         }
     }
+    total
 }
 
 /// # SAFETY
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Reference client for the DPI hub of the Verilator simulations.
+
+The protocol is described in hw/dv/dpi/common/dpi_hub/dpi_hub.h. Without a
+channel, the channels of the simulation are listed. With a channel, it is
+connected to stdin and stdout, like the endpoint the channel replaces.
+"""
+
+import argparse
+import logging as log
+import os
+import select
+import socket
+import struct
+import sys
+import time
+from typing import Dict, Optional
+
+FRAME_DATA = 0
+FRAME_CREDIT = 1
+FRAME_CHANNEL = 2
+FRAME_CLOSE = 3
+
+HEADER = struct.Struct("<HBBI")
+
+
+def pack_frame(channel: int, frame_type: int, payload: bytes = b"") -> bytes:
+    """Return a frame of `frame_type` with `payload` on `channel`."""
+    return HEADER.pack(channel, frame_type, 0, len(payload)) + payload
+
+
+class DpiHubClient:
+    """A connection to the DPI hub.
+
+    Frames are received by `poll()`, which `send()` and `recv()` call as
+    needed. Data to the simulation never exceeds the credit of its channel.
+    """
+
+    def __init__(self, path: str, timeout: float = 10.0):
+        self.timeout = timeout
+        self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.sock.connect(path)
+        self.connected = True
+        self.channels: Dict[str, int] = {}
+        self.names: Dict[int, str] = {}
+        self.credit: Dict[int, int] = {}
+        self.data: Dict[int, bytearray] = {}
+        self.closed: Dict[int, bool] = {}
+        self._buf = bytearray()
+
+    def close(self) -> None:
+        self.sock.close()
+        self.connected = False
+
+    def _deadline(self, timeout: Optional[float]) -> float:
+        return time.monotonic() + (self.timeout if timeout is None else timeout)
+
+    def _handle(self, channel: int, frame_type: int, payload: bytes) -> None:
+        if frame_type == FRAME_CHANNEL:
+            name = payload.decode()
+            self.channels[name] = channel
+            self.names[channel] = name
+            self.credit[channel] = 0
+            self.data.setdefault(channel, bytearray())
+            self.closed[channel] = False
+        elif frame_type == FRAME_CREDIT:
+            (credit, ) = struct.unpack("<I", payload)
+            self.credit[channel] = self.credit.get(channel, 0) + credit
+        elif frame_type == FRAME_DATA:
+            self.data.setdefault(channel, bytearray()).extend(payload)
+        elif frame_type == FRAME_CLOSE:
+            self.closed[channel] = True
+            self.credit[channel] = 0
+
+    def poll(self, timeout: float = 0.0) -> bool:
+        """Process the frames received within `timeout` seconds.
+
+        Returns:
+            False if the hub closed the connection.
+        """
+        if not self.connected:
+            return False
+        ready, _, _ = select.select([self.sock], [], [], timeout)
+        if not ready:
+            return True
+        chunk = self.sock.recv(65536)
+        if not chunk:
+            self.connected = False
+            return False
+        self._buf.extend(chunk)
+        while len(self._buf) >= HEADER.size:
+            channel, frame_type, _, length = HEADER.unpack_from(self._buf)
+            if len(self._buf) < HEADER.size + length:
+                break
+            payload = bytes(self._buf[HEADER.size:HEADER.size + length])
+            del self._buf[:HEADER.size + length]
+            self._handle(channel, frame_type, payload)
+        return True
+
+    def wait_channel(self, name: str, timeout: Optional[float] = None) -> int:
+        """Return the id of channel `name` once it has been announced."""
+        deadline = self._deadline(timeout)
+        while name not in self.channels:
+            if time.monotonic() > deadline:
+                raise TimeoutError(f"Channel {name} was not announced")
+            if not self.poll(0.01):
+                raise ConnectionError("The hub closed the connection")
+        return self.channels[name]
+
+    def send(self, name: str, data: bytes,
+             timeout: Optional[float] = None) -> None:
+        """Send `data` on channel `name`, as the credit of the channel allows.
+        """
+        channel = self.wait_channel(name, timeout)
+        deadline = self._deadline(timeout)
+        pos = 0
+        while pos < len(data):
+            num = min(self.credit[channel], len(data) - pos)
+            if num:
+                self.sock.sendall(
+                    pack_frame(channel, FRAME_DATA, data[pos:pos + num]))
+                self.credit[channel] -= num
+                pos += num
+                continue
+            if self.closed[channel]:
+                raise ConnectionError(f"Channel {name} was closed")
+            if time.monotonic() > deadline:
+                raise TimeoutError(f"No credit on channel {name}")
+            if not self.poll(0.01):
+                raise ConnectionError("The hub closed the connection")
+
+    def recv(self, name: str, size: int,
+             timeout: Optional[float] = None) -> bytes:
+        """Return `size` bytes received on channel `name`."""
+        channel = self.wait_channel(name, timeout)
+        deadline = self._deadline(timeout)
+        buf = self.data[channel]
+        while len(buf) < size:
+            if time.monotonic() > deadline:
+                raise TimeoutError(f"Received {len(buf)} of {size} bytes "
+                                   f"on channel {name}")
+            if not self.poll(0.01):
+                raise ConnectionError("The hub closed the connection")
+        data = bytes(buf[:size])
+        del buf[:size]
+        return data
+
+
+def bridge(client: DpiHubClient, name: str) -> None:
+    """Connect channel `name` to stdin and stdout until either side closes."""
+    channel = client.wait_channel(name)
+    stdin = sys.stdin.buffer.raw
+    stdout = sys.stdout.buffer
+    stdin_open = True
+    while client.connected and not client.closed[channel]:
+        fds = [client.sock, stdin] if stdin_open else [client.sock]
+        ready, _, _ = select.select(fds, [], [])
+        if stdin in ready:
+            data = os.read(stdin.fileno(), max(client.credit[channel], 1))
+            if data:
+                client.send(name, data)
+            else:
+                stdin_open = False
+        if client.sock in ready:
+            client.poll()
+            if client.data[channel]:
+                stdout.write(client.data[channel])
+                stdout.flush()
+                client.data[channel].clear()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("socket", help="Socket of the DPI hub")
+    parser.add_argument("channel", nargs="?",
+                        help="Channel to connect to stdin and stdout")
+    args = parser.parse_args()
+
+    log.basicConfig(format="%(levelname)s: %(message)s")
+    try:
+        client = DpiHubClient(args.socket)
+    except OSError as e:
+        log.error(f"Unable to connect to {args.socket}: {e}")
+        return 1
+
+    try:
+        if args.channel:
+            bridge(client, args.channel)
+        else:
+            # The channels are announced right after connecting.
+            end = time.monotonic() + 0.5
+            while time.monotonic() < end and client.poll(0.05):
+                pass
+            for name, channel in sorted(client.channels.items(),
+                                        key=lambda c: c[1]):
+                print(f"{channel}: {name}")
+    except (ConnectionError, TimeoutError) as e:
+        log.error(e)
+        return 1
+    finally:
+        client.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,166 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Tests of the DPI hub protocol, against the hub of dpi_hub_echo."""
+
+import os
+import socket
+import subprocess
+import tempfile
+import time
+import unittest
+from pathlib import Path
+
+from dpi_hub_client import (FRAME_CHANNEL, FRAME_CREDIT, FRAME_DATA, HEADER,
+                            DpiHubClient, pack_frame)
+
+# The credit of a channel whose buffer is empty, DPI_HUB_RX_BYTES in dpi_hub.c
+RX_BYTES = 4096
+
+ECHO_BIN = os.environ.get("DPI_HUB_ECHO",
+                          str(Path(__file__).parent / "dpi_hub_echo"))
+
+
+class TestDpiHub(unittest.TestCase):
+
+    def setUp(self):
+        self.tmpdir = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.tmpdir.name, "hub.sock")
+        self.proc = subprocess.Popen([ECHO_BIN],
+                                     env=dict(os.environ,
+                                              DPI_HUB_SOCKET=self.path),
+                                     stdout=subprocess.DEVNULL)
+        deadline = time.monotonic() + 10
+        while not os.path.exists(self.path):
+            self.assertLess(time.monotonic(), deadline,
+                            "The hub did not create its socket")
+            time.sleep(0.01)
+        self.client = self.connect()
+
+    def tearDown(self):
+        self.client.close()
+        if self.proc.poll() is None:
+            self.proc.kill()
+        self.proc.wait()
+        self.tmpdir.cleanup()
+
+    def connect(self) -> DpiHubClient:
+        # The hub rejects a new client until it noticed that the previous one
+        # disconnected.
+        deadline = time.monotonic() + 5
+        while True:
+            client = DpiHubClient(self.path)
+            try:
+                for name in ["echo", "sink", "ctrl"]:
+                    client.wait_channel(name)
+                break
+            except ConnectionError:
+                client.close()
+                self.assertLess(time.monotonic(), deadline)
+                time.sleep(0.01)
+        # The CREDIT frame follows the CHANNEL frame in the same pass.
+        client.poll(0.1)
+        return client
+
+    def test_announce(self):
+        self.assertEqual(self.client.channels, {
+            "echo": 0,
+            "sink": 1,
+            "ctrl": 2
+        })
+        for channel in self.client.channels.values():
+            self.assertEqual(self.client.credit[channel], RX_BYTES)
+
+    def test_echo(self):
+        # Several times the credit, so the hub has to return credit.
+        data = bytes(i * 7 % 251 for i in range(5 * RX_BYTES + 123))
+        self.client.send("echo", data)
+        self.assertEqual(self.client.recv("echo", len(data)), data)
+        # All credit is returned once the model has read everything.
+        deadline = time.monotonic() + 5
+        while self.client.credit[0] != RX_BYTES:
+            self.assertLess(time.monotonic(), deadline)
+            self.client.poll(0.01)
+
+    def test_batched_frames(self):
+        # Frames of several channels and a partial frame in one write, and the
+        # rest of the frame in another one.
+        frames = (pack_frame(0, FRAME_DATA, b"Hello, ") +
+                  pack_frame(1, FRAME_DATA, b"ignored") +
+                  pack_frame(0, FRAME_DATA, b"hub!"))
+        self.client.sock.sendall(frames[:-2])
+        time.sleep(0.1)
+        self.client.sock.sendall(frames[-2:])
+        self.assertEqual(self.client.recv("echo", 11), b"Hello, hub!")
+
+    def test_frame_format(self):
+        # The raw bytes of the announcement to a new client.
+        expected = b""
+        for channel, name in enumerate([b"echo", b"sink", b"ctrl"]):
+            expected += HEADER.pack(channel, FRAME_CHANNEL, 0, len(name)) + name
+            expected += (HEADER.pack(channel, FRAME_CREDIT, 0, 4) +
+                         RX_BYTES.to_bytes(4, "little"))
+
+        self.client.close()
+        # Wait for the hub to notice, as in connect().
+        time.sleep(0.1)
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        sock.connect(self.path)
+        sock.settimeout(5)
+        data = b""
+        while len(data) < len(expected):
+            chunk = sock.recv(len(expected) - len(data))
+            self.assertTrue(chunk, "The hub closed the connection")
+            data += chunk
+        sock.close()
+        self.assertEqual(data, expected)
+
+    def test_credit_exceeded(self):
+        sink = self.client.channels["sink"]
+        self.client.send("sink", bytes(RX_BYTES))
+        self.assertEqual(self.client.credit[sink], 0)
+        # The model never reads the sink, so no credit comes back.
+        self.client.poll(0.2)
+        self.assertEqual(self.client.credit[sink], 0)
+
+        # Sending beyond the credit gets the client dropped.
+        self.client.sock.sendall(pack_frame(sink, FRAME_DATA, b"x"))
+        deadline = time.monotonic() + 5
+        while self.client.poll(0.01):
+            self.assertLess(time.monotonic(), deadline)
+
+        # A new client only gets the credit of the free space.
+        self.client.close()
+        self.client = self.connect()
+        self.assertEqual(self.client.credit[sink], 0)
+        self.assertEqual(self.client.credit[self.client.channels["echo"]],
+                         RX_BYTES)
+
+    def test_flood_does_not_block(self):
+        # Ask for more data than the hub and the socket can buffer, and do not
+        # read it for a while. The model must not wait for the client forever.
+        self.client.send("ctrl", b"f")
+        time.sleep(2)
+        self.assertEqual(self.client.recv("ctrl", 1, timeout=30), b"F")
+        self.client.poll(0.5)
+        sink = self.client.channels["sink"]
+        received = len(self.client.data[sink])
+        self.assertGreater(received, 0)
+        self.assertLess(received, 4 * 1024 * 1024)
+
+        # Once the client caught up, the channel works as before.
+        self.client.send("echo", b"ping")
+        self.assertEqual(self.client.recv("echo", 4), b"ping")
+
+    def test_close(self):
+        self.client.send("ctrl", b"q")
+        deadline = time.monotonic() + 5
+        while self.client.poll(0.01):
+            self.assertLess(time.monotonic(), deadline)
+        self.assertEqual(list(self.client.closed.values()), [True] * 3)
+        self.assertEqual(self.proc.wait(5), 0)
+        self.assertFalse(os.path.exists(self.path))
+
+
+if __name__ == "__main__":
+    unittest.main()
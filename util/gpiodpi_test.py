@@ -0,0 +1,173 @@
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Tests of the host protocol of gpiodpi, against gpiodpi_driver."""
+
+import os
+import queue
+import struct
+import subprocess
+import tempfile
+import threading
+import time
+import unittest
+from pathlib import Path
+
+from dpi_hub_client import DpiHubClient
+
+# GPIODPI_EVENT_* in gpiodpi.h
+EVENT_SYNC = 0x80
+EVENT_SET = 0x81
+EVENT_OUTPUT = 0x82
+EVENT = struct.Struct("<B3xIIIQ")
+
+DRIVER_BIN = os.environ.get("GPIODPI_DRIVER",
+                            str(Path(__file__).parent / "gpiodpi_driver"))
+
+
+def event(event_type: int,
+          mask: int = 0,
+          value: int = 0,
+          weak: int = 0,
+          cycle: int = 0) -> bytes:
+    return EVENT.pack(event_type, mask, value, weak, cycle)
+
+
+class TestGpiodpi(unittest.TestCase):
+
+    def setUp(self):
+        self.tmpdir = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.tmpdir.name, "hub.sock")
+        self.proc = subprocess.Popen([DRIVER_BIN],
+                                     env=dict(os.environ,
+                                              DPI_HUB_SOCKET=self.path),
+                                     stdout=subprocess.PIPE,
+                                     text=True)
+        # The cycles and values of the pins printed by the driver, as they
+        # change
+        self.pins = queue.Queue()
+        self.reader = threading.Thread(target=self.read_pins)
+        self.reader.start()
+
+        deadline = time.monotonic() + 10
+        while not os.path.exists(self.path):
+            self.assertLess(time.monotonic(), deadline,
+                            "The hub did not create its socket")
+            time.sleep(0.01)
+        self.client = DpiHubClient(self.path)
+        self.client.wait_channel("gpio0")
+
+    def tearDown(self):
+        self.client.close()
+        self.proc.kill()
+        self.proc.wait()
+        self.reader.join()
+        self.proc.stdout.close()
+        self.tmpdir.cleanup()
+
+    def read_pins(self):
+        for line in self.proc.stdout:
+            words = line.split()
+            if len(words) == 3 and words[0] == "PINS":
+                self.pins.put((int(words[1], 16), int(words[2], 16)))
+
+    def wait_pins_at(self, value: int) -> list:
+        """Return the cycles and pin values up to `value`."""
+        seen = []
+        while not seen or seen[-1][1] != value:
+            seen.append(self.pins.get(timeout=10))
+        return seen
+
+    def wait_pins(self, value: int) -> list:
+        """Return the pin values up to `value`."""
+        return [v for _, v in self.wait_pins_at(value)]
+
+    def recv_event(self) -> tuple:
+        """Return the next event from the device, skipping any text."""
+        data = self.client.recv("gpio0", 1)
+        while data[0] < EVENT_SYNC:
+            data = self.client.recv("gpio0", 1)
+        data += self.client.recv("gpio0", EVENT.size - 1)
+        return EVENT.unpack(data)
+
+    def recv_until_sync(self) -> list:
+        """Return the events from the device up to the reply to a SYNC."""
+        events = [self.recv_event()]
+        while events[-1][0] != EVENT_SYNC:
+            events.append(self.recv_event())
+        return events
+
+    def sync(self) -> int:
+        """Return the current cycle of the device."""
+        self.client.send("gpio0", event(EVENT_SYNC))
+        return self.recv_until_sync()[-1][4]
+
+    def test_text(self):
+        self.client.send("gpio0", b"h2 h5\n")
+        self.assertEqual(self.wait_pins(0x24), [0x24])
+        self.client.send("gpio0", b"l2\n")
+        self.assertEqual(self.wait_pins(0x20), [0x20])
+
+    def test_binary(self):
+        self.client.send("gpio0",
+                         event(EVENT_SET, 0xff, 0x12) + event(EVENT_SYNC))
+        self.recv_until_sync()
+        self.assertEqual(self.wait_pins(0x12), [0x12])
+
+    def test_text_then_binary(self):
+        # The switch in the middle of a read: the text before the first event
+        # is applied first, and the events override it.
+        self.client.send(
+            "gpio0", b"h3 h4\n" + event(EVENT_SET, 0x10, 0x00) +
+            event(EVENT_SET, 0x1, 0x1) + event(EVENT_SYNC))
+        self.recv_until_sync()
+        self.assertEqual(self.wait_pins(0x9), [0x9])
+
+        # The following reads are events as well.
+        self.client.send("gpio0", event(EVENT_SET, 0x8, 0x0, cycle=0))
+        self.assertEqual(self.wait_pins(0x1), [0x1])
+
+    def test_future_sets(self):
+        # Events for future cycles, sent out of order, are applied at their
+        # cycle and in the order of their cycles.
+        now = self.sync()
+        self.client.send(
+            "gpio0",
+            event(EVENT_SET, 0xff, 0x3, cycle=now + 3000) +
+            event(EVENT_SET, 0xff, 0x1, cycle=now + 1000) +
+            event(EVENT_SET, 0xff, 0x2, cycle=now + 2000))
+        self.assertEqual(self.wait_pins_at(0x3), [(now + 1000, 0x1),
+                                                  (now + 2000, 0x2),
+                                                  (now + 3000, 0x3)])
+
+        # Events for the same cycle apply in the order they were sent.
+        now = self.sync()
+        self.client.send(
+            "gpio0",
+            event(EVENT_SET, 0xff, 0x5, cycle=now + 1000) +
+            event(EVENT_SET, 0x0f, 0x6, cycle=now + 1000))
+        self.assertEqual(self.wait_pins_at(0x6), [(now + 1000, 0x6)])
+
+    def test_output_events(self):
+        # The driver outputs the pins 15..0 one cycle after the host drives
+        # them, with the pins 31..16 as the output enables.
+        now = self.sync()
+        self.client.send(
+            "gpio0",
+            # Drive pins 0 and 1, i.e. both data and output enable change.
+            event(EVENT_SET, 0x00030003, 0x00030001, cycle=now + 1000) +
+            # Pin 1 goes tri-state without a change of its data.
+            event(EVENT_SET, 0x00020000, 0x00000000, cycle=now + 2000) +
+            # Only the data of pin 0 changes.
+            event(EVENT_SET, 0x00000001, 0x00000000, cycle=now + 3000) +
+            event(EVENT_SYNC, cycle=now + 4000))
+        self.assertEqual(self.recv_until_sync(), [
+            (EVENT_OUTPUT, 0x3, 0x1, 0x3, now + 1001),
+            (EVENT_OUTPUT, 0x1, 0x1, 0x2, now + 2001),
+            (EVENT_OUTPUT, 0x1, 0x0, 0x1, now + 3001),
+            (EVENT_SYNC, 0x1, 0x0, 0x0, now + 4000),
+        ])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,15 @@
+// Copyright lowRISC contributors (OpenTitan project).
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_UTIL_SVDPI_SHIM_SVDPI_H_
+#define OPENTITAN_UTIL_SVDPI_SHIM_SVDPI_H_
+
+// The part of the simulator's svdpi.h that the DPI models use, to build them
+// into the host tests of //util without a simulator.
+
+#include <stdint.h>
+
+typedef uint32_t svBitVecVal;
+
+#endif  // OPENTITAN_UTIL_SVDPI_SHIM_SVDPI_H_
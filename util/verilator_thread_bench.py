@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors (OpenTitan project).
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Measures the speed of the chip-level Verilator model against thread count.
+
+For every requested thread count, this script builds `//hw:verilator` with
+`--threads N`, boots the given ROM, flash and OTP images for a fixed number of
+cycles and reports the simulation speed printed by VerilatorSimCtrl.
+
+With `--pgo`, each model is first built with `--prof-pgo` and run once to
+collect a profile of its threads, and then rebuilt with that profile, which
+lets Verilator partition the model according to the measured cost of each of
+its parts rather than its static estimates. This needs Verilator 5.
+
+  Typical usage:
+
+  util/verilator_thread_bench.py --threads 1 2 4 8 \\
+      --rom bazel-bin/sw/device/lib/testing/test_rom/test_rom_sim_verilator.scr.39.vmem \\
+      --otp bazel-bin/hw/top_earlgrey/data/otp/img_rma.vmem \\
+      --flash bazel-bin/sw/device/tests/uart_smoketest_prog_sim_verilator.64.scr.vmem
+"""
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+REPO_TOP = Path(__file__).resolve().parent.parent
+BAZEL = str(REPO_TOP / "bazelisk.sh")
+SPEED_RE = re.compile(r"^Simulation speed: ([0-9.e+]+) cycles/s", re.MULTILINE)
+
+
+def build_model(threads: int, extra_options: list, dest: Path) -> Path:
+    """Builds the Verilator model and copies it to `dest`."""
+    options = ["--threads", str(threads)] + extra_options
+    flag = "--//hw:verilator_options=" + ",".join(options)
+    subprocess.run([BAZEL, "build", flag, "//hw:verilator"],
+                   cwd=REPO_TOP,
+                   check=True)
+    files = subprocess.run(
+        [BAZEL, "cquery", flag, "--output=files", "//hw:verilator"],
+        cwd=REPO_TOP,
+        check=True,
+        stdout=subprocess.PIPE,
+        text=True).stdout.split()
+    shutil.copy(REPO_TOP / files[0], dest)
+    return dest
+
+
+def run_model(model: Path, args: argparse.Namespace,
+              plusargs: tuple = ()) -> float:
+    """Boots the images on `model` and returns the speed in cycles/s."""
+    with tempfile.TemporaryDirectory() as workdir:
+        # The model creates its UART, SPI and GPIO endpoints in the current
+        # directory.
+        result = subprocess.run([
+            str(model.resolve()),
+            f"--meminit=rom0,{args.rom.resolve()}",
+            f"--meminit=flash0,{args.flash.resolve()}",
+            f"--meminit=otp,{args.otp.resolve()}",
+            f"--term-after-cycles={args.cycles}",
+        ] + list(plusargs),
+                                cwd=workdir,
+                                stdin=subprocess.DEVNULL,
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT,
+                                text=True)
+    match = SPEED_RE.search(result.stdout)
+    if not match:
+        sys.stderr.write(result.stdout)
+        raise RuntimeError(f"{model} did not report its speed")
+    return float(match.group(1))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--threads",
+                        type=int,
+                        nargs="+",
+                        default=[1, 2, 4, 8],
+                        help="Thread counts to measure")
+    parser.add_argument("--cycles",
+                        type=int,
+                        default=2000000,
+                        help="Number of cycles to simulate for each model")
+    parser.add_argument("--rom", type=Path, required=True, help="ROM image")
+    parser.add_argument("--flash",
+                        type=Path,
+                        required=True,
+                        help="Flash image")
+    parser.add_argument("--otp", type=Path, required=True, help="OTP image")
+    parser.add_argument("--pgo",
+                        action="store_true",
+                        help="Tune the thread partitioning with a profile")
+    parser.add_argument("--outdir",
+                        type=Path,
+                        default=Path("build/verilator_thread_bench"),
+                        help="Where to keep the models and profiles")
+    args = parser.parse_args()
+
+    args.outdir.mkdir(parents=True, exist_ok=True)
+    results = []
+    for threads in args.threads:
+        name = f"Vchip_sim_tb_threads{threads}"
+        options = []
+        if args.pgo:
+            profile = (args.outdir / f"profile_threads{threads}.vlt").resolve()
+            model = build_model(threads, ["--prof-pgo"],
+                                args.outdir / f"{name}_prof")
+            run_model(model, args, [f"+verilator+prof+vlt+file+{profile}"])
+            options.append(str(profile))
+        model = build_model(threads, options, args.outdir / name)
+        results.append((threads, run_model(model, args)))
+
+    base = results[0][1]
+    print(f"{'threads':>8} {'cycles/s':>12} {'speedup':>8}")
+    for threads, speed in results:
+        print(f"{threads:>8} {speed:>12.0f} {speed / base:>8.2f}")
+
+
+if __name__ == "__main__":
+    main()